@@ -5,6 +5,12 @@
 //  ・ビルボード用（常にカメラへ正面を向く 2D スプライト）
 //  ・各頂点を uPosition からの相対位置として扱う
 //  ・法線は不要（ライティングをしない想定）
+//
+//  パーミュテーション（ShaderVariantCache が #define を差し込む）
+//    USE_IMPOSTOR   : 八面体インポスター（ImpostorAtlas）の板ポリ
+//                     メッシュの外接球を覆う四角形をカメラへ向け、
+//                     アトラス参照用のローカル座標を Impostor.frag へ渡す
+//    USE_INSTANCING : ワールド行列を頂点属性から取る（USE_IMPOSTOR と併用）
 //======================================================================
 
 
@@ -22,6 +28,20 @@ uniform mat4 uViewProj;
 // inPosition は中心からのオフセット（-0.5～+0.5）を想定
 uniform vec3 uPosition;
 
+#ifdef USE_IMPOSTOR
+// カメラ位置（Impostor.frag と共通）
+uniform vec3 uCameraPos;
+
+// ベイク時の外接球（メッシュのローカル座標）
+uniform vec3  uImpostorCenter;
+uniform float uImpostorRadius;
+#endif
+
+#ifdef USE_INSTANCING
+// フェード距離（x : 開始, y : 完全に消える距離）
+uniform vec2 uFadeRange;
+#endif
+
 
 //======================================================================
 //  Attributes（頂点属性）
@@ -30,6 +50,13 @@ layout(location = 0) in vec3 inPosition;   // ローカル座標（中心から
 layout(location = 1) in vec3 inNormal;     // 未使用（ビルボードはライティングしない）
 layout(location = 2) in vec2 inTexCoord;   // UV
 
+#ifdef USE_INSTANCING
+// インスタンスのワールド行列の第 0〜2 列（Phong.vert と同じ）
+layout(location = 5) in vec4 inInstanceCol0;
+layout(location = 6) in vec4 inInstanceCol1;
+layout(location = 7) in vec4 inInstanceCol2;
+#endif
+
 
 //======================================================================
 //  Fragment Shader へ渡す値
@@ -37,12 +64,69 @@ layout(location = 2) in vec2 inTexCoord;   // UV
 out vec2 fragTexCoord;
 out vec3 fragWorldPos;
 
+#ifdef USE_IMPOSTOR
+out vec3 fragLocalPos;              // 外接球の中心からの位置（ローカル単位）
+out vec3 fragLocalRay;              // カメラ → 頂点（ローカル）
+flat out vec3  fragViewDir;         // 中心 → カメラ（ローカル、正規化）
+flat out mat3  fragLocalToWorld;    // 法線用の回転（v * M）
+flat out float fragScale;           // ローカル → ワールドの長さの倍率
+#endif
+
+#ifdef USE_INSTANCING
+// 距離フェード（1 : 表示, 0 : 消える）
+out float fragFade;
+#endif
+
 
 //======================================================================
 //  main
 //======================================================================
 void main()
 {
+#ifdef USE_IMPOSTOR
+    //------------------------------------------------------------------
+    // Step 1 : ワールド行列と外接球の中心
+    //   行ベクトル規約なので、各列を mat4 の列にそのまま並べればよい
+    //------------------------------------------------------------------
+#ifdef USE_INSTANCING
+    mat4 world = mat4(inInstanceCol0, inInstanceCol1, inInstanceCol2, vec4(0.0, 0.0, 0.0, 1.0));
+#else
+    mat4 world = uWorldTransform;
+#endif
+    vec3  center = (vec4(uImpostorCenter, 1.0) * world).xyz;
+    float scale  = length(vec3(world[0].x, world[1].x, world[2].x));
+    mat3  rot    = mat3(world[0].xyz, world[1].xyz, world[2].xyz) / max(scale, 1e-6);
+
+    //------------------------------------------------------------------
+    // Step 2 : 中心からカメラへ向けた四角形（外接球を覆うサイズ）
+    //------------------------------------------------------------------
+    vec3 toCam   = normalize(uCameraPos - center);
+    vec3 up      = (abs(toCam.y) > 0.999) ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    vec3 right   = normalize(cross(up, -toCam));
+    vec3 quadUp  = cross(-toCam, right);
+    vec3 offset  = (right * inPosition.x + quadUp * inPosition.y) * (2.0 * uImpostorRadius * scale);
+
+    vec4 pos     = vec4(center + offset, 1.0);
+    fragWorldPos = pos.xyz;
+
+    //------------------------------------------------------------------
+    // Step 3 : アトラス参照用のローカル量（rot は正規直交なので rot * v が逆変換）
+    //------------------------------------------------------------------
+    fragLocalPos     = (rot * offset) / scale;
+    fragLocalRay     = rot * (pos.xyz - uCameraPos);
+    fragViewDir      = rot * toCam;
+    fragLocalToWorld = rot;
+    fragScale        = scale;
+
+#ifdef USE_INSTANCING
+    vec3  origin = vec3(inInstanceCol0.w, inInstanceCol1.w, inInstanceCol2.w);
+    float dist   = distance(uCameraPos, origin);
+    fragFade = clamp((uFadeRange.y - dist) / max(uFadeRange.y - uFadeRange.x, 0.001), 0.0, 1.0);
+#endif
+
+    gl_Position  = pos * uViewProj;
+    fragTexCoord = inTexCoord;
+#else
     //------------------------------------------------------------------
     // Step 1 : ビルボード中心 + 頂点オフセット
     //------------------------------------------------------------------
@@ -73,4 +157,5 @@ void main()
     // Step 5 : UV をそのまま出力
     //------------------------------------------------------------------
     fragTexCoord = inTexCoord;
+#endif
 }
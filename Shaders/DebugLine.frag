@@ -0,0 +1,15 @@
+#version 410 core
+
+//======================================================================
+// DebugLine.frag
+// ・DebugDraw の線分を頂点色そのままで塗る（ライティングなし）
+//======================================================================
+
+in vec4 fragColor;
+
+out vec4 outColor;
+
+void main()
+{
+    outColor = fragColor;
+}
@@ -0,0 +1,34 @@
+#version 410 core
+
+//======================================================================
+// DebugLine.vert
+// ・DebugDraw が積んだ線分用の頂点シェーダ
+// ・頂点はワールド座標で来るのでワールド行列は不要
+//======================================================================
+
+
+//-----------------------------------------------------------------------
+//  Uniforms
+//-----------------------------------------------------------------------
+// ビュー射影行列（ワールド → クリップ空間）
+uniform mat4 uViewProj;
+
+
+//-----------------------------------------------------------------------
+//  Attributes（頂点属性）
+//-----------------------------------------------------------------------
+layout(location = 0) in vec3 inPosition;   // 頂点座標（ワールド）
+layout(location = 1) in vec4 inColor;      // 線色（RGBA8 正規化）
+
+
+//-----------------------------------------------------------------------
+//  出力
+//-----------------------------------------------------------------------
+out vec4 fragColor;
+
+
+void main()
+{
+    gl_Position = vec4(inPosition, 1.0) * uViewProj;
+    fragColor   = inColor;
+}
@@ -0,0 +1,238 @@
+#version 410 core
+
+//======================================================================
+//  Impostor.frag
+//  ・八面体インポスター（ImpostorAtlas）の描画（頂点は Billboard.vert）
+//  ・アトラスは N x N のフレーム。フレーム (i, j) は八面体マップ上の
+//    方向からメッシュを正射影で撮ったもの
+//  ・カメラ方向を囲む 4 フレームを、各フレームの投影面へ視線を
+//    延ばして参照し、双線形の重みでブレンドする（切り替わりが飛ばない）
+//  ・アルファはテスト（0.5 未満は discard）。半透明ソートは不要
+//  ・法線アトラスでライティング、深度アトラスで gl_FragDepth を書く
+//
+//  パーミュテーション
+//    USE_FOG        : 距離フォグを合成する
+//    USE_INSTANCING : 距離フェードをディザ抜きで行う（ScatterComponent）
+//
+//  ※ 方向の符号化・フレームの基底は ImpostorAtlas.cpp と一致させること
+//======================================================================
+
+
+//======================================================================
+//  入力
+//======================================================================
+in vec2 fragTexCoord;
+in vec3 fragWorldPos;
+in vec3 fragLocalPos;
+in vec3 fragLocalRay;
+flat in vec3  fragViewDir;
+flat in mat3  fragLocalToWorld;
+flat in float fragScale;
+
+#ifdef USE_INSTANCING
+in float fragFade;
+#endif
+
+
+//======================================================================
+//  出力
+//======================================================================
+out vec4 outColor;
+
+
+//======================================================================
+//  Uniforms
+//======================================================================
+
+// アトラス（0 : アルベド + カバレッジ, 1 : 法線 + 深度）
+uniform sampler2D uTexture;
+uniform sampler2D uNormalDepth;
+
+// アトラスのレイアウト
+uniform float uFramesPerSide;   // N
+uniform float uHemisphere;      // 1 : 上半球のみ, 0 : 全球
+uniform float uImpostorRadius;
+uniform float uFrameTexel;      // 1 フレームの 1 テクセル（0〜1）
+
+// 深度の書き込み用
+uniform mat4 uViewProj;
+
+// カメラ・ライト（LightingManager::ApplyToShader）
+uniform vec3  uCameraPos;
+uniform vec3  uAmbientLight;
+uniform float uSunIntensity;
+
+struct DirectionalLight
+{
+    vec3 mDirection;
+    vec3 mDiffuseColor;
+    vec3 mSpecColor;
+};
+uniform DirectionalLight uDirLight;
+
+#ifdef USE_FOG
+struct FogInfo
+{
+    float maxDist;
+    float minDist;
+    vec3  color;
+};
+uniform FogInfo uFoginfo;
+#endif
+
+
+//======================================================================
+//  関数：八面体マップ（方向 ⇔ [-1, 1]^2）
+//======================================================================
+vec2 EncodeDir(vec3 d)
+{
+    d /= (abs(d.x) + abs(d.y) + abs(d.z));
+    if (uHemisphere > 0.5)
+    {
+        return vec2(d.x + d.z, d.x - d.z);
+    }
+    vec2 p = d.xz;
+    if (d.y < 0.0)
+    {
+        p = (1.0 - abs(p.yx)) * vec2(p.x >= 0.0 ? 1.0 : -1.0, p.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return p;
+}
+
+vec3 DecodeDir(vec2 e)
+{
+    vec3 d;
+    if (uHemisphere > 0.5)
+    {
+        vec2 p = vec2(e.x + e.y, e.x - e.y) * 0.5;
+        d = vec3(p.x, 1.0 - abs(p.x) - abs(p.y), p.y);
+    }
+    else
+    {
+        d = vec3(e.x, 1.0 - abs(e.x) - abs(e.y), e.y);
+        if (d.y < 0.0)
+        {
+            d.xz = (1.0 - abs(d.zx)) * vec2(d.x >= 0.0 ? 1.0 : -1.0, d.z >= 0.0 ? 1.0 : -1.0);
+        }
+    }
+    return normalize(d);
+}
+
+
+//======================================================================
+//  関数：1 フレーム分のサンプル
+//  ・視線をフレームの投影面（中心を通り dir に垂直）まで延ばし、
+//    ベイク時の LookAt と同じ基底で UV を求める
+//======================================================================
+void SampleFrame(vec2 frame, float weight, inout vec4 albedo, inout vec4 normalDepth)
+{
+    if (weight <= 0.0) return;
+
+    vec3 dir = DecodeDir(frame / (uFramesPerSide - 1.0) * 2.0 - 1.0);
+
+    vec3 ray = normalize(fragLocalRay);
+    float denom = dot(ray, dir);
+    float t = (abs(denom) > 1e-4) ? -dot(fragLocalPos, dir) / denom : 0.0;
+    vec3 p = fragLocalPos + ray * t;
+
+    vec3 zAxis = -dir;
+    vec3 up    = (abs(dir.y) > 0.999) ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    vec3 xAxis = normalize(cross(up, zAxis));
+    vec3 yAxis = cross(zAxis, xAxis);
+
+    vec2 uv = vec2(dot(p, xAxis), dot(p, yAxis)) / (2.0 * uImpostorRadius) + 0.5;
+    if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0)))) return;
+
+    // 隣のフレームへにじまないよう半テクセル内側に寄せる
+    uv = clamp(uv, vec2(uFrameTexel * 0.5), vec2(1.0 - uFrameTexel * 0.5));
+    vec2 atlasUV = (frame + uv) / uFramesPerSide;
+
+    albedo      += texture(uTexture,     atlasUV) * weight;
+    normalDepth += texture(uNormalDepth, atlasUV) * weight;
+}
+
+
+//======================================================================
+//  関数：ディザ抜きのしきい値（4x4 Bayer、Phong.frag と同じ）
+//======================================================================
+#ifdef USE_INSTANCING
+float DitherThreshold()
+{
+    const float bayer[16] = float[16]( 0.0,  8.0,  2.0, 10.0,
+                                      12.0,  4.0, 14.0,  6.0,
+                                       3.0, 11.0,  1.0,  9.0,
+                                      15.0,  7.0, 13.0,  5.0);
+    ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+#endif
+
+
+//======================================================================
+//  main()
+//======================================================================
+void main()
+{
+#ifdef USE_INSTANCING
+    if (fragFade < DitherThreshold())
+    {
+        discard;
+    }
+#endif
+
+    //------------------------------------------------------------------
+    // Step 1 : カメラ方向を囲む 4 フレームと重み
+    //------------------------------------------------------------------
+    vec3 viewDir = fragViewDir;
+    if (uHemisphere > 0.5)
+    {
+        viewDir.y = max(viewDir.y, 0.0);
+        viewDir   = normalize(viewDir + vec3(0.0, 1e-4, 0.0));
+    }
+
+    vec2 grid  = (EncodeDir(viewDir) * 0.5 + 0.5) * (uFramesPerSide - 1.0);
+    vec2 base  = clamp(floor(grid), vec2(0.0), vec2(uFramesPerSide - 2.0));
+    vec2 f     = clamp(grid - base, 0.0, 1.0);
+
+    vec4 albedo      = vec4(0.0);
+    vec4 normalDepth = vec4(0.0);
+    SampleFrame(base,                 (1.0 - f.x) * (1.0 - f.y), albedo, normalDepth);
+    SampleFrame(base + vec2(1.0, 0.0), f.x        * (1.0 - f.y), albedo, normalDepth);
+    SampleFrame(base + vec2(0.0, 1.0), (1.0 - f.x) * f.y,        albedo, normalDepth);
+    SampleFrame(base + vec2(1.0, 1.0), f.x        * f.y,         albedo, normalDepth);
+
+    if (albedo.a < 0.5)
+    {
+        discard;
+    }
+    albedo.rgb      /= albedo.a;
+    normalDepth.rgb /= albedo.a;
+    normalDepth.a   /= albedo.a;
+
+    //------------------------------------------------------------------
+    // Step 2 : ライティング（アンビエント + 太陽の拡散のみ）
+    //------------------------------------------------------------------
+    vec3 N = normalize((normalDepth.rgb * 2.0 - 1.0) * fragLocalToWorld);
+    vec3 L = normalize(-uDirLight.mDirection);
+    vec3 lighting = uAmbientLight + uDirLight.mDiffuseColor * max(dot(N, L), 0.0) * uSunIntensity;
+    vec3 color = albedo.rgb * lighting;
+
+    //------------------------------------------------------------------
+    // Step 3 : 深度（ベイク時の中心からの奥行きぶんカメラ側へ寄せる）
+    //------------------------------------------------------------------
+    float offset  = (normalDepth.a * 2.0 - 1.0) * uImpostorRadius * fragScale;
+    vec3  surface = fragWorldPos - normalize(fragWorldPos - uCameraPos) * offset;
+    vec4  clip    = vec4(surface, 1.0) * uViewProj;
+    gl_FragDepth  = clamp(clip.z / clip.w * 0.5 + 0.5, 0.0, 1.0);
+
+    //------------------------------------------------------------------
+    // Step 4 : フォグ
+    //------------------------------------------------------------------
+#ifdef USE_FOG
+    float dist = length(uCameraPos - surface);
+    float fogFactor = clamp((uFoginfo.maxDist - dist) / (uFoginfo.maxDist - uFoginfo.minDist), 0.0, 1.0);
+    color = mix(uFoginfo.color, color, fogFactor);
+#endif
+
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,51 @@
+#version 410 core
+
+//======================================================================
+//  ImpostorBake.frag
+//  ・ImpostorAtlas のベイク用（頂点は Phong.vert をそのまま使う）
+//  ・ワールド行列でメッシュを外接球の中心へ移しているので、
+//    fragWorldPos は「中心からのローカル位置」になる
+//  ・出力 0 : アルベド（テクスチャ色）+ カバレッジ
+//    出力 1 : 法線（0〜1 に詰める）+ 奥行き（中心から撮影方向へ、±半径 → 0〜1）
+//======================================================================
+
+
+//======================================================================
+//  入力（Phong.vert と同じ）
+//======================================================================
+in vec2 fragTexCoord;
+in vec3 fragNormal;
+in vec3 fragWorldPos;
+in vec4 fragPosLightSpace;
+
+
+//======================================================================
+//  出力
+//======================================================================
+layout(location = 0) out vec4 outAlbedo;
+layout(location = 1) out vec4 outNormalDepth;
+
+
+//======================================================================
+//  Uniforms
+//======================================================================
+uniform sampler2D uTexture;
+
+// 撮影方向（中心 → カメラ）と外接球の半径
+uniform vec3  uBakeDir;
+uniform float uImpostorRadius;
+
+
+void main()
+{
+    vec4 texColor = texture(uTexture, fragTexCoord);
+    if (texColor.a < 0.5)
+    {
+        discard;
+    }
+
+    float depth = dot(fragWorldPos, uBakeDir) / uImpostorRadius;
+
+    outAlbedo      = vec4(texColor.rgb, 1.0);
+    outNormalDepth = vec4(normalize(fragNormal) * 0.5 + 0.5, clamp(depth * 0.5 + 0.5, 0.0, 1.0));
+}
@@ -2,8 +2,20 @@
 
 //======================================================================
 //  Phong.frag
-//  ・Phong + Toon 切り替え可能なライティング
+//  ・Phong / Toon ライティング
 //  ・ディレクショナルライト + シャドウマッピング + フォグ対応
+//
+//  パーミュテーション（ShaderVariantCache が #define を差し込む）
+//    USE_TOON           : トゥーンライティング（旧 uUseToon）
+//    USE_SHADOW         : シャドウマップを参照する
+//    USE_FOG            : 距離フォグを合成する
+//    USE_OVERRIDE_COLOR : ライティングせず単色で塗る（旧 uOverrideColor）
+//    USE_INSTANCING     : 距離フェードをディザ抜きで行う（ScatterComponent）
+//    USE_BAKED_LIGHTING : 焼いた太陽の可視率と AO を使う（LightBaker）
+//                         シャドウマップの代わりなので USE_SHADOW とは併用しない
+//
+//  実行時の uniform 分岐を持たないので、必要な機能だけの
+//  最小バリアントが Renderer 側で選ばれる。
 //======================================================================
 
 
@@ -20,6 +32,16 @@ in vec3 fragWorldPos;
 // ライト空間座標（シャドウマップ用）
 in vec4 fragPosLightSpace;
 
+#ifdef USE_INSTANCING
+// 距離フェード（1 : 表示, 0 : 消える）
+in float fragFade;
+#endif
+
+#ifdef USE_BAKED_LIGHTING
+// 焼いたライティング（x : 太陽の可視率, y : AO）
+in vec2 fragBakedLighting;
+#endif
+
 
 //======================================================================
 //  出力
@@ -31,29 +53,29 @@ out vec4 outColor;
 //  Uniforms - マテリアル/カメラ/ライティング
 //======================================================================
 
-// ベースカラー用テクスチャ
-uniform sampler2D uTexture;
-
+#ifdef USE_OVERRIDE_COLOR
 // 単色で塗りつぶす場合の色
 uniform vec3 uUniformColor;
-// true の時はテクスチャを無視して uUniformColor を使う
-uniform bool uOverrideColor;
+#else
+// ベースカラー用テクスチャ
+uniform sampler2D uTexture;
+#endif
 
-// カメラ位置（視線ベクトル計算用）
+// カメラ位置（視線ベクトル／フォグ距離計算用）
 uniform vec3 uCameraPos;
 
-// スペキュラーの鋭さ（指数）
-uniform float uSpecPower;
+// マテリアル（共有 UBO / MaterialBuffer のスロットを glBindBufferRange で割り当て）
+//   std140 : vec3 も 16 バイト境界になるため vec4 で持つ
+layout(std140) uniform MaterialBlock
+{
+    vec4 uMatAmbient;    // rgb : アンビエント色
+    vec4 uMatDiffuse;    // rgb : ディフューズ色
+    vec4 uMatSpecular;   // rgb : スペキュラー色, a : スペキュラーの鋭さ（指数）
+};
 
 // 環境光（アンビエント）
 uniform vec3 uAmbientLight;
 
-// シャドウバイアス（シャドウアクネ対策）
-uniform float uShadowBias;
-
-// Toon シェーディングを使うかどうか
-uniform bool uUseToon;
-
 // 太陽光の強さ（朝夕や天候でのスケール）
 uniform float uSunIntensity;
 
@@ -73,6 +95,7 @@ uniform DirectionalLight uDirLight;
 //======================================================================
 //  Fog（フォグ情報）
 //======================================================================
+#ifdef USE_FOG
 struct FogInfo
 {
     float maxDist;  // フォグが完全にかかる距離
@@ -80,24 +103,32 @@ struct FogInfo
     vec3  color;   // フォグの色
 };
 uniform FogInfo uFoginfo;
+#endif
 
 
 //======================================================================
 //  Shadow Mapping
 //======================================================================
+#ifdef USE_SHADOW
 // デプス比較付きのシャドウマップ
 uniform sampler2DShadow uShadowMap;
 
+// シャドウバイアス（シャドウアクネ対策）
+uniform float uShadowBias;
+#endif
+
 
 //======================================================================
 //  定数（Toon 関連）
 //======================================================================
+#ifdef USE_TOON
 const float toonDiffuseThreshold = 0.5;
 const float toonSpecThreshold    = 0.95;
+#endif
 
 
 //======================================================================
-//  関数：ライティング計算（Phong / Toon 切り替え）
+//  関数：ライティング計算（Phong / Toon はコンパイル時に選択）
 //======================================================================
 vec3 ComputeLighting(vec3 N, vec3 V, vec3 L)
 {
@@ -107,37 +138,34 @@ vec3 ComputeLighting(vec3 N, vec3 V, vec3 L)
     // 光が当たっている側のみ計算
     if (NdotL > 0.0)
     {
-        if (uUseToon)
-        {
-            //----------------------------
-            // Toon Diffuse
-            //----------------------------
-            float diffIntensity = step(toonDiffuseThreshold, NdotL);
-
-            //----------------------------
-            // Toon Specular
-            //----------------------------
-            float specIntensity = pow(max(dot(reflect(-L, N), V), 0.0), uSpecPower);
-            specIntensity = step(toonSpecThreshold, specIntensity);
-
-            result += uDirLight.mDiffuseColor * diffIntensity;
-            result += uDirLight.mSpecColor   * specIntensity;
-        }
-        else
-        {
-            //----------------------------
-            // Phong Diffuse
-            //----------------------------
-            vec3 diffuse = uDirLight.mDiffuseColor * NdotL;
-
-            //----------------------------
-            // Phong Specular
-            //----------------------------
-            vec3 specular = uDirLight.mSpecColor *
-                            pow(max(dot(reflect(-L, N), V), 0.0), uSpecPower);
-
-            result += diffuse + specular;
-        }
+#ifdef USE_TOON
+        //----------------------------
+        // Toon Diffuse
+        //----------------------------
+        float diffIntensity = step(toonDiffuseThreshold, NdotL);
+
+        //----------------------------
+        // Toon Specular
+        //----------------------------
+        float specIntensity = pow(max(dot(reflect(-L, N), V), 0.0), uMatSpecular.a);
+        specIntensity = step(toonSpecThreshold, specIntensity);
+
+        result += uDirLight.mDiffuseColor * diffIntensity;
+        result += uDirLight.mSpecColor   * specIntensity;
+#else
+        //----------------------------
+        // Phong Diffuse
+        //----------------------------
+        vec3 diffuse = uDirLight.mDiffuseColor * NdotL;
+
+        //----------------------------
+        // Phong Specular
+        //----------------------------
+        vec3 specular = uDirLight.mSpecColor *
+                        pow(max(dot(reflect(-L, N), V), 0.0), uMatSpecular.a);
+
+        result += diffuse + specular;
+#endif
     }
 
     return result;
@@ -149,6 +177,7 @@ vec3 ComputeLighting(vec3 N, vec3 V, vec3 L)
 //  ・ライト空間座標からシャドウマップを参照
 //  ・0.5〜1.0 の範囲で「少し柔らかい」シャドウに調整
 //======================================================================
+#ifdef USE_SHADOW
 float ComputeShadow()
 {
     // 透視除算
@@ -174,67 +203,110 @@ float ComputeShadow()
     // 0.5〜1.0 にマッピングして「完全な真っ暗」にはしない
     return mix(0.5, 1.0, shadow);
 }
+#endif
 
 
 //======================================================================
-//  main()
+//  関数：フォグ合成
 //======================================================================
-void main()
+vec3 ApplyFog(vec3 color)
 {
-    //------------------------------------------------------------------
-    // Step 1 : フォグ係数の計算
-    //------------------------------------------------------------------
+#ifdef USE_FOG
     float dist = length(uCameraPos - fragWorldPos);
     float fogFactor = clamp(
         (uFoginfo.maxDist - dist) / (uFoginfo.maxDist - uFoginfo.minDist),
         0.0,
         1.0
     );
+    return mix(uFoginfo.color, color, fogFactor);
+#else
+    return color;
+#endif
+}
 
-    //------------------------------------------------------------------
-    // Step 2 : 単色描画モード（デバッグ等）
-    //------------------------------------------------------------------
-    if (uOverrideColor)
+
+//======================================================================
+//  関数：ディザ抜きのしきい値（4x4 Bayer）
+//  ・半透明ソートなしでフェードさせるため、画素ごとに discard する
+//======================================================================
+#ifdef USE_INSTANCING
+float DitherThreshold()
+{
+    const float bayer[16] = float[16]( 0.0,  8.0,  2.0, 10.0,
+                                      12.0,  4.0, 14.0,  6.0,
+                                       3.0, 11.0,  1.0,  9.0,
+                                      15.0,  7.0, 13.0,  5.0);
+    ivec2 p = ivec2(gl_FragCoord.xy) & 3;
+    return (bayer[p.y * 4 + p.x] + 0.5) / 16.0;
+}
+#endif
+
+
+//======================================================================
+//  main()
+//======================================================================
+void main()
+{
+#ifdef USE_INSTANCING
+    if (fragFade < DitherThreshold())
     {
-        // フォグだけ適用して早期リターン
-        vec3 col = mix(uFoginfo.color, uUniformColor, fogFactor);
-        outColor = vec4(col, 1.0);
-        return;
+        discard;
     }
+#endif
 
+#ifdef USE_OVERRIDE_COLOR
+    //------------------------------------------------------------------
+    // 単色描画モード（トゥーン輪郭・デバッグ等）
+    //   フォグだけ適用して終了
     //------------------------------------------------------------------
-    // Step 3 : 基本ベクトル（N:法線, V:視線, L:ライト方向）
+    outColor = vec4(ApplyFog(uUniformColor), 1.0);
+#else
+    //------------------------------------------------------------------
+    // Step 1 : 基本ベクトル（N:法線, V:視線, L:ライト方向）
     //------------------------------------------------------------------
     vec3 N = normalize(fragNormal);
     vec3 V = normalize(uCameraPos - fragWorldPos);
     vec3 L = normalize(-uDirLight.mDirection);
 
     //------------------------------------------------------------------
-    // Step 4 : ディレクショナルライトによるライティング
+    // Step 2 : ディレクショナルライトによるライティング
     //------------------------------------------------------------------
     // まず太陽光(ディレクショナルライト)の分だけ計算
     vec3 dirLight = ComputeLighting(N, V, L);
 
     // アンビエント + 太陽光（太陽の強さでスケール）
+#ifdef USE_BAKED_LIGHTING
+    // 焼いた AO で環境光を遮る
+    vec3 lighting = uAmbientLight * fragBakedLighting.y + dirLight * uSunIntensity;
+#else
     vec3 lighting = uAmbientLight + dirLight * uSunIntensity;
+#endif
 
     //------------------------------------------------------------------
-    // Step 5 : シャドウ（太陽の強さに応じて影もフェード）
+    // Step 3 : シャドウ（太陽の強さに応じて影もフェード）
     //------------------------------------------------------------------
+#if defined(USE_BAKED_LIGHTING)
+    // 焼いた太陽の可視率をシャドウマップと同じ 0.5〜1.0 の濃さで使う
+    float shadowFactor = mix(0.5, 1.0, fragBakedLighting.x);
+    shadowFactor = mix(1.0, shadowFactor, uSunIntensity);
+    lighting *= shadowFactor;
+#elif defined(USE_SHADOW)
     float shadowFactor = ComputeShadow();
     shadowFactor = mix(1.0, shadowFactor, uSunIntensity);
+    lighting *= shadowFactor;
+#endif
 
     //------------------------------------------------------------------
-    // Step 6 : テクスチャ取得 + ライティング適用
+    // Step 4 : テクスチャ取得 + ライティング適用
     //------------------------------------------------------------------
     vec4 texColor = texture(uTexture, fragTexCoord);
-    texColor.rgb *= lighting * shadowFactor;
+    texColor.rgb *= lighting;
 
     //------------------------------------------------------------------
-    // Step 7 : フォグ合成
+    // Step 5 : フォグ合成
     //------------------------------------------------------------------
-    vec3 finalColor = mix(uFoginfo.color, texColor.rgb, fogFactor);
-    outColor = vec4(finalColor, texColor.a);
+    outColor = vec4(ApplyFog(texColor.rgb), texColor.a);
+#endif
 }
 /*
 #version 410
@@ -4,6 +4,16 @@
 //  Phong.vert
 //  ・Phong ライティング用の標準メッシュ頂点シェーダー
 //  ・シャドウマッピング用にライト空間座標も出力
+//
+//  パーミュテーション（ShaderVariantCache が #define を差し込む）
+//    USE_SKINNING : ボーンパレットによるスキニングを行う
+//                   （旧 Skinned.vert 相当）
+//    USE_INSTANCING : ワールド行列を頂点属性（インスタンス単位）から取る
+//                   （ScatterComponent の instanced 描画。距離フェード付き）
+//    USE_BAKED_LIGHTING : 焼いた太陽の可視率と AO を頂点属性から渡す
+//                   （LightBaker。静的メッシュのみ）
+//
+//  ※ ToyLib は「行ベクトル × 行列 (v * M)」で統一。
 //======================================================================
 
 
@@ -20,6 +30,23 @@ uniform mat4 uViewProj;
 // ワールド → ライト空間行列（シャドウマップ生成用）
 uniform mat4 uLightSpaceMatrix;
 
+#ifdef USE_INSTANCING
+// カメラ位置（フェード距離の計算用。Phong.frag と共通）
+uniform vec3 uCameraPos;
+
+// フェード距離（x : 開始, y : 完全に消える距離）
+uniform vec2 uFadeRange;
+#endif
+
+#ifdef USE_SKINNING
+// スキニング用ボーン行列パレット（BonePaletteBuffer の共有 UBO）
+//  - 配列長は BonePaletteBuffer::kMaxBones と合わせる
+layout(std140, row_major) uniform BonePalette
+{
+    mat4 uMatrixPalette[256];
+};
+#endif
+
 
 //======================================================================
 //  Vertex Attributes
@@ -32,6 +59,26 @@ layout(location = 1) in vec3 inNormal;
 // UV（テクスチャ座標）
 layout(location = 2) in vec2 inTexCoord;
 
+#ifdef USE_SKINNING
+// 影響ボーンID（最大4本）
+layout(location = 3) in uvec4 inSkinBones;
+// ボーンウェイト
+layout(location = 4) in vec4  inSkinWeights;
+#endif
+
+#ifdef USE_INSTANCING
+// インスタンスのワールド行列の第 0〜2 列
+//   行ベクトル規約なので dot(v, 列) がワールド座標の各成分になる
+layout(location = 5) in vec4 inInstanceCol0;
+layout(location = 6) in vec4 inInstanceCol1;
+layout(location = 7) in vec4 inInstanceCol2;
+#endif
+
+#ifdef USE_BAKED_LIGHTING
+// 焼いたライティング（x : 太陽の可視率, y : AO）
+layout(location = 8) in vec2 inBakedLighting;
+#endif
+
 
 //======================================================================
 //  Varyings（フラグメントへ渡す）
@@ -49,16 +96,55 @@ out vec3 fragWorldPos;
 // ライト空間座標（シャドウマップ参照用）
 out vec4 fragPosLightSpace;
 
+#ifdef USE_INSTANCING
+// 距離フェード（1 : 表示, 0 : 消える。フラグメントでディザ抜き）
+out float fragFade;
+#endif
+
+#ifdef USE_BAKED_LIGHTING
+// 焼いたライティング（x : 太陽の可視率, y : AO）
+out vec2 fragBakedLighting;
+#endif
+
 
 //======================================================================
 //  main()
 //======================================================================
 void main()
 {
+    vec4 pos = vec4(inPosition, 1.0);
+    vec4 n   = vec4(inNormal, 0.0);
+
+#ifdef USE_SKINNING
+    //------------------------------------------------------------------
+    // Step 0 : スキニング（ボーン4本分の線形結合）
+    //------------------------------------------------------------------
+    mat4 skinMat =
+          uMatrixPalette[inSkinBones[0]] * inSkinWeights[0]
+        + uMatrixPalette[inSkinBones[1]] * inSkinWeights[1]
+        + uMatrixPalette[inSkinBones[2]] * inSkinWeights[2]
+        + uMatrixPalette[inSkinBones[3]] * inSkinWeights[3];
+
+    pos = pos * skinMat;
+    n   = n   * skinMat;
+#endif
+
     //------------------------------------------------------------------
     // Step 1 : 頂点座標をワールド空間へ
     //------------------------------------------------------------------
-    vec4 worldPos = vec4(inPosition, 1.0) * uWorldTransform;
+#ifdef USE_INSTANCING
+    vec4 worldPos = vec4(dot(pos, inInstanceCol0),
+                         dot(pos, inInstanceCol1),
+                         dot(pos, inInstanceCol2),
+                         1.0);
+
+    // インスタンスの原点（各列の w = 平行移動）で距離フェード
+    vec3  origin = vec3(inInstanceCol0.w, inInstanceCol1.w, inInstanceCol2.w);
+    float dist   = distance(uCameraPos, origin);
+    fragFade = clamp((uFadeRange.y - dist) / max(uFadeRange.y - uFadeRange.x, 0.001), 0.0, 1.0);
+#else
+    vec4 worldPos = pos * uWorldTransform;
+#endif
     fragWorldPos = worldPos.xyz;
 
     //------------------------------------------------------------------
@@ -67,9 +153,15 @@ void main()
     gl_Position = worldPos * uViewProj;
 
     //------------------------------------------------------------------
-    // Step 3 : 法線をワールド空間で変換（スケールも含める）
+    // Step 3 : 法線をワールド空間で変換（w = 0 として平行移動を除外）
     //------------------------------------------------------------------
-    fragNormal = normalize(mat3(uWorldTransform) * inNormal);
+#ifdef USE_INSTANCING
+    fragNormal = normalize(vec3(dot(n, inInstanceCol0),
+                                dot(n, inInstanceCol1),
+                                dot(n, inInstanceCol2)));
+#else
+    fragNormal = normalize((n * uWorldTransform).xyz);
+#endif
 
     //------------------------------------------------------------------
     // Step 4 : UV そのまま渡す
@@ -80,4 +172,8 @@ void main()
     // Step 5 : ライト空間座標（シャドウマップで使う）
     //------------------------------------------------------------------
     fragPosLightSpace = worldPos * uLightSpaceMatrix;
+
+#ifdef USE_BAKED_LIGHTING
+    fragBakedLighting = inBakedLighting;
+#endif
 }
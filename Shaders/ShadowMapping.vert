@@ -0,0 +1,86 @@
+#version 410 core
+
+//======================================================================
+//  ShadowMapping.vert
+//
+//  ライト視点の深度マップ作成パス。
+//  ライト視点の座標系（LightSpaceMatrix = Projection * View）に
+//  頂点を変換し、gl_Position に書き込むだけ。
+//
+//  パーミュテーション（ShaderVariantCache が #define を差し込む）
+//    USE_SKINNING : ボーンパレットでスキニングしてから変換する
+//                   （旧 ShadowMapping_Skinned.vert 相当）
+//    USE_INSTANCING : ワールド行列を頂点属性（インスタンス単位）から取る
+//
+//  ※色情報・法線・UV は深度パスでは使用しないため不要。
+//======================================================================
+
+// ---------------------------------------------------------
+// Uniforms
+// ---------------------------------------------------------
+
+// モデル → ワールド変換
+uniform mat4 uWorldTransform;
+
+// ワールド → ライト空間変換（LightProj * LightView）
+uniform mat4 uLightSpaceMatrix;
+
+#ifdef USE_SKINNING
+// ボーン変換行列パレット（BonePaletteBuffer の共有 UBO・最大256ボーン）
+layout(std140, row_major) uniform BonePalette
+{
+    mat4 uMatrixPalette[256];
+};
+#endif
+
+
+// ---------------------------------------------------------
+// 頂点属性（頂点バッファ）
+// ---------------------------------------------------------
+layout(location = 0) in vec3 inPosition;     // 頂点位置
+
+#ifdef USE_SKINNING
+// 深度用 VAO では u8 x 4 / unorm16 x 4 に詰めたものが入る（VertexArray::SetDepthActive）
+layout(location = 3) in uvec4 inSkinBones;   // 影響ボーンID（4つ）
+layout(location = 4) in vec4  inSkinWeights; // ボーンウエイト（4つ）
+#endif
+
+#ifdef USE_INSTANCING
+// インスタンスのワールド行列の第 0〜2 列（Phong.vert と同じ）
+layout(location = 5) in vec4 inInstanceCol0;
+layout(location = 6) in vec4 inInstanceCol1;
+layout(location = 7) in vec4 inInstanceCol2;
+#endif
+
+
+// ---------------------------------------------------------
+// メインシェーダ
+// ---------------------------------------------------------
+void main()
+{
+    vec4 pos = vec4(inPosition, 1.0);
+
+#ifdef USE_SKINNING
+    // 4ボーンの線形合成（ToyLib は 行ベクトル × 行列）
+    mat4 skinMat =
+          uMatrixPalette[inSkinBones[0]] * inSkinWeights[0]
+        + uMatrixPalette[inSkinBones[1]] * inSkinWeights[1]
+        + uMatrixPalette[inSkinBones[2]] * inSkinWeights[2]
+        + uMatrixPalette[inSkinBones[3]] * inSkinWeights[3];
+
+    pos = pos * skinMat;
+#endif
+
+    // モデル → ワールド → ライト空間（これが影マップ座標）
+#ifdef USE_INSTANCING
+    vec4 worldPos = vec4(dot(pos, inInstanceCol0),
+                         dot(pos, inInstanceCol1),
+                         dot(pos, inInstanceCol2),
+                         1.0);
+    gl_Position = worldPos * uLightSpaceMatrix;
+#else
+    gl_Position = pos * uWorldTransform * uLightSpaceMatrix;
+#endif
+
+    // ※ 深度だけ使うのでフラグメント向け varyings は不要
+}
@@ -0,0 +1,61 @@
+#version 410
+
+//======================================================================
+//  SkinningTF.vert
+//  ・スキニングだけを行い、結果をトランスフォームフィードバックで書き出す
+//  ・フラグメントシェーダなし（GL_RASTERIZER_DISCARD で描画）
+//  ・書き出した位置／法線はモデル空間のまま。以降のパスは
+//    USE_SKINNING なしのバリアントで通常メッシュとして描く
+//
+//  ※ ToyLib は「行ベクトル × 行列 (v * M)」で統一。
+//======================================================================
+
+
+//======================================================================
+//  Uniforms
+//======================================================================
+
+// スキニング用ボーン行列パレット（BonePaletteBuffer の共有 UBO）
+//  - 配列長は BonePaletteBuffer::kMaxBones と合わせる
+layout(std140, row_major) uniform BonePalette
+{
+    mat4 uMatrixPalette[256];
+};
+
+
+//======================================================================
+//  Vertex Attributes（スキンメッシュの VertexArray と同じ配置）
+//======================================================================
+
+layout(location = 0) in vec3  inPosition;
+layout(location = 1) in vec3  inNormal;
+layout(location = 3) in uvec4 inSkinBones;
+layout(location = 4) in vec4  inSkinWeights;
+
+
+//======================================================================
+//  Transform Feedback 出力
+//  ・outPosition → バッファ 0、outNormal → バッファ 1
+//======================================================================
+
+out vec3 outPosition;
+out vec3 outNormal;
+
+
+//======================================================================
+//  main()
+//======================================================================
+void main()
+{
+    mat4 skinMat =
+          uMatrixPalette[inSkinBones[0]] * inSkinWeights[0]
+        + uMatrixPalette[inSkinBones[1]] * inSkinWeights[1]
+        + uMatrixPalette[inSkinBones[2]] * inSkinWeights[2]
+        + uMatrixPalette[inSkinBones[3]] * inSkinWeights[3];
+
+    // 法線の正規化は描画側（Phong.vert）で行うのでここでは不要
+    outPosition = (vec4(inPosition, 1.0) * skinMat).xyz;
+    outNormal   = (vec4(inNormal,   0.0) * skinMat).xyz;
+
+    gl_Position = vec4(0.0);
+}
@@ -0,0 +1,32 @@
+#version 410 core
+
+//======================================================================
+// SkyCapture.vert
+//
+// ・スカイキャッシュ用：キューブマップの 1 面をフルスクリーン四角形で描く
+// ・aPos（-1〜1）を uFace の面の方向ベクトルに変換して
+//   WeatherDome.frag にそのまま渡す（vWorldDir は正規化しない）
+// ・面の向きは GL のキューブマップ規約（+X, -X, +Y, -Y, +Z, -Z）
+//======================================================================
+
+layout (location = 0) in vec2 aPos;
+
+// 0〜5 : GL_TEXTURE_CUBE_MAP_POSITIVE_X からの番号
+uniform int uFace;
+
+out vec3 vWorldDir;
+
+void main()
+{
+    float u = aPos.x;
+    float v = aPos.y;
+
+    if      (uFace == 0) vWorldDir = vec3( 1.0,  -v,  -u);
+    else if (uFace == 1) vWorldDir = vec3(-1.0,  -v,   u);
+    else if (uFace == 2) vWorldDir = vec3(   u, 1.0,   v);
+    else if (uFace == 3) vWorldDir = vec3(   u,-1.0,  -v);
+    else if (uFace == 4) vWorldDir = vec3(   u,  -v, 1.0);
+    else                 vWorldDir = vec3(  -u,  -v,-1.0);
+
+    gl_Position = vec4(aPos, 0.0, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 410 core
+
+//======================================================================
+// SkyCube.frag
+//
+// ・スカイキャッシュ（キューブマップ）を方向で引くだけの空
+// ・頂点シェーダは WeatherDome.vert（vWorldDir はドームの方向）
+//======================================================================
+
+in vec3 vWorldDir;
+out vec4 FragColor;
+
+uniform samplerCube uSkyCube;
+
+void main()
+{
+    FragColor = vec4(texture(uSkyCube, normalize(vWorldDir)).rgb, 1.0);
+}
@@ -0,0 +1,115 @@
+#version 410
+
+//======================================================================
+//  Terrain.vert
+//  ・TerrainComponent 用の頂点シェーダー（フラグメントは Phong.frag）
+//  ・全チャンク共通の格子メッシュ（0〜1 の XZ）を、チャンクの位置と
+//    サイズで配置し、高さは R16 のハイトマップから引く
+//  ・CDLOD の頂点モーフィング：LOD 境界の手前で奇数頂点を
+//    隣の偶数頂点へ寄せ、1 段粗い格子と継ぎ目なく一致させる
+//
+//  ※ ToyLib は「行ベクトル × 行列 (v * M)」で統一。
+//======================================================================
+
+
+//======================================================================
+//  Uniforms
+//======================================================================
+
+// ワールド → クリップ行列
+uniform mat4 uViewProj;
+
+// ワールド → ライト空間行列（シャドウマップ参照用）
+uniform mat4 uLightSpaceMatrix;
+
+// カメラ位置（モーフ距離の計算に使う。Phong.frag と共通）
+uniform vec3 uCameraPos;
+
+// ハイトマップ（R16：0〜1）
+uniform sampler2D uHeightMap;
+
+// 地形全体の配置
+uniform vec3  uTerrainOrigin;   // 格子の最小 XZ 角、高さ 0 の Y
+uniform vec2  uTerrainSize;     // 格子全体の XZ サイズ
+uniform vec2  uHeightMapSize;   // ハイトマップのサンプル数（幅, 奥行き）
+uniform float uCellSize;        // サンプル間隔
+uniform float uHeightScale;     // サンプル値 1.0 のときの高さ
+uniform float uTexTiling;       // テクスチャ 1 回分のワールド長
+
+// 格子メッシュの 1 辺のセル数
+uniform float uGridDim;
+
+// チャンク単位
+uniform vec3 uChunk;            // xy : 最小 XZ 角, z : 1 辺のサイズ
+uniform vec2 uMorph;            // x : モーフ開始距離, y : 終了距離
+
+
+//======================================================================
+//  Vertex Attributes
+//======================================================================
+
+// 格子上の位置（0〜1）
+layout(location = 0) in vec2 inGridPos;
+
+
+//======================================================================
+//  Varyings（Phong.frag と同じ）
+//======================================================================
+out vec2 fragTexCoord;
+out vec3 fragNormal;
+out vec3 fragWorldPos;
+out vec4 fragPosLightSpace;
+
+
+//======================================================================
+//  関数：ワールド XZ の地表高さ
+//  ・サンプル中心は (i + 0.5) / size（HeightField::GetHeight と一致）
+//======================================================================
+float SampleHeight(vec2 xz)
+{
+    vec2 uv = ((xz - uTerrainOrigin.xz) / uCellSize + 0.5) / uHeightMapSize;
+    return uTerrainOrigin.y + textureLod(uHeightMap, uv, 0.0).r * uHeightScale;
+}
+
+
+//======================================================================
+//  main()
+//======================================================================
+void main()
+{
+    //------------------------------------------------------------------
+    // Step 1 : モーフ前の位置でカメラ距離を求める
+    //------------------------------------------------------------------
+    vec2  xz    = uChunk.xy + inGridPos * uChunk.z;
+    float dist  = distance(uCameraPos, vec3(xz.x, SampleHeight(xz), xz.y));
+    float morph = clamp((dist - uMorph.x) / (uMorph.y - uMorph.x), 0.0, 1.0);
+
+    //------------------------------------------------------------------
+    // Step 2 : 奇数番目の頂点を 1 段粗い格子へ寄せる
+    //   fract(g * N / 2) は偶数頂点で 0、奇数頂点で 0.5
+    //------------------------------------------------------------------
+    vec2 oddOffset = fract(inGridPos * uGridDim * 0.5) * 2.0 / uGridDim;
+    xz -= oddOffset * uChunk.z * morph;
+
+    // ハイトマップ外にはみ出たチャンクの頂点は端に潰す
+    xz = clamp(xz, uTerrainOrigin.xz, uTerrainOrigin.xz + uTerrainSize);
+
+    //------------------------------------------------------------------
+    // Step 3 : 高さと法線（中心差分）
+    //------------------------------------------------------------------
+    vec4 worldPos = vec4(xz.x, SampleHeight(xz), xz.y, 1.0);
+    fragWorldPos  = worldPos.xyz;
+
+    float hL = SampleHeight(xz - vec2(uCellSize, 0.0));
+    float hR = SampleHeight(xz + vec2(uCellSize, 0.0));
+    float hD = SampleHeight(xz - vec2(0.0, uCellSize));
+    float hU = SampleHeight(xz + vec2(0.0, uCellSize));
+    fragNormal = normalize(vec3(hL - hR, 2.0 * uCellSize, hD - hU));
+
+    //------------------------------------------------------------------
+    // Step 4 : クリップ座標・UV・ライト空間
+    //------------------------------------------------------------------
+    gl_Position       = worldPos * uViewProj;
+    fragTexCoord      = (xz - uTerrainOrigin.xz) / uTexTiling;
+    fragPosLightSpace = worldPos * uLightSpaceMatrix;
+}
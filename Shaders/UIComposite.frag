@@ -0,0 +1,23 @@
+#version 410 core
+
+//======================================================================
+//  UIComposite.frag
+//
+//  保持モード UI（UILayerCache）のキャッシュをシーンへ合成する。
+//  頂点シェーダは WeatherScreen.vert（フルスクリーンクアッド）を共用。
+//
+//  ・キャッシュは乗算済みアルファなので、そのまま出力して
+//    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA) で重ねる
+//======================================================================
+
+in vec2 vUV;
+
+out vec4 outColor;
+
+// UI のキャッシュ（RGBA・乗算済みアルファ）
+uniform sampler2D uTexture;
+
+void main()
+{
+    outColor = texture(uTexture, vUV);
+}
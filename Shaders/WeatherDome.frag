@@ -142,8 +142,9 @@ void main()
     // 視線方向（スカイドーム上の方向）
     vec3 dir = normalize(vWorldDir);
 
-    // vWorldDir.y を 0〜1 にマッピング（天頂方向ほど 1）
-    float t = clamp(vWorldDir.y, 0.0, 1.0);
+    // dir.y を 0〜1 にマッピング（天頂方向ほど 1）
+    // ※ キューブマップへのキャプチャでは vWorldDir が正規化されていないので dir を使う
+    float t = clamp(dir.y, 0.0, 1.0);
 
     // 天候による「晴れ感」フェード
     float weatherFade = (uWeatherType == 0) ? 1.0 : 0.3;
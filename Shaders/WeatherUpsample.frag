@@ -0,0 +1,69 @@
+#version 410 core
+
+//======================================================================
+//  WeatherUpsample.frag
+//
+//  縮小解像度で描いた天気オーバーレイ（WeatherScreen.frag）を画面へ拡大合成する。
+//  頂点シェーダは WeatherScreen.vert（フルスクリーンクアッド）を共用。
+//
+//  ・周囲 2x2 の縮小テクセルをバイリニアの重みで混ぜるが、
+//    各テクセル中心のシーン深度がこの画素の深度から離れているほど重みを下げる
+//    （手前の物体の輪郭で、奥の霧がにじみ出さないように）
+//  ・深度は射影行列の [2][2] / [3][2] で視点からの距離に戻し、相対差で比べる
+//  ・uDepthAware == 0 ならただのバイリニア
+//
+//  出力はオーバーレイと同じ「白＋アルファ」。
+//  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) で重ねる
+//======================================================================
+
+in vec2 vUV;
+
+out vec4 FragColor;
+
+uniform sampler2D uOverlay;         // 縮小オーバーレイ（RGBA）
+uniform sampler2D uSceneDepth;      // シーンの深度（NEAREST）
+uniform vec2      uLowResolution;   // 縮小オーバーレイのサイズ
+uniform vec2      uDepthParams;     // 射影行列の (mat[2][2], mat[3][2])
+uniform int       uDepthAware;
+
+float LinearDepth(float depth)
+{
+    float ndc = depth * 2.0 - 1.0;
+    return uDepthParams.y / (ndc - uDepthParams.x);
+}
+
+void main()
+{
+    if (uDepthAware == 0)
+    {
+        FragColor = texture(uOverlay, vUV);
+        return;
+    }
+
+    // 左下の縮小テクセルと、その中での位置
+    vec2 texel = vUV * uLowResolution - 0.5;
+    vec2 base  = floor(texel);
+    vec2 f     = texel - base;
+
+    float center = LinearDepth(texture(uSceneDepth, vUV).r);
+
+    vec4  sum  = vec4(0.0);
+    float wsum = 0.0;
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            vec2 uv = (base + vec2(i, j) + 0.5) / uLowResolution;
+
+            float bw = (i == 0 ? 1.0 - f.x : f.x) * (j == 0 ? 1.0 - f.y : f.y);
+            float z  = LinearDepth(texture(uSceneDepth, uv).r);
+            float dw = 1.0 / (0.01 + abs(center - z) / max(abs(center), 0.001));
+
+            float w = bw * dw;
+            sum  += texture(uOverlay, uv) * w;
+            wsum += w;
+        }
+    }
+
+    FragColor = sum / max(wsum, 1e-5);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "Asset/Geometry/Meshlet.h"
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -65,6 +66,10 @@ public:
     // DPI スケール（UI などで使用）
     void SetWindowDisplayScale(float scale) { mWindowDisplayScale = scale; }
 
+    // メッシュレット分割（以後に読み込む静的メッシュに適用。読み込み済みのものは変わらない）
+    void SetMeshletSettings(const MeshletSettings& settings) { mMeshletSettings = settings; }
+    const MeshletSettings& GetMeshletSettings() const { return mMeshletSettings; }
+
     // 登録済みアセットをすべて破棄（シーン切り替え等）
     void UnloadData();
 
@@ -83,6 +88,9 @@ private:
 
     // DPI スケール（UI 調整用）
     float mWindowDisplayScale;
+
+    // メッシュレット分割の設定
+    MeshletSettings mMeshletSettings;
 };
 
 } // namespace toy
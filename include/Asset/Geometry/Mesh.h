@@ -40,6 +40,10 @@ public:
 
     // マテリアルを取得（メッシュインデックスに対応）
     std::shared_ptr<class Material> GetMaterial(size_t index);
+    
+    // 生成済みの頂点配列をマテリアルと組で追加（静的バッチなどの手続き生成用）
+    //   va の TextureID は追加したマテリアルの番号に書き換える
+    void AddSubMesh(std::shared_ptr<class VertexArray> va, std::shared_ptr<class Material> material);
 
     // 使用するシェーダー名を取得（"Mesh", "Skinned" など）
     const std::string& GetShaderName() const { return mShaderName; }
@@ -50,6 +54,9 @@ public:
     // Assimp のシーンアクセス（必要があれば）
     const aiScene* GetScene() const { return mScene; }
 
+    // ボーン数（スキンメッシュでなければ 0）
+    unsigned int GetNumBones() const { return mNumBones; }
+
     // 指定時刻のボーン姿勢（スキンメッシュ用）を計算
     void ComputePoseAtTime(float animationTime,
                            const aiAnimation* pAnimation,
@@ -66,7 +73,7 @@ public:
 
 private:
     // メッシュデータ読み込み（頂点/インデックス、ボーン有無の判定）
-    void LoadMeshData();
+    void LoadMeshData(const struct MeshletSettings& meshlets);
 
     // マテリアル読み込み
     void LoadMaterials(class AssetManager* assetMamager);
@@ -75,7 +82,8 @@ private:
     void LoadAnimations();
 
     // 通常メッシュ生成（ボーンなし）
-    void CreateMesh(const aiMesh* m);
+    //   meshlets が有効で三角形が多ければメッシュレットへ分ける
+    void CreateMesh(const aiMesh* m, const struct MeshletSettings& meshlets);
 
     // スキンメッシュ生成（ボーンあり）
     void CreateMeshBone(const aiMesh* m);
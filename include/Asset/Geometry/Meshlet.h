@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+#include "Utils/Frustum.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------
+// MeshletSettings（AssetManager::SetMeshletSettings）
+// ・enabled      : 読み込み時にメッシュレットへ分けるか
+// ・maxTriangles : 1 メッシュレットの三角形数（上限）
+// ・minTriangles : これ未満のサブメッシュは分けない
+//                 （小さいものは丸ごと描いた方が速い）
+//-------------------------------------------
+struct MeshletSettings
+{
+    bool         enabled      = false;
+    unsigned int maxTriangles = 96;
+    unsigned int minTriangles = 4096;
+};
+
+//-------------------------------------------
+// MeshletDrawRanges
+// ・カリングを通ったメッシュレットの描画範囲（glMultiDrawElements の引数）
+// ・連続して生き残ったメッシュレットは 1 つの範囲にまとめる
+//-------------------------------------------
+struct MeshletDrawRanges
+{
+    std::vector<int>         counts;    // インデックス数
+    std::vector<const void*> offsets;   // インデックスバッファ上のバイト位置
+    size_t                   visibleMeshlets = 0;
+
+    void Clear()
+    {
+        counts.clear();
+        offsets.clear();
+        visibleMeshlets = 0;
+    }
+};
+
+//-------------------------------------------
+// MeshletSet
+// ・1 サブメッシュ（静的メッシュ）を数十〜百数十三角形の塊に分けたもの
+// ・塊ごとに包む球と法線の円錐を持ち、CPU でフラスタム／裏向き判定をする
+// ・インデックスは塊ごとに連続するよう並べ替える（Build が書き換える）
+//   → 生き残った塊をそのまま glMultiDrawElements で描ける
+// ・判定用のデータは要素ごとの配列（SoA）で持ち、ループを自動ベクトル化させる
+// ・座標はローカル。ワールド行列は Cull に渡す
+//-------------------------------------------
+class MeshletSet
+{
+public:
+    MeshletSet();
+
+    //-----------------------------------------------
+    // 分割
+    //   verts / norms : xyz * 頂点数（法線は面の表裏を決めるのに使う）
+    //   indices       : 三角形リスト（塊ごとに並べ替える）
+    //   面の向き（6 方向）で分けてから、重心のモートン順に maxTriangles ずつ切る
+    //-----------------------------------------------
+    bool Build(const float* verts,
+               const float* norms,
+               std::vector<unsigned int>& indices,
+               unsigned int maxTriangles);
+
+    //-----------------------------------------------
+    // カリング
+    //   frustum   : ワールドの視錐台
+    //   cameraPos : ワールドのカメラ位置（裏向き判定用）
+    //   戻り値：生き残ったメッシュレット数（out に描画範囲）
+    //   ・非一様スケールのワールド行列では裏向き判定をしない
+    //-----------------------------------------------
+    size_t Cull(const Matrix4& world,
+                const Frustum& frustum,
+                const Vector3& cameraPos,
+                MeshletDrawRanges& out) const;
+
+    size_t GetCount() const { return mIndexStart.size(); }
+
+private:
+    // 塊ごと（SoA）
+    std::vector<float>    mCenterX, mCenterY, mCenterZ, mRadius;    // 包む球
+    std::vector<float>    mAxisX, mAxisY, mAxisZ, mCutoff;          // 法線の円錐
+    std::vector<uint32_t> mIndexStart;
+    std::vector<uint32_t> mIndexCount;
+
+    // Cull の作業用
+    mutable std::vector<uint8_t> mVisible;
+};
+
+} // namespace toy
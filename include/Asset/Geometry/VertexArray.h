@@ -63,6 +63,32 @@ public:
                 unsigned int numIndices,
                 bool isVec2Only);
 
+    //=====================================================
+    // ▼ スキニング結果の受け皿（トランスフォームフィードバック出力）
+    //   - 位置・法線は自前のバッファ（GPU が書き込む）
+    //   - UV とインデックスは source のバッファをそのまま参照
+    //   - source より先に破棄すること（共有バッファは解放しない）
+    //=====================================================
+    explicit VertexArray(const VertexArray* source);
+
+    //=====================================================
+    // ▼ インスタンス描画用（ScatterComponent）
+    //   - 位置・法線・UV・インデックスは source のバッファを参照
+    //   - location 5〜7 にインスタンス属性（vec4 x 3、divisor 1）を
+    //     instanceBuffer から割り当てる
+    //   - source より先に破棄すること（共有バッファは解放しない）
+    //=====================================================
+    VertexArray(const VertexArray* source, unsigned int instanceBuffer);
+
+    //=====================================================
+    // ▼ 焼き込みライティング付き（LightBaker）
+    //   - 位置・法線・UV・インデックスは source のバッファを参照
+    //   - location 8 に焼いた値（vec2 : 太陽の可視率, AO）を頂点ごとに持つ
+    //     bakedLighting : 2 * numVerts
+    //   - source より先に破棄すること（共有バッファは解放しない）
+    //=====================================================
+    VertexArray(const VertexArray* source, const float* bakedLighting);
+
     virtual ~VertexArray();
 
     //-----------------------------------------------
@@ -70,6 +96,16 @@ public:
     //-----------------------------------------------
     void SetActive();
 
+    //-----------------------------------------------
+    // 深度だけのパス（シャドウマップ等）用の VAO を bind
+    //  - 位置（location 0）だけを読む。スキンありは詰めたボーン属性
+    //    （ID: u8 x 4 / Weight: unorm16 x 4 = 12 バイト）も付ける
+    //  - 位置は元々 vec3 だけの VBO なので共有する（コピーは持たない）
+    //  - 深度用 VAO が無いもの（スプライト等）は通常の VAO を bind
+    //-----------------------------------------------
+    void SetDepthActive();
+    bool HasDepthStream() const { return mDepthArrayID != 0; }
+
     //-----------------------------------------------
     // 使用するテクスチャ（MaterialIndex）を記録
     //-----------------------------------------------
@@ -82,6 +118,17 @@ public:
     unsigned int GetNumVerts() const   { return mNumVerts; }
     unsigned int GetNumIndices() const { return mNumIndices; }
 
+    // VBO 取得（0:pos 1:normal 2:uv 3:boneID 4:weight、無ければ 0）
+    unsigned int GetVertexBuffer(int slot) const { return mVertexBuffer[slot]; }
+
+    // IBO 取得（静的バッチの読み戻し等）
+    unsigned int GetIndexBuffer() const { return mIndexBufferID; }
+
+    // インスタンス属性の読み出し位置を変える（バイト単位、VAO を bind する）
+    //   GL 4.1 には baseInstance が無いので、バッチごとにポインタをずらす
+    //   depthOnly なら深度用の VAO 側をずらして bind する
+    void SetInstanceOffset(size_t byteOffset, bool depthOnly = false);
+
     //-----------------------------------------------
     // 三角形ポリゴン（ローカル）取得
     //-----------------------------------------------
@@ -92,6 +139,13 @@ public:
     //-----------------------------------------------
     std::vector<struct Polygon> GetWorldPolygons(const Matrix4& worldTransform) const;
 
+    //-----------------------------------------------
+    // メッシュレット（読み込み時に分けた場合のみ。無ければ nullptr）
+    //  - インデックスバッファは塊ごとに並んでいる前提（Mesh が並べ替えて渡す）
+    //-----------------------------------------------
+    void SetMeshlets(std::unique_ptr<class MeshletSet> meshlets);
+    const class MeshletSet* GetMeshlets() const { return mMeshlets.get(); }
+
 private:
     // 頂点数・インデックス数
     unsigned int mNumVerts   = 0;
@@ -108,6 +162,18 @@ private:
     unsigned int mVertexBufferID = 0;
     unsigned int mIndexBufferID  = 0;
 
+    // インスタンス属性のバッファ（所有しない）
+    unsigned int mInstanceBuffer = 0;
+
+    // 焼き込みライティングの VBO（所有する）
+    unsigned int mBakedBuffer = 0;
+
+    //-----------------------------------------------
+    // 深度パス用 VAO と、詰めたボーン属性の VBO
+    //-----------------------------------------------
+    unsigned int mDepthArrayID    = 0;
+    unsigned int mDepthBoneBuffer = 0;
+
     //-----------------------------------------------
     // マテリアルインデックスとして使う TextureID
     //-----------------------------------------------
@@ -118,6 +184,11 @@ private:
     //-----------------------------------------------
     std::vector<struct Polygon> mPolygons;
 
+    //-----------------------------------------------
+    // メッシュレット（CPU カリング用）
+    //-----------------------------------------------
+    std::unique_ptr<class MeshletSet> mMeshlets;
+
 private:
     //-----------------------------------------------
     // ローカル頂点 → Polygon（三角形リスト）へ変換
@@ -125,6 +196,12 @@ private:
     void CreatePolygons(const float* verts,
                         const unsigned int* indices,
                         unsigned int numIndices);
+
+    //-----------------------------------------------
+    // 深度用 VAO を作り、位置とインデックスだけ関連付ける
+    //  （bind したまま返すので、呼び出し側で属性を足せる）
+    //-----------------------------------------------
+    void CreateDepthArray(unsigned int positionBuffer, unsigned int indexBuffer);
 };
 
 } // namespace toy
@@ -8,17 +8,25 @@ namespace toy {
 // Material
 //  - シェーダへ送るマテリアル情報を保持
 //  - Texture, 色, Shininess などを統合
-//  - Renderer 側で Shader と組み合わせて使用される
+//  - パラメータは MaterialBuffer（共有 UBO）の 1 スロットに置き、
+//    値が変わった時だけ書き込む
 //======================================================
 class Material
 {
 public:
     Material();
+    ~Material();
 
-    // 指定シェーダへマテリアル情報をバインドする
-    //   textureUnit … DiffuseMap を貼るスロット番号（通常 0）
-    void BindToShader(std::shared_ptr<class Shader> shader,
-                      int textureUnit = 0) const;
+    // マテリアルをバインドする
+    //   ・UBO スロットを確保（初回のみ）し、dirty なら書き込み
+    //   ・スロットを glBindBufferRange で MaterialBlock に割り当て
+    //   ・DiffuseMap を textureUnit に貼る（通常 0）
+    void Bind(const std::shared_ptr<class MaterialBuffer>& buffer,
+              int textureUnit = 0);
+
+    // UBO スロットを確保して番号を返す（描画ソートのキーに使用）
+    int PrepareSlot(const std::shared_ptr<class MaterialBuffer>& buffer);
+    int GetSlot() const { return mSlot; }
 
     //--- テクスチャ関連 ------------------------------------
     void SetDiffuseMap(std::shared_ptr<class Texture> tex)
@@ -27,16 +35,19 @@ public:
     }
 
     //--- 光沢（スペキュラー強度） ---------------------------
-    void SetSpecPower(float power) { mShininess = power; }
+    void SetSpecPower(float power) { mShininess = power; mIsDirty = true; }
 
     //--- カラー設定 -----------------------------------------
     // Diffuse/Specular/Ambient など通常の PBR で使う値
-    void SetDiffuseColor(const Vector3& color)  { mDiffuseColor  = color; }
-    void SetSpecularColor(const Vector3& color) { mSpecularColor = color; }
-    void SetAmbientColor(const Vector3& color)  { mAmbientColor  = color; }
+    void SetDiffuseColor(const Vector3& color)  { mDiffuseColor  = color; mIsDirty = true; }
+    void SetSpecularColor(const Vector3& color) { mSpecularColor = color; mIsDirty = true; }
+    void SetAmbientColor(const Vector3& color)  { mAmbientColor  = color; mIsDirty = true; }
 
     // DiffuseMap を無視して単色で描画したいときに使用
+    //   単色描画は USE_OVERRIDE_COLOR バリアントで行う（MeshComponent が選択）
     void SetOverrideColor(bool enable, const Vector3& color);
+    bool GetOverrideColor() const { return mOverrideColor; }
+    const Vector3& GetUniformColor() const { return mUniformColor; }
 
 private:
     //--- 基本テクスチャ -------------------------------------
@@ -53,6 +64,11 @@ private:
     //--- 完全に単色化する場合の制御 -------------------------
     bool    mOverrideColor = false;
     Vector3 mUniformColor  = Vector3::Zero;
+
+    //--- 共有 UBO 上の置き場所 ------------------------------
+    std::weak_ptr<class MaterialBuffer> mBuffer;
+    int  mSlot    = -1;
+    bool mIsDirty = true;
 };
 
 } // namespace toy
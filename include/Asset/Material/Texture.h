@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Utils/MathUtil.h"
+#include <cstdint>
 #include <string>
 
 namespace toy {
@@ -69,9 +70,22 @@ public:
 
     // --------------------------------------------------------
     // シャドウマップ用テクスチャ生成（深度テクスチャ）
+    //   2 回目以降は同じテクスチャ ID のまま作り直す
     // --------------------------------------------------------
     void CreateShadowMap(int width, int height);
 
+    // --------------------------------------------------------
+    // ハイトマップ用テクスチャ生成（R16 正規化、1 チャンネル）
+    //   - 頂点シェーダで texture().r が 0〜1 の高さになる
+    // --------------------------------------------------------
+    bool CreateHeightMap(const uint16_t* samples, int width, int height);
+
+    // --------------------------------------------------------
+    // ミップマップ生成（描画済みのレンダーターゲット等に使う）
+    //   - MIN_FILTER を LINEAR_MIPMAP_LINEAR に切り替える
+    // --------------------------------------------------------
+    void GenerateMipmaps();
+
     // Raw texture ID
     unsigned int GetTextureID() const { return mTextureID; }
 
@@ -42,6 +42,8 @@ public:
     void SetExclusive(bool isExclusive) { mIsExclusive = isExclusive; }
 
     // 毎フレーム呼ばれる（Actor の位置を反映し、減衰計算など）
+    //  - 距離減衰ありの音は Actor の重要度で間引く
+    //    （Dormant の間、ループ音は一時停止して戻ったら再開）
     void Update(float deltaTime) override;
 
 private:
@@ -57,6 +59,7 @@ private:
     bool  mIsExclusive = false;              // 排他モード
 
     bool  mHasPlayed = false;                // AutoPlay 用フラグ
+    bool  mIsSuspended = false;              // 重要度が低く一時停止中
 
     ALuint mSource = 0;                      // OpenAL ソース（このコンポ用）
 };
@@ -2,6 +2,7 @@
 
 #include "Engine/Core/Component.h"
 #include "Utils/MathUtil.h"
+#include <cstdint>
 #include <memory>
 
 namespace toy {
@@ -16,8 +17,23 @@ class CameraComponent : public Component
 {
 public:
     CameraComponent(class Actor* owner, int updateOrder = 200);
+    virtual ~CameraComponent();
     void Update(float deltaTime) override;
 
+    //----------------------------------------------------------------------
+    // 追加ビューとして描く（分割画面の 2 人目、ミニマップなど）
+    //   - 有効にすると View 行列はメインではなくこのビューへ送られる
+    //   - viewport はウィンドウに対する割合（左下原点）
+    //   - layerMask は LayerMaskBit() の和
+    //----------------------------------------------------------------------
+    void EnableRenderView(const struct RenderViewport& viewport,
+                          const Matrix4& projection,
+                          uint32_t layerMask = 0xFFFFFFFF,
+                          int order = 0);
+    void DisableRenderView();
+    bool HasRenderView() const { return mViewID > 0; }
+    int  GetRenderViewID() const { return mViewID; }
+
 protected:
     //----------------------------------------------------------------------
     // カメラのワールド座標（派生クラス側で更新する）
@@ -36,6 +52,9 @@ protected:
     //   - メインアクターとは独立している
     //----------------------------------------------------------------------
     std::unique_ptr<class Actor> mCameraActor;
+
+    // 追加ビューの ID（0 ならメインビューのカメラ）
+    int mViewID;
 };
 
 } // namespace toy
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Utils/MathUtil.h"
+#include "Engine/Runtime/SignificanceManager.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -155,6 +156,25 @@ public:
     void SetActorID(const std::string actorID) { mActorID = actorID; }
     std::string GetActorID() const { return mActorID; }
     
+    //=========================================================
+    // ポータルカリング（PortalSystem）
+    //=========================================================
+    
+    // 所属セル（-1 ならセル外＝ポータル判定なし）
+    //   dynamic : true なら描画時に位置からセルを引き直す（動く Actor 用）
+    void SetPortalCell(int cell, bool dynamic = false) { mPortalCell = cell; mIsPortalCellDynamic = dynamic; }
+    int GetPortalCell() const { return mPortalCell; }
+    bool IsPortalCellDynamic() const { return mIsPortalCellDynamic; }
+    
+    //=========================================================
+    // 重要度（SignificanceManager が毎フレーム書き込む）
+    //=========================================================
+    
+    // 段階（アニメ・パーティクル・音・影が間引きに使う）とその元のスコア
+    Significance GetSignificance() const { return mSignificance; }
+    float GetSignificanceScore() const { return mSignificanceScore; }
+    void SetSignificance(Significance s, float score) { mSignificance = s; mSignificanceScore = score; }
+    
     
 private:
     //---------------------------------------------------------
@@ -184,6 +204,18 @@ private:
     //---------------------------------------------------------
     enum State mStatus;
     std::string mActorID;
+    
+    //---------------------------------------------------------
+    // ポータルカリングのセル
+    //---------------------------------------------------------
+    int  mPortalCell;
+    bool mIsPortalCellDynamic;
+    
+    //---------------------------------------------------------
+    // 重要度
+    //---------------------------------------------------------
+    Significance mSignificance;
+    float        mSignificanceScore;
 };
 
 } // namespace toy
@@ -46,6 +46,7 @@ public:
     class AssetManager*    GetAssetManager()    const { return mAssetManager.get(); }
     class SoundMixer*      GetSoundMixer()      const { return mSoundMixer.get(); }
     class TimeOfDaySystem* GetTimeOfDaySystem() const { return mTimeOfDaySys.get(); }
+    class SignificanceManager* GetSignificanceManager() const { return mSignificance.get(); }
     
     //-----------------------------------------
     // ウィンドウ操作
@@ -111,6 +112,7 @@ private:
     std::unique_ptr<class AssetManager>    mAssetManager;
     std::unique_ptr<class SoundMixer>      mSoundMixer;
     std::unique_ptr<class TimeOfDaySystem> mTimeOfDaySys;
+    std::unique_ptr<class SignificanceManager> mSignificance;
     
     //-----------------------------------------
     // Actor 管理
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+#include "glad/glad.h"
+
+namespace toy {
+
+//-------------------------------------------------------------
+// BonePaletteBuffer
+// ・全キャラクターのボーン行列パレットを 1 本の UBO にまとめる
+// ・フレーム頭に 1 回だけマップし、各キャラの行列を
+//   AnimationPlayer の配列から直接書き込む（中間コピーなし）
+// ・描画時は各キャラのオフセットを glBindBufferRange で
+//   UBB_BONES に割り当てる（シャドウ／通常／輪郭で共有）
+//-------------------------------------------------------------
+class BonePaletteBuffer
+{
+public:
+    // シェーダ側 "BonePalette" ブロックの配列長（Phong.vert / ShadowMapping.vert と合わせる）
+    static constexpr unsigned int kMaxBones = 256;
+
+    BonePaletteBuffer();
+    ~BonePaletteBuffer();
+
+    bool Initialize(GLsizeiptr initialBytes = 256 * 1024);
+    void Shutdown();
+
+    // 1 パレット分に必要なバイト数（オフセットアライメント込み）
+    GLsizeiptr GetAlignedSize(unsigned int boneCount) const;
+
+    // フレーム開始：requiredBytes 分を確保してマップ
+    //   （前フレームの内容は捨てる = GPU との同期待ちなし）
+    bool BeginFrame(GLsizeiptr requiredBytes);
+
+    // パレットを書き込み、そのオフセットを返す（失敗時 -1）
+    GLintptr Write(const Matrix4* matrices, unsigned int count);
+
+    // フレーム内の書き込み終了（アンマップ）
+    void EndFrame();
+
+    // 指定オフセットのパレットを UBB_BONES にバインド
+    void Bind(GLintptr offset);
+
+private:
+    GLuint         mUBO;
+    GLsizeiptr     mCapacity;
+    GLsizeiptr     mCursor;
+    GLint          mAlign;
+    unsigned char* mMapped;
+    GLintptr       mBoundOffset;
+};
+
+} // namespace toy
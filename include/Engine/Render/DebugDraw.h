@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// DebugDraw
+// ・線・ボックス・OBB・球・レイ・フラスタムを即時モードで積み、
+//   フレームの最後に 1 本の動的 VBO から GL_LINES 1 回で描画する
+// ・コンポーネントは毎フレーム（Update 等で）積み直すだけでよい
+//   （VAO を個別に持たない）
+// ・無効時（デバッグモードでない時）は Add 系は何もしない
+//-------------------------------------------------------------
+class DebugDraw
+{
+public:
+    DebugDraw();
+    ~DebugDraw();
+
+    bool Initialize(std::shared_ptr<class Shader> shader);
+    void Shutdown();
+
+    void SetEnabled(bool b) { mIsEnabled = b; }
+    bool IsEnabled() const { return mIsEnabled; }
+
+    //---------------------------------------------------------
+    // プリミティブ追加（すべてワールド座標）
+    //---------------------------------------------------------
+
+    // 線分
+    void AddLine(const Vector3& a, const Vector3& b, const Vector3& color);
+
+    // 軸平行ボックス
+    void AddBox(const Vector3& min, const Vector3& max, const Vector3& color);
+
+    // ローカル AABB を transform で変換したボックス（回転・スケール込み）
+    void AddBox(const Vector3& min, const Vector3& max,
+                const Matrix4& transform, const Vector3& color);
+
+    // 有向ボックス（中心・各軸の半径・正規化済みの軸）
+    void AddOrientedBox(const Vector3& center, const Vector3& halfExtents,
+                        const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ,
+                        const Vector3& color);
+
+    // 球（XY / YZ / ZX の 3 本の円）
+    void AddSphere(const Vector3& center, float radius, const Vector3& color,
+                   int segments = 16);
+
+    // レイ（start から dir 方向に length）
+    void AddRay(const Vector3& start, const Vector3& dir, float length,
+                const Vector3& color);
+
+    // フラスタム（viewProj の逆行列から 8 頂点を求める）
+    void AddFrustum(const Matrix4& viewProj, const Vector3& color);
+
+    //---------------------------------------------------------
+    // 描画
+    //---------------------------------------------------------
+
+    // 積んだ線をまとめて描画し、バッファを空にする
+    void Flush(const Matrix4& viewProj);
+
+    // 描画せずに破棄
+    void Clear() { mVerts.clear(); }
+
+    // 直近の Flush で描いた線の本数（デバッグ用）
+    size_t GetLastLineCount() const { return mLastLineCount; }
+
+private:
+    struct LineVertex
+    {
+        float    pos[3];
+        uint32_t color;   // RGBA8
+    };
+
+    // 8 頂点（min/max の並び: 0..3 が下面、4..7 が上面）からボックスの 12 辺を積む
+    void AddBoxEdges(const Vector3* corners, uint32_t color);
+
+    void PushVertex(const Vector3& p, uint32_t color);
+    static uint32_t PackColor(const Vector3& color);
+
+    std::shared_ptr<class Shader> mShader;
+    std::vector<LineVertex>       mVerts;
+
+    GLuint     mVAO;
+    GLuint     mVBO;
+    GLsizeiptr mCapacity;   // VBO の確保済みバイト数
+
+    bool   mIsEnabled;
+    size_t mLastLineCount;
+};
+
+} // namespace toy
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// FrameCapture
+// ・バックバッファを PNG に保存する（スクリーンショット・連番キャプチャ）
+// ・glReadPixels を PBO（GL_PIXEL_PACK_BUFFER）へ発行してフェンスを置き、
+//   数フレーム後に完了したものだけマップする → 描画パイプラインを止めない
+// ・取り出した画素はワーカースレッドが上下反転して IMG_SavePNG で書き出す
+// ・PBO がすべて使用中、またはワーカーの待ち行列が溢れたフレームは
+//   連番キャプチャなら捨てる（フレーム時間を優先）。スクリーンショットは次のフレームへ持ち越す
+//
+// 使い方（Renderer::Draw 内）
+//   描画を終えてスワップする直前に EndFrame(w, h)
+//-------------------------------------------------------------
+class FrameCapture
+{
+public:
+    static const int    kRingSize      = 3;
+    static const size_t kMaxQueuedJobs = 8;
+
+    FrameCapture();
+    ~FrameCapture();
+
+    bool Initialize();
+
+    // 発行済みの読み戻しと書き出しを終えてから停止
+    void Shutdown();
+
+    // 次のフレームを 1 枚保存
+    void RequestScreenshot(const std::string& filePath);
+
+    // N フレームごとに保存（pathPrefix_000000.png, pathPrefix_000001.png ...）
+    void StartSequence(const std::string& pathPrefix, int everyNthFrame = 1);
+    void StopSequence();
+    bool IsSequenceActive() const { return mIsSequence; }
+
+    // フレームの終わり（バックバッファ描画後・スワップ前）に呼ぶ
+    void EndFrame(int width, int height);
+
+    // 統計（デバッグ用）
+    unsigned int GetSavedCount()   const { return mSavedCount; }
+    unsigned int GetDroppedCount() const { return mDroppedCount; }
+
+private:
+    // 読み戻し中の PBO
+    struct Slot
+    {
+        GLuint      pbo      = 0;
+        size_t      capacity = 0;      // バイト数
+        GLsync      fence    = nullptr;
+        int         width    = 0;
+        int         height   = 0;
+        uint64_t    sequence = 0;      // 発行順
+        std::string path;
+    };
+
+    // ワーカーへ渡す書き出し要求
+    struct Job
+    {
+        std::vector<uint8_t> pixels;
+        int         width  = 0;
+        int         height = 0;
+        std::string path;
+    };
+
+    // 完了した読み戻しを発行順に取り出す（wait なら完了まで待つ）
+    void PollSlots(bool wait);
+
+    // バックバッファを空いている PBO へ読み戻す（空きが無ければ false）
+    bool IssueReadback(int width, int height, const std::string& path);
+
+    void WorkerMain();
+
+    Slot     mSlots[kRingSize];
+    uint64_t mIssueCount;
+
+    // 要求
+    std::string mScreenshotPath;
+    bool        mIsSequence;
+    std::string mSequencePrefix;
+    int         mSequenceInterval;
+    uint64_t    mSequenceFrame;
+    uint64_t    mSequenceIndex;
+
+    // ワーカー
+    std::thread             mWorker;
+    std::mutex              mMutex;
+    std::condition_variable mCondition;
+    std::deque<Job>         mJobs;
+    std::vector<std::vector<uint8_t>> mFreeBuffers;    // 使い回す画素バッファ
+    bool                    mIsRunning;
+
+    std::atomic<unsigned int> mSavedCount;    // ワーカーが更新
+    unsigned int              mDroppedCount;
+};
+
+} // namespace toy
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace toy {
+namespace GLCapture {
+
+//-------------------------------------------------------------
+// GL コマンドキャプチャのファイル形式（GLRecorder が書き、GLReplay が読む）
+//
+//   Header { magic "TGLC", version, frameCount }
+//   [コマンド列]
+//     セットアップ（キャプチャ開始時点のオブジェクトと状態）… Op::EndSetup
+//     フレーム 0 のコマンド … Op::EndFrame
+//     フレーム 1 …
+//
+// ・各コマンドは Op(uint16) + 引数（リトルエンディアンの生バイト）
+// ・オブジェクト名は記録時の GL 名のまま。再生側で作り直して対応を取る
+// ・uniform は location ではなく名前で記録する（リンクし直すと変わるため）
+// ・バッファとテクスチャの中身はコマンドにそのまま埋め込む
+//-------------------------------------------------------------
+const uint32_t kMagic   = 0x434C4754;   // "TGLC"
+const uint32_t kVersion = 2;    // 2: MultiDrawElements を追加
+
+enum class Op : uint16_t
+{
+    // 区切り
+    EndSetup = 1,
+    EndFrame,
+
+    // オブジェクトの生成・破棄
+    GenBuffer,
+    DeleteBuffer,
+    GenTexture,
+    DeleteTexture,
+    GenVertexArray,
+    DeleteVertexArray,
+    GenFramebuffer,
+    DeleteFramebuffer,
+    GenRenderbuffer,
+    DeleteRenderbuffer,
+    GenTransformFeedback,
+    DeleteTransformFeedback,
+    CreateShader,
+    DeleteShader,
+    CreateProgram,
+    DeleteProgram,
+
+    // シェーダ・プログラム
+    ShaderSource,
+    CompileShader,
+    AttachShader,
+    TransformFeedbackVaryings,
+    LinkProgram,
+    UseProgram,
+    UniformBlockBinding,
+    Uniform,
+
+    // バッファ
+    BindBuffer,
+    BindBufferBase,
+    BindBufferRange,
+    BufferData,
+    BufferSubData,
+
+    // 頂点配列
+    BindVertexArray,
+    EnableVertexAttribArray,
+    DisableVertexAttribArray,
+    VertexAttribPointer,
+    VertexAttribIPointer,
+    VertexAttribDivisor,
+
+    // テクスチャ
+    ActiveTexture,
+    BindTexture,
+    TexImage2D,
+    TexParameteri,
+    GenerateMipmap,
+    PixelStorei,
+
+    // フレームバッファ
+    BindFramebuffer,
+    FramebufferTexture2D,
+    FramebufferRenderbuffer,
+    BindRenderbuffer,
+    RenderbufferStorage,
+    DrawBuffers,
+    DrawBuffer,
+    ReadBuffer,
+
+    // 固定機能の状態
+    Enable,
+    Disable,
+    BlendFunc,
+    BlendFuncSeparate,
+    DepthMask,
+    ColorMask,
+    FrontFace,
+    Viewport,
+    Scissor,
+    ClearColor,
+    Clear,
+
+    // 描画
+    DrawArrays,
+    DrawElements,
+    DrawElementsInstanced,
+    MultiDrawElements,      // 範囲数 + (count, offset) の組をそのまま埋め込む
+    BindTransformFeedback,
+    BeginTransformFeedback,
+    EndTransformFeedback,
+    ReadPixels,
+};
+
+// Uniform コマンドの種類
+enum class UniformKind : uint8_t
+{
+    Int1,
+    Float1,
+    Float2,
+    Float3,
+    Float4,
+    Matrix4,
+};
+
+struct Header
+{
+    uint32_t magic      = kMagic;
+    uint32_t version    = kVersion;
+    uint32_t frameCount = 0;
+    uint32_t reserved   = 0;
+};
+
+//-------------------------------------------------------------
+// 書き込み
+//-------------------------------------------------------------
+class Writer
+{
+public:
+    explicit Writer(std::vector<uint8_t>& out) : mOut(out) {}
+
+    void Begin(Op op) { Put(static_cast<uint16_t>(op)); }
+
+    template <typename T>
+    void Put(const T& value)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        mOut.insert(mOut.end(), p, p + sizeof(T));
+    }
+
+    // 長さ（uint64）+ 中身。data が nullptr なら長さ 0
+    void PutBytes(const void* data, size_t size)
+    {
+        if (!data) size = 0;
+        Put(static_cast<uint64_t>(size));
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        if (size > 0) mOut.insert(mOut.end(), p, p + size);
+    }
+
+    void PutString(const std::string& s) { PutBytes(s.data(), s.size()); }
+
+private:
+    std::vector<uint8_t>& mOut;
+};
+
+//-------------------------------------------------------------
+// 読み出し（範囲外を読もうとしたら IsValid() が false になる）
+//-------------------------------------------------------------
+class Reader
+{
+public:
+    Reader(const uint8_t* data, size_t size)
+    : mData(data), mSize(size), mPos(0), mIsValid(true) {}
+
+    bool   IsEnd()   const { return mPos >= mSize; }
+    bool   IsValid() const { return mIsValid; }
+    size_t GetPos()  const { return mPos; }
+
+    template <typename T>
+    T Get()
+    {
+        T value{};
+        if (mPos + sizeof(T) > mSize)
+        {
+            mIsValid = false;
+            mPos = mSize;
+            return value;
+        }
+        std::memcpy(&value, mData + mPos, sizeof(T));
+        mPos += sizeof(T);
+        return value;
+    }
+
+    Op GetOp() { return static_cast<Op>(Get<uint16_t>()); }
+
+    // 中身へのポインタを返す（size == 0 なら nullptr）
+    const uint8_t* GetBytes(size_t& size)
+    {
+        uint64_t n = Get<uint64_t>();
+        if (!mIsValid || mPos + n > mSize)
+        {
+            mIsValid = false;
+            mPos  = mSize;
+            size  = 0;
+            return nullptr;
+        }
+        size = static_cast<size_t>(n);
+        const uint8_t* p = (size > 0) ? mData + mPos : nullptr;
+        mPos += size;
+        return p;
+    }
+
+    std::string GetString()
+    {
+        size_t size = 0;
+        const uint8_t* p = GetBytes(size);
+        return p ? std::string(reinterpret_cast<const char*>(p), size) : std::string();
+    }
+
+private:
+    const uint8_t* mData;
+    size_t         mSize;
+    size_t         mPos;
+    bool           mIsValid;
+};
+
+} // namespace GLCapture
+} // namespace toy
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// GLRecorder
+// ・Renderer / Shader / VertexArray / Texture が発行する GL 呼び出しを
+//   横取りしてバイナリのキャプチャファイルへ書き出す（形式は GLCaptureFormat.h）
+// ・glad の debug 版関数ポインタ（glad_debug_glXxx）を差し替えて横取りする
+//   → 呼び出し側のコードは変更不要。取り外せば元のポインタへ戻す
+// ・インストールしている間は、オブジェクトの生成・破棄と uniform の名前だけを追跡する
+//   （キャプチャしていないフレームの負担はほぼ無い）
+// ・BeginCapture すると、その時点の全オブジェクト（バッファ・テクスチャの中身込み）と
+//   状態を GL から読み出してセットアップ部として書き、続く N フレームのコマンドを記録する
+// ・記録しないもの：タイマークエリ・フェンス・glGet 系、クライアントメモリへの glReadPixels
+// ・同時にインストールできるのは 1 つだけ
+//
+// 使い方（Renderer）
+//   gladLoadGLLoader の直後に Install()
+//   スワップの直前に EndFrame()
+//-------------------------------------------------------------
+class GLRecorder
+{
+public:
+    GLRecorder();
+    ~GLRecorder();
+
+    // 横取りを開始／終了（GL コンテキストが有効な間に呼ぶ）
+    bool Install();
+    void Uninstall();
+    bool IsInstalled() const { return sInstance == this; }
+
+    // 次のフレームから frameCount フレームを記録し、終わったら filePath へ書き出す
+    //   セットアップ部はフレームの区切り（次の EndFrame）で読み出す
+    bool BeginCapture(const std::string& filePath, int frameCount = 1);
+    bool IsCapturing() const { return mPendingFrames > 0 || mFramesLeft > 0; }
+
+    // フレームの終わり（スワップ前）に呼ぶ
+    void EndFrame();
+
+    // 統計（デバッグ用）
+    size_t GetLastCaptureBytes() const { return mLastCaptureBytes; }
+
+private:
+    struct Hooks;   // 差し替え先の関数群（GLRecorder.cpp）
+
+    // glTexImage2D で作ったイメージ（glGetTexImage で読み戻すときの形式）
+    struct TexImage
+    {
+        GLenum  target;         // GL_TEXTURE_2D / GL_TEXTURE_CUBE_MAP_POSITIVE_X + i
+        GLint   level;
+        GLint   internalFormat;
+        GLsizei width;
+        GLsizei height;
+        GLenum  format;
+        GLenum  type;
+    };
+    struct TextureInfo
+    {
+        GLenum                bindTarget = 0;   // 最初にバインドされたターゲット
+        std::vector<TexImage> images;
+    };
+
+    // マップ中の範囲（書き込みなら Unmap 時に BufferSubData として記録）
+    struct MapInfo
+    {
+        GLintptr   offset = 0;
+        GLsizeiptr length = 0;
+        GLbitfield access = 0;
+        void*      pointer = nullptr;
+    };
+
+    // 追跡
+    void OnTexImage(GLenum target, const TexImage& image);
+    void OnLinkProgram(GLuint program);
+
+    // セットアップ部の書き出し
+    void WriteSetup();
+    void WriteObjects();
+    void WriteBuffers();
+    void WriteTextures();
+    void WriteRenderbuffers();
+    void WritePrograms();
+    void WriteVertexArrays();
+    void WriteFramebuffers();
+    void WriteGlobalState();
+
+    bool Flush();
+
+    bool IsRecording() const { return mFramesLeft > 0 && !mIsSnapshotting; }
+
+    static GLRecorder* sInstance;
+
+    // 生きているオブジェクト
+    std::unordered_set<GLuint>              mBuffers;
+    std::unordered_map<GLuint, TextureInfo> mTextures;
+    std::unordered_set<GLuint>              mVertexArrays;
+    std::unordered_set<GLuint>              mFramebuffers;
+    std::unordered_set<GLuint>              mRenderbuffers;
+    std::unordered_set<GLuint>              mTransformFeedbacks;
+    std::unordered_map<GLuint, GLenum>      mShaders;       // 名前 → 種類
+    std::unordered_set<GLuint>              mPrograms;
+
+    // プログラムごとの uniform location → 名前
+    std::unordered_map<GLuint, std::unordered_map<GLint, std::string>> mUniformNames;
+    // プログラムごとの uniform ブロック index → 名前
+    std::unordered_map<GLuint, std::unordered_map<GLuint, std::string>> mBlockNames;
+
+    std::unordered_map<GLenum, MapInfo> mMapped;    // ターゲット → マップ中の範囲
+    GLuint mCurrentProgram;
+    GLint  mUnpackAlignment;
+
+    // キャプチャ
+    std::string          mFilePath;
+    std::vector<uint8_t> mStream;
+    int                  mPendingFrames;    // BeginCapture から次の EndFrame まで
+    int                  mFramesLeft;
+    uint32_t             mFrameCount;
+    bool                 mIsSnapshotting;
+    size_t               mLastCaptureBytes;
+};
+
+} // namespace toy
@@ -127,6 +127,10 @@ public:
     void ApplyToShader(std::shared_ptr<class Shader> shader,
                        const Matrix4& viewMatrix);
     
+    // 所有権を持たない呼び出し側（描画キュー等）向け
+    void ApplyToShader(class Shader* shader,
+                       const Matrix4& viewMatrix);
+    
     
 private:
     //---------------------------------------------------------
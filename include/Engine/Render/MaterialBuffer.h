@@ -0,0 +1,67 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// MaterialBlock
+// ・シェーダ側 "MaterialBlock"（std140）と 1:1 で対応するデータ
+// ・vec3 は std140 で 16 バイト境界になるため float[4] で持つ
+//-------------------------------------------------------------
+struct MaterialBlock
+{
+    float ambient[4];    // rgb : AmbientColor
+    float diffuse[4];    // rgb : DiffuseColor
+    float specular[4];   // rgb : SpecularColor,  a : SpecPower
+};
+
+//-------------------------------------------------------------
+// MaterialBuffer
+// ・全マテリアルのパラメータを 1 本の UBO にまとめて持つ
+// ・各 Material はスロットを 1 つ確保し、変更時だけそこへ書き込む
+// ・描画時は glBindBufferRange でスロットを UBB_MATERIAL に割り当てる
+//   （uniform の個別アップロードは行わない）
+//-------------------------------------------------------------
+class MaterialBuffer
+{
+public:
+    MaterialBuffer();
+    ~MaterialBuffer();
+
+    // UBO 生成（capacity はスロット数の初期値。足りなければ倍々で拡張）
+    bool Initialize(int capacity = 256);
+    void Shutdown();
+
+    // スロット確保／解放
+    int  Allocate();
+    void Release(int slot);
+
+    // スロットへ書き込み（Material が dirty の時だけ呼ばれる）
+    void Upload(int slot, const MaterialBlock& block);
+
+    // スロットを UBB_MATERIAL にバインド（同じスロットなら何もしない）
+    void Bind(int slot);
+
+    // フレーム頭などでバインド状態のキャッシュを捨てる
+    void InvalidateBinding() { mBoundSlot = -1; }
+
+    // 統計（デバッグ用）
+    int GetUsedSlotCount() const { return mNextSlot - static_cast<int>(mFreeSlots.size()); }
+
+private:
+    // 容量拡張（既存スロットの内容は CPU 側ミラーから再転送）
+    void Grow(int newCapacity);
+
+    GLuint     mUBO;
+    GLsizeiptr mStride;     // 1 スロットのバイト数（オフセットアライメント込み）
+    int        mCapacity;
+    int        mNextSlot;
+    int        mBoundSlot;
+
+    std::vector<int>           mFreeSlots;
+    std::vector<MaterialBlock> mMirror;     // 拡張時の再転送用
+};
+
+} // namespace toy
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// MeshDrawPass
+// ・1 サブメッシュの描画がどのパスに属するか
+// ・ソートキーの最上位に入るので、この順に描かれる
+//-------------------------------------------------------------
+enum class MeshDrawPass : uint8_t
+{
+    Main,           // 通常描画（MaterialBlock を使用）
+    OverrideColor,  // 単色マテリアル（uUniformColor を使用）
+    Outline,        // トゥーン輪郭（裏面・黒）
+};
+
+//-------------------------------------------------------------
+// MeshDrawItem
+// ・サブメッシュ 1 つ分の描画要求
+//-------------------------------------------------------------
+struct MeshDrawItem
+{
+    uint64_t             sortKey  = 0;
+    class MeshComponent* comp     = nullptr;
+    class VertexArray*   va       = nullptr;
+    class Material*      material = nullptr;   // Main では UBO、単色パスでは色の参照
+    class Shader*        shader   = nullptr;   // 使用するバリアント
+    MeshDrawPass         pass     = MeshDrawPass::Main;
+
+    // メッシュレットのカリング結果（nullptr ならサブメッシュ全体を描く）
+    const struct MeshletDrawRanges* ranges = nullptr;
+};
+
+//-------------------------------------------------------------
+// MeshDrawQueue
+// ・MeshComponent から集めたサブメッシュを
+//   [パス][シェーダ][マテリアル][コンポーネント] の順にソートして描く
+// ・シェーダ切り替え・マテリアルのバインドは値が変わった時だけ行う
+//   → 同じマテリアルは 1 フレームに 1 回しかバインドされない
+//-------------------------------------------------------------
+class MeshDrawQueue
+{
+public:
+    MeshDrawQueue();
+
+    // 積んだ要求を破棄（確保済みメモリは再利用）
+    void Clear();
+
+    // 要求を追加（ソートキーはここで計算）
+    //   materialSlot : MaterialBuffer 上のスロット（単色パスでは 0 で良い）
+    void Add(const MeshDrawItem& item, int materialSlot);
+
+    // ソートして描画
+    void Execute(class Renderer* renderer);
+
+    size_t GetCount() const { return mItems.size(); }
+
+    // 直近の Execute の統計（デバッグ用）
+    unsigned int GetShaderSwitchCount() const { return mShaderSwitches; }
+    unsigned int GetMaterialBindCount() const { return mMaterialBinds; }
+    unsigned int GetMultiDrawCount()    const { return mMultiDraws; }
+
+private:
+    std::vector<MeshDrawItem> mItems;
+
+    // 追加順（同じキーのコンポーネントをまとめるため）
+    uint32_t mSequence;
+
+    unsigned int mShaderSwitches;
+    unsigned int mMaterialBinds;
+    unsigned int mMultiDraws;
+};
+
+} // namespace toy
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// OcclusionStats
+// ・1 フレーム分のオクルージョンカリング結果
+//-------------------------------------------------------------
+struct OcclusionStats
+{
+    unsigned int occluders    = 0;  // ラスタライズした遮蔽物の数
+    unsigned int occluderTris = 0;  // そのうち画面内に残った三角形数
+    unsigned int tested       = 0;  // 判定したオブジェクト数
+    unsigned int culled       = 0;  // 隠れていて描画を省いた数
+};
+
+//-------------------------------------------------------------
+// OcclusionCuller
+// ・CPU 上の低解像度デプスバッファ（kWidth x kHeight）に
+//   遮蔽物の三角形をラスタライズし、AABB の画面矩形を判定する
+// ・深度は 1/w で保持（大きいほど手前、0 = 何もない）
+//   → 画面空間で線形補間できるので透視補正が不要
+// ・ラスタライズは画面を横帯に分けてワーカースレッドで並列に行う
+//   （帯ごとに書き込み先が重ならないのでロック不要）
+// ・判定は保守的：少しでも怪しければ「見える」とする
+//
+// 使い方（Renderer::BuildVisibleLists 内）
+//   BeginFrame(viewProj) → AddOccluder(...) x N → Rasterize()
+//   → IsVisible(aabb) x M
+//-------------------------------------------------------------
+class OcclusionCuller
+{
+public:
+    static constexpr int kWidth  = 256;
+    static constexpr int kHeight = 128;
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    // numWorkers : メインスレッド以外に使うスレッド数（0 ならメインのみ）
+    void Initialize(unsigned int numWorkers);
+    void Shutdown();
+
+    // フレーム開始：デプスバッファと統計をクリア
+    void BeginFrame(const Matrix4& viewProj);
+
+    // 遮蔽物を追加（polys はローカル座標、world で変換）
+    void AddOccluder(const struct Polygon* polys, size_t count, const Matrix4& world);
+
+    // 積んだ遮蔽物をデプスバッファへ描く
+    void Rasterize();
+
+    // 遮蔽物が 1 つも無ければ判定不要
+    bool HasOccluders() const { return !mTris.empty(); }
+
+    // AABB（ワールド）が見える可能性があるか
+    bool IsVisible(const struct Cube& aabb);
+
+    const OcclusionStats& GetStats() const { return mStats; }
+
+private:
+    // 画面空間の三角形（x, y はピクセル、z は 1/w）
+    struct ScreenTri
+    {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    // [rowBegin, rowEnd) の行だけをラスタライズ
+    void RasterizeBand(int rowBegin, int rowEnd);
+
+    // 矩形内のすべてのピクセルが depth より手前の遮蔽物で覆われているか
+    bool IsRectOccluded(int x0, int y0, int x1, int y1, float depth) const;
+
+    // ワーカースレッド本体
+    void WorkerMain(unsigned int index);
+
+    Matrix4                mViewProj;
+    std::vector<float>     mDepth;     // kWidth * kHeight
+    std::vector<ScreenTri> mTris;
+    OcclusionStats         mStats;
+
+    //---------------------------------------------------------
+    // ワーカースレッド
+    //---------------------------------------------------------
+    std::vector<std::thread> mWorkers;
+    std::mutex               mMutex;
+    std::condition_variable  mStartCV;
+    std::condition_variable  mDoneCV;
+    unsigned int             mGeneration;   // Rasterize() ごとに進める
+    unsigned int             mPending;      // 未完了のワーカー数
+    bool                     mIsQuitting;
+};
+
+} // namespace toy
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+#include "Utils/Frustum.h"
+#include "Asset/Geometry/Polygon.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// PortalStats
+// ・1 フレーム分のポータルカリング結果
+//-------------------------------------------------------------
+struct PortalStats
+{
+    unsigned int cellsReached  = 0;  // 到達したセル数
+    unsigned int portalsPassed = 0;  // 視錐台を通したポータル数
+    unsigned int culled        = 0;  // 未到達セル・ポータル外で省いた数
+};
+
+//-------------------------------------------------------------
+// PortalSystem
+// ・屋内マップ用のセル＆ポータルによる可視判定
+//   ・セル   : 部屋（AABB）
+//   ・ポータル : 2 つのセルをつなぐ出入口（4 頂点の四角形、両面）
+// ・カメラのいるセルから出発し、見えているポータルで視錐台を
+//   切り詰めながら隣のセルへ再帰的にたどる
+//   → 到達したセルに登録された Actor だけを描く
+// ・Actor は SetPortalCell で所属セルを持つ（-1 ならセル外＝通常のフラスタムのみ）
+//   動く Actor は dynamic にしておくと毎フレーム位置からセルを引き直す
+// ・カメラがどのセルにも入っていないフレームは何もしない（屋外）
+// ・影（ライト側）の可視判定には使わない
+//
+// 使い方（Renderer::BuildVisibleLists 内）
+//   BeginFrame(frustum, eye) → IsVisible(actor, aabb) x N
+//-------------------------------------------------------------
+class PortalSystem
+{
+public:
+    PortalSystem();
+
+    //---------------------------------------------------------
+    // レベルデータ
+    //---------------------------------------------------------
+
+    // セルを追加（戻り値はセル番号、同名があれば -1）
+    int AddCell(const std::string& name, const Cube& bounds);
+
+    // ポータルを追加（corners は四角形の 4 頂点を外周順に）
+    bool AddPortal(int cellA, int cellB, const Vector3 corners[4]);
+
+    // JSON から読み込む（既存のセル・ポータルは破棄）
+    //   { "cells"  : [ { "name": "hall", "min": [x,y,z], "max": [x,y,z] }, ... ],
+    //     "portals": [ { "cells": ["hall", "room"], "corners": [[x,y,z] x 4] }, ... ] }
+    bool LoadFromFile(const std::string& filePath);
+
+    void Clear();
+
+    bool HasCells() const { return !mCells.empty(); }
+
+    int FindCell(const std::string& name) const;
+
+    // 点を含むセル（無ければ -1、重なっていれば先に登録したもの）
+    int FindCellAt(const Vector3& pos) const;
+
+    //---------------------------------------------------------
+    // Actor の登録
+    //---------------------------------------------------------
+
+    // 現在位置からセルを決めて登録
+    void RegisterActor(class Actor* actor, bool dynamic = false);
+
+    // セル名を指定して登録（部屋をまたぐ大きな物など）
+    bool RegisterActorInCell(class Actor* actor, const std::string& cellName);
+
+    //---------------------------------------------------------
+    // 可視判定
+    //---------------------------------------------------------
+
+    // フレーム開始：セルをたどって到達範囲を求める
+    //   戻り値：カメラがセル内にいてポータル判定を行うなら true
+    bool BeginFrame(const Frustum& cameraFrustum, const Vector3& eye);
+
+    // Actor（の AABB）が見える可能性があるか
+    //   カメラのフラスタム判定は呼び出し側で済ませている前提
+    bool IsVisible(class Actor* actor, const Cube& aabb);
+
+    const PortalStats& GetStats() const { return mStats; }
+
+private:
+    struct Portal
+    {
+        int     cells[2];
+        Vector3 corners[4];
+        Plane   plane;
+    };
+
+    // 切り詰めた視錐台（mViewPlanes 上の範囲）
+    struct CellView
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct Cell
+    {
+        std::string name;
+        Cube        bounds;
+        std::vector<int> portals;
+
+        // フレームごとの到達情報
+        std::vector<CellView> views;
+        bool fullView = false;      // カメラの視錐台をそのまま使う
+        bool onPath   = false;      // 再帰中（循環防止）
+    };
+
+    // cell に planes の視錐台で到達した
+    void Traverse(int cell, const std::vector<Plane>& planes, int depth);
+
+    bool IsReached(const Cell& cell) const { return cell.fullView || !cell.views.empty(); }
+
+    std::vector<Cell>   mCells;
+    std::vector<Portal> mPortals;
+
+    // このフレームの視錐台の平面（CellView が参照）
+    std::vector<Plane> mViewPlanes;
+
+    Vector3 mEye;
+    Plane   mFarPlane;
+    bool    mIsActive;
+
+    PortalStats mStats;
+};
+
+} // namespace toy
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// QualityBound
+// ・そのノブを下げると主にどちらの時間が減るか
+//-------------------------------------------------------------
+enum class QualityBound : uint8_t
+{
+    CPU  = 1,
+    GPU  = 2,
+    Both = 3,
+};
+
+//-------------------------------------------------------------
+// QualityGovernorSettings
+// ・targetMs      : 目標フレーム時間（CPU と GPU の重い方で比べる）
+// ・downRatio     : 目標のこの倍を超え続けたら 1 段下げる
+// ・upRatio       : 目標のこの倍を下回り続けたら 1 段戻す
+//                   （間は何もしない帯＝ヒステリシス）
+// ・holdFrames    : 下げるまでに超え続けるフレーム数（戻すのはこの 2 倍）
+// ・cooldownFrames: 変更した後、次の判断までに待つフレーム数
+// ・smoothing     : 指数移動平均の係数（大きいほど最新の値に寄る）
+// ・log           : 変更を標準出力へ出す
+//-------------------------------------------------------------
+struct QualityGovernorSettings
+{
+    bool  enabled        = false;
+    float targetMs       = 16.6f;
+    float downRatio      = 1.10f;
+    float upRatio        = 0.80f;
+    int   holdFrames     = 30;
+    int   cooldownFrames = 60;
+    float smoothing      = 0.1f;
+    bool  log            = false;
+};
+
+//-------------------------------------------------------------
+// QualityDecision
+// ・ガバナーが行った変更 1 回分（ログ・テレメトリ用）
+//-------------------------------------------------------------
+struct QualityDecision
+{
+    uint64_t    frame = 0;
+    std::string knob;
+    int         fromLevel = 0;
+    int         toLevel   = 0;
+    float       value     = 0.0f;     // 変更後の値
+    float       cpuMs     = 0.0f;     // 判断時の平滑化した時間
+    float       gpuMs     = 0.0f;
+};
+
+//-------------------------------------------------------------
+// QualityGovernor
+// ・平滑化した CPU / GPU のフレーム時間を見て、登録したノブを 1 段ずつ動かす
+// ・ノブは値の列（低品質 → 高品質）と、値を反映する関数で登録する
+//   開始時の段が上限（設定ファイルの値より上げることはない）
+// ・重いときは、ボトルネック側（CPU / GPU）に効くノブのうち
+//   登録順で先のものから下げる（見た目の損が小さいものを先に登録する）
+// ・軽いときは、最後に下げたノブから戻す
+// ・GPU 時間が取れない（タイマークエリ未対応など）間は CPU 時間だけで判断する
+//
+// 使い方（Renderer）
+//   フレームの処理の頭（アプリの更新の前）に BeginFrame()
+//   スワップの直前に EndFrame(gpuMs)
+//-------------------------------------------------------------
+class QualityGovernor
+{
+public:
+    using ApplyFunc    = std::function<void(float value)>;
+    using DecisionFunc = std::function<void(const QualityDecision&)>;
+
+    QualityGovernor();
+
+    void SetSettings(const QualityGovernorSettings& settings);
+    const QualityGovernorSettings& GetSettings() const { return mSettings; }
+    void SetEnabled(bool enable) { mSettings.enabled = enable; }
+    bool IsEnabled() const { return mSettings.enabled; }
+
+    //---------------------------------------------------------
+    // ノブ
+    //---------------------------------------------------------
+
+    // values : 低品質 → 高品質の順。level は開始時（＝上限）の段
+    //   登録時に apply(values[level]) を呼ぶ。同名があれば置き換える
+    void AddKnob(const std::string& name, const std::vector<float>& values, int level,
+                 QualityBound bound, const ApplyFunc& apply);
+    void RemoveKnob(const std::string& name);
+
+    // 手動で段を変える（上限も変わる）
+    bool SetKnobLevel(const std::string& name, int level);
+    int  GetKnobLevel(const std::string& name) const;
+
+    //---------------------------------------------------------
+    // フレーム
+    //---------------------------------------------------------
+    void BeginFrame();
+
+    // gpuMs < 0 なら GPU 時間なし
+    void EndFrame(float gpuMs);
+
+    //---------------------------------------------------------
+    // 統計・ログ
+    //---------------------------------------------------------
+    float GetCpuMs() const { return mCpuMs; }
+    float GetGpuMs() const { return mGpuMs; }
+
+    // 直近の変更（古い順、最大 kMaxDecisions 件）
+    const std::deque<QualityDecision>& GetDecisions() const { return mDecisions; }
+
+    // 変更のたびに呼ばれる
+    void SetDecisionCallback(const DecisionFunc& func) { mOnDecision = func; }
+
+private:
+    struct Knob
+    {
+        std::string        name;
+        std::vector<float> values;
+        int                level    = 0;
+        int                maxLevel = 0;
+        QualityBound       bound    = QualityBound::Both;
+        ApplyFunc          apply;
+    };
+
+    static const size_t kMaxDecisions = 64;
+
+    Knob* FindKnob(const std::string& name);
+    const Knob* FindKnob(const std::string& name) const;
+
+    // 1 段下げる／戻す（動かせたら true）
+    bool StepDown(bool isGpuBound);
+    bool StepUp();
+    void ChangeLevel(Knob& knob, int level);
+
+    QualityGovernorSettings mSettings;
+    std::vector<Knob>       mKnobs;         // 登録順＝下げる順
+    std::vector<std::string> mLowered;      // 下げた順（戻すときは後ろから）
+
+    uint64_t mBeginTicks;
+    uint64_t mFrame;
+    float    mCpuMs;
+    float    mGpuMs;
+    bool     mHasSample;
+    bool     mHasGpu;
+    int      mOverFrames;
+    int      mUnderFrames;
+    int      mCooldown;
+
+    std::deque<QualityDecision> mDecisions;
+    DecisionFunc                mOnDecision;
+};
+
+} // namespace toy
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace toy {
+
+// グラフ上のリソース番号（-1 は無効）
+using RGResource = int;
+
+//-------------------------------------------------------------
+// RGTextureDesc
+// ・一時テクスチャの仕様（同じ仕様のものだけが実体を共有できる）
+//   format : 内部フォーマット（GL_RGBA8, GL_RGBA16F, GL_DEPTH_COMPONENT24 など）
+//-------------------------------------------------------------
+struct RGTextureDesc
+{
+    int          width  = 0;
+    int          height = 0;
+    unsigned int format = 0;
+
+    bool operator==(const RGTextureDesc& o) const
+    {
+        return width == o.width && height == o.height && format == o.format;
+    }
+};
+
+//-------------------------------------------------------------
+// RGPassTiming
+// ・パス 1 つ分の GPU 時間（数フレーム遅れの値）
+//-------------------------------------------------------------
+struct RGPassTiming
+{
+    std::string name;
+    float       gpuMs = 0.0f;
+};
+
+//-------------------------------------------------------------
+// RenderGraph
+// ・1 フレーム分の描画パスを宣言してからまとめて実行する
+//   （毎フレーム Reset → AddPass x N → Compile → Execute）
+// ・パスは読み書きするリソースを宣言する
+//   ・出力（MarkOutput）に寄与しないパスは省く
+//   ・書き込み → 読み込みの依存で並べる（依存が無ければ宣言順）
+//   ・一時テクスチャ（CreateTexture）は最初に使うパスで実体を割り当て、
+//     最後に使うパスの後で返却する
+//     → 寿命が重ならない同仕様のテクスチャは同じ GL テクスチャを使い回す
+//   ・実体はフレームをまたいでプールに残し、しばらく使われなければ破棄
+// ・一時テクスチャへ書くパスは、グラフが FBO をバインドしてから呼ぶ
+//   （カラーは Write の順に COLOR_ATTACHMENT0..、深度フォーマットは DEPTH）
+//   取り込んだリソース（ImportTexture）へ書くパスは自分で FBO を扱う
+// ・SetTiming(true) でパスごとの GPU 時間（GL_TIME_ELAPSED）を測る
+//-------------------------------------------------------------
+class RenderGraph
+{
+public:
+    //---------------------------------------------------------
+    // PassBuilder
+    // ・AddPass のセットアップ中にだけ使う
+    //---------------------------------------------------------
+    class PassBuilder
+    {
+    public:
+        void Read(RGResource res);
+        void Write(RGResource res);
+
+        // 出力に関係なく必ず実行する（読み戻しなど）
+        void SetSideEffect();
+
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph* graph, int pass) : mGraph(graph), mPass(pass) {}
+
+        RenderGraph* mGraph;
+        int          mPass;
+    };
+
+    using SetupFunc   = std::function<void(PassBuilder&)>;
+    using ExecuteFunc = std::function<void(RenderGraph&)>;
+
+    RenderGraph();
+    ~RenderGraph();
+
+    // GL リソース（プール・FBO・クエリ）を破棄
+    void Shutdown();
+
+    //---------------------------------------------------------
+    // フレームの宣言
+    //---------------------------------------------------------
+
+    // 宣言を破棄（プールは残す）
+    void Reset();
+
+    // 外部で管理しているテクスチャ（0 ならバックバッファ扱い）
+    RGResource ImportTexture(const std::string& name, unsigned int texture);
+
+    // このフレームだけ使う一時テクスチャ
+    RGResource CreateTexture(const std::string& name, const RGTextureDesc& desc);
+
+    // 最終出力（これに寄与しないパスは省かれる）
+    void MarkOutput(RGResource res);
+
+    // パスを追加（setup はその場で呼ばれる）
+    void AddPass(const std::string& name, const SetupFunc& setup, const ExecuteFunc& execute);
+
+    // 不要パスの除去・並べ替え・一時テクスチャの割り当て
+    bool Compile();
+
+    // 並べたパスを実行
+    void Execute();
+
+    //---------------------------------------------------------
+    // パス実行中に使う
+    //---------------------------------------------------------
+
+    // リソースの GL テクスチャ ID
+    unsigned int GetTexture(RGResource res) const;
+    const RGTextureDesc& GetDesc(RGResource res) const;
+
+    //---------------------------------------------------------
+    // 統計・計測
+    //---------------------------------------------------------
+
+    void SetTiming(bool enable) { mIsTiming = enable; }
+    bool IsTiming() const { return mIsTiming; }
+
+    // 直近に結果が取れたフレームのパス別 GPU 時間
+    const std::vector<RGPassTiming>& GetTimings() const { return mTimings; }
+
+    // 直近の Compile の統計（デバッグ用）
+    unsigned int GetPassCount()      const { return static_cast<unsigned int>(mPasses.size()); }
+    unsigned int GetCulledPassCount() const { return mCulledPasses; }
+    unsigned int GetTransientCount() const { return mTransientCount; }
+    unsigned int GetPhysicalCount()  const { return static_cast<unsigned int>(mPool.size()); }
+
+private:
+    struct ResourceNode
+    {
+        std::string   name;
+        RGTextureDesc desc;
+        bool          imported = false;
+        unsigned int  texture  = 0;     // 取り込み時、または割り当て後の実体
+        int           physical = -1;    // mPool の添字（一時テクスチャのみ）
+        bool          isOutput = false;
+    };
+
+    struct PassNode
+    {
+        std::string             name;
+        ExecuteFunc             execute;
+        std::vector<RGResource> reads;
+        std::vector<RGResource> writes;
+        bool                    sideEffect = false;
+        bool                    live       = false;
+    };
+
+    // プール上の実体
+    struct PhysicalTexture
+    {
+        RGTextureDesc desc;
+        unsigned int  texture  = 0;
+        bool          inUse    = false;
+        uint64_t      lastUsed = 0;     // 最後に使ったフレーム
+    };
+
+    // GPU 時間計測（数フレーム遅れで結果を読む）
+    static const int kTimingFrames = 3;
+    struct TimingFrame
+    {
+        std::vector<unsigned int> queries;
+        std::vector<std::string>  names;
+        size_t                    used = 0;
+        bool                      pending = false;
+    };
+
+    bool IsValid(RGResource res) const { return res >= 0 && res < static_cast<int>(mResources.size()); }
+
+    // 依存順に並べる（循環があれば false）
+    bool SortPasses();
+
+    int  AcquirePhysical(const RGTextureDesc& desc);
+    void CollectIdlePhysical();
+
+    // 一時テクスチャへ書くパスの FBO
+    bool BindTargets(const PassNode& pass);
+
+    void ReadTimings(TimingFrame& frame);
+
+    std::vector<ResourceNode> mResources;
+    std::vector<PassNode>     mPasses;
+    std::vector<int>          mOrder;       // 実行するパス（並べ替え済み）
+
+    std::vector<PhysicalTexture> mPool;
+
+    // アタッチメントの組み合わせ → FBO
+    std::map<std::vector<unsigned int>, unsigned int> mFramebuffers;
+
+    uint64_t mFrame;
+    bool     mIsCompiled;
+
+    unsigned int mCulledPasses;
+    unsigned int mTransientCount;
+
+    bool mIsTiming;
+    TimingFrame mTimingFrames[kTimingFrames];
+    int mTimingIndex;
+    std::vector<RGPassTiming> mTimings;
+};
+
+} // namespace toy
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "Utils/MathUtil.h"
+#include "Utils/Frustum.h"
+#include "Engine/Render/ShaderVariantCache.h"
+#include "Engine/Render/MeshDrawQueue.h"
+#include "Engine/Render/TransparentQueue.h"
+#include "Asset/Geometry/Polygon.h"
 #include "glad/glad.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <SDL3/SDL.h>
 
 namespace toy {
@@ -25,6 +32,9 @@ enum class VisualLayer
     UI,             // UI / HUD
 };
 
+// VisualLayer の数（レイヤー別コンテナの配列サイズ）
+const int NUM_VISUAL_LAYERS = static_cast<int>(VisualLayer::UI) + 1;
+
 //-------------------------------------------------------------
 // UI スケール情報
 // ・物理解像度 / 論理解像度 / スケール係数をまとめて保持
@@ -44,6 +54,59 @@ struct UIScaleInfo
     float offsetY  = 0.0f;  // レターボックスの上下余白
 };
 
+//-------------------------------------------------------------
+// UI の画面矩形（ピクセル、GL と同じ左下原点）
+// ・保持モード UI の部分再描画（UILayerCache）で使う
+//-------------------------------------------------------------
+struct UIRect
+{
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+
+    bool IsEmpty() const { return w <= 0 || h <= 0; }
+    bool operator==(const UIRect& o) const { return x == o.x && y == o.y && w == o.w && h == o.h; }
+    bool operator!=(const UIRect& o) const { return !(*this == o); }
+};
+
+// UI コンポーネントの前回キャッシュからの変化
+enum class UIChange
+{
+    None,   // 変化なし
+    Rect,   // 矩形の中だけ描き直せばよい
+    Full,   // 範囲が分からない（全体を描き直す）
+};
+
+//-------------------------------------------------------------
+// 描画ビュー（分割画面・ミニマップなど）
+// ・viewport はウィンドウに対する割合（左下原点、0〜1）
+// ・layerMask は LayerMaskBit() の和。適用されるのは 3D と背景 2D
+//   （OverlayScreen / UI は画面全体に 1 回だけ描く）
+// ・背景 2D を含むビューだけスカイを描く
+//-------------------------------------------------------------
+struct RenderViewport
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float w = 1.0f;
+    float h = 1.0f;
+};
+
+inline uint32_t LayerMaskBit(VisualLayer layer) { return 1u << static_cast<int>(layer); }
+const uint32_t ALL_LAYERS_MASK = (1u << NUM_VISUAL_LAYERS) - 1;
+
+struct RenderView
+{
+    Matrix4        view       = Matrix4::Identity;
+    Matrix4        projection = Matrix4::Identity;
+    RenderViewport viewport;
+    uint32_t       layerMask  = ALL_LAYERS_MASK;
+    int            order      = 0;      // 小さいほど先に描く（メインビューは常に最初）
+    bool           clear      = true;   // ビューポート内をクリアしてから描く
+    bool           enabled    = true;
+};
+
 //-------------------------------------------------------------
 // Renderer
 // ・SDL ウィンドウと OpenGL コンテキストを管理
@@ -95,6 +158,23 @@ public:
     // View * Projection（描画時によく使う）
     Matrix4 GetViewProjMatrix() const { return mViewMatrix * mProjectionMatrix; }
     
+    // ※ 描画中（Draw() の中）の Get*Matrix は、いま描いているビューの行列を返す
+    
+    // 追加ビュー（分割画面の 2 人目・ミニマップなど）
+    //   - 可視判定はメインビューと同じ 1 回の走査でまとめて行う
+    //   - ボーン・スキニング・シャドウマップは全ビューで共有
+    //     （ライト空間はメインビュー基準）
+    //   - オクルージョン／ポータルカリングはメインビューだけ
+    //   戻り値：ビュー ID（1 から。メインビューは SetViewMatrix / SetMainViewport で扱う）
+    int  AddView(const RenderView& view);
+    void RemoveView(int id);
+    RenderView* GetView(int id);
+    
+    // メインビュー（SetViewMatrix の行列で描くビュー）の画面範囲とレイヤー
+    void SetMainViewport(const RenderViewport& viewport) { mMainViewport = viewport; }
+    const RenderViewport& GetMainViewport() const { return mMainViewport; }
+    void SetMainLayerMask(uint32_t mask) { mMainLayerMask = mask; }
+    
     // 視野角（Perspective FOV／度数法）
     float GetPerspectiveFov() const { return mPerspectiveFOV; }
     void SetPerspectiveFov(float f) { mPerspectiveFOV = f; }
@@ -127,9 +207,16 @@ public:
     //---------------------------------------------------------
     
     // VisualComponent を登録／解除
+    //   - 登録は保留リストに積み、次の描画の頭でレイヤー別リストへまとめて挿入
+    //   - 解除は削除セットに積み、次の描画の頭でまとめて詰める
+    //   - レイヤー／描画順の変更も解除→登録として扱う（VisualComponent から呼ばれる）
     void AddVisualComp(class VisualComponent* comp);
     void RemoveVisualComp(class VisualComponent* comp);
     
+    // スキニング対象（ボーンパレットを毎フレーム書き込むもの）を登録／解除
+    void AddSkinnedComp(class SkeletalMeshComponent* comp);
+    void RemoveSkinnedComp(class SkeletalMeshComponent* comp);
+    
     
     //---------------------------------------------------------
     // デバッグ系
@@ -139,6 +226,9 @@ public:
     bool GetDebugMode() const { return mIsDebugMode; }
     bool IsDebugMode() const { return mIsDebugMode; }
     
+    // デバッグ線描画（デバッグモード時のみ有効、フレーム末にまとめて描画）
+    class DebugDraw* GetDebugDraw() const { return mDebugDraw.get(); }
+    
     
     //---------------------------------------------------------
     // リソース管理／補助
@@ -157,6 +247,116 @@ public:
     // 名前指定でシェーダ取得
     std::shared_ptr<class Shader> GetShader(const std::string& name) { return mShaders[name]; }
     
+    // パーミュテーション付きシェーダ取得
+    //   name     : 共通ソース名（"Phong", "Shadow"）
+    //   features : ShaderFeature のビットマスク
+    //   初回要求時にコンパイルされ、以降はキャッシュを返す
+    std::shared_ptr<class Shader> GetShaderVariant(const std::string& name, uint32_t features);
+    
+    // マテリアル用の共有 UBO
+    std::shared_ptr<class MaterialBuffer> GetMaterialBuffer() const { return mMaterialBuffer; }
+    
+    // ボーン行列パレット用の共有 UBO
+    std::shared_ptr<class BonePaletteBuffer> GetBonePaletteBuffer() const { return mBonePaletteBuffer; }
+    
+    // スキニング前処理（トランスフォームフィードバック）の有効／無効
+    //   無効時、または初期化に失敗した環境ではシェーダ内スキニングで描く
+    void SetPreSkinning(bool enable) { mIsPreSkinning = enable; }
+    bool IsPreSkinningActive() const { return mIsPreSkinning && mSkinningStage; }
+    
+    // CPU オクルージョンカリング（SetOccluder した遮蔽物の裏を省く）の有効／無効
+    void SetOcclusionCulling(bool enable) { mIsOcclusionCulling = enable; }
+    bool IsOcclusionCulling() const { return mIsOcclusionCulling; }
+    
+    // Effect3D レイヤーを奥から手前へソートして描くか
+    //   無効時は従来どおり DrawOrder 順
+    void SetTransparencySort(bool enable) { mIsTransparencySort = enable; }
+    bool IsTransparencySort() const { return mIsTransparencySort; }
+    
+    // 直近フレームのオクルージョンカリング統計
+    const struct OcclusionStats& GetOcclusionStats() const;
+    
+    // 屋内用のセル＆ポータルカリング
+    //   セルが 1 つも無い、またはカメラがセル外なら何もしない
+    class PortalSystem* GetPortalSystem() const { return mPortalSystem.get(); }
+    void SetPortalCulling(bool enable) { mIsPortalCulling = enable; }
+    bool IsPortalCulling() const { return mIsPortalCulling; }
+    
+    // 散布物（ScatterComponent）の品質
+    //   density       : 描くインスタンスの割合（0〜1）
+    //   distanceScale : LOD 距離とフェード距離の倍率
+    void SetScatterQuality(float density, float distanceScale);
+    float GetScatterDensity() const { return mScatterDensity; }
+    float GetScatterDistanceScale() const { return mScatterDistanceScale; }
+    
+    // マテリアル未設定のサブメッシュ用
+    std::shared_ptr<class Material> GetDefaultMaterial() const { return mDefaultMaterial; }
+    
+    // 単体描画用の作業キュー（MeshComponent::Draw から使う）
+    MeshDrawQueue& GetImmediateDrawQueue() { return mImmediateQueue; }
+    
+    // フレームの描画パス（パス別 GPU 時間は GetRenderGraph()->SetTiming(true) で取れる）
+    class RenderGraph* GetRenderGraph() const { return mRenderGraph.get(); }
+    
+    // 画面キャプチャ（PBO で非同期に読み戻し、別スレッドで PNG 保存）
+    //   SaveScreenshot    : 次のフレームを 1 枚
+    //   StartFrameCapture : everyNthFrame ごとに pathPrefix_000000.png ...
+    void SaveScreenshot(const std::string& filePath);
+    void StartFrameCapture(const std::string& pathPrefix, int everyNthFrame = 1);
+    void StopFrameCapture();
+    class FrameCapture* GetFrameCapture() const { return mFrameCapture.get(); }
+    
+    // GL コマンドのキャプチャ（"debug": { "gl_recorder": true } のときだけ有効）
+    //   次のフレームから frames フレーム分を filePath へ書き出す。tools/GLReplay で再生・計測
+    bool CaptureGLFrames(const std::string& filePath, int frames = 1);
+    class GLRecorder* GetGLRecorder() const { return mGLRecorder.get(); }
+    
+    // 静的バッチ（レベル読み込み後に GetStaticBatcher()->Build()）
+    class StaticBatcher* GetStaticBatcher() const { return mStaticBatcher.get(); }
+    
+    // メッシュレットの CPU カリング（AssetManager::SetMeshletSettings で分けたメッシュのみ）
+    void SetMeshletCulling(bool b) { mIsMeshletCulling = b; }
+    bool IsMeshletCulling() const { return mIsMeshletCulling; }
+    
+    // 焼き込みライティング（LoadCache → Apply。無ければ Bake → SaveCache）
+    class LightBaker* GetLightBaker() const { return mLightBaker.get(); }
+    
+    // 品質ガバナー（平滑化したフレーム時間を見て、下の品質をノブ単位で上げ下げする）
+    //   "quality_governor": { "enabled": true, ... } で有効。変更は GetDecisions() で取れる
+    //   標準のノブ：overlay_scale / particle_budget / lod_bias / shadow_update / shadow_resolution / render_scale
+    class QualityGovernor* GetQualityGovernor() const { return mQualityGovernor.get(); }
+    
+    // シーンの描画解像度の倍率（0.25〜1）
+    //   1 未満なら 3D を縮小バッファへ描いてから画面へ拡大する（オーバーレイ・UI は等倍）
+    void SetRenderScale(float scale);
+    float GetRenderScale() const { return mRenderScale; }
+    
+    // パーティクルを描く割合（0〜1、ParticleComponent が参照）
+    void SetParticleBudget(float budget);
+    float GetParticleBudget() const { return mParticleBudget; }
+    
+    // 画面オーバーレイ（雨・霧・雪）の描画解像度の倍率（0.25〜1、WeatherOverlayComponent が参照）
+    //   1 未満なら縮小バッファへ描いてから、シーンの深度を見て拡大合成する
+    void SetOverlayScale(float scale);
+    float GetOverlayScale() const { return mOverlayScale; }
+    
+    // 拡大合成で深度を見るか（見るときはシーンを一時バッファへ描き、深度をテクスチャで残す）
+    void SetOverlayDepthAware(bool b) { mIsOverlayDepthAware = b; }
+    bool IsOverlayDepthAware() const { return mIsOverlayDepthAware; }
+    
+    // シーンの深度テクスチャ（Overlay パスの間だけ有効。無ければ 0）
+    unsigned int GetSceneDepthTexture() const { return mSceneDepthTexture; }
+    
+    // Actor の重要度（Application が設定。段階に応じて影を落とすかを決める）
+    void SetSignificanceManager(class SignificanceManager* manager) { mSignificance = manager; }
+    
+    // 保持モード UI（変化があったフレームだけ UI をキャッシュへ描き直し、毎フレームは合成のみ）
+    //   UI を直接描く独自コンポーネントは CheckUIChange を実装すること
+    //   （未実装のものは毎フレーム全体を描き直す扱い）
+    void SetRetainedUI(bool b);
+    bool IsRetainedUI() const { return mIsRetainedUI; }
+    class UILayerCache* GetUILayerCache() const { return mUILayerCache.get(); }
+    
     
     //---------------------------------------------------------
     // シャドウマップ／ライト空間
@@ -168,6 +368,17 @@ public:
     // シャドウマップテクスチャ（デプス or sampler2DShadow 等）
     std::shared_ptr<class Texture> GetShadowMapTexture() const { return mShadowMapTexture; }
     
+    // このフレームでシャドウマップが描かれたか
+    //   false の時はシャドウ参照なしのバリアントを選べる
+    bool IsShadowMapActive() const { return mIsShadowMapActive; }
+    
+    // シャドウマップの解像度（同じテクスチャの中身を作り直す）
+    void SetShadowMapResolution(int width, int height);
+    
+    // シャドウマップを何フレームに 1 回描き直すか（間のフレームは前回の行列とマップを使う）
+    void SetShadowUpdateInterval(int frames);
+    int  GetShadowUpdateInterval() const { return mShadowUpdateInterval; }
+    
     
     //---------------------------------------------------------
     // 共通ジオメトリ（スプライト / フルスクリーン）
@@ -218,6 +429,12 @@ private:
     // デバッグ描画 ON/OFF
     bool mIsDebugMode;
     
+    // GL コマンドの記録フックを入れるか（起動時の設定のみ）
+    bool mIsGLRecorder;
+    
+    // メッシュレットのカリングを行うか
+    bool mIsMeshletCulling;
+    
     // クリアカラー
     Vector3 mClearColor;
     
@@ -274,6 +491,99 @@ private:
     std::unordered_map<std::string, std::shared_ptr<class Shader>> mShaders;
     bool LoadShaders();
     
+    // 共通ソースごとのパーミュテーションキャッシュ
+    std::unordered_map<std::string, std::unique_ptr<ShaderVariantCache>> mShaderVariants;
+    
+    
+    //---------------------------------------------------------
+    // マテリアル／メッシュ描画キュー
+    //---------------------------------------------------------
+    
+    std::shared_ptr<class MaterialBuffer> mMaterialBuffer;
+    std::shared_ptr<class Material>       mDefaultMaterial;
+    
+    // Object3D レイヤーのメッシュをまとめてソート描画するキュー
+    MeshDrawQueue mMeshQueue;
+    MeshDrawQueue mImmediateQueue;
+    
+    // キューに載らなかったコンポーネント（フレーム内の作業用）
+    std::vector<class VisualComponent*> mDeferredComps;
+    
+    // Effect3D レイヤーの奥行きソート
+    TransparentQueue mTransparentQueue;
+    bool mIsTransparencySort;
+    
+    
+    //---------------------------------------------------------
+    // ボーンパレット
+    //---------------------------------------------------------
+    
+    std::shared_ptr<class BonePaletteBuffer> mBonePaletteBuffer;
+    std::vector<class SkeletalMeshComponent*> mSkinnedComps;
+    
+    // デバッグ線のバッチ描画
+    std::unique_ptr<class DebugDraw> mDebugDraw;
+    
+    // スキニング前処理（nullptr ならシェーダ内スキニング）
+    std::unique_ptr<class SkinningStage> mSkinningStage;
+    bool mIsPreSkinning;
+    
+    // CPU オクルージョンカリング
+    std::unique_ptr<class OcclusionCuller> mOcclusionCuller;
+    bool mIsOcclusionCulling;
+    
+    // セル＆ポータルカリング
+    std::unique_ptr<class PortalSystem> mPortalSystem;
+    bool mIsPortalCulling;
+    
+    // フレームの描画パス
+    std::unique_ptr<class RenderGraph> mRenderGraph;
+    
+    // 画面キャプチャ
+    std::unique_ptr<class FrameCapture> mFrameCapture;
+    
+    // GL コマンドのキャプチャ
+    std::unique_ptr<class GLRecorder> mGLRecorder;
+    
+    // 静的バッチ
+    std::unique_ptr<class StaticBatcher> mStaticBatcher;
+    
+    // 焼き込みライティング
+    std::unique_ptr<class LightBaker> mLightBaker;
+    
+    // 保持モード UI
+    std::unique_ptr<class UILayerCache> mUILayerCache;
+    bool mIsRetainedUI;
+    std::vector<class VisualComponent*> mLastUIVisible;    // 比較だけに使う（参照しない）
+    void DrawRetainedUI();
+    
+    // 散布物の品質
+    float mScatterDensity;
+    float mScatterDistanceScale;
+    
+    // 品質ガバナーと、そのノブが動かす値
+    std::unique_ptr<class QualityGovernor> mQualityGovernor;
+    float mRenderScale;
+    float mParticleBudget;
+    float mOverlayScale;
+    bool  mIsOverlayDepthAware;
+    unsigned int mSceneDepthTexture;
+    void  RegisterQualityKnobs();
+    
+    // Actor の重要度（Application が所有）
+    class SignificanceManager* mSignificance;
+    
+    // シーンパスの描画先のサイズ（縮小描画中は縮小バッファ、それ以外は画面）
+    float mTargetWidth;
+    float mTargetHeight;
+    
+    // 全スキニング対象のパレットをまとめて書き込む（シャドウパスより前）
+    void UpdateBonePalettes();
+    
+    // 前処理が有効なら、可視リスト（メイン・影・追加ビュー）に入ったものだけ
+    // トランスフォームフィードバックでスキニングする（BuildVisibleLists の後）
+    void PreSkinVisible();
+    
     
     //---------------------------------------------------------
     // シャドウマッピング処理
@@ -283,22 +593,83 @@ private:
     bool   InitializeShadowMapping();
     void   RenderShadowMap();
     
+    // ライト視点行列の計算とシャドウ有効判定（可視判定より前に行う）
+    void   UpdateLightSpaceMatrix();
+    
     Matrix4 mLightSpaceMatrix;
     std::shared_ptr<class Texture> mShadowMapTexture;
+    bool    mIsShadowMapActive;
+    
+    // 間引き更新（mIsShadowRefresh が false のフレームは描き直さない）
+    int     mShadowUpdateInterval;
+    int     mShadowFrameCount;
+    bool    mIsShadowRefresh;
+    bool    mIsShadowMapValid;
     
     
     //---------------------------------------------------------
     // Visual / SkyDome
     //---------------------------------------------------------
     
-    std::vector<class VisualComponent*> mVisualComps;
+    // レイヤー別の登録リスト（DrawOrder 昇順）
+    std::vector<class VisualComponent*> mLayerComps[NUM_VISUAL_LAYERS];
+    
+    // 今フレームの可視リスト（レイヤー別／シャドウ用）
+    std::vector<class VisualComponent*> mLayerVisible[NUM_VISUAL_LAYERS];
+    std::vector<class VisualComponent*> mShadowVisible;
+    
+    // DrawVisualLayer が読む可視リスト（メイン or 追加ビューのもの）
+    std::vector<class VisualComponent*>* mDrawVisible;
+    
+    // 追加ビュー
+    struct ViewSlot
+    {
+        int        id;
+        RenderView desc;
+        std::vector<class VisualComponent*> visible[NUM_VISUAL_LAYERS];
+    };
+    std::vector<ViewSlot> mViews;           // order 順
+    std::vector<Frustum>  mViewFrustums;    // mViews と同じ並び（フレーム内の作業用）
+    int            mNextViewID;
+    RenderViewport mMainViewport;
+    uint32_t       mMainLayerMask;
+    
+    // ビュー 1 つ分のシーン（スカイ・背景 2D・3D・エフェクト）
+    void DrawSceneView(const Matrix4& view, const Matrix4& projection,
+                       const RenderViewport& viewport, uint32_t layerMask,
+                       std::vector<class VisualComponent*>* visible, bool clear);
+    
+    // 次フレーム頭に反映する登録／解除
+    std::vector<class VisualComponent*>        mPendingVisuals;
+    std::unordered_set<class VisualComponent*> mRemovedVisuals;
+    bool mIsLayerDirty[NUM_VISUAL_LAYERS];
     
     // SkyDome は Game 側で生成・所有し、生ポインタを保持
     class SkyDomeComponent* mSkyDomeComp;
     
+    // 保留中の登録／解除をレイヤー別リストへ反映
+    void FlushVisualChanges();
+    
+    // カメラ／ライトのフラスタムで 1 回だけ走査し、可視リストを作る
+    //   遮蔽物があれば、その裏に隠れたものを可視リストから外す
+    void BuildVisibleLists();
+    
+    // オクルージョン判定待ちの可視コンポーネント（フレーム内の作業用）
+    struct OcclusionCandidate
+    {
+        int    layer;   // mLayerVisible の添字
+        size_t index;   // mLayerVisible[layer] 内の位置
+        Cube   aabb;    // ワールド AABB
+    };
+    std::vector<OcclusionCandidate> mOcclusionCandidates;
+    
     void DrawSky();
     void DrawVisualLayer(VisualLayer layer);
     
+    // このフレームのパス（影・シーン・オーバーレイ・UI）をグラフに積む
+    void BuildRenderGraph();
+    void DrawScenePass();
+    
     
     //---------------------------------------------------------
     // デバッグ用カウンタ
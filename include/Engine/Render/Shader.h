@@ -7,9 +7,21 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
 namespace toy {
 
+//-------------------------------------------------------------
+// UniformBlockBinding
+// ・共有 UBO のバインディングポイント
+// ・同名の uniform ブロックを持つプログラムは Load() 時に自動で結び付ける
+//-------------------------------------------------------------
+enum UniformBlockBinding : GLuint
+{
+    UBB_MATERIAL = 0,   // "MaterialBlock"（MaterialBuffer）
+    UBB_BONES    = 1,   // "BonePalette"（BonePaletteBuffer）
+};
+
 //-------------------------------------------------------------
 // Shader
 // ・頂点シェーダ／フラグメントシェーダを読み込み＆リンクして
@@ -29,14 +41,26 @@ public:
     // シェーダプログラムを読み込み＆コンパイル＆リンク
     //   vertName: 頂点シェーダのファイル名
     //   fragName: フラグメントシェーダのファイル名
-    bool Load(const std::string& vertName, const std::string& fragName);
+    //   defines : #version 行の直後に差し込む #define 群（パーミュテーション用）
+    bool Load(const std::string& vertName, const std::string& fragName,
+              const std::string& defines = "");
+    
+    // トランスフォームフィードバック用（頂点シェーダのみ）のプログラムを作る
+    //   varyings : 書き出す out 変数名（順にバッファ 0, 1, ... へ分けて出力）
+    bool LoadTransformFeedback(const std::string& vertName,
+                               const std::vector<std::string>& varyings,
+                               const std::string& defines = "");
     
     // シェーダプログラムと個別シェーダを破棄
     void Unload();
     
     // このシェーダをアクティブにする（glUseProgram）
+    //   すでにアクティブなら何もしない（半透明キュー等で連続する切り替えを省く）
     void SetActive();
     
+    // プログラム ID（描画ソートのキー等に使用）
+    GLuint GetProgramID() const { return mShaderProgramID; }
+    
     
     //---------------------------------------------------------
     // uniform 設定（行列・ベクトル・スカラー等）
@@ -46,7 +70,7 @@ public:
     void SetMatrixUniform(const char* name, const Matrix4& matrix);
     
     // 行列配列（スキニング等で使用）
-    void SetMatrixUniforms(const char* name, Matrix4* matrices, unsigned count);
+    void SetMatrixUniforms(const char* name, const Matrix4* matrices, unsigned count);
     
     // 3D ベクトル
     void SetVectorUniform(const char* name, const Vector3& vector);
@@ -76,19 +100,26 @@ private:
     GLuint mFragShaderID;      // フラグメントシェーダ
     GLuint mShaderProgramID;   // リンク済みプログラム
     
+    // 現在 glUseProgram されているプログラム（全シェーダ共通）
+    static GLuint sActiveProgram;
+    
     
     //---------------------------------------------------------
     // 内部ヘルパー関数
     //---------------------------------------------------------
     
     // シェーダファイルを読み込み、コンパイル
-    bool CompileShader(const std::string& fileName, GLenum shaderType, GLuint& outShader);
+    bool CompileShader(const std::string& fileName, GLenum shaderType,
+                       const std::string& defines, GLuint& outShader);
     
     // シェーダコンパイル結果チェック
     bool IsCompiled(GLuint shader);
     
     // シェーダプログラムのリンク＆バリデーションチェック
     bool IsValidProgram();
+    
+    // 既知の uniform ブロックを UniformBlockBinding に結び付ける
+    void BindUniformBlocks();
 };
 
 } // namespace toy
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// ShaderFeature
+// ・シェーダパーミュテーションの機能ビット
+// ・ビットごとに #define が 1 つ対応し、共通ソースの先頭に差し込まれる
+//   （実行時の uniform 分岐をコンパイル時の #ifdef に置き換える）
+//-------------------------------------------------------------
+enum ShaderFeature : uint32_t
+{
+    SF_NONE           = 0,
+    SF_SKINNED        = 1u << 0,   // USE_SKINNING       : ボーンパレットによるスキニング
+    SF_TOON           = 1u << 1,   // USE_TOON           : トゥーンライティング
+    SF_SHADOW         = 1u << 2,   // USE_SHADOW         : シャドウマップ参照
+    SF_FOG            = 1u << 3,   // USE_FOG            : 距離フォグ
+    SF_OVERRIDE_COLOR = 1u << 4,   // USE_OVERRIDE_COLOR : 単色描画（輪郭など）
+    SF_INSTANCED      = 1u << 5,   // USE_INSTANCING     : インスタンス属性のワールド行列＋距離フェード
+    SF_IMPOSTOR       = 1u << 6,   // USE_IMPOSTOR       : 八面体インポスターの板ポリ（Billboard.vert）
+    SF_BAKED_LIGHTING = 1u << 7,   // USE_BAKED_LIGHTING : 焼いた太陽の可視率と AO（リアルタイムの影は引かない）
+};
+
+//-------------------------------------------------------------
+// ShaderVariantCache
+// ・1 組の頂点／フラグメントソースから、機能ビットごとの
+//   バリアントをオンデマンドでコンパイルしてキャッシュする
+// ・同じビットマスクは 2 回目以降キャッシュから返す
+// ・コンパイル失敗したマスクも記録し、毎フレーム再試行しない
+//-------------------------------------------------------------
+class ShaderVariantCache
+{
+public:
+    ShaderVariantCache(const std::string& vertName, const std::string& fragName);
+    ~ShaderVariantCache();
+
+    // 指定マスクのバリアントを取得（未コンパイルならここでコンパイル）
+    std::shared_ptr<class Shader> GetVariant(uint32_t features);
+
+    // コンパイル済みバリアントをすべて破棄
+    void Clear();
+
+    // 機能ビット → "#define USE_XXX\n" の列へ変換
+    static std::string BuildDefines(uint32_t features);
+
+private:
+    std::string mVertName;
+    std::string mFragName;
+
+    // ビットマスク → コンパイル済みシェーダ（失敗時は nullptr）
+    std::unordered_map<uint32_t, std::shared_ptr<class Shader>> mVariants;
+};
+
+} // namespace toy
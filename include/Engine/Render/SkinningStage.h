@@ -0,0 +1,46 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include <memory>
+#include <string>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// SkinningStage
+// ・スキンメッシュをフレーム頭に 1 回だけスキニングする前処理
+// ・トランスフォームフィードバックで位置／法線をキャラごとの
+//   VertexArray（VertexArray(const VertexArray*) で作った受け皿）へ書き出す
+// ・シャドウ／通常／輪郭パスはその結果を非スキニングのシェーダで描く
+//
+// 使い方（Renderer::UpdateBonePalettes 内）
+//   Begin() → 各キャラのパレットをバインドして Skin() → End()
+//-------------------------------------------------------------
+class SkinningStage
+{
+public:
+    SkinningStage();
+    ~SkinningStage();
+
+    // shaderPath : Shaders ディレクトリ（SkinningTF.vert を読む）
+    bool Initialize(const std::string& shaderPath);
+    void Shutdown();
+
+    void Begin();
+    void End();
+
+    // source（ボーン属性付き）をスキニングして dest の位置／法線へ書き出す
+    //   - 呼び出し前に対象のボーンパレットを UBB_BONES にバインドしておくこと
+    void Skin(class VertexArray* source, class VertexArray* dest);
+
+    // 直近フレームでスキニングした頂点数（デバッグ用）
+    unsigned int GetSkinnedVertexCount() const { return mSkinnedVerts; }
+
+private:
+    std::shared_ptr<class Shader> mShader;
+    GLuint       mTFO;
+    unsigned int mSkinnedVerts;
+};
+
+} // namespace toy
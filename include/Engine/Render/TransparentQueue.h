@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// TransparentDrawItem
+// ・半透明コンポーネント 1 つ分の描画要求
+//-------------------------------------------------------------
+struct TransparentDrawItem
+{
+    class VisualComponent* comp      = nullptr;
+    float                  viewDepth = 0.0f;   // ビュー空間の奥行き（大きいほど遠い）
+    uint32_t               stateId   = 0;      // シェーダ・テクスチャ・ブレンドの要約
+};
+
+//-------------------------------------------------------------
+// TransparentQueue
+// ・Effect3D レイヤーのコンポーネントを奥から手前へ並べて描く
+// ・キーは「奥行き（反転して量子化）＋描画ステート」の 32bit で、
+//   基数ソート（O(n)）で並べる
+//     → ほぼ同じ奥行きのものは同じステート同士が隣り合い、
+//       シェーダの切り替え（Shader::SetActive）が省かれる
+// ・安定ソートなので、奥行きもステートも同じなら DrawOrder 順を保つ
+// ・コンポーネント内部の並び（パーティクル 1 粒ずつ等）は各 Draw() が行う
+//-------------------------------------------------------------
+class TransparentQueue
+{
+public:
+    TransparentQueue();
+
+    // 積んだ要求を破棄（確保済みメモリは再利用）
+    void Clear();
+
+    // 要求を追加（奥行きは GetSortPosition() をビュー変換して求める）
+    void Add(class VisualComponent* comp, const Matrix4& view);
+
+    // ソートして描画
+    void Execute();
+
+    size_t GetCount() const { return mItems.size(); }
+
+    // 直近の Execute の統計（デバッグ用）
+    //   前の要求とステートが変わった回数
+    unsigned int GetStateChangeCount() const { return mStateChanges; }
+
+private:
+    std::vector<TransparentDrawItem> mItems;
+
+    // ソート用の作業領域
+    std::vector<uint32_t> mKeys;
+    std::vector<uint32_t> mOrder;
+    std::vector<uint32_t> mScratch;
+
+    unsigned int mStateChanges;
+};
+
+} // namespace toy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Engine/Render/Renderer.h"
+#include "glad/glad.h"
+
+#include <functional>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// UILayerCache
+// ・保持モード UI：UI レイヤーを画面サイズの RGBA テクスチャへ描いておき、
+//   毎フレームはそれをシーンへ 1 回合成するだけにする
+// ・描き直すのは何か変わったフレームだけ
+//     MarkDirty()     : 全体（登録変更・画面サイズ変更など）
+//     MarkDirty(rect) : 矩形の中だけ（シザーで切って、クリア → 全 UI を描く）
+// ・キャッシュは乗算済みアルファで持つ
+//     描き込み：color = (SRC_ALPHA, 1-SRC_ALPHA) / alpha = (1, 1-SRC_ALPHA)
+//     加算    ：color = (1, 1)                  / alpha = (0, 1)
+//     合成    ：(1, 1-SRC_ALPHA)
+//   → 直接バックバッファへ描いた場合と同じ結果になる
+//
+// 使い方（Renderer の UI パス）
+//   cache.Update(w, h, drawUI);   // 汚れていれば描き直す
+//   cache.Composite(shader, quad);
+//-------------------------------------------------------------
+class UILayerCache
+{
+public:
+    UILayerCache();
+    ~UILayerCache();
+
+    void Shutdown();
+
+    // 次の Update で描き直す範囲を足す
+    void MarkDirty();
+    void MarkDirty(const UIRect& rect);
+    bool IsDirty() const { return mIsFullDirty || !mDirtyRect.IsEmpty(); }
+
+    // 矩形単位の部分再描画を使うか（false なら常に全体を描き直す）
+    void SetPartialRedraw(bool b) { mIsPartialRedraw = b; }
+    bool IsPartialRedraw() const { return mIsPartialRedraw; }
+
+    // 汚れていれば drawUI でキャッシュを描き直す
+    //   戻り値：描き直したら true
+    bool Update(int width, int height, const std::function<void()>& drawUI);
+
+    // キャッシュをバックバッファ（今バインドされている FBO）へ合成
+    void Composite(class Shader* shader, class VertexArray* quad);
+
+    GLuint GetTexture() const { return mTexture; }
+
+    // 統計（デバッグ用）
+    unsigned int GetRedrawCount()        const { return mRedrawCount; }
+    unsigned int GetPartialRedrawCount() const { return mPartialRedrawCount; }
+
+private:
+    bool Resize(int width, int height);
+
+    GLuint mFBO;
+    GLuint mTexture;
+    int    mWidth;
+    int    mHeight;
+
+    bool   mIsFullDirty;
+    UIRect mDirtyRect;      // 汚れた範囲の和（空なら無し）
+    bool   mIsPartialRedraw;
+
+    unsigned int mRedrawCount;
+    unsigned int mPartialRedrawCount;
+};
+
+} // namespace toy
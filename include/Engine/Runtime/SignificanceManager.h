@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// Significance
+// ・Actor の重要度の段階（小さいほど重要）
+// ・SignificanceManager が毎フレーム Actor に書き込む
+//-------------------------------------------------------------
+enum class Significance : uint8_t
+{
+    High,       // 近い／画面に大きく映っている
+    Medium,
+    Low,
+    Dormant,    // 画面外の遠方など、ほぼ寄与しない
+};
+
+const int NUM_SIGNIFICANCE = static_cast<int>(Significance::Dormant) + 1;
+
+//-------------------------------------------------------------
+// SignificancePolicy
+// ・段階ごとに各サブシステムがどこまで手を抜くか
+//   *Interval : 何フレームに 1 回更新するか（0 なら更新しない）
+//   間引いたフレームの経過時間は次の更新にまとめて渡す
+//-------------------------------------------------------------
+struct SignificancePolicy
+{
+    int   animInterval     = 1;     // AnimationPlayer の姿勢計算（とスキニング）
+    int   particleInterval = 1;     // ParticleComponent の移動・発生
+    float particleBudget   = 1.0f;  // ParticleComponent の描画割合（Renderer の予算に掛ける）
+    int   soundInterval    = 1;     // SoundComponent の位置反映（0 ならループ音を一時停止）
+    bool  castShadow       = true;  // シャドウマップに描くか
+};
+
+//-------------------------------------------------------------
+// SignificanceSettings
+// ・スコアは「画面上の大きさ」（包む球の半径 / 画面の高さの半分）
+//   視錐台の外なら hiddenWeight を掛ける
+// ・nearDistance 以内は常に High（カメラの直近・背後のプレイヤーなど）
+// ・段階が下がるのはしきい値を (1 - hysteresis) 倍下回ったとき
+//   （境目でフレームごとに行き来しないように）
+//-------------------------------------------------------------
+struct SignificanceSettings
+{
+    bool  enabled       = true;     // false なら全 Actor が High
+    float nearDistance  = 10.0f;
+    float highSize      = 0.15f;    // これ以上なら High
+    float mediumSize    = 0.05f;    // これ以上なら Medium
+    float lowSize       = 0.01f;    // これ以上なら Low（未満は Dormant）
+    float hiddenWeight  = 0.25f;
+    float hysteresis    = 0.2f;
+    float defaultRadius = 1.0f;     // BoundingVolumeComponent が無い Actor の半径（スケール前）
+};
+
+//-------------------------------------------------------------
+// SignificanceManager
+// ・Actor の更新前に 1 回だけ全 Actor を見て、距離・画面上の大きさ・
+//   視錐台の内外から重要度を決める（結果は Actor::GetSignificance()）
+// ・各サブシステムは GetPolicy(actor->GetSignificance()) を見て間引く
+//   更新のタイミングは IsUpdateFrame で Actor ごとにずらす
+// ・カメラは Renderer の現在のビュー／射影行列（前フレームに設定されたもの）
+//-------------------------------------------------------------
+class SignificanceManager
+{
+public:
+    SignificanceManager();
+
+    void SetSettings(const SignificanceSettings& settings) { mSettings = settings; }
+    const SignificanceSettings& GetSettings() const { return mSettings; }
+    void SetEnabled(bool enable) { mSettings.enabled = enable; }
+    bool IsEnabled() const { return mSettings.enabled; }
+
+    // 段階ごとの間引き方
+    void SetPolicy(Significance s, const SignificancePolicy& policy) { mPolicies[static_cast<int>(s)] = policy; }
+    const SignificancePolicy& GetPolicy(Significance s) const { return mPolicies[static_cast<int>(s)]; }
+
+    // 全 Actor の重要度を更新
+    void Update(const std::vector<std::unique_ptr<class Actor>>& actors,
+                const Matrix4& view, const Matrix4& projection);
+
+    // interval フレームに 1 回 true（Actor ごとに位相をずらす。0 なら常に false）
+    bool IsUpdateFrame(int interval, const class Actor* actor) const;
+
+    // 直近の Update で各段階になった Actor 数
+    int GetCount(Significance s) const { return mCounts[static_cast<int>(s)]; }
+
+private:
+    Significance Classify(float score, Significance current) const;
+
+    SignificanceSettings mSettings;
+    SignificancePolicy   mPolicies[NUM_SIGNIFICANCE];
+    int                  mCounts[NUM_SIGNIFICANCE];
+    uint64_t             mFrame;
+};
+
+} // namespace toy
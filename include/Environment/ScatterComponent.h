@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Graphics/VisualComponent.h"
+#include "Asset/Geometry/Polygon.h"
+#include "Utils/MathUtil.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+struct Frustum;
+
+namespace toy {
+
+//----------------------------------------------------------------------
+// ScatterComponent
+//  - 草・岩・木などの大量配置物を、Actor を作らずに描くコンポーネント
+//  - インスタンスはワールド行列（3 列分 = 48 バイト）だけを持ち、
+//    XZ の格子セルに振り分けて保持する
+//      ・カリングはセル単位（セルの AABB とフラスタム）
+//      ・LOD はインスタンスごとにカメラ距離で選ぶ
+//        （最遠の LOD は ImpostorAtlas の板ポリにもできる）
+//      ・LOD ごと・サブメッシュごとに 1 回の glDrawElementsInstanced
+//  - フェード距離の手前からディザで消していく（半透明ソート不要）
+//  - 品質設定（Renderer::SetScatterQuality）で密度と距離を縮められる
+//      ・セル内のインスタンスは追加時にシャッフル済みなので、
+//        密度を下げるときは先頭から一定割合だけ描けばよい
+//
+//  配置：インスタンスはワールド座標（Actor の Transform は反映しない）
+//----------------------------------------------------------------------
+class ScatterComponent : public VisualComponent
+{
+public:
+    static const int kMaxLODs = 4;
+
+    ScatterComponent(class Actor* owner, int drawOrder = 100);
+    ~ScatterComponent();
+
+    // セルの 1 辺（インスタンス追加前に設定する）
+    void SetCellSize(float size);
+
+    // LOD メッシュ（lod = 0 が最も近い）
+    //  maxDistance : この LOD を使う最大距離（これを超えたら次の LOD）
+    void SetLODMesh(int lod, std::shared_ptr<class Mesh> mesh, float maxDistance);
+
+    // LOD をインポスターにする（影には描かない）
+    void SetLODImpostor(int lod, std::shared_ptr<class ImpostorAtlas> impostor, float maxDistance);
+
+    // フェード（start から消え始め、end で完全に消える）
+    void SetFadeRange(float start, float end);
+
+    //------------------------------------------------------------------
+    // インスタンス追加
+    //------------------------------------------------------------------
+    void AddInstance(const Vector3& pos, float yaw, float scale);
+    void AddInstance(const Matrix4& world);
+
+    // min〜max の XZ 範囲にランダム配置（ground があれば地表に置く）
+    void ScatterRandom(const Vector3& min, const Vector3& max, int count,
+                       float minScale, float maxScale, unsigned int seed,
+                       const class HeightField* ground = nullptr);
+
+    void ClearInstances();
+
+    size_t GetInstanceCount() const { return mInstanceCount; }
+
+    // 直近の描画パスで描いたインスタンス数（デバッグ用）
+    unsigned int GetDrawnInstanceCount() const { return mDrawnCount; }
+
+    void Draw() override;
+    void DrawShadow() override;
+
+private:
+    // インスタンス（ワールド行列の第 0〜2 列、w にそれぞれ平行移動）
+    struct ScatterInstance
+    {
+        float col[3][4];
+    };
+
+    struct ScatterCell
+    {
+        Cube  bounds;       // インスタンス原点の範囲
+        float maxScale;     // メッシュ半径に掛けて bounds を広げる
+        std::vector<ScatterInstance> instances;
+    };
+
+    struct ScatterLOD
+    {
+        std::shared_ptr<class Mesh> mesh;
+        std::shared_ptr<class ImpostorAtlas> impostor;
+        float maxDistance = 0.0f;
+        float radius      = 0.0f;   // メッシュ原点からの最大距離
+        std::vector<std::unique_ptr<class VertexArray>> instanceVAs;
+    };
+
+    // 描画対象を LOD ごとに集めてインスタンスバッファへ転送
+    //  戻り値：描くインスタンスの総数
+    size_t GatherInstances(const Frustum& frustum, const Vector3& camPos);
+
+    // LOD ごとのインスタンス描画（シェーダは bind 済み）
+    //  impostors : true ならインポスターの LOD だけ、false ならメッシュの LOD だけ
+    //  depthOnly : 位置とインスタンス属性だけの VAO で描く（影用）
+    void DrawLODs(class Shader* shader, bool impostors, bool bindMaterial, bool depthOnly = false);
+
+    // LOD 設定の共通処理（添字チェックと VAO の作り直し）
+    ScatterLOD* ResetLOD(int lod, float maxDistance);
+    void UpdateLODBounds();
+
+    ScatterCell& GetCell(const Vector3& pos);
+    void EnsureInstanceBuffer();
+
+    float mCellSize;
+    float mFadeStart;
+    float mFadeEnd;
+
+    std::vector<ScatterCell>                  mCells;
+    std::unordered_map<uint64_t, size_t>      mCellIndex;
+    size_t                                    mInstanceCount;
+    float                                     mMaxRadius;
+
+    ScatterLOD mLODs[kMaxLODs];
+    int        mNumLODs;
+
+    // 追加時のシャッフル用
+    std::minstd_rand mRandom;
+
+    // ストリーミング用インスタンスバッファ
+    unsigned int mInstanceBuffer;
+    size_t       mInstanceCapacity;    // バイト数
+    std::vector<ScatterInstance> mStaging[kMaxLODs];
+    unsigned int mDrawnCount;
+};
+
+} // namespace toy
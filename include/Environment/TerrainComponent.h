@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Graphics/VisualComponent.h"
+#include "Utils/MathUtil.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Frustum;
+
+namespace toy {
+
+//----------------------------------------------------------------------
+// TerrainComponent
+//  - 16bit ハイトマップから地形を描画するコンポーネント
+//  - 地形を四分木のチャンクに分け、カメラからの距離で LOD を選ぶ（CDLOD）
+//      ・全チャンクで 1 つの格子メッシュ（mGridDim x mGridDim セル）を共有
+//      ・チャンクのサイズが LOD 1 段ごとに 2 倍 → 遠いほど粗い
+//      ・LOD 境界の手前で頂点をモーフィングし、段差・T 字の継ぎ目を出さない
+//  - チャンク単位でフラスタムカリング（Actor の BoundingVolume は不要）
+//  - 高さは頂点シェーダで R16 テクスチャから引く（Terrain.vert）
+//  - 同じ HeightField を PhysWorld に登録し、地面判定にも使う
+//
+//  配置：Actor の位置を地形の中心（XZ）と高さ 0 の Y にする
+//        （回転・スケールは反映しない）
+//  影  ：受けるのみ（シャドウマップへは描かない）
+//----------------------------------------------------------------------
+class TerrainComponent : public VisualComponent
+{
+public:
+    TerrainComponent(class Actor* owner, int drawOrder = 50);
+    ~TerrainComponent();
+
+    // ハイトマップ読み込み（AssetsPath 基準、ヘッダなし 16bit LE）
+    //  width / depth : サンプル数
+    //  cellSize      : サンプル間隔（ワールド単位）
+    //  heightScale   : サンプル値 65535 のときの高さ
+    bool LoadHeightMap(const std::string& fileName,
+                       int width, int depth,
+                       float cellSize, float heightScale);
+
+    // LOD 設定（読み込み後に変えた場合は四分木を作り直す）
+    //  gridDim   : チャンク 1 辺のセル数（2 のべき乗に丸める）
+    //  lodLevels : LOD の段数（最上段のチャンクが四分木の根）
+    //  lod0Range : 最も細かい LOD を使う距離（以降 1 段ごとに 2 倍）
+    void SetLODSettings(int gridDim, int lodLevels, float lod0Range);
+
+    // テクスチャ 1 回分のワールド長
+    void SetTextureTiling(float length) { mTexTiling = length; }
+
+    // 地表テクスチャ（マテリアルの DiffuseMap にも設定）
+    void SetTexture(std::shared_ptr<class Texture> tex) override;
+
+    // マテリアル（色・スペキュラー）
+    std::shared_ptr<class Material> GetMaterial() const { return mMaterial; }
+
+    void Draw() override;
+
+    // 地表の高さ（範囲外は端の値）
+    float GetHeightAt(float x, float z) const;
+
+    std::shared_ptr<class HeightField> GetHeightField() const { return mHeightField; }
+
+    // 直近フレームに描いたチャンク数（デバッグ用）
+    unsigned int GetDrawnChunkCount() const { return static_cast<unsigned int>(mSelected.size()); }
+
+private:
+    //------------------------------------------------------------------
+    // 四分木ノード（XZ の正方形と、その範囲の高さの最小／最大）
+    //------------------------------------------------------------------
+    struct TerrainNode
+    {
+        float x, z;         // 最小 XZ 角
+        float size;         // 1 辺の長さ
+        float minY, maxY;
+        int   child[4];     // 子ノードの添字（地形外なら -1）
+    };
+
+    // 今フレーム描くチャンク
+    struct SelectedChunk
+    {
+        int   node;
+        int   level;
+        float distSq;       // 手前から描くためのソートキー
+    };
+
+    // 共有格子メッシュ（0〜1 の XZ）
+    void CreateGridMesh();
+
+    // 四分木と LOD 距離の構築
+    void BuildQuadTree();
+    int  BuildNode(float x, float z, float size, int level);
+
+    // CDLOD のノード選択
+    //  false : このノードは level の距離外（親の LOD で描くべき）
+    bool SelectNode(int index, int level, const Vector3& camPos, const Frustum& frustum);
+    void AddChunk(int index, int level, const Vector3& camPos, const Frustum& frustum);
+
+    struct Cube GetNodeBox(const TerrainNode& node) const;
+
+    std::shared_ptr<class HeightField> mHeightField;
+    std::shared_ptr<class Texture>     mHeightMap;
+    std::shared_ptr<class Material>    mMaterial;
+    std::shared_ptr<class VertexArray> mGridVAO;
+
+    int   mGridDim;
+    int   mLODLevels;
+    float mLOD0Range;
+    float mTexTiling;
+
+    std::vector<TerrainNode>   mNodes;
+    std::vector<int>           mRoots;
+    std::vector<float>         mLODRanges;     // LOD ごとの使用距離
+    std::vector<float>         mMorphStarts;   // LOD ごとのモーフ開始距離
+    std::vector<SelectedChunk> mSelected;
+};
+
+} // namespace toy
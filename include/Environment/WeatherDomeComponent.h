@@ -1,9 +1,27 @@
 #pragma once
 #include "Environment/SkyDomeComponent.h"
 #include "Environment/WeatherManager.h"
+#include "glad/glad.h"
+#include <cstdint>
 
 namespace toy {
 
+//----------------------------------------------
+// スカイキャッシュ
+//   Off       : 毎フレーム WeatherDome.frag で全画素を計算（従来どおり）
+//   OnChange  : 時刻・太陽方向・天気がしきい値を超えて変わった時だけ
+//               キューブマップ 6 面を描き直す
+//   Amortized : 毎フレーム 1 面ずつ描き直す（天気の切り替え時は 6 面まとめて）
+//   キャッシュ中の背景はキューブマップを 1 回引くだけ
+//   ※ STORM は雷のフラッシュが毎フレーム変わるので、キャッシュせず直接描く
+//----------------------------------------------
+enum class SkyCacheMode
+{
+    Off,
+    OnChange,
+    Amortized,
+};
+
 //==============================================
 // 時間帯・天候に応じてスカイドームを描画する派生クラス
 //   └ SkyDomeComponent は基底の "空 VAO / Shader" 管理だけ担当
@@ -12,6 +30,7 @@ class WeatherDomeComponent : public SkyDomeComponent
 {
 public:
     WeatherDomeComponent(class Actor* a);
+    ~WeatherDomeComponent();
     
     // スカイドーム描画
     void Draw() override;
@@ -29,6 +48,24 @@ public:
     WeatherType GetWeatherType() const { return mWeatherType; }
     void SetWeatherType(WeatherType weather) { mWeatherType = weather; }
     
+    // スカイキャッシュ（resolution は 1 面の辺の長さ）
+    void SetSkyCache(SkyCacheMode mode, int resolution = 128);
+    SkyCacheMode GetSkyCacheMode() const { return mCacheMode; }
+    
+    // 描き直す条件（OnChange）
+    //   timeOfDay      : 時刻（0〜1）の変化量
+    //   sunAngle       : 太陽方向の変化（度）
+    //   refreshSeconds : 変化が無くてもこの秒数で描き直す（雲の流れ用、0 なら描き直さない）
+    void SetSkyCacheThreshold(float timeOfDay, float sunAngle, float refreshSeconds);
+    
+    // キューブマップの平均色を環境光に混ぜる（weight : 0 で従来の環境光、1 で空の色のみ）
+    //   キャッシュの 6 面が揃うたびに最小ミップを読み戻して求める
+    void SetSkyAmbient(bool enable, float weight = 0.5f);
+    
+    // キャッシュのキューブマップ（RGB16F、ミップあり。Off の間は 0）
+    GLuint GetSkyCubeMap() const { return mSkyCube; }
+    const Vector3& GetSkyAmbientColor() const { return mSkyAmbientColor; }
+    
 private:
     //==============================================
     // 基本状態
@@ -63,6 +100,42 @@ private:
 
     // 時間帯による空色
     Vector3 GetSkyColor(float time);
+    
+    //==============================================
+    // スカイキャッシュ
+    //==============================================
+    SkyCacheMode mCacheMode;
+    int          mCacheSize;
+    GLuint       mSkyCube;
+    GLuint       mCaptureFBO;
+    std::shared_ptr<class Shader> mCaptureShader;   // 1 面分を WeatherDome.frag で描く
+    std::shared_ptr<class Shader> mCubeShader;      // キューブマップを引くだけ
+    
+    bool        mIsCacheValid;
+    int         mNextFace;          // Amortized で次に描く面
+    float       mCachedTime;        // 最後に描き直した時の状態
+    Vector3     mCachedSunDir;
+    WeatherType mCachedWeather;
+    uint64_t    mCachedTicks;
+    
+    float mTimeThreshold;
+    float mSunCosThreshold;
+    float mRefreshSeconds;
+    
+    bool    mIsSkyAmbient;
+    float   mSkyAmbientWeight;
+    Vector3 mSkyAmbientColor;
+    bool    mHasSkyAmbient;
+    
+    // 空のシェーダ共通 uniform
+    void SetSkyUniforms(class Shader* shader);
+    
+    // キャッシュの作成／破棄と更新
+    bool CreateSkyCache();
+    void DestroySkyCache();
+    void UpdateSkyCache();
+    void RenderCacheFaces(int first, int count);
+    void ReadSkyAmbient();
 };
 
 } // namespace toy
@@ -1,5 +1,7 @@
 #pragma once
 #include "Graphics/VisualComponent.h"
+#include "glad/glad.h"
+#include <memory>
 
 namespace toy {
 
@@ -11,6 +13,8 @@ namespace toy {
 //
 // ※ WeatherManager から数値をセットされ、Draw() で強さに応じて描画。
 // ※ SkyDome（空・太陽）とは独立しており、画面へのオーバーレイ担当。
+// ※ Renderer::GetOverlayScale() が 1 未満なら縮小バッファへ描き、
+//    シーンの深度を見ながら画面へ拡大合成する（WeatherUpsample.frag）。
 //======================================================================
 class WeatherOverlayComponent : public VisualComponent
 {
@@ -18,6 +22,7 @@ public:
     WeatherOverlayComponent(class Actor* owner,
                             int drawOrder = 100,
                             VisualLayer layer = VisualLayer::OverlayScreen);
+    ~WeatherOverlayComponent();
 
     // 画面全体のオーバーレイ描画
     void Draw() override;
@@ -27,6 +32,12 @@ public:
     void SetFogAmount  (const float amt) { mFogAmount  = amt; }
     void SetSnowAmout  (const float amt) { mSnowAmount = amt; }
 
+    // どれかのエフェクトが出ているか（シェーダ側も 0.01 以下は無視する）
+    bool IsActive() const { return mRainAmount > 0.01f || mFogAmount > 0.01f || mSnowAmount > 0.01f; }
+
+    // 描くフレームだけ、縮小合成用にシーンの深度を要求する
+    bool NeedsSceneDepth() const override { return IsActive(); }
+
 private:
     //------ 各エフェクトの強度（0.0〜1.0） ------
     float mRainAmount;   // 雨（雨粒の量・密度）
@@ -36,6 +47,22 @@ private:
     //------ 描画に使用するスクリーンサイズ ------
     float mScreenWidth;
     float mScreenHeight;
+    
+    //------ 縮小オーバーレイ ------
+    std::shared_ptr<class Shader> mUpsampleShader;
+    GLuint mLowResFBO;
+    GLuint mLowResTexture;
+    int    mLowResWidth;
+    int    mLowResHeight;
+    
+    // WeatherScreen.frag の全画面描画（描画先・ステートは呼び出し側）
+    void DrawOverlay(float width, float height);
+    
+    // 縮小バッファへ描いて拡大合成（できなければ false）
+    bool DrawReduced(int width, int height);
+    
+    bool ResizeLowRes(int width, int height);
+    void DestroyLowRes();
 };
 
 } // namespace toy
@@ -1,6 +1,7 @@
 // ParticleComponent.h
 #pragma once
 #include "Graphics/VisualComponent.h"
+#include <cstdint>
 #include <vector>
 
 namespace toy {
@@ -9,6 +10,7 @@ namespace toy {
 // パーティクル描画コンポーネント
 // - Sprite（テクスチャ）を複数生成してパーティクル風に描画する
 // - 加算／通常ブレンドの切り替え
+//   （通常ブレンドのときは粒を奥から手前へ並べ替えて描く）
 // - 雨・火花・煙などの簡易表現に利用
 //======================================================================
 class ParticleComponent : public VisualComponent
@@ -94,10 +96,14 @@ private:
     //==================================================================
     void GenerateParts();
     
+    //==================================================================
+    // 通常ブレンド用：可視パーティクルを奥から手前へ並べる（内部用）
+    //==================================================================
+    void SortParts(const Matrix4& worldView);
+    
     //==================================================================
     // メンバ変数
     //==================================================================
-    std::shared_ptr<class Texture> mTexture;   // パーティクル用テクスチャ
     Vector3 mPosition;                         // 発生位置
     std::vector<Particle> mParts;              // 生成済みパーティクル一覧
     
@@ -110,7 +116,16 @@ private:
     float mPartSpeed;                          // 速度係数
     
     ParticleMode mParticleMode;                // モード（挙動）
-    bool mIsBlendAdd;                          // 加算合成かどうか
+    
+    // 重要度で間引いた分（次の更新でまとめて進める）
+    float mPendingTime;
+    int   mPendingFrames;
+    
+    // 奥行きソートの作業領域（SortParts）
+    std::vector<uint32_t> mVisibleParts;       // 可視パーティクルの添字
+    std::vector<uint32_t> mSortKeys;
+    std::vector<uint32_t> mSortOrder;
+    std::vector<uint32_t> mSortScratch;
 };
 
 } // namespace toy
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+#include <memory>
+#include <string>
+
+namespace toy {
+
+//------------------------------------------------------------
+// ImpostorBakeSettings
+//   ・framesPerSide   : アトラス 1 辺のフレーム数 N（N x N 方向から撮る）
+//   ・frameResolution : 1 フレームのピクセル数（1 辺）
+//   ・hemisphere      : true なら上半球だけ（木・建物など下から見ない物）
+//------------------------------------------------------------
+struct ImpostorBakeSettings
+{
+    int  framesPerSide   = 8;
+    int  frameResolution = 128;
+    bool hemisphere      = true;
+};
+
+//------------------------------------------------------------
+// ImpostorAtlas
+//   ・遠景用の八面体インポスター
+//   ・メッシュを八面体マップ上の N x N 方向から正射影で撮り、
+//       アルベド + カバレッジ（RGBA8）
+//       法線 + 奥行き        （RGBA8）
+//     の 2 枚のアトラスにまとめる
+//   ・ロード時に Bake するか、SaveCache したファイルを LoadCache する
+//   ・描画は Billboard.vert（USE_IMPOSTOR）+ Impostor.frag
+//     （ImpostorComponent / ScatterComponent から使う）
+//   ・スキンメッシュはバインドポーズで撮る
+//------------------------------------------------------------
+class ImpostorAtlas
+{
+public:
+    ImpostorAtlas();
+
+    // メッシュからアトラスを生成（GL コンテキストが必要）
+    bool Bake(class Renderer* renderer,
+              std::shared_ptr<class Mesh> mesh,
+              const ImpostorBakeSettings& settings = ImpostorBakeSettings());
+
+    // キャッシュファイル（独自バイナリ）の読み書き
+    bool SaveCache(const std::string& filePath) const;
+    bool LoadCache(const std::string& filePath);
+
+    bool IsValid() const { return mAlbedo != nullptr; }
+
+    // 描画用 uniform とアトラスを設定（Impostor シェーダを bind 済みであること）
+    //   アルベドはユニット 0、法線 + 奥行きは kNormalDepthUnit
+    void Apply(class Shader* shader) const;
+
+    // 中心 (0,0) の 1x1 四角形（位置・法線・UV が別バッファ、インスタンス化可能）
+    std::shared_ptr<class VertexArray> GetQuad() const { return mQuad; }
+
+    // ベイク時の外接球（メッシュのローカル座標）
+    const Vector3& GetCenter() const { return mCenter; }
+    float GetRadius() const { return mRadius; }
+
+    int  GetFramesPerSide() const { return mFramesPerSide; }
+    bool IsHemisphere()     const { return mIsHemisphere; }
+
+    std::shared_ptr<class Texture> GetAlbedo()      const { return mAlbedo; }
+    std::shared_ptr<class Texture> GetNormalDepth() const { return mNormalDepth; }
+
+    static const int kNormalDepthUnit = 2;
+
+private:
+    // フレーム (x, y) の撮影方向（中心 → カメラ）
+    Vector3 GetFrameDirection(int x, int y) const;
+
+    void CreateQuad();
+
+    std::shared_ptr<class Texture>     mAlbedo;
+    std::shared_ptr<class Texture>     mNormalDepth;
+    std::shared_ptr<class VertexArray> mQuad;
+
+    Vector3 mCenter;
+    float   mRadius;
+    int     mFramesPerSide;
+    int     mFrameResolution;
+    bool    mIsHemisphere;
+};
+
+} // namespace toy
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Graphics/Mesh/MeshComponent.h"
+#include <memory>
+
+namespace toy {
+
+//------------------------------------------------------------
+// ImpostorComponent
+//   ・遠くでは八面体インポスター（ImpostorAtlas）に切り替わる MeshComponent
+//   ・カメラからの距離が SetImpostor の distance を超えたら、
+//     メッシュの代わりにカメラへ向けた板ポリ 1 枚を描く
+//     （アトラスの近い 4 方向をブレンド、法線でライティング）
+//   ・近距離・影は通常の MeshComponent と同じ
+//------------------------------------------------------------
+class ImpostorComponent : public MeshComponent
+{
+public:
+    ImpostorComponent(class Actor* a, int drawOrder = 100);
+    ~ImpostorComponent();
+
+    // インポスターと切り替え距離（atlas が無効ならメッシュのまま）
+    void SetImpostor(std::shared_ptr<class ImpostorAtlas> atlas, float distance);
+    void SetImpostorDistance(float distance) { mImpostorDistance = distance; }
+    float GetImpostorDistance() const { return mImpostorDistance; }
+
+    std::shared_ptr<class ImpostorAtlas> GetImpostor() const { return mImpostor; }
+
+    void Draw() override;
+
+    // インポスター描画中はキューに載せず Draw() に回す
+    bool SubmitDrawItems(MeshDrawQueue& queue) override;
+
+private:
+    // 今フレームはインポスターで描くか
+    bool UseImpostor() const;
+    void DrawImpostor();
+
+    std::shared_ptr<class ImpostorAtlas> mImpostor;
+    float mImpostorDistance;
+};
+
+} // namespace toy
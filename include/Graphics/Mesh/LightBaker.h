@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace toy {
+
+//------------------------------------------------------------
+// LightBakeSettings
+//   ・sunDirection : 光の向き（ライト → シーン）。焼いた後に太陽が動くと合わなくなる
+//   ・sunSamples / sunAngle : 太陽の円盤（見かけの半径・度）内で散らす本数（半影）
+//   ・aoSamples / aoDistance : AO の半球サンプル数と、遮蔽とみなす距離
+//   ・rayBias   : レイの始点を法線方向へ浮かせる量（自己遮蔽対策）
+//   ・threads   : 0 なら全コア
+//------------------------------------------------------------
+struct LightBakeSettings
+{
+    Vector3      sunDirection = Vector3(0.0f, -1.0f, 0.0f);
+    int          sunSamples   = 4;
+    float        sunAngle     = 0.5f;
+    int          aoSamples    = 32;
+    float        aoDistance   = 4.0f;
+    float        rayBias      = 0.02f;
+    unsigned int threads      = 0;
+};
+
+//------------------------------------------------------------
+// LightBaker
+//   ・動かない背景メッシュの「太陽の可視率」と「AO」を CPU のレイトレースで
+//     頂点ごとに焼き、キャッシュファイルへ書き出す／読み込む
+//   ・遮蔽物は焼く対象すべての三角形（VertexArray::GetWorldPolygons）。
+//     BVH を組んで全コアで頂点を分担する
+//   ・適用したコンポーネントは USE_BAKED_LIGHTING のバリアントで描かれ、
+//     シャドウマップを引かない（影を落とす側には引き続き参加する）
+//   ・結果はキー（Actor の ID + "@" + ワールド行列のハッシュ。
+//     同じキーが複数あれば "#1" ...）で持つ。名前の無い Actor
+//     （既定の ID）でも、置き場所が同じなら登録順が変わっても取り違えない
+//     → ゲーム側は MeshComponent::SetLightBaking(true) した後に
+//        LoadCache → Apply（キャッシュが無ければ Bake → SaveCache）
+//   ・コマンドライン版は tools/LightBaker（シーン記述の JSON から焼く）
+//   ・対象外：スキンメッシュ。頂点数がキャッシュと合わないサブメッシュは適用しない
+//   ・ライトマップ（UV 展開したアトラス）ではなく頂点単位なので、
+//     細かい影を受けたい面は頂点を細かく割っておくこと
+//------------------------------------------------------------
+class LightBaker
+{
+public:
+    LightBaker();
+    ~LightBaker();
+
+    // 候補の登録（MeshComponent::SetLightBaking から呼ばれる）
+    void AddCandidate(class MeshComponent* comp);
+    void RemoveCandidate(class MeshComponent* comp);
+
+    // 結果のキー（Actor の ID + "@" + ワールド行列のハッシュ。重複の "#n" は付けない）
+    static std::string MakeKey(const std::string& actorID, const Matrix4& world);
+
+    // コンポーネントを介さずに形状を足す（コマンドライン版用）
+    void AddInstance(const std::string& key, std::shared_ptr<class Mesh> mesh, const Matrix4& world);
+
+    // 候補と追加した形状をすべて焼いて結果を保持する
+    //   戻り値：焼いた頂点数
+    size_t Bake(const LightBakeSettings& settings = LightBakeSettings());
+
+    // 結果のキャッシュ
+    bool SaveCache(const std::string& filePath) const;
+    bool LoadCache(const std::string& filePath);
+
+    // 結果を候補のコンポーネントへ適用する
+    //   戻り値：適用したコンポーネント数
+    size_t Apply();
+
+    // 適用を外して通常のシャドウマップ描画に戻す
+    void ClearApplied();
+
+    // 統計（デバッグ用）
+    size_t GetResultCount() const { return mResults.size(); }
+
+private:
+    // 焼く形状（キー・メッシュ・ワールド行列）
+    struct Instance
+    {
+        std::string                 key;
+        std::shared_ptr<class Mesh> mesh;
+        Matrix4                     world;
+        class MeshComponent*        comp = nullptr;
+    };
+
+    // 候補と追加分をまとめ、キーを振る
+    std::vector<Instance> CollectInstances() const;
+
+    std::vector<class MeshComponent*> mCandidates;
+    std::vector<Instance>             mInstances;
+    std::vector<class MeshComponent*> mApplied;
+
+    // キー → サブメッシュごとの頂点データ（頂点数 x 2：太陽の可視率, AO）
+    std::unordered_map<std::string, std::vector<std::vector<float>>> mResults;
+};
+
+} // namespace toy
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "Graphics/VisualComponent.h"
+#include "Engine/Render/MeshDrawQueue.h"
+#include "Asset/Geometry/Meshlet.h"
 #include "Utils/MathUtil.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace toy {
 
@@ -11,6 +15,7 @@ namespace toy {
 //   ・3Dメッシュ（静的 / スキンメッシュ）を描画するコンポーネント
 //   ・Mesh, Shader, LightingManager などの描画リソースを保持
 //   ・各種描画モード（トゥーン / シャドウ）に対応
+//   ・状態に応じて Phong シェーダの最小バリアントを選んで描画する
 //------------------------------------------------------------
 class MeshComponent : public VisualComponent
 {
@@ -31,22 +36,64 @@ public:
     
     //--------------------------------------------------------
     // Draw()
-    //   ・通常のメッシュ描画
+    //   ・通常のメッシュ描画（このコンポーネント単体で即時描画）
+    //   ・加算ブレンド等でキューに載せない場合に使われる
     //--------------------------------------------------------
     virtual void Draw();
 
+    //--------------------------------------------------------
+    // SubmitDrawItems()
+    //   ・サブメッシュごとの描画要求を Renderer のキューへ積む
+    //   ・キュー側でシェーダ／マテリアル順にソートして描かれる
+    //--------------------------------------------------------
+    bool SubmitDrawItems(MeshDrawQueue& queue) override;
+
+    //--------------------------------------------------------
+    // SetObjectUniforms()
+    //   ・キューから呼ばれ、オブジェクト単位の uniform を設定
+    //     （ワールド行列、スキニング行列）
+    //--------------------------------------------------------
+    virtual void SetObjectUniforms(class Shader* shader, MeshDrawPass pass);
+
     //--------------------------------------------------------
     // DrawShadow()
     //   ・影描画専用（ShadowMap生成用）
     //--------------------------------------------------------
     virtual void DrawShadow();
     
+    //--------------------------------------------------------
+    // CollectOccluder()
+    //   ・オクルージョンカリング用の遮蔽物形状を積む
+    //--------------------------------------------------------
+    void CollectOccluder(class OcclusionCuller& culler) override;
+    
     //--------------------------------------------------------
     // Mesh / Texture 設定
     //--------------------------------------------------------
-    virtual void SetMesh(std::shared_ptr<class Mesh> m) { mMesh = m; }
+    virtual void SetMesh(std::shared_ptr<class Mesh> m) { mMesh = m; mBakedArrays.clear(); }
+    std::shared_ptr<class Mesh> GetMesh() const { return mMesh; }
     void SetTextureIndex(unsigned int index) { mTextureIndex = index; }
 
+    //--------------------------------------------------------
+    // 静的バッチの対象にする（動かない背景物用）
+    //   Renderer の StaticBatcher::Build でまとめられると非表示になり、
+    //   以後の移動・メッシュ変更は反映されない（Clear で元に戻る）
+    //--------------------------------------------------------
+    void SetStaticBatching(bool enable);
+    bool IsStaticBatching() const { return mIsStaticBatching; }
+
+    //--------------------------------------------------------
+    // 焼き込みライティングの対象にする（動かない背景物用）
+    //   Renderer の LightBaker で焼いた値（太陽の可視率・AO）を適用すると、
+    //   シャドウマップを引かないバリアントで描かれる（影は落とし続ける）
+    //   bakedLighting : サブメッシュごとに 2 * 頂点数
+    //--------------------------------------------------------
+    void SetLightBaking(bool enable);
+    bool IsLightBaking() const { return mIsLightBaking; }
+    void SetBakedLighting(const std::vector<std::vector<float>>& bakedLighting);
+    void ClearBakedLighting();
+    bool HasBakedLighting() const { return !mBakedArrays.empty(); }
+
     //--------------------------------------------------------
     // Skeletal / Static メッシュ状態
     //--------------------------------------------------------
@@ -72,6 +119,31 @@ public:
     virtual void SetAnimID(unsigned int animID, bool mode) {}
     
 protected:
+    //--------------------------------------------------------
+    // シェーダバリアント選択
+    //   ・スキン / トゥーン / 影 の状態から ShaderFeature を決め、
+    //     変化した時だけ Renderer のキャッシュから引き直す
+    //--------------------------------------------------------
+    void SelectShaders();
+
+    // 単色描画（輪郭・OverrideColor マテリアル）用バリアントを取得
+    std::shared_ptr<class Shader> GetOverrideShader();
+
+    // サブメッシュをキューへ積む（Draw / SubmitDrawItems 共通）
+    void CollectDrawItems(MeshDrawQueue& queue);
+
+    // スキニング等、派生クラス固有の uniform を設定
+    //   （通常メッシュでは何もしない）
+    virtual void SetSkinningUniforms(class Shader* shader) {}
+
+    // このフレームのスキニングが前処理で済んでいるか
+    //   true ならシェーダは USE_SKINNING なしのバリアントを使う
+    virtual bool IsPreSkinned() const { return false; }
+
+    // 実際に描画する VertexArray（前処理済みならスキニング結果の受け皿）
+    //   焼き込みライティングがあれば、その値を持つ VertexArray
+    virtual class VertexArray* GetDrawVertexArray(size_t index, class VertexArray* source);
+
     //--------------------------------------------------------
     // 保持している描画リソース
     //--------------------------------------------------------
@@ -84,14 +156,27 @@ protected:
 
     // ライティング・シェーダー
     std::shared_ptr<class LightingManager> mLightingManger;
-    std::shared_ptr<class Shader> mShader;         // 通常描画用シェーダ
+    std::shared_ptr<class Shader> mShader;         // 通常描画用シェーダ（選択中のバリアント）
     std::shared_ptr<class Shader> mShadowShader;   // シャドウマップ描画用シェーダ
+    uint32_t mShadowFeatures;                      // mShadowShader の ShaderFeature ビット
+    std::shared_ptr<class Shader> mOverrideShader; // 単色描画用バリアント（必要時のみ取得）
+    uint32_t mShaderFeatures;                      // mShader の ShaderFeature ビット
 
     //--------------------------------------------------------
     // トゥーン（輪郭）描画設定
     //--------------------------------------------------------
     bool  mIsToon;          // true なら toon + Outline
     float mContourFactor;   // 1.05f など。輪郭スケール係数
+
+    // 静的バッチの対象か
+    bool mIsStaticBatching;
+
+    // 焼き込みライティングの対象か／適用済みの VertexArray（サブメッシュごと）
+    bool mIsLightBaking;
+    std::vector<std::shared_ptr<class VertexArray>> mBakedArrays;
+
+    // メッシュレットのカリング結果（サブメッシュごと。次の収集まで有効）
+    std::vector<MeshletDrawRanges> mMeshletRanges;
 };
 
 } // namespace toy
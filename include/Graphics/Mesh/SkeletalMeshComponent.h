@@ -5,8 +5,8 @@
 #include <vector>
 #include <memory>
 
-// スキニング用ボーンの最大数（Shader側と合わせる）
-const size_t MAX_SKELETON_BONES = 96;
+// スキニング用ボーンの最大数（BonePaletteBuffer::kMaxBones / Shader側と合わせる）
+const size_t MAX_SKELETON_BONES = 256;
 
 namespace toy {
 
@@ -27,19 +27,14 @@ public:
     SkeletalMeshComponent(class Actor* a,
                           int drawOrder = 100,
                           VisualLayer layer = VisualLayer::Effect3D);
-    
-    //--------------------------------------------------------
-    // 描画
-    //  - MeshComponent::Draw を拡張して
-    //    スキニング用のボーン行列をシェーダへ送る
-    //--------------------------------------------------------
-    void Draw() override;
-    void DrawShadow() override;
+    ~SkeletalMeshComponent();
     
     //--------------------------------------------------------
     // Update
     //  - AnimationPlayer の再生時間を進めて
     //    ボーン姿勢を更新
+    //  - Actor の重要度が低い間は数フレームに 1 回
+    //    （間の経過時間はまとめて進める）
     //--------------------------------------------------------
     void Update(float deltaTime) override;
     
@@ -65,12 +60,55 @@ public:
     //--------------------------------------------------------
     class AnimationPlayer* GetAnimPlayer() { return mAnimPlayer.get(); }
     
+    //--------------------------------------------------------
+    // ボーンパレット（Renderer::UpdateBonePalettes から呼ばれる）
+    //  - GetPaletteBoneCount : このフレームに書き込むボーン数（0 なら書かない）
+    //  - WritePalette        : 共有 UBO へ書き込み、オフセットを保持
+    //  - InvalidatePalette   : このフレームはパレットなし
+    //--------------------------------------------------------
+    unsigned int GetPaletteBoneCount() const;
+    void WritePalette(class BonePaletteBuffer& buffer);
+    void InvalidatePalette() { mPaletteOffset = -1; }
+    
+    //--------------------------------------------------------
+    // スキニング前処理（パレット書き込みの直後に呼ばれる）
+    //  - stage が nullptr なら今フレームはシェーダ内スキニング
+    //--------------------------------------------------------
+    void PreSkin(class SkinningStage* stage);
+    
+protected:
+    //--------------------------------------------------------
+    // スキニング用ボーン行列(BonePalette ブロック)をバインドする
+    //  - 描画自体は MeshComponent::Draw / DrawShadow を共用し、
+    //    USE_SKINNING バリアントが選ばれる
+    //  - 行列はフレーム頭に書き込み済みなのでオフセットを指すだけ
+    //--------------------------------------------------------
+    void SetSkinningUniforms(class Shader* shader) override;
+    
+    // 前処理済みなら受け皿の VertexArray を描く
+    bool IsPreSkinned() const override { return mIsPreSkinned; }
+    class VertexArray* GetDrawVertexArray(size_t index, class VertexArray* source) override;
+    
 private:
     // 現在のアニメーション再生時間（秒）
     float mAnimTime;
     
+    // 重要度で間引いた分の経過時間（次の姿勢計算でまとめて進める）
+    float mPendingAnimTime;
+    
+    // 前回のスキニングから姿勢が変わったか（変わっていなければ受け皿を使い回す）
+    bool mIsPoseDirty;
+    bool mIsSkinCached;
+    
     // アニメーション再生制御クラス
     std::unique_ptr<class AnimationPlayer> mAnimPlayer;
+    
+    // 共有パレット UBO 上のオフセット（-1 = 今フレームは未書き込み）
+    long mPaletteOffset;
+    
+    // スキニング結果の受け皿（サブメッシュごと、前処理を使う時だけ生成）
+    std::vector<std::unique_ptr<class VertexArray>> mSkinnedVAs;
+    bool mIsPreSkinned;
 };
 
 } // namespace toy
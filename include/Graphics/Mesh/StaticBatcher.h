@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace toy {
+
+//------------------------------------------------------------
+// StaticBatchSettings
+//   ・clusterSize : まとめる範囲（XZ の格子の 1 辺）
+//                   大きいほど描画回数は減るが、フラスタムカリングが粗くなる
+//------------------------------------------------------------
+struct StaticBatchSettings
+{
+    float clusterSize = 32.0f;
+};
+
+//------------------------------------------------------------
+// StaticBatcher
+//   ・SetStaticBatching(true) にした MeshComponent を、レベル読み込み後に
+//     [格子セル][マテリアル] ごとに 1 つの頂点配列へまとめる
+//   ・頂点はワールド座標へ変換済み（バッチ用 Actor は原点・スケール 1）
+//     → シェーダの変更やインスタンス化は不要で、通常の Phong で描ける
+//   ・元の頂点は GPU のバッファから読み戻す（glGetBufferSubData）
+//     同じメッシュを使うコンポーネントは 1 回だけ読む
+//   ・対象外：スキンメッシュ、トゥーン、加算ブレンド、Object3D 以外のレイヤー、
+//           焼き込みライティング適用済み（頂点ごとの値を持つため）
+//   ・影を落とすか／遮蔽物かが違うものは別のバッチにする
+//   ・まとめた元のコンポーネントは非表示にする（Clear で元に戻す）
+//------------------------------------------------------------
+class StaticBatcher
+{
+public:
+    StaticBatcher();
+    ~StaticBatcher();
+
+    // 候補の登録（MeshComponent::SetStaticBatching から呼ばれる）
+    void AddCandidate(class MeshComponent* comp);
+    void RemoveCandidate(class MeshComponent* comp);
+
+    // 候補をまとめてバッチ用 Actor を作る（既存のバッチは作り直す）
+    //   戻り値：作ったバッチ（描画単位）の数
+    size_t Build(const StaticBatchSettings& settings = StaticBatchSettings());
+
+    // バッチ用 Actor を破棄し、元のコンポーネントを表示に戻す
+    void Clear();
+
+    // 統計（デバッグ用）
+    size_t GetBatchedCount() const { return mBatchedComps.size(); }
+    size_t GetBatchCount()   const { return mBatchCount; }
+
+private:
+    // GPU から読み戻したサブメッシュ（ローカル座標）
+    struct SourceGeometry
+    {
+        std::vector<float>        positions;
+        std::vector<float>        normals;
+        std::vector<float>        uvs;
+        std::vector<unsigned int> indices;
+    };
+
+    const SourceGeometry* ReadBack(class VertexArray* va);
+
+    std::vector<class MeshComponent*> mCandidates;
+
+    // 今のバッチの状態
+    std::vector<class MeshComponent*> mBatchedComps;
+    std::vector<class Actor*>         mBatchActors;
+    size_t                            mBatchCount;
+
+    // 読み戻しのキャッシュ（Build の間だけ保持）
+    std::unordered_map<const class VertexArray*, SourceGeometry> mGeometryCache;
+};
+
+} // namespace toy
@@ -40,6 +40,7 @@ public:
     {
         mScaleWidth  = w;
         mScaleHeight = h;
+        mIsUIDirty   = true;
     }
 
     //==================================================
@@ -55,9 +56,23 @@ public:
     //
     // UI 用スプライトでは通常 true
     //==================================================
-    void SetIsTopLeft(bool b) { mIsTopLeft = b; }
+    void SetIsTopLeft(bool b) { mIsTopLeft = b; mIsUIDirty = true; }
+
+    //==================================================
+    // 保持モード UI：前回描いた矩形と今の矩形を比べる
+    //  （テクスチャ・スケール・位置・ブレンドの変化を拾う）
+    //==================================================
+    UIChange CheckUIChange(UIRect& outRect) const override;
 
 private:
+    //==================================================
+    // 画面上の配置（中心原点 / 右+ / 上+ のピクセル座標と表示サイズ）
+    //==================================================
+    void ComputePlacement(const UIScaleInfo& ui, Vector3& pos, float& width, float& height) const;
+
+    // 画面矩形（GL の左下原点ピクセル、フィルタのにじみ分 1px 広げる）
+    UIRect ComputeScreenRect() const;
+
     //==================================================
     // パラメータ
     //==================================================
@@ -76,6 +91,11 @@ private:
 
     // 左上固定（true のとき Actor 位置ではなく画面座標で描画）
     bool  mIsTopLeft;
+
+    // 保持モード UI 用：前回描いた矩形と状態
+    UIRect mLastUIRect;
+    bool   mLastIsBlendAdd;
+    bool   mIsUIDirty;
 };
 
 } // namespace toy
@@ -28,6 +28,10 @@ public:
     //  影が不要なコンポーネントはデフォルト実装（何もしない）を使う
     virtual void DrawShadow() {}
 
+    // 描画キューへの登録（Renderer がまとめてソート描画する）
+    //  キューに積んだら true。false の場合は従来どおり Draw() が呼ばれる
+    virtual bool SubmitDrawItems(class MeshDrawQueue& queue) { return false; }
+
     // 使用テクスチャの設定／取得
     virtual void SetTexture(std::shared_ptr<class Texture> tex) { mTexture = tex; }
     std::shared_ptr<class Texture> GetTexture() const { return mTexture; }
@@ -41,21 +45,47 @@ public:
     bool IsBlendAdd() const { return mIsBlendAdd; }
     
     // 描画レイヤーの設定／取得
-    void SetLayer(VisualLayer layer) { mLayer = layer; }
+    //  変更時は Renderer のレイヤー別リストへ登録し直す
+    void SetLayer(VisualLayer layer);
     VisualLayer GetLayer() const { return mLayer; }
     
     // 描画順の設定／取得（同一レイヤー内のソートに使用）
+    //  変更時は Renderer のレイヤー別リストへ登録し直す
     int GetDrawOrder() const { return mDrawOrder; }
-    void SetDrawOrder(int order) { mDrawOrder = order; }
+    void SetDrawOrder(int order);
     
     // 使用シェーダ／ライティング管理の設定
     void SetShader(std::shared_ptr<class Shader> shader) { mShader = shader; }
+    std::shared_ptr<class Shader> GetShader() const { return mShader; }
     void SetLightingManager(std::shared_ptr<LightingManager> light) { mLightingManager = light; }
     
     // シャドウ描画を行うかどうか
     bool GetEnableShadow() const { return mEnableShadow; }
     void SetEnableShadow(const bool b) { mEnableShadow = b; }
 
+    // オクルージョンカリングの遮蔽物として使うかどうか
+    //  useHull : true なら BoundingVolume の箱（12 三角形）で代用する
+    //            （壁・建物など、ほぼ箱形のものに限る）
+    void SetOccluder(bool b, bool useHull = false) { mIsOccluder = b; mIsOccluderHull = useHull; }
+    bool IsOccluder() const { return mIsOccluder; }
+
+    // 遮蔽物の三角形を OcclusionCuller へ積む
+    //  形状を持たないコンポーネントはデフォルト実装（何もしない）を使う
+    virtual void CollectOccluder(class OcclusionCuller& culler) {}
+
+    // 半透明ソート（TransparentQueue）で奥行きを測る位置（ワールド座標）
+    //  デフォルトはアクターのワールド位置
+    virtual Vector3 GetSortPosition() const;
+
+    // 保持モード UI（Renderer::SetRetainedUI）：前回キャッシュへ描いてからの変化
+    //  Rect のときは outRect に描き直す範囲（前回と今回の矩形の和）を入れる
+    //  デフォルトは「分からない」（毎フレーム全体を描き直す）
+    virtual UIChange CheckUIChange(UIRect& outRect) const { return UIChange::Full; }
+
+    // 画面オーバーレイ（OverlayScreen）：このフレーム、シーンの深度テクスチャを使うか
+    //  true のものがあるときだけ Renderer はシーンを一時バッファへ描いて深度を残す
+    virtual bool NeedsSceneDepth() const { return false; }
+
 protected:
     // メインテクスチャ
     std::shared_ptr<class Texture> mTexture;
@@ -81,6 +111,10 @@ protected:
     // シャドウマップに描画するかどうか
     bool mEnableShadow;
 
+    // オクルージョンカリングの遮蔽物かどうか（箱で代用するか）
+    bool mIsOccluder;
+    bool mIsOccluderHull;
+
     // 描画に使う頂点配列（フルスクリーンクアッドなど）
     std::shared_ptr<class VertexArray> mVertexArray;
 };
@@ -73,8 +73,8 @@ public:
     // ・sc  : 各軸ごとのスケール倍率
     void AdjustBoundingBox(const Vector3& pos, const Vector3& sc);
     
-    // デバッグ表示用ワイヤーフレーム VAO を作成
-    void CreateVArray();
+    // デバッグモード時、ボックスを DebugDraw へ積む
+    void Update(float deltaTime) override;
     
     // アクターのワールド行列更新時に呼ばれる
     // OBB の中心・軸・半径・バウンディングスフィア半径などを更新
@@ -111,9 +111,6 @@ private:
     
     // AABB から生成した 12枚のポリゴン（ローカル空間）
     std::shared_ptr<struct Polygon[]> mPolygons;
-    
-    // デバッグ表示用のワイヤーフレーム（AABB 可視化）
-    std::unique_ptr<class WireframeComponent> mWireframe;
 };
 
 } // namespace toy
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Utils/MathUtil.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace toy {
+
+//------------------------------------------------------------------------------
+// HeightField
+//------------------------------------------------------------------------------
+// ・16bit ハイトマップ（width x depth サンプルの格子）を保持する。
+// ・サンプル (ix, iz) のワールド位置は
+//     x = origin.x + ix * cellSize
+//     z = origin.z + iz * cellSize
+//     y = origin.y + sample / 65535 * heightScale
+// ・TerrainComponent の描画（高さテクスチャ）と PhysWorld の地面判定で
+//   同じデータを共有する。
+//------------------------------------------------------------------------------
+class HeightField
+{
+public:
+    HeightField();
+
+    //--------------------------------------------------------------------------
+    // 読み込み
+    // ・ヘッダなしの 16bit リトルエンディアン（.r16 / .raw）
+    //--------------------------------------------------------------------------
+    bool LoadRaw16(const std::string& filePath, int width, int depth);
+
+    // 配置（origin は格子の最小 XZ 角と高さ 0 の Y）
+    void SetPlacement(const Vector3& origin, float cellSize, float heightScale);
+
+    //--------------------------------------------------------------------------
+    // 高さ問い合わせ
+    //--------------------------------------------------------------------------
+    // XZ が格子の範囲内か
+    bool Contains(float x, float z) const;
+
+    // 双線形補間した地表の高さ（範囲外は端の値）
+    float GetHeight(float x, float z) const;
+
+    // 地表の法線（中心差分）
+    Vector3 GetNormal(float x, float z) const;
+
+    // サンプル (ix, iz) のワールド高さ（範囲外は端に丸める）
+    float GetSampleHeight(int ix, int iz) const;
+
+    // サンプル範囲 [ix0, ix1] x [iz0, iz1] の最小／最大高さ
+    void GetRangeMinMax(int ix0, int iz0, int ix1, int iz1,
+                        float& outMin, float& outMax) const;
+
+    //--------------------------------------------------------------------------
+    // ゲッター
+    //--------------------------------------------------------------------------
+    bool  IsValid()        const { return !mSamples.empty(); }
+    int   GetWidth()       const { return mWidth; }
+    int   GetDepth()       const { return mDepth; }
+    float GetCellSize()    const { return mCellSize; }
+    float GetHeightScale() const { return mHeightScale; }
+    const Vector3& GetOrigin() const { return mOrigin; }
+
+    // 格子全体のワールドサイズ
+    float GetSizeX() const { return (mWidth - 1) * mCellSize; }
+    float GetSizeZ() const { return (mDepth - 1) * mCellSize; }
+
+    // 生データ（テクスチャ転送用）
+    const std::vector<uint16_t>& GetSamples() const { return mSamples; }
+
+private:
+    std::vector<uint16_t> mSamples;   // width * depth（行 = z）
+    int     mWidth;
+    int     mDepth;
+    Vector3 mOrigin;
+    float   mCellSize;
+    float   mHeightScale;
+};
+
+} // namespace toy
@@ -21,6 +21,9 @@ public:
     // レーザー衝突判定用 Ray を返す
     Ray GetRay() const override;
     
+    // デバッグモード時、レーザーを DebugDraw へ積む
+    void Update(float deltaTime) override;
+    
     // レーザーの見た目／射程の長さ（実際の当たり判定は無限 Ray でもよい）
     void SetRayLength(float len) { mLength = len; }
     float GetRayLength() const { return mLength; }
@@ -26,7 +26,7 @@ struct MTVResult
 // ・ColliderComponent を集約し、衝突判定/押し戻し/地面判定を行う。
 // ・AABB/OBB/BoundingSphere、Polygon（地形メッシュ）を扱う。
 // ・Ray vs OBB / Ray vs Polygon もサポート。
-// ・GetNearestGroundY() は Collider（C_GROUND）と TerrainPolygon の両方を使う
+// ・GetNearestGroundY() は Collider（C_GROUND）と TerrainPolygon／HeightField を使う
 //   “ハイブリッド地面判定”。
 //------------------------------------------------------------------------------
 class PhysWorld
@@ -49,7 +49,7 @@ public:
     
     //--------------------------------------------------------------------------
     // 地面情報インターフェイス
-    // ・単純な高さ返却（TerrainPolygon のみ）
+    // ・単純な高さ返却（TerrainPolygon と HeightField）
     // ・GetNearestGroundY は Terrain と C_GROUND 両方を探索する
     //--------------------------------------------------------------------------
     float GetGroundHeightAt(const Vector3& pos) const;
@@ -60,6 +60,11 @@ public:
     // 地形ポリゴンをセット（外部メッシュから読み込む）
     void SetGroundPolygons(const std::vector<struct Polygon>& polys);
     
+    // ハイトフィールド地形をセット（TerrainComponent が登録／解除する）
+    // ・ポリゴン走査なしで XZ から直接高さを引ける
+    void SetHeightField(const class HeightField* field) { mHeightField = field; }
+    const class HeightField* GetHeightField() const { return mHeightField; }
+    
     //--------------------------------------------------------------------------
     // RayCCD / RayCast 系
     //--------------------------------------------------------------------------
@@ -140,6 +145,7 @@ private:
     //--------------------------------------------------------------------------
     std::vector<class ColliderComponent*> mColliders; // すべてのコライダー
     std::vector<struct Polygon> mTerrainPolygons;     // 静的地形メッシュ
+    const class HeightField*    mHeightField;         // ハイトフィールド地形（所有しない）
 };
 
 } // namespace toy
@@ -21,6 +21,7 @@
 #include "Engine/Runtime/InputSystem.h"
 #include "Engine/Runtime/AnimationPlayer.h"
 #include "Engine/Runtime/TimeOfDaySystem.h"
+#include "Engine/Runtime/SignificanceManager.h"
 #include "Engine/Runtime/SingleInstance.h"
 
 //======================================
@@ -28,7 +29,16 @@
 //======================================
 #include "Engine/Render/Renderer.h"
 #include "Engine/Render/Shader.h"
+#include "Engine/Render/ShaderVariantCache.h"
 #include "Engine/Render/LightingManager.h"
+#include "Engine/Render/DebugDraw.h"
+#include "Engine/Render/OcclusionCuller.h"
+#include "Engine/Render/PortalSystem.h"
+#include "Engine/Render/RenderGraph.h"
+#include "Engine/Render/FrameCapture.h"
+#include "Engine/Render/GLRecorder.h"
+#include "Engine/Render/UILayerCache.h"
+#include "Engine/Render/QualityGovernor.h"
 
 //======================================
 // Asset
@@ -50,6 +60,7 @@
 // --- Geometry Assets ---
 #include "Asset/Geometry/Bone.h"
 #include "Asset/Geometry/Mesh.h"
+#include "Asset/Geometry/Meshlet.h"
 #include "Asset/Geometry/VertexArray.h"
 #include "Asset/Geometry/Polygon.h"
 
@@ -72,8 +83,12 @@
 #include "Graphics/VisualComponent.h"
 
 // --- Mesh 系 ---
+#include "Graphics/Mesh/ImpostorAtlas.h"
+#include "Graphics/Mesh/ImpostorComponent.h"
+#include "Graphics/Mesh/LightBaker.h"
 #include "Graphics/Mesh/MeshComponent.h"
 #include "Graphics/Mesh/SkeletalMeshComponent.h"
+#include "Graphics/Mesh/StaticBatcher.h"
 
 // --- Sprite / Billboard 系 ---
 #include "Graphics/Sprite/SpriteComponent.h"
@@ -84,13 +99,14 @@
 // --- Effect 系 ---
 #include "Graphics/Effect/ParticleComponent.h"
 #include "Graphics/Effect/ShadowSpriteComponent.h"
-#include "Graphics/Effect/WireframeComponent.h"
 
 //======================================
 // Environment (Sky, Weather)
 //======================================
+#include "Environment/ScatterComponent.h"
 #include "Environment/SkyDomeComponent.h"
 #include "Environment/SkyDomeMeshGenerator.h"
+#include "Environment/TerrainComponent.h"
 #include "Environment/WeatherDomeComponent.h"
 #include "Environment/WeatherManager.h"
 #include "Environment/WeatherOverlayComponent.h"
@@ -111,6 +127,7 @@
 #include "Physics/BoundingVolumeComponent.h"
 #include "Physics/ColliderComponent.h"
 #include "Physics/GravityComponent.h"
+#include "Physics/HeightField.h"
 #include "Physics/LaserColliderComponent.h"
 #include "Physics/PhysWorld.h"
 
@@ -125,6 +142,7 @@
 //======================================
 #include "Utils/MathUtil.h"
 #include "Utils/JsonHelper.h"
+#include "Utils/RadixSort.h"
 #include "Utils/StringUtil.h"
 
 
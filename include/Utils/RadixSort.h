@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace RadixSort
+{
+//==============================================================================
+// float → 大小関係を保った uint32 キー
+//------------------------------------------------------------------------------
+// ・正の数は符号ビットを立て、負の数は全ビット反転する（IEEE754 の定番変換）
+// ・降順に並べたい場合は ~FloatToKey(f) を使う
+//==============================================================================
+inline uint32_t FloatToKey(float f)
+{
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+//==============================================================================
+// 0〜1 の値を bits ビットの整数へ量子化（範囲外は丸める）
+//==============================================================================
+inline uint32_t Quantize(float t, int bits)
+{
+    const uint32_t maxValue = (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1u);
+    if (!(t > 0.0f)) return 0;
+    if (t >= 1.0f)   return maxValue;
+    return static_cast<uint32_t>(t * static_cast<float>(maxValue));
+}
+
+//==============================================================================
+// SortIndices
+//------------------------------------------------------------------------------
+// ・keys を昇順に並べたときの添字列を order に返す（LSD 基数ソート、O(n)）
+// ・8 ビット x 4 パス。全要素が同じ桁になるパスは飛ばす
+// ・安定ソートなので、同じキーは元の順序（描画順など）を保つ
+// ・scratch は作業用（呼び出し側で使い回せばフレームごとの確保が不要）
+//==============================================================================
+inline void SortIndices(const std::vector<uint32_t>& keys,
+                        std::vector<uint32_t>& order,
+                        std::vector<uint32_t>& scratch)
+{
+    const size_t count = keys.size();
+    order.resize(count);
+    scratch.resize(count);
+    std::iota(order.begin(), order.end(), 0u);
+    if (count < 2) return;
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i)
+        {
+            ++histogram[(keys[order[i]] >> shift) & 0xFF];
+        }
+
+        // この桁が全部同じなら並べ替え不要
+        if (histogram[(keys[order[0]] >> shift) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (size_t& h : histogram)
+        {
+            size_t n = h;
+            h = offset;
+            offset += n;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t index = order[i];
+            scratch[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+        }
+        std::swap(order, scratch);
+    }
+}
+
+} // namespace RadixSort
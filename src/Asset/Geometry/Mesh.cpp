@@ -3,6 +3,7 @@
 #include "Asset/AssetManager.h"
 #include "Asset/Geometry/VertexArray.h"
 #include "Asset/Geometry/Bone.h"
+#include "Asset/Geometry/Meshlet.h"
 #include "Asset/Geometry/Polygon.h"
 #include "Asset/Material/Material.h"
 
@@ -451,7 +452,7 @@ void Mesh::CreateMeshBone(const aiMesh* m)
 //==============================================================
 // 通常メッシュ（ボーンなし）頂点バッファ生成
 //==============================================================
-void Mesh::CreateMesh(const aiMesh* m)
+void Mesh::CreateMesh(const aiMesh* m, const MeshletSettings& meshlets)
 {
     std::vector<float>         vertexBuffer;   // XYZ
     std::vector<float>         normalBuffer;   // XYZ
@@ -493,6 +494,17 @@ void Mesh::CreateMesh(const aiMesh* m)
         indexBuffer.push_back(face.mIndices[2]);
     }
 
+    // メッシュレット分割（インデックスを塊ごとに並べ替えてから VAO を作る）
+    std::unique_ptr<MeshletSet> meshletSet;
+    if (meshlets.enabled && m->mNumFaces >= meshlets.minTriangles)
+    {
+        meshletSet = std::make_unique<MeshletSet>();
+        if (!meshletSet->Build(vertexBuffer.data(), normalBuffer.data(), indexBuffer, meshlets.maxTriangles))
+        {
+            meshletSet = nullptr;
+        }
+    }
+
     // VAO を生成
     mVertexArray.push_back(
         std::make_shared<VertexArray>(
@@ -502,6 +514,10 @@ void Mesh::CreateMesh(const aiMesh* m)
             uvBuffer.data(),
             static_cast<unsigned int>(indexBuffer.size()),
             indexBuffer.data()));
+    if (meshletSet)
+    {
+        mVertexArray.back()->SetMeshlets(std::move(meshletSet));
+    }
 
     // このメッシュで使うマテリアル番号を覚えておく
     mVertexArray.back()->SetTextureID(m->mMaterialIndex);
@@ -551,7 +567,7 @@ bool Mesh::Load(const std::string& fileName,
     inv = inv.Inverse();
     MatrixAi2Gl(mGlobalInverseTransform, inv);
 
-    LoadMeshData();
+    LoadMeshData(assetMamager->GetMeshletSettings());
     LoadMaterials(assetMamager);
     LoadAnimations();
 
@@ -561,7 +577,7 @@ bool Mesh::Load(const std::string& fileName,
 //==============================================================
 // シーン中の全 aiMesh から VAO を構築
 //==============================================================
-void Mesh::LoadMeshData()
+void Mesh::LoadMeshData(const MeshletSettings& meshlets)
 {
     for (int i = 0; i < static_cast<int>(mScene->mNumMeshes); i++)
     {
@@ -573,7 +589,7 @@ void Mesh::LoadMeshData()
         }
         else
         {
-            CreateMesh(m);
+            CreateMesh(m, meshlets);
         }
     }
 }
@@ -712,6 +728,18 @@ std::shared_ptr<Material> Mesh::GetMaterial(size_t index)
     return nullptr;
 }
 
+//==============================================================
+// 手続き生成のサブメッシュ追加
+//==============================================================
+void Mesh::AddSubMesh(std::shared_ptr<VertexArray> va, std::shared_ptr<Material> material)
+{
+    if (!va) return;
+
+    va->SetTextureID(static_cast<unsigned int>(mMaterials.size()));
+    mMaterials.push_back(material);
+    mVertexArray.push_back(va);
+}
+
 //==============================================================
 // 指定アニメーションの指定時刻のボーン行列配列を計算
 // outTransforms には「ボーン数ぶん」の行列が詰められる。
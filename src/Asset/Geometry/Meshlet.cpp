@@ -0,0 +1,313 @@
+#include "Asset/Geometry/Meshlet.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace toy {
+
+namespace {
+
+// 裏向き判定をしない塊の cutoff（dot <= 長さ なので常に偽になる）
+const float kNoCone = 2.0f;
+
+// 円錐が広すぎる（面の向きがばらばら）とみなす境目
+const float kMinConeDot = 0.1f;
+
+// 10 bit x 3 のモートン符号
+uint32_t ExpandBits(uint32_t v)
+{
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+uint32_t Morton3D(float x, float y, float z)
+{
+    auto quantize = [](float t)
+    {
+        return static_cast<uint32_t>(std::min(std::max(t * 1024.0f, 0.0f), 1023.0f));
+    };
+    return (ExpandBits(quantize(x)) << 2) | (ExpandBits(quantize(y)) << 1) | ExpandBits(quantize(z));
+}
+
+// 分割中の三角形
+struct TriangleInfo
+{
+    uint32_t index;     // 元の三角形番号
+    uint32_t bucket;    // 面の向き（0〜5：±X, ±Y, ±Z）
+    uint32_t morton;
+    Vector3  normal;    // 面法線（頂点法線の側へ向けたもの）
+};
+
+} // namespace
+
+
+MeshletSet::MeshletSet()
+{
+}
+
+//-------------------------------------------
+// Build()
+//  1) 三角形ごとに面法線・重心を求め、面の向きで 6 つに分ける
+//  2) 向きごと、重心のモートン順に並べて maxTriangles ずつ切る
+//     （同じ向きで近い三角形が同じ塊になり、円錐が細くなる）
+//  3) 塊ごとに包む球と法線の円錐を求め、インデックスを並べ替える
+//-------------------------------------------
+bool MeshletSet::Build(const float* verts,
+                       const float* norms,
+                       std::vector<unsigned int>& indices,
+                       unsigned int maxTriangles)
+{
+    const size_t numTris = indices.size() / 3;
+    if (numTris == 0 || !verts) return false;
+
+    maxTriangles = std::min(std::max(maxTriangles, 16u), 256u);
+
+    auto position = [verts](unsigned int i)
+    {
+        return Vector3(verts[i * 3 + 0], verts[i * 3 + 1], verts[i * 3 + 2]);
+    };
+
+    // 重心の範囲（モートン符号の正規化用）
+    Vector3 bmin(Math::Infinity, Math::Infinity, Math::Infinity);
+    Vector3 bmax(-Math::Infinity, -Math::Infinity, -Math::Infinity);
+    std::vector<Vector3> centroids(numTris);
+    for (size_t t = 0; t < numTris; ++t)
+    {
+        Vector3 c = (position(indices[t * 3 + 0]) + position(indices[t * 3 + 1]) + position(indices[t * 3 + 2]))
+                  * (1.0f / 3.0f);
+        centroids[t] = c;
+        bmin = Vector3(std::min(bmin.x, c.x), std::min(bmin.y, c.y), std::min(bmin.z, c.z));
+        bmax = Vector3(std::max(bmax.x, c.x), std::max(bmax.y, c.y), std::max(bmax.z, c.z));
+    }
+    Vector3 extent = bmax - bmin;
+    Vector3 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                      extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                      extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+    std::vector<TriangleInfo> tris(numTris);
+    for (size_t t = 0; t < numTris; ++t)
+    {
+        unsigned int i0 = indices[t * 3 + 0];
+        unsigned int i1 = indices[t * 3 + 1];
+        unsigned int i2 = indices[t * 3 + 2];
+        Vector3 n = Vector3::Cross(position(i1) - position(i0), position(i2) - position(i0));
+
+        // 巻き順ではなく頂点法線の側を表とする（座標系の変換に左右されない）
+        if (norms)
+        {
+            Vector3 vn(norms[i0 * 3 + 0] + norms[i1 * 3 + 0] + norms[i2 * 3 + 0],
+                       norms[i0 * 3 + 1] + norms[i1 * 3 + 1] + norms[i2 * 3 + 1],
+                       norms[i0 * 3 + 2] + norms[i1 * 3 + 2] + norms[i2 * 3 + 2]);
+            if (Vector3::Dot(n, vn) < 0.0f) n = -1.0f * n;
+        }
+        if (n.Length() > Math::NearZeroEpsilon) n.Normalize();
+
+        float ax = std::fabs(n.x), ay = std::fabs(n.y), az = std::fabs(n.z);
+        uint32_t bucket = (ax >= ay && ax >= az) ? (n.x >= 0.0f ? 0 : 1)
+                        : (ay >= az)             ? (n.y >= 0.0f ? 2 : 3)
+                        :                          (n.z >= 0.0f ? 4 : 5);
+
+        Vector3 c = centroids[t] - bmin;
+        tris[t].index  = static_cast<uint32_t>(t);
+        tris[t].bucket = bucket;
+        tris[t].morton = Morton3D(c.x * invExtent.x, c.y * invExtent.y, c.z * invExtent.z);
+        tris[t].normal = n;
+    }
+
+    std::stable_sort(tris.begin(), tris.end(),
+                     [](const TriangleInfo& a, const TriangleInfo& b)
+                     {
+                         return (a.bucket != b.bucket) ? a.bucket < b.bucket : a.morton < b.morton;
+                     });
+
+    //---------------------------------------
+    // 塊に切って、インデックスを並べ替える
+    //---------------------------------------
+    std::vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+
+    mCenterX.clear(); mCenterY.clear(); mCenterZ.clear(); mRadius.clear();
+    mAxisX.clear();   mAxisY.clear();   mAxisZ.clear();   mCutoff.clear();
+    mIndexStart.clear();
+    mIndexCount.clear();
+
+    size_t begin = 0;
+    while (begin < numTris)
+    {
+        size_t end = begin + 1;
+        while (end < numTris && end - begin < maxTriangles && tris[end].bucket == tris[begin].bucket)
+        {
+            ++end;
+        }
+
+        // 包む球（頂点の AABB の中心から最も遠い頂点まで）
+        Vector3 vmin(Math::Infinity, Math::Infinity, Math::Infinity);
+        Vector3 vmax(-Math::Infinity, -Math::Infinity, -Math::Infinity);
+        Vector3 axis = Vector3::Zero;
+        for (size_t t = begin; t < end; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                Vector3 p = position(indices[tris[t].index * 3 + k]);
+                vmin = Vector3(std::min(vmin.x, p.x), std::min(vmin.y, p.y), std::min(vmin.z, p.z));
+                vmax = Vector3(std::max(vmax.x, p.x), std::max(vmax.y, p.y), std::max(vmax.z, p.z));
+            }
+            axis += tris[t].normal;
+        }
+        Vector3 center = (vmin + vmax) * 0.5f;
+        float radius = 0.0f;
+        for (size_t t = begin; t < end; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int index = indices[tris[t].index * 3 + k];
+                radius = std::max(radius, (position(index) - center).Length());
+                sorted.push_back(index);
+            }
+        }
+
+        // 法線の円錐（軸は面法線の平均。一番外れた面との角度で開き具合を決める）
+        float cutoff = kNoCone;
+        if (axis.Length() > Math::NearZeroEpsilon)
+        {
+            axis.Normalize();
+            float minDot = 1.0f;
+            for (size_t t = begin; t < end; ++t)
+            {
+                minDot = std::min(minDot, Vector3::Dot(tris[t].normal, axis));
+            }
+            if (minDot > kMinConeDot)
+            {
+                cutoff = std::sqrt(1.0f - minDot * minDot);
+            }
+        }
+
+        mCenterX.push_back(center.x);
+        mCenterY.push_back(center.y);
+        mCenterZ.push_back(center.z);
+        mRadius.push_back(radius);
+        mAxisX.push_back(axis.x);
+        mAxisY.push_back(axis.y);
+        mAxisZ.push_back(axis.z);
+        mCutoff.push_back(cutoff);
+        mIndexStart.push_back(static_cast<uint32_t>(begin * 3));
+        mIndexCount.push_back(static_cast<uint32_t>((end - begin) * 3));
+
+        begin = end;
+    }
+
+    indices.swap(sorted);
+    return true;
+}
+
+//-------------------------------------------
+// Cull()
+//  - 視錐台の平面をローカルへ移して、球の中心との距離で判定
+//    （中心の距離は正確、半径は最大スケール倍で保守的に）
+//  - 裏向き：カメラから見て円錐ごと背を向けていれば落とす
+//      dot(c - eye, axis) >= cutoff * |c - eye| + radius
+//  - 一様スケールのときだけ、カメラをローカルへ移して円錐判定をする
+//-------------------------------------------
+size_t MeshletSet::Cull(const Matrix4& world,
+                        const Frustum& frustum,
+                        const Vector3& cameraPos,
+                        MeshletDrawRanges& out) const
+{
+    out.Clear();
+    const size_t count = mIndexStart.size();
+    if (count == 0) return 0;
+
+    //---------------------------------------
+    // 平面をローカルへ（row ベクトル：p' = p * M）
+    //   n'_i = Σ_j M[i][j] n_j、d' = d + Σ_j M[3][j] n_j
+    //---------------------------------------
+    float px[6], py[6], pz[6], pd[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        const Plane& p = frustum.planes[i];
+        px[i] = world.mat[0][0] * p.normal.x + world.mat[0][1] * p.normal.y + world.mat[0][2] * p.normal.z;
+        py[i] = world.mat[1][0] * p.normal.x + world.mat[1][1] * p.normal.y + world.mat[1][2] * p.normal.z;
+        pz[i] = world.mat[2][0] * p.normal.x + world.mat[2][1] * p.normal.y + world.mat[2][2] * p.normal.z;
+        pd[i] = p.d + world.mat[3][0] * p.normal.x + world.mat[3][1] * p.normal.y + world.mat[3][2] * p.normal.z;
+    }
+
+    Vector3 scale = world.GetScale();
+    float maxScale = std::max(scale.x, std::max(scale.y, scale.z));
+    float minScale = std::min(scale.x, std::min(scale.y, scale.z));
+    bool  useCone  = (maxScale > 0.0f) && (minScale / maxScale > 0.99f);
+
+    Vector3 eye = Vector3::Zero;
+    if (useCone)
+    {
+        Matrix4 invWorld = world;
+        invWorld.Invert();
+        eye = Vector3::Transform(cameraPos, invWorld);
+    }
+
+    //---------------------------------------
+    // 判定（分岐を避け、フラグを配列へ書く）
+    //---------------------------------------
+    mVisible.resize(count);
+    const float* cx = mCenterX.data();
+    const float* cy = mCenterY.data();
+    const float* cz = mCenterZ.data();
+    const float* cr = mRadius.data();
+    const float* ax = mAxisX.data();
+    const float* ay = mAxisY.data();
+    const float* az = mAxisZ.data();
+    const float* cc = mCutoff.data();
+    uint8_t*     visible = mVisible.data();
+
+    for (size_t m = 0; m < count; ++m)
+    {
+        float r = cr[m] * maxScale;
+        bool inside = true;
+        for (int i = 0; i < 6; ++i)
+        {
+            inside = inside && (px[i] * cx[m] + py[i] * cy[m] + pz[i] * cz[m] + pd[i] >= -r);
+        }
+        visible[m] = inside ? 1 : 0;
+    }
+
+    if (useCone)
+    {
+        for (size_t m = 0; m < count; ++m)
+        {
+            float dx = cx[m] - eye.x;
+            float dy = cy[m] - eye.y;
+            float dz = cz[m] - eye.z;
+            float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+            bool back = (dx * ax[m] + dy * ay[m] + dz * az[m]) >= cc[m] * dist + cr[m];
+            visible[m] = back ? 0 : visible[m];
+        }
+    }
+
+    //---------------------------------------
+    // 生き残りを連続範囲にまとめる
+    //---------------------------------------
+    size_t m = 0;
+    while (m < count)
+    {
+        if (!visible[m])
+        {
+            ++m;
+            continue;
+        }
+        uint32_t start = mIndexStart[m];
+        uint32_t indexCount = 0;
+        while (m < count && visible[m])
+        {
+            indexCount += mIndexCount[m];
+            ++out.visibleMeshlets;
+            ++m;
+        }
+        out.counts.push_back(static_cast<int>(indexCount));
+        out.offsets.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(start) * sizeof(unsigned int)));
+    }
+    return out.visibleMeshlets;
+}
+
+} // namespace toy
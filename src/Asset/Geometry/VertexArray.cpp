@@ -1,9 +1,28 @@
 #include "Asset/Geometry/VertexArray.h"
+#include "Asset/Geometry/Meshlet.h"
 #include "Asset/Geometry/Polygon.h"
 #include "glad/glad.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace toy {
 
+namespace {
+
+// 深度パス用に詰めたボーン属性（12 バイト）
+struct PackedBoneData
+{
+    uint8_t  ids[4];
+    uint16_t weights[4];    // 0..65535 → 0..1（正規化して読む）
+};
+static_assert(sizeof(PackedBoneData) == 12, "PackedBoneData must be tightly packed");
+
+} // namespace
+
 //==============================================================
 // コンストラクタ（スキンメッシュ用）
 //  - 頂点：位置・法線・UV
@@ -109,6 +128,53 @@ VertexArray::VertexArray(unsigned int numVerts,
     glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[4]);
     glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
 
+    //------------------------------------------
+    // 深度パス用：位置 + 詰めたボーン属性
+    //  - ボーン ID が 255 を超えるときは u8 に入らないので
+    //    元の BoneID / Weight の VBO をそのまま使う
+    //------------------------------------------
+    bool canPack = std::all_of(boneids, boneids + numVerts * 4,
+                               [](unsigned int id) { return id <= 0xFF; });
+
+    CreateDepthArray(mVertexBuffer[0], mIndexBufferID);
+    glEnableVertexAttribArray(3);
+    glEnableVertexAttribArray(4);
+
+    if (canPack)
+    {
+        std::vector<PackedBoneData> packed(numVerts);
+        for (unsigned int i = 0; i < numVerts; ++i)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                float w = std::min(std::max(weights[i * 4 + k], 0.0f), 1.0f);
+                packed[i].ids[k]     = static_cast<uint8_t>(boneids[i * 4 + k]);
+                packed[i].weights[k] = static_cast<uint16_t>(std::lround(w * 65535.0f));
+            }
+        }
+
+        glGenBuffers(1, &mDepthBoneBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, mDepthBoneBuffer);
+        glBufferData(GL_ARRAY_BUFFER,
+                     sizeof(PackedBoneData) * numVerts,
+                     packed.data(),
+                     GL_STATIC_DRAW);
+
+        const GLsizei stride = sizeof(PackedBoneData);
+        glVertexAttribIPointer(3, 4, GL_UNSIGNED_BYTE, stride,
+                               reinterpret_cast<void*>(offsetof(PackedBoneData, ids)));
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_SHORT, GL_TRUE, stride,
+                              reinterpret_cast<void*>(offsetof(PackedBoneData, weights)));
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[3]);
+        glVertexAttribIPointer(3, 4, GL_INT, 0, nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[4]);
+        glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+    }
+    glBindVertexArray(0);
+
     // 三角形ポリゴン（ローカル座標）生成
     CreatePolygons(verts, indices, mNumIndices);
 }
@@ -186,6 +252,10 @@ VertexArray::VertexArray(unsigned int numVerts,
     glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[2]);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
 
+    // 深度パス用：位置のみ
+    CreateDepthArray(mVertexBuffer[0], mIndexBufferID);
+    glBindVertexArray(0);
+
     // 三角形ポリゴン（ローカル座標）生成
     CreatePolygons(verts, indices, mNumIndices);
 }
@@ -314,6 +384,201 @@ VertexArray::VertexArray(const float* verts,
     // vec2-only の場合は物理用ポリゴンは不要なので作成しない
 }
 
+//==============================================================
+// コンストラクタ（スキニング結果の受け皿）
+//  - 位置・法線：トランスフォームフィードバックで毎フレーム書き込む
+//  - UV・インデックス：source と共有（所有しないので mVertexBuffer[2] /
+//    mIndexBufferID には入れず、デストラクタで解放されないようにする）
+//  - ボーン属性は持たない（USE_SKINNING なしのシェーダで描く）
+//==============================================================
+VertexArray::VertexArray(const VertexArray* source)
+{
+    mNumVerts   = source->mNumVerts;
+    mNumIndices = source->mNumIndices;
+    mTextureID  = source->mTextureID;
+
+    // VAO
+    glGenVertexArrays(1, &mVertexBufferID);
+    glBindVertexArray(mVertexBufferID);
+
+    //------------------------------------------
+    // インデックスバッファ（共有）
+    //------------------------------------------
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, source->mIndexBufferID);
+
+    //------------------------------------------
+    // 出力先 VBO 2 本：位置・法線
+    //------------------------------------------
+    glGenBuffers(2, mVertexBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[0]);
+    glBufferData(GL_ARRAY_BUFFER,
+                 sizeof(float) * mNumVerts * 3,
+                 nullptr,
+                 GL_DYNAMIC_COPY);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[1]);
+    glBufferData(GL_ARRAY_BUFFER,
+                 sizeof(float) * mNumVerts * 3,
+                 nullptr,
+                 GL_DYNAMIC_COPY);
+
+    //------------------------------------------
+    // 頂点属性設定
+    //------------------------------------------
+    glEnableVertexAttribArray(0); // position
+    glEnableVertexAttribArray(1); // normal
+    glEnableVertexAttribArray(2); // uv
+
+    // position
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[0]);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    // normal
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer[1]);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    // uv（共有）
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[2]);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    // 深度パス用：スキニング済みの位置のみ
+    CreateDepthArray(mVertexBuffer[0], source->mIndexBufferID);
+
+    glBindVertexArray(0);
+
+    // 物理判定は元メッシュ側のポリゴンを使うのでここでは作らない
+}
+
+//==============================================================
+// コンストラクタ（インスタンス描画用）
+//  - 頂点・インデックスは source と共有（所有しないので
+//    mVertexBuffer / mIndexBufferID には入れない）
+//  - インスタンス属性：ワールド行列の第 0〜2 列（vec4 x 3 = 48 バイト）
+//==============================================================
+VertexArray::VertexArray(const VertexArray* source, unsigned int instanceBuffer)
+{
+    mNumVerts       = source->mNumVerts;
+    mNumIndices     = source->mNumIndices;
+    mTextureID      = source->mTextureID;
+    mInstanceBuffer = instanceBuffer;
+
+    // VAO
+    glGenVertexArrays(1, &mVertexBufferID);
+    glBindVertexArray(mVertexBufferID);
+
+    //------------------------------------------
+    // インデックスバッファ（共有）
+    //------------------------------------------
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, source->mIndexBufferID);
+
+    //------------------------------------------
+    // 頂点属性（共有）
+    //------------------------------------------
+    glEnableVertexAttribArray(0); // position
+    glEnableVertexAttribArray(1); // normal
+    glEnableVertexAttribArray(2); // uv
+
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[0]);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[1]);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[2]);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    //------------------------------------------
+    // インスタンス属性
+    //------------------------------------------
+    for (GLuint i = 0; i < 3; ++i)
+    {
+        glEnableVertexAttribArray(5 + i);
+        glVertexAttribDivisor(5 + i, 1);
+    }
+    SetInstanceOffset(0);
+
+    //------------------------------------------
+    // 深度パス用：位置 + インスタンス属性
+    //------------------------------------------
+    CreateDepthArray(source->mVertexBuffer[0], source->mIndexBufferID);
+    for (GLuint i = 0; i < 3; ++i)
+    {
+        glEnableVertexAttribArray(5 + i);
+        glVertexAttribDivisor(5 + i, 1);
+    }
+    SetInstanceOffset(0, true);
+
+    glBindVertexArray(0);
+}
+
+//==============================================================
+// コンストラクタ（焼き込みライティング付き）
+//  - 頂点・インデックスは source と共有（インスタンス描画用と同じく所有しない）
+//  - 焼いた値の VBO だけを持つ：vec2（太陽の可視率, AO）= 8 バイト / 頂点
+//==============================================================
+VertexArray::VertexArray(const VertexArray* source, const float* bakedLighting)
+{
+    mNumVerts   = source->mNumVerts;
+    mNumIndices = source->mNumIndices;
+    mTextureID  = source->mTextureID;
+
+    // VAO
+    glGenVertexArrays(1, &mVertexBufferID);
+    glBindVertexArray(mVertexBufferID);
+
+    //------------------------------------------
+    // インデックスバッファ（共有）
+    //------------------------------------------
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, source->mIndexBufferID);
+
+    //------------------------------------------
+    // 頂点属性（共有）
+    //------------------------------------------
+    glEnableVertexAttribArray(0); // position
+    glEnableVertexAttribArray(1); // normal
+    glEnableVertexAttribArray(2); // uv
+
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[0]);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[1]);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, source->mVertexBuffer[2]);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    //------------------------------------------
+    // 焼き込みライティング
+    //------------------------------------------
+    glGenBuffers(1, &mBakedBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mBakedBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * mNumVerts * 2, bakedLighting, GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    // 深度パス用：位置のみ（影は引き続き落とす）
+    CreateDepthArray(source->mVertexBuffer[0], source->mIndexBufferID);
+
+    glBindVertexArray(0);
+}
+
+void VertexArray::SetInstanceOffset(size_t byteOffset, bool depthOnly)
+{
+    if (!mInstanceBuffer) return;
+
+    const GLsizei stride = sizeof(float) * 12;
+
+    glBindVertexArray((depthOnly && mDepthArrayID) ? mDepthArrayID : mVertexBufferID);
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    for (GLuint i = 0; i < 3; ++i)
+    {
+        glVertexAttribPointer(5 + i, 4, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<void*>(byteOffset + sizeof(float) * 4 * i));
+    }
+}
+
 //==============================================================
 // ポリゴンデータ生成（ローカル座標の三角形）
 //  - verts: xyz xyz ...
@@ -368,6 +633,11 @@ std::vector<Polygon> VertexArray::GetWorldPolygons(const Matrix4& worldTransform
     return result;
 }
 
+void VertexArray::SetMeshlets(std::unique_ptr<MeshletSet> meshlets)
+{
+    mMeshlets = std::move(meshlets);
+}
+
 //==============================================================
 // デストラクタ
 //==============================================================
@@ -378,7 +648,10 @@ VertexArray::~VertexArray()
     // 生成済みの VBO / IBO / VAO を破棄
     glDeleteBuffers(5, mVertexBuffer);       // 未使用スロットは 0 のままなので安全
     glDeleteBuffers(1, &mIndexBufferID);
+    glDeleteBuffers(1, &mDepthBoneBuffer);
+    glDeleteBuffers(1, &mBakedBuffer);
     glDeleteVertexArrays(1, &mVertexBufferID);
+    glDeleteVertexArrays(1, &mDepthArrayID);
 }
 
 //==============================================================
@@ -389,4 +662,29 @@ void VertexArray::SetActive()
     glBindVertexArray(mVertexBufferID);
 }
 
+//==============================================================
+// 深度パス用 VAO を bind（無ければ通常の VAO）
+//==============================================================
+void VertexArray::SetDepthActive()
+{
+    glBindVertexArray(mDepthArrayID ? mDepthArrayID : mVertexBufferID);
+}
+
+//==============================================================
+// 深度パス用 VAO 生成
+//  - 位置 VBO・IBO は参照するだけ（所有しない）
+//  - 呼び出し後も VAO は bind したまま
+//==============================================================
+void VertexArray::CreateDepthArray(unsigned int positionBuffer, unsigned int indexBuffer)
+{
+    glGenVertexArrays(1, &mDepthArrayID);
+    glBindVertexArray(mDepthArrayID);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, positionBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+}
+
 } // namespace toy
@@ -1,5 +1,5 @@
 #include "Asset/Material/Material.h"
-#include "Engine/Render/Shader.h"
+#include "Engine/Render/MaterialBuffer.h"
 #include "Asset/Material/Texture.h"
 
 namespace toy {
@@ -17,34 +17,66 @@ Material::Material()
 , mDiffuseMap(nullptr)
 , mOverrideColor(false)
 , mUniformColor(Vector3::Zero)
+, mSlot(-1)
+, mIsDirty(true)
 {
 }
 
 //--------------------------------------------------------------
-// BindToShader()
-//   Shader に対してマテリアル情報を一括で反映させる。
-//   ・単色描画フラグ
-//   ・Ambient / Diffuse / Specular / Shininess
-//   ・DiffuseMap のバインド
+// デストラクタ
+//   ・UBO スロットを返却（Renderer 側が先に破棄されていれば何もしない）
 //--------------------------------------------------------------
-void Material::BindToShader(std::shared_ptr<Shader> shader,
-                            int textureUnit) const
+Material::~Material()
 {
-    // 単色描画（OverrideColor）
-    shader->SetBooleanUniform("uOverrideColor", mOverrideColor);
-    shader->SetVectorUniform("uUniformColor", mUniformColor);
+    if (auto buffer = mBuffer.lock())
+    {
+        buffer->Release(mSlot);
+    }
+}
+
+//--------------------------------------------------------------
+// PrepareSlot()
+//   ・初回（または別バッファに切り替わった時）にスロットを確保
+//   ・値が変わっていればここで UBO に書き込む
+//--------------------------------------------------------------
+int Material::PrepareSlot(const std::shared_ptr<MaterialBuffer>& buffer)
+{
+    if (mSlot < 0 || mBuffer.lock() != buffer)
+    {
+        mSlot    = buffer->Allocate();
+        mBuffer  = buffer;
+        mIsDirty = true;
+    }
 
-    // マテリアル基本色
-    shader->SetVectorUniform("uAmbientColor",  mAmbientColor);
-    shader->SetVectorUniform("uDiffuseColor",  mDiffuseColor);
-    shader->SetVectorUniform("uSpecColor",     mSpecularColor);
-    shader->SetFloatUniform ("uSpecPower",     mShininess);
+    if (mIsDirty)
+    {
+        MaterialBlock block =
+        {
+            { mAmbientColor.x,  mAmbientColor.y,  mAmbientColor.z,  1.0f },
+            { mDiffuseColor.x,  mDiffuseColor.y,  mDiffuseColor.z,  1.0f },
+            { mSpecularColor.x, mSpecularColor.y, mSpecularColor.z, mShininess },
+        };
+        buffer->Upload(mSlot, block);
+        mIsDirty = false;
+    }
+
+    return mSlot;
+}
+
+//--------------------------------------------------------------
+// Bind()
+//   ・UBO のスロットを割り当て、DiffuseMap を貼るだけ
+//   ・uniform の個別アップロードは行わない
+//--------------------------------------------------------------
+void Material::Bind(const std::shared_ptr<MaterialBuffer>& buffer,
+                    int textureUnit)
+{
+    buffer->Bind(PrepareSlot(buffer));
 
     // DiffuseMap（基本1枚のみ）
     if (mDiffuseMap)
     {
         mDiffuseMap->SetActive(textureUnit);
-        shader->SetTextureUniform("uTexture", textureUnit);
     }
 }
 
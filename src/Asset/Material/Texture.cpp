@@ -217,7 +217,11 @@ void Texture::CreateShadowMap(int width, int height)
     mWidth  = width;
     mHeight = height;
 
-    glGenTextures(1, &mTextureID);
+    // 作り直し（解像度変更）は同じ ID のまま中身だけ確保し直す
+    if (mTextureID == 0)
+    {
+        glGenTextures(1, &mTextureID);
+    }
     glBindTexture(GL_TEXTURE_2D, mTextureID);
 
     glTexImage2D(
@@ -235,6 +239,54 @@ void Texture::CreateShadowMap(int width, int height)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
 }
 
+//============================================================
+// ハイトマップ用テクスチャ（R16）
+//   - TerrainComponent が頂点シェーダで高さを引く
+//   - LINEAR で HeightField::GetHeight と同じ双線形補間になる
+//============================================================
+bool Texture::CreateHeightMap(const uint16_t* samples, int width, int height)
+{
+    if (!samples || width <= 0 || height <= 0)
+    {
+        return false;
+    }
+
+    mWidth  = width;
+    mHeight = height;
+
+    glGenTextures(1, &mTextureID);
+    glBindTexture(GL_TEXTURE_2D, mTextureID);
+
+    // 1 行が 4 バイト境界とは限らないので 2 バイト境界で転送
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexImage2D(
+        GL_TEXTURE_2D, 0, GL_R16,
+        width, height, 0,
+        GL_RED, GL_UNSIGNED_SHORT,
+        samples
+    );
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return true;
+}
+
+//============================================================
+// ミップマップ生成
+//   - ImpostorAtlas のように FBO で描いた後に呼ぶ
+//============================================================
+void Texture::GenerateMipmaps()
+{
+    if (mTextureID == 0) return;
+
+    glBindTexture(GL_TEXTURE_2D, mTextureID);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+}
+
 //============================================================
 // 自前生成（レンズフレア用などの円形グラデーション）
 //============================================================
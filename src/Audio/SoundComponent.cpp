@@ -6,6 +6,7 @@
 #include "Asset/AssetManager.h"
 #include "Asset/Audio/SoundEffect.h"
 #include "Engine/Render/Renderer.h"
+#include "Engine/Runtime/SignificanceManager.h"
 #include "Utils/MathUtil.h"
 #include <iostream>
 
@@ -19,6 +20,7 @@ SoundComponent::SoundComponent(Actor* owner, int updateOrder)
 , mUseDistanceAttenuation(false)
 , mIsExclusive(false)
 , mHasPlayed(false)
+, mIsSuspended(false)
 , mSource(0)
 {
 }
@@ -88,6 +90,7 @@ void SoundComponent::Play()
 //--------------------------------------
 void SoundComponent::Stop()
 {
+    mIsSuspended = false;
     if (mSource != 0)
     {
         alSourceStop(mSource);
@@ -118,6 +121,34 @@ void SoundComponent::Update(float)
         mHasPlayed = true;
     }
 
+    //----------------------------------
+    // 重要度による間引き（2D の音は対象外）
+    //----------------------------------
+    Actor* owner = GetOwner();
+    auto significance = owner->GetApp()->GetSignificanceManager();
+    if (mSource != 0 && mUseDistanceAttenuation && significance)
+    {
+        int interval = significance->GetPolicy(owner->GetSignificance()).soundInterval;
+        if (interval <= 0)
+        {
+            // ループ音は止めておき、重要度が戻ったら続きから鳴らす
+            if (mIsLoop && !mIsSuspended && IsPlaying())
+            {
+                alSourcePause(mSource);
+                mIsSuspended = true;
+            }
+            return;
+        }
+        if (mIsSuspended)
+        {
+            auto pos = owner->GetPosition();
+            alSource3f(mSource, AL_POSITION, pos.x, pos.y, pos.z);
+            alSourcePlay(mSource);
+            mIsSuspended = false;
+        }
+        if (!significance->IsUpdateFrame(interval, owner)) return;
+    }
+
     if (mSource != 0)
     {
         ALint state = 0;
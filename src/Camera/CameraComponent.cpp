@@ -8,18 +8,74 @@ namespace toy {
 
 CameraComponent::CameraComponent(Actor* a, int updateOrder)
     : Component(a, updateOrder)
+    , mViewID(0)
 {
     // カメラ計算に利用する補助アクター
     // （これを使って位置・向きの独立計算を行う）
     mCameraActor = std::make_unique<Actor>(GetOwner()->GetApp());
 }
 
+CameraComponent::~CameraComponent()
+{
+    DisableRenderView();
+}
+
+//----------------------------------------------------------------------
+// 追加ビューの登録／解除
+//----------------------------------------------------------------------
+void CameraComponent::EnableRenderView(const RenderViewport& viewport,
+                                       const Matrix4& projection,
+                                       uint32_t layerMask,
+                                       int order)
+{
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    if (!renderer) return;
+
+    // 登録済みなら設定だけ差し替える
+    if (RenderView* view = renderer->GetView(mViewID))
+    {
+        view->viewport   = viewport;
+        view->projection = projection;
+        view->layerMask  = layerMask;
+        return;
+    }
+
+    RenderView view;
+    view.view       = renderer->GetViewMatrix();
+    view.projection = projection;
+    view.viewport   = viewport;
+    view.layerMask  = layerMask;
+    view.order      = order;
+    mViewID = renderer->AddView(view);
+}
+
+void CameraComponent::DisableRenderView()
+{
+    if (mViewID <= 0) return;
+
+    if (auto renderer = GetOwner()->GetApp()->GetRenderer())
+    {
+        renderer->RemoveView(mViewID);
+    }
+    mViewID = 0;
+}
+
 //----------------------------------------------------------------------
 // View 行列を Renderer に登録
+//   - 追加ビューを持っていればそちらへ
 //----------------------------------------------------------------------
 void CameraComponent::SetViewMatrix(const Matrix4& view)
 {
-    GetOwner()->GetApp()->GetRenderer()->SetViewMatrix(view);
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    if (mViewID > 0)
+    {
+        if (RenderView* rv = renderer->GetView(mViewID))
+        {
+            rv->view = view;
+            return;
+        }
+    }
+    renderer->SetViewMatrix(view);
 }
 
 //----------------------------------------------------------------------
@@ -38,7 +94,13 @@ void CameraComponent::SetCameraPosition(const Vector3& pos)
 //----------------------------------------------------------------------
 void CameraComponent::Update(float)
 {
-    auto invView = GetOwner()->GetApp()->GetRenderer()->GetInvViewMatrix();
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    Matrix4 invView = renderer->GetInvViewMatrix();
+    if (RenderView* rv = renderer->GetView(mViewID))
+    {
+        invView = rv->view;
+        invView.Invert();
+    }
     mCameraPosition = invView.GetTranslation();
 }
 
@@ -22,6 +22,10 @@ Actor::Actor(Application* a)
 , mIsRecomputeWorldTransform(true)
 , mActorID("Unnamed Actor")
 , mParent(nullptr)
+, mPortalCell(-1)
+, mIsPortalCellDynamic(false)
+, mSignificance(Significance::High)
+, mSignificanceScore(1.0f)
 {
 }
 
@@ -6,6 +6,8 @@
 #include "Asset/AssetManager.h"
 #include "Audio/SoundMixer.h"
 #include "Engine/Runtime/TimeOfDaySystem.h"
+#include "Engine/Render/QualityGovernor.h"
+#include "Engine/Runtime/SignificanceManager.h"
 
 #include <algorithm>
 #include <SDL3/SDL.h>
@@ -39,6 +41,8 @@ Application::Application()
     mAssetManager  = std::make_unique<AssetManager>();
     mSoundMixer    = std::make_unique<SoundMixer>(mAssetManager.get());
     mTimeOfDaySys  = std::make_unique<TimeOfDaySystem>();
+    mSignificance  = std::make_unique<SignificanceManager>();
+    mRenderer->SetSignificanceManager(mSignificance.get());
 }
 
 Application::~Application()
@@ -379,6 +383,9 @@ void Application::UpdateFrame()
 
     mTicksCount = now;
     
+    // 品質ガバナーの CPU 時間はここ（待ちの後）から描画のスワップ前まで
+    mRenderer->GetQualityGovernor()->BeginFrame();
+    
     if (mIsPause)
         return;
     
@@ -386,6 +393,9 @@ void Application::UpdateFrame()
     UpdateGame(deltaTime);
     mPhysWorld->Test();
     
+    // 重要度（アニメ・パーティクル・音が Actor の更新の中で参照する）
+    mSignificance->Update(mActors, mRenderer->GetViewMatrix(), mRenderer->GetProjectionMatrix());
+    
     mIsUpdatingActors = true;
     for (auto& a : mActors)
     {
@@ -1,4 +1,5 @@
 #include "Engine/Core/Application.h"
+#include "Engine/Runtime/SignificanceManager.h"
 #include "Utils/JsonHelper.h"
 #include <fstream>
 #include <iostream>
@@ -9,6 +10,7 @@ namespace toy {
 // Application::LoadSettings
 //   - ウィンドウタイトル
 //   - デフォルトのウィンドウサイズ
+//   - 重要度（SignificanceManager）のしきい値
 //=============================================================
 bool Application::LoadSettings(const std::string& filePath)
 {
@@ -57,6 +59,32 @@ bool Application::LoadSettings(const std::string& filePath)
         JsonHelper::GetInt(data["screen"], "screen_height", mScreenHeight);
     }
     
+    //---------------------------------------------------------
+    // 重要度（距離・画面上の大きさ・視錐台の内外で Actor を段階分け）
+    //   "significance": {
+    //       "enabled":       true,
+    //       "near_distance": 10.0,
+    //       "high_size":     0.15,
+    //       "medium_size":   0.05,
+    //       "low_size":      0.01,
+    //       "hidden_weight": 0.25,
+    //       "hysteresis":    0.2
+    //   }
+    //---------------------------------------------------------
+    if (data.contains("significance"))
+    {
+        const auto& s = data["significance"];
+        SignificanceSettings settings = mSignificance->GetSettings();
+        JsonHelper::GetBool (s, "enabled",       settings.enabled);
+        JsonHelper::GetFloat(s, "near_distance", settings.nearDistance);
+        JsonHelper::GetFloat(s, "high_size",     settings.highSize);
+        JsonHelper::GetFloat(s, "medium_size",   settings.mediumSize);
+        JsonHelper::GetFloat(s, "low_size",      settings.lowSize);
+        JsonHelper::GetFloat(s, "hidden_weight", settings.hiddenWeight);
+        JsonHelper::GetFloat(s, "hysteresis",    settings.hysteresis);
+        mSignificance->SetSettings(settings);
+    }
+    
     std::cerr << "Loaded Application settings from "
     << filePath.c_str() << std::endl;
     return true;
@@ -0,0 +1,160 @@
+#include "Engine/Render/BonePaletteBuffer.h"
+#include "Engine/Render/Shader.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace toy {
+
+namespace {
+
+// シェーダが参照するブロック全体のサイズ（mat4 x kMaxBones）
+const GLsizeiptr kBlockBytes =
+    static_cast<GLsizeiptr>(sizeof(Matrix4)) * BonePaletteBuffer::kMaxBones;
+
+} // namespace
+
+
+BonePaletteBuffer::BonePaletteBuffer()
+: mUBO(0)
+, mCapacity(0)
+, mCursor(0)
+, mAlign(256)
+, mMapped(nullptr)
+, mBoundOffset(-1)
+{
+}
+
+BonePaletteBuffer::~BonePaletteBuffer()
+{
+    // 実際の解放処理は Shutdown() 側で行う前提
+}
+
+//-------------------------------------------------------------
+// 初期化
+//-------------------------------------------------------------
+bool BonePaletteBuffer::Initialize(GLsizeiptr initialBytes)
+{
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &mAlign);
+    if (mAlign <= 0)
+    {
+        mAlign = 256;
+    }
+
+    glGenBuffers(1, &mUBO);
+    if (mUBO == 0)
+    {
+        std::cerr << "[BonePaletteBuffer] Failed to create UBO" << std::endl;
+        return false;
+    }
+
+    mCapacity = (initialBytes > kBlockBytes) ? initialBytes : kBlockBytes;
+    glBindBuffer(GL_UNIFORM_BUFFER, mUBO);
+    glBufferData(GL_UNIFORM_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return true;
+}
+
+void BonePaletteBuffer::Shutdown()
+{
+    if (mUBO)
+    {
+        glDeleteBuffers(1, &mUBO);
+        mUBO = 0;
+    }
+    mCapacity    = 0;
+    mCursor      = 0;
+    mMapped      = nullptr;
+    mBoundOffset = -1;
+}
+
+GLsizeiptr BonePaletteBuffer::GetAlignedSize(unsigned int boneCount) const
+{
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(sizeof(Matrix4)) * boneCount;
+    return ((bytes + mAlign - 1) / mAlign) * mAlign;
+}
+
+//-------------------------------------------------------------
+// フレーム開始
+//   - バインド範囲は常にブロック全体（kMaxBones 本）になるので、
+//     最後のパレットの後ろにもブロック 1 個分の余白を取る
+//   - MAP_INVALIDATE_BUFFER で前フレームの GPU 読み出しを待たない
+//-------------------------------------------------------------
+bool BonePaletteBuffer::BeginFrame(GLsizeiptr requiredBytes)
+{
+    if (!mUBO) return false;
+
+    mCursor      = 0;
+    mBoundOffset = -1;
+
+    GLsizeiptr needed = requiredBytes + kBlockBytes;
+    glBindBuffer(GL_UNIFORM_BUFFER, mUBO);
+    if (needed > mCapacity)
+    {
+        while (mCapacity < needed)
+        {
+            mCapacity *= 2;
+        }
+        glBufferData(GL_UNIFORM_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+    }
+
+    mMapped = static_cast<unsigned char*>(
+        glMapBufferRange(GL_UNIFORM_BUFFER, 0, mCapacity,
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    if (!mMapped)
+    {
+        std::cerr << "[BonePaletteBuffer] glMapBufferRange failed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+// パレット書き込み
+//-------------------------------------------------------------
+GLintptr BonePaletteBuffer::Write(const Matrix4* matrices, unsigned int count)
+{
+    if (!mMapped || !matrices || count == 0) return -1;
+
+    if (count > kMaxBones)
+    {
+        count = kMaxBones;
+    }
+
+    GLsizeiptr size = GetAlignedSize(count);
+    if (mCursor + size + kBlockBytes > mCapacity)
+    {
+        std::cerr << "[BonePaletteBuffer] Palette buffer overflow" << std::endl;
+        return -1;
+    }
+
+    GLintptr offset = mCursor;
+    std::memcpy(mMapped + offset, matrices, sizeof(Matrix4) * count);
+    mCursor += size;
+    return offset;
+}
+
+void BonePaletteBuffer::EndFrame()
+{
+    if (!mMapped) return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mUBO);
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    mMapped = nullptr;
+}
+
+//-------------------------------------------------------------
+// バインド（同じオフセットなら何もしない）
+//-------------------------------------------------------------
+void BonePaletteBuffer::Bind(GLintptr offset)
+{
+    if (!mUBO || offset < 0 || offset == mBoundOffset) return;
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, UBB_BONES, mUBO, offset, kBlockBytes);
+    mBoundOffset = offset;
+}
+
+} // namespace toy
@@ -0,0 +1,298 @@
+#include "Engine/Render/DebugDraw.h"
+#include "Engine/Render/Shader.h"
+
+#include <iostream>
+
+namespace toy {
+
+DebugDraw::DebugDraw()
+: mShader(nullptr)
+, mVAO(0)
+, mVBO(0)
+, mCapacity(0)
+, mIsEnabled(false)
+, mLastLineCount(0)
+{
+}
+
+DebugDraw::~DebugDraw()
+{
+    // 実際の解放処理は Shutdown() 側で行う前提
+}
+
+//-------------------------------------------------------------
+// 初期化
+//   - 頂点フォーマット: location 0 = 位置 (vec3)、location 1 = 色 (RGBA8 正規化)
+//-------------------------------------------------------------
+bool DebugDraw::Initialize(std::shared_ptr<Shader> shader)
+{
+    mShader = shader;
+    if (!mShader)
+    {
+        std::cerr << "[DebugDraw] Shader is not loaded" << std::endl;
+        return false;
+    }
+
+    glGenVertexArrays(1, &mVAO);
+    glBindVertexArray(mVAO);
+
+    glGenBuffers(1, &mVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    mCapacity = static_cast<GLsizeiptr>(sizeof(LineVertex) * 4096);
+    glBufferData(GL_ARRAY_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex),
+                          reinterpret_cast<void*>(0));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(LineVertex),
+                          reinterpret_cast<void*>(sizeof(float) * 3));
+
+    glBindVertexArray(0);
+    return true;
+}
+
+void DebugDraw::Shutdown()
+{
+    if (mVBO)
+    {
+        glDeleteBuffers(1, &mVBO);
+        mVBO = 0;
+    }
+    if (mVAO)
+    {
+        glDeleteVertexArrays(1, &mVAO);
+        mVAO = 0;
+    }
+    mCapacity = 0;
+    mVerts.clear();
+    mShader = nullptr;
+}
+
+
+//=============================================================
+// プリミティブ追加
+//=============================================================
+
+uint32_t DebugDraw::PackColor(const Vector3& color)
+{
+    auto toByte = [](float v) -> uint32_t
+    {
+        v = Math::Clamp(v, 0.0f, 1.0f);
+        return static_cast<uint32_t>(v * 255.0f + 0.5f);
+    };
+
+    // メモリ上で R,G,B,A の順に並ぶようにする（リトルエンディアン前提）
+    return  toByte(color.x)
+         | (toByte(color.y) << 8)
+         | (toByte(color.z) << 16)
+         | (0xFFu << 24);
+}
+
+void DebugDraw::PushVertex(const Vector3& p, uint32_t color)
+{
+    LineVertex v;
+    v.pos[0] = p.x;
+    v.pos[1] = p.y;
+    v.pos[2] = p.z;
+    v.color  = color;
+    mVerts.push_back(v);
+}
+
+void DebugDraw::AddLine(const Vector3& a, const Vector3& b, const Vector3& color)
+{
+    if (!mIsEnabled) return;
+
+    uint32_t c = PackColor(color);
+    PushVertex(a, c);
+    PushVertex(b, c);
+}
+
+//-------------------------------------------------------------
+// ボックスの 12 辺
+//   corners: 0..3 = 下面（-Y）、4..7 = 上面（+Y）、同じ並び順
+//-------------------------------------------------------------
+void DebugDraw::AddBoxEdges(const Vector3* corners, uint32_t color)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        int next = (i + 1) % 4;
+
+        // 下面
+        PushVertex(corners[i], color);
+        PushVertex(corners[next], color);
+
+        // 上面
+        PushVertex(corners[i + 4], color);
+        PushVertex(corners[next + 4], color);
+
+        // 縦の辺
+        PushVertex(corners[i], color);
+        PushVertex(corners[i + 4], color);
+    }
+}
+
+void DebugDraw::AddBox(const Vector3& min, const Vector3& max, const Vector3& color)
+{
+    if (!mIsEnabled) return;
+
+    const Vector3 corners[8] =
+    {
+        Vector3(min.x, min.y, min.z),
+        Vector3(max.x, min.y, min.z),
+        Vector3(max.x, min.y, max.z),
+        Vector3(min.x, min.y, max.z),
+        Vector3(min.x, max.y, min.z),
+        Vector3(max.x, max.y, min.z),
+        Vector3(max.x, max.y, max.z),
+        Vector3(min.x, max.y, max.z),
+    };
+    AddBoxEdges(corners, PackColor(color));
+}
+
+void DebugDraw::AddBox(const Vector3& min, const Vector3& max,
+                       const Matrix4& transform, const Vector3& color)
+{
+    if (!mIsEnabled) return;
+
+    const Vector3 corners[8] =
+    {
+        Vector3::Transform(Vector3(min.x, min.y, min.z), transform),
+        Vector3::Transform(Vector3(max.x, min.y, min.z), transform),
+        Vector3::Transform(Vector3(max.x, min.y, max.z), transform),
+        Vector3::Transform(Vector3(min.x, min.y, max.z), transform),
+        Vector3::Transform(Vector3(min.x, max.y, min.z), transform),
+        Vector3::Transform(Vector3(max.x, max.y, min.z), transform),
+        Vector3::Transform(Vector3(max.x, max.y, max.z), transform),
+        Vector3::Transform(Vector3(min.x, max.y, max.z), transform),
+    };
+    AddBoxEdges(corners, PackColor(color));
+}
+
+void DebugDraw::AddOrientedBox(const Vector3& center, const Vector3& halfExtents,
+                               const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ,
+                               const Vector3& color)
+{
+    if (!mIsEnabled) return;
+
+    Vector3 ex = axisX * halfExtents.x;
+    Vector3 ey = axisY * halfExtents.y;
+    Vector3 ez = axisZ * halfExtents.z;
+
+    const Vector3 corners[8] =
+    {
+        center - ex - ey - ez,
+        center + ex - ey - ez,
+        center + ex - ey + ez,
+        center - ex - ey + ez,
+        center - ex + ey - ez,
+        center + ex + ey - ez,
+        center + ex + ey + ez,
+        center - ex + ey + ez,
+    };
+    AddBoxEdges(corners, PackColor(color));
+}
+
+void DebugDraw::AddSphere(const Vector3& center, float radius, const Vector3& color,
+                          int segments)
+{
+    if (!mIsEnabled || segments < 3) return;
+
+    uint32_t c    = PackColor(color);
+    float    step = Math::TwoPi / static_cast<float>(segments);
+
+    for (int i = 0; i < segments; ++i)
+    {
+        float a0 = step * i;
+        float a1 = step * (i + 1);
+        float c0 = Math::Cos(a0) * radius, s0 = Math::Sin(a0) * radius;
+        float c1 = Math::Cos(a1) * radius, s1 = Math::Sin(a1) * radius;
+
+        // XY 平面
+        PushVertex(center + Vector3(c0, s0, 0.0f), c);
+        PushVertex(center + Vector3(c1, s1, 0.0f), c);
+
+        // YZ 平面
+        PushVertex(center + Vector3(0.0f, c0, s0), c);
+        PushVertex(center + Vector3(0.0f, c1, s1), c);
+
+        // ZX 平面
+        PushVertex(center + Vector3(s0, 0.0f, c0), c);
+        PushVertex(center + Vector3(s1, 0.0f, c1), c);
+    }
+}
+
+void DebugDraw::AddRay(const Vector3& start, const Vector3& dir, float length,
+                       const Vector3& color)
+{
+    if (!mIsEnabled) return;
+
+    AddLine(start, start + dir * length, color);
+}
+
+//-------------------------------------------------------------
+// フラスタム
+//   - NDC の立方体 (-1..1)^3 の 8 隅を viewProj の逆行列で戻す
+//   - 行ベクトル規約なので TransformWithPerspDiv(v, inv) で良い
+//-------------------------------------------------------------
+void DebugDraw::AddFrustum(const Matrix4& viewProj, const Vector3& color)
+{
+    if (!mIsEnabled) return;
+
+    Matrix4 inv = viewProj;
+    inv.Invert();
+
+    const Vector3 corners[8] =
+    {
+        Vector3::TransformWithPerspDiv(Vector3(-1.0f, -1.0f, -1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3( 1.0f, -1.0f, -1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3( 1.0f, -1.0f,  1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3(-1.0f, -1.0f,  1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3(-1.0f,  1.0f, -1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3( 1.0f,  1.0f, -1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3( 1.0f,  1.0f,  1.0f), inv),
+        Vector3::TransformWithPerspDiv(Vector3(-1.0f,  1.0f,  1.0f), inv),
+    };
+    AddBoxEdges(corners, PackColor(color));
+}
+
+
+//=============================================================
+// 描画
+//=============================================================
+
+//-------------------------------------------------------------
+// Flush
+//   - 足りなければ VBO を倍々で拡張、足りていれば orphan してから転送
+//   - 1 フレームの全線分を GL_LINES 1 回で描く
+//-------------------------------------------------------------
+void DebugDraw::Flush(const Matrix4& viewProj)
+{
+    mLastLineCount = mVerts.size() / 2;
+    if (mVerts.empty() || !mShader || !mVAO) return;
+
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(sizeof(LineVertex) * mVerts.size());
+
+    glBindVertexArray(mVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
+    if (bytes > mCapacity)
+    {
+        while (mCapacity < bytes)
+        {
+            mCapacity *= 2;
+        }
+    }
+    glBufferData(GL_ARRAY_BUFFER, mCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, mVerts.data());
+
+    mShader->SetActive();
+    mShader->SetMatrixUniform("uViewProj", viewProj);
+
+    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(mVerts.size()));
+
+    glBindVertexArray(0);
+    mVerts.clear();
+}
+
+} // namespace toy
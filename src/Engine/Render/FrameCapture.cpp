@@ -0,0 +1,321 @@
+#include "Engine/Render/FrameCapture.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace toy {
+
+FrameCapture::FrameCapture()
+: mIssueCount(0)
+, mIsSequence(false)
+, mSequenceInterval(1)
+, mSequenceFrame(0)
+, mSequenceIndex(0)
+, mIsRunning(false)
+, mSavedCount(0)
+, mDroppedCount(0)
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+    Shutdown();
+}
+
+bool FrameCapture::Initialize()
+{
+    if (mIsRunning) return true;
+
+    for (auto& slot : mSlots)
+    {
+        glGenBuffers(1, &slot.pbo);
+    }
+
+    mIsRunning = true;
+    mWorker = std::thread(&FrameCapture::WorkerMain, this);
+    return true;
+}
+
+void FrameCapture::Shutdown()
+{
+    if (!mIsRunning) return;
+
+    // 発行済みの読み戻しは書き出してから終える
+    PollSlots(true);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsRunning = false;
+    }
+    mCondition.notify_all();
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+
+    for (auto& slot : mSlots)
+    {
+        if (slot.fence)
+        {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        glDeleteBuffers(1, &slot.pbo);
+        slot.pbo      = 0;
+        slot.capacity = 0;
+    }
+}
+
+//=============================================================
+// 要求
+//=============================================================
+
+void FrameCapture::RequestScreenshot(const std::string& filePath)
+{
+    mScreenshotPath = filePath;
+}
+
+void FrameCapture::StartSequence(const std::string& pathPrefix, int everyNthFrame)
+{
+    mIsSequence       = true;
+    mSequencePrefix   = pathPrefix;
+    mSequenceInterval = everyNthFrame > 0 ? everyNthFrame : 1;
+    mSequenceFrame    = 0;
+    mSequenceIndex    = 0;
+}
+
+void FrameCapture::StopSequence()
+{
+    mIsSequence = false;
+}
+
+//=============================================================
+// フレーム処理
+//=============================================================
+
+void FrameCapture::EndFrame(int width, int height)
+{
+    if (!mIsRunning) return;
+
+    // 先に完了分を回収して PBO を空ける
+    PollSlots(false);
+
+    if (width <= 0 || height <= 0) return;
+
+    if (!mScreenshotPath.empty())
+    {
+        if (IssueReadback(width, height, mScreenshotPath))
+        {
+            mScreenshotPath.clear();
+        }
+    }
+
+    if (mIsSequence)
+    {
+        bool capture = (mSequenceFrame % static_cast<uint64_t>(mSequenceInterval)) == 0;
+        ++mSequenceFrame;
+        if (capture)
+        {
+            // 番号は捨てたフレームも進める（抜けがファイル名で分かるように）
+            char name[32];
+            std::snprintf(name, sizeof(name), "_%06llu.png",
+                          static_cast<unsigned long long>(mSequenceIndex++));
+            if (!IssueReadback(width, height, mSequencePrefix + name))
+            {
+                ++mDroppedCount;
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------
+// 読み戻しの発行
+//   - GL_BACK をそのまま PBO へ（GPU 側のコピーだけで戻る）
+//   - フェンスで完了を後から確認する
+//-------------------------------------------------------------
+bool FrameCapture::IssueReadback(int width, int height, const std::string& path)
+{
+    Slot* slot = nullptr;
+    for (auto& s : mSlots)
+    {
+        if (!s.fence)
+        {
+            slot = &s;
+            break;
+        }
+    }
+    if (!slot) return false;
+
+    size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    if (slot->capacity < size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot->capacity = size;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot->fence    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->width    = width;
+    slot->height   = height;
+    slot->path     = path;
+    slot->sequence = mIssueCount++;
+    return true;
+}
+
+//-------------------------------------------------------------
+// 完了した読み戻しを回収
+//   - 発行順に見て、未完了のものがあればそこで止める
+//     （連番の順序をワーカー側でも保つため）
+//-------------------------------------------------------------
+void FrameCapture::PollSlots(bool wait)
+{
+    for (;;)
+    {
+        Slot* oldest = nullptr;
+        for (auto& s : mSlots)
+        {
+            if (s.fence && (!oldest || s.sequence < oldest->sequence))
+            {
+                oldest = &s;
+            }
+        }
+        if (!oldest) return;
+
+        GLuint64 timeout = wait ? 1000000000ull : 0;   // 待つ場合は最大 1 秒
+        GLenum result = glClientWaitSync(oldest->fence,
+                                         wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                         timeout);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+        {
+            if (!wait) return;
+
+            // 待っても終わらない（コンテキスト喪失など）ものは捨てる
+            std::cerr << "FrameCapture: readback timed out " << oldest->path << std::endl;
+            glDeleteSync(oldest->fence);
+            oldest->fence = nullptr;
+            ++mDroppedCount;
+            continue;
+        }
+
+        glDeleteSync(oldest->fence);
+        oldest->fence = nullptr;
+
+        size_t size = static_cast<size_t>(oldest->width) * static_cast<size_t>(oldest->height) * 4;
+
+        Job job;
+        job.width  = oldest->width;
+        job.height = oldest->height;
+        job.path   = oldest->path;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mJobs.size() >= kMaxQueuedJobs)
+            {
+                // 書き出しが追いつかない → このフレームは諦める
+                ++mDroppedCount;
+                continue;
+            }
+            if (!mFreeBuffers.empty())
+            {
+                job.pixels.swap(mFreeBuffers.back());
+                mFreeBuffers.pop_back();
+            }
+        }
+        job.pixels.resize(size);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, oldest->pbo);
+        void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                        static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT);
+        if (mapped)
+        {
+            std::memcpy(job.pixels.data(), mapped, size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (!mapped)
+        {
+            std::cerr << "FrameCapture: failed to map readback buffer" << std::endl;
+            ++mDroppedCount;
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJobs.push_back(std::move(job));
+        }
+        mCondition.notify_one();
+    }
+}
+
+//-------------------------------------------------------------
+// ワーカー：上下反転して PNG へ
+//   （GL は左下原点なので、そのままだと上下逆さまになる）
+//-------------------------------------------------------------
+void FrameCapture::WorkerMain()
+{
+    std::vector<uint8_t> row;
+
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return !mJobs.empty() || !mIsRunning; });
+            if (mJobs.empty()) return;
+
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+        }
+
+        size_t pitch = static_cast<size_t>(job.width) * 4;
+        row.resize(pitch);
+        for (int y = 0; y < job.height / 2; ++y)
+        {
+            uint8_t* top    = job.pixels.data() + pitch * y;
+            uint8_t* bottom = job.pixels.data() + pitch * (job.height - 1 - y);
+            std::memcpy(row.data(), top, pitch);
+            std::memcpy(top, bottom, pitch);
+            std::memcpy(bottom, row.data(), pitch);
+        }
+
+        // バックバッファのアルファは半透明の合成で 1 未満になっているので不透明にする
+        uint8_t* pixel = job.pixels.data();
+        for (size_t i = 0, n = static_cast<size_t>(job.width) * job.height; i < n; ++i)
+        {
+            pixel[i * 4 + 3] = 255;
+        }
+
+        SDL_Surface* surface = SDL_CreateSurfaceFrom(job.width, job.height,
+                                                     SDL_PIXELFORMAT_RGBA32,
+                                                     job.pixels.data(),
+                                                     static_cast<int>(pitch));
+        bool saved = false;
+        if (surface)
+        {
+            saved = IMG_SavePNG(surface, job.path.c_str());
+            SDL_DestroySurface(surface);
+        }
+        if (!saved)
+        {
+            std::cerr << "FrameCapture: failed to save " << job.path
+                      << " (" << SDL_GetError() << ")" << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (saved) ++mSavedCount;
+        mFreeBuffers.push_back(std::move(job.pixels));
+    }
+}
+
+} // namespace toy
@@ -0,0 +1,1765 @@
+#include "Engine/Render/GLRecorder.h"
+#include "Engine/Render/GLCaptureFormat.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+namespace toy {
+
+using GLCapture::Op;
+using GLCapture::UniformKind;
+
+GLRecorder* GLRecorder::sInstance = nullptr;
+
+//=============================================================
+// 差し替える関数の一覧
+//   X(名前) … glad_debug_gl名前 を Hooks::名前 へ差し替える
+//=============================================================
+#define TOY_GL_RECORDER_HOOKS(X) \
+    X(GenBuffers) X(DeleteBuffers) X(GenTextures) X(DeleteTextures) \
+    X(GenVertexArrays) X(DeleteVertexArrays) X(GenFramebuffers) X(DeleteFramebuffers) \
+    X(GenRenderbuffers) X(DeleteRenderbuffers) X(GenTransformFeedbacks) X(DeleteTransformFeedbacks) \
+    X(CreateShader) X(DeleteShader) X(CreateProgram) X(DeleteProgram) \
+    X(ShaderSource) X(CompileShader) X(AttachShader) X(TransformFeedbackVaryings) \
+    X(LinkProgram) X(UseProgram) X(GetUniformLocation) X(GetUniformBlockIndex) X(UniformBlockBinding) \
+    X(Uniform1i) X(Uniform1f) X(Uniform2fv) X(Uniform3fv) X(Uniform4fv) X(UniformMatrix4fv) \
+    X(BindBuffer) X(BindBufferBase) X(BindBufferRange) X(BufferData) X(BufferSubData) \
+    X(MapBufferRange) X(UnmapBuffer) \
+    X(BindVertexArray) X(EnableVertexAttribArray) X(DisableVertexAttribArray) \
+    X(VertexAttribPointer) X(VertexAttribIPointer) X(VertexAttribDivisor) \
+    X(ActiveTexture) X(BindTexture) X(TexImage2D) X(TexParameteri) X(GenerateMipmap) X(PixelStorei) \
+    X(BindFramebuffer) X(FramebufferTexture2D) X(FramebufferRenderbuffer) \
+    X(BindRenderbuffer) X(RenderbufferStorage) X(DrawBuffers) X(DrawBuffer) X(ReadBuffer) \
+    X(Enable) X(Disable) X(BlendFunc) X(BlendFuncSeparate) X(DepthMask) X(ColorMask) \
+    X(FrontFace) X(Viewport) X(Scissor) X(ClearColor) X(Clear) \
+    X(DrawArrays) X(DrawElements) X(DrawElementsInstanced) X(MultiDrawElements) \
+    X(BindTransformFeedback) X(BeginTransformFeedback) X(EndTransformFeedback) X(ReadPixels)
+
+namespace {
+
+// 差し替え前の関数ポインタ（横取りした後はここから本物を呼ぶ）
+#define TOY_GL_DECLARE_NEXT(name) decltype(glad_debug_gl##name) sNext##name = nullptr;
+TOY_GL_RECORDER_HOOKS(TOY_GL_DECLARE_NEXT)
+#undef TOY_GL_DECLARE_NEXT
+
+//-------------------------------------------------------------
+// glTexImage2D / glReadPixels のバイト数
+//-------------------------------------------------------------
+size_t BytesPerPixel(GLenum format, GLenum type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_INT_24_8:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_5_9_9_9_REV:
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_8_8_8_8_REV:
+        return 4;
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+        return 2;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        return 8;
+    default:
+        break;
+    }
+
+    size_t components = 4;
+    switch (format)
+    {
+    case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+        components = 1; break;
+    case GL_RG: case GL_RG_INTEGER:
+        components = 2; break;
+    case GL_RGB: case GL_BGR: case GL_RGB_INTEGER:
+        components = 3; break;
+    default:
+        components = 4; break;
+    }
+
+    size_t size = 1;
+    switch (type)
+    {
+    case GL_SHORT: case GL_UNSIGNED_SHORT: case GL_HALF_FLOAT:
+        size = 2; break;
+    case GL_INT: case GL_UNSIGNED_INT: case GL_FLOAT:
+        size = 4; break;
+    default:
+        size = 1; break;
+    }
+    return components * size;
+}
+
+size_t ImageBytes(GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment)
+{
+    if (width <= 0 || height <= 0) return 0;
+    size_t a   = static_cast<size_t>(std::max(alignment, 1));
+    size_t row = static_cast<size_t>(width) * BytesPerPixel(format, type);
+    row = (row + a - 1) / a * a;
+    return row * static_cast<size_t>(height);
+}
+
+// ミップマップを使うフィルタか
+bool IsMipmapFilter(GLint filter)
+{
+    return filter == GL_NEAREST_MIPMAP_NEAREST || filter == GL_LINEAR_MIPMAP_NEAREST ||
+           filter == GL_NEAREST_MIPMAP_LINEAR  || filter == GL_LINEAR_MIPMAP_LINEAR;
+}
+
+} // namespace
+
+//=============================================================
+// 差し替え先
+//   本物を呼んでから追跡・記録する（Unmap / Delete だけは先に記録する）
+//=============================================================
+struct GLRecorder::Hooks
+{
+    static GLRecorder* R() { return sInstance; }
+    static bool Rec() { return sInstance && sInstance->IsRecording(); }
+    static GLCapture::Writer W() { return GLCapture::Writer(sInstance->mStream); }
+
+    //---------------------------------------------------------
+    // オブジェクトの生成・破棄
+    //---------------------------------------------------------
+    static void RecordNames(Op op, GLsizei n, const GLuint* names)
+    {
+        if (!Rec() || !names) return;
+        auto w = W();
+        for (GLsizei i = 0; i < n; ++i)
+        {
+            w.Begin(op);
+            w.Put<uint32_t>(names[i]);
+        }
+    }
+
+    template <typename Set>
+    static void Track(Set& set, GLsizei n, const GLuint* names, bool add)
+    {
+        if (!names) return;
+        for (GLsizei i = 0; i < n; ++i)
+        {
+            if (names[i] == 0) continue;
+            if (add) set.insert(names[i]);
+            else     set.erase(names[i]);
+        }
+    }
+
+    static void APIENTRY GenBuffers(GLsizei n, GLuint* names)
+    {
+        sNextGenBuffers(n, names);
+        if (!R()) return;
+        Track(R()->mBuffers, n, names, true);
+        RecordNames(Op::GenBuffer, n, names);
+    }
+    static void APIENTRY DeleteBuffers(GLsizei n, const GLuint* names)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteBuffer, n, names);
+            Track(R()->mBuffers, n, names, false);
+        }
+        sNextDeleteBuffers(n, names);
+    }
+    static void APIENTRY GenTextures(GLsizei n, GLuint* names)
+    {
+        sNextGenTextures(n, names);
+        if (!R()) return;
+        for (GLsizei i = 0; i < n; ++i) R()->mTextures[names[i]] = TextureInfo();
+        RecordNames(Op::GenTexture, n, names);
+    }
+    static void APIENTRY DeleteTextures(GLsizei n, const GLuint* names)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteTexture, n, names);
+            for (GLsizei i = 0; i < n; ++i) R()->mTextures.erase(names[i]);
+        }
+        sNextDeleteTextures(n, names);
+    }
+    static void APIENTRY GenVertexArrays(GLsizei n, GLuint* names)
+    {
+        sNextGenVertexArrays(n, names);
+        if (!R()) return;
+        Track(R()->mVertexArrays, n, names, true);
+        RecordNames(Op::GenVertexArray, n, names);
+    }
+    static void APIENTRY DeleteVertexArrays(GLsizei n, const GLuint* names)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteVertexArray, n, names);
+            Track(R()->mVertexArrays, n, names, false);
+        }
+        sNextDeleteVertexArrays(n, names);
+    }
+    static void APIENTRY GenFramebuffers(GLsizei n, GLuint* names)
+    {
+        sNextGenFramebuffers(n, names);
+        if (!R()) return;
+        Track(R()->mFramebuffers, n, names, true);
+        RecordNames(Op::GenFramebuffer, n, names);
+    }
+    static void APIENTRY DeleteFramebuffers(GLsizei n, const GLuint* names)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteFramebuffer, n, names);
+            Track(R()->mFramebuffers, n, names, false);
+        }
+        sNextDeleteFramebuffers(n, names);
+    }
+    static void APIENTRY GenRenderbuffers(GLsizei n, GLuint* names)
+    {
+        sNextGenRenderbuffers(n, names);
+        if (!R()) return;
+        Track(R()->mRenderbuffers, n, names, true);
+        RecordNames(Op::GenRenderbuffer, n, names);
+    }
+    static void APIENTRY DeleteRenderbuffers(GLsizei n, const GLuint* names)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteRenderbuffer, n, names);
+            Track(R()->mRenderbuffers, n, names, false);
+        }
+        sNextDeleteRenderbuffers(n, names);
+    }
+    static void APIENTRY GenTransformFeedbacks(GLsizei n, GLuint* names)
+    {
+        sNextGenTransformFeedbacks(n, names);
+        if (!R()) return;
+        Track(R()->mTransformFeedbacks, n, names, true);
+        RecordNames(Op::GenTransformFeedback, n, names);
+    }
+    static void APIENTRY DeleteTransformFeedbacks(GLsizei n, const GLuint* names)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteTransformFeedback, n, names);
+            Track(R()->mTransformFeedbacks, n, names, false);
+        }
+        sNextDeleteTransformFeedbacks(n, names);
+    }
+    static GLuint APIENTRY CreateShader(GLenum type)
+    {
+        GLuint shader = sNextCreateShader(type);
+        if (R() && shader)
+        {
+            R()->mShaders[shader] = type;
+            if (Rec())
+            {
+                auto w = W();
+                w.Begin(Op::CreateShader);
+                w.Put<uint32_t>(type);
+                w.Put<uint32_t>(shader);
+            }
+        }
+        return shader;
+    }
+    static void APIENTRY DeleteShader(GLuint shader)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteShader, 1, &shader);
+            R()->mShaders.erase(shader);
+        }
+        sNextDeleteShader(shader);
+    }
+    static GLuint APIENTRY CreateProgram()
+    {
+        GLuint program = sNextCreateProgram();
+        if (R() && program)
+        {
+            R()->mPrograms.insert(program);
+            RecordNames(Op::CreateProgram, 1, &program);
+        }
+        return program;
+    }
+    static void APIENTRY DeleteProgram(GLuint program)
+    {
+        if (R())
+        {
+            RecordNames(Op::DeleteProgram, 1, &program);
+            R()->mPrograms.erase(program);
+            R()->mUniformNames.erase(program);
+            R()->mBlockNames.erase(program);
+        }
+        sNextDeleteProgram(program);
+    }
+
+    //---------------------------------------------------------
+    // シェーダ・プログラム
+    //---------------------------------------------------------
+    static void APIENTRY ShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+    {
+        sNextShaderSource(shader, count, strings, lengths);
+        if (!Rec()) return;
+
+        std::string source;
+        for (GLsizei i = 0; i < count; ++i)
+        {
+            if (!strings[i]) continue;
+            if (lengths && lengths[i] >= 0) source.append(strings[i], lengths[i]);
+            else                            source.append(strings[i]);
+        }
+        auto w = W();
+        w.Begin(Op::ShaderSource);
+        w.Put<uint32_t>(shader);
+        w.PutString(source);
+    }
+    static void APIENTRY CompileShader(GLuint shader)
+    {
+        sNextCompileShader(shader);
+        RecordNames(Op::CompileShader, 1, &shader);
+    }
+    static void APIENTRY AttachShader(GLuint program, GLuint shader)
+    {
+        sNextAttachShader(program, shader);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::AttachShader);
+        w.Put<uint32_t>(program);
+        w.Put<uint32_t>(shader);
+    }
+    static void APIENTRY TransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar* const* varyings, GLenum mode)
+    {
+        sNextTransformFeedbackVaryings(program, count, varyings, mode);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::TransformFeedbackVaryings);
+        w.Put<uint32_t>(program);
+        w.Put<uint32_t>(mode);
+        w.Put<int32_t>(count);
+        for (GLsizei i = 0; i < count; ++i) w.PutString(varyings[i]);
+    }
+    static void APIENTRY LinkProgram(GLuint program)
+    {
+        sNextLinkProgram(program);
+        if (!R()) return;
+        R()->OnLinkProgram(program);
+        RecordNames(Op::LinkProgram, 1, &program);
+    }
+    static void APIENTRY UseProgram(GLuint program)
+    {
+        sNextUseProgram(program);
+        if (!R()) return;
+        R()->mCurrentProgram = program;
+        RecordNames(Op::UseProgram, 1, &program);
+    }
+    static GLint APIENTRY GetUniformLocation(GLuint program, const GLchar* name)
+    {
+        GLint location = sNextGetUniformLocation(program, name);
+        if (R() && location >= 0)
+        {
+            R()->mUniformNames[program][location] = name;
+        }
+        return location;
+    }
+    static GLuint APIENTRY GetUniformBlockIndex(GLuint program, const GLchar* name)
+    {
+        GLuint index = sNextGetUniformBlockIndex(program, name);
+        if (R() && index != GL_INVALID_INDEX)
+        {
+            R()->mBlockNames[program][index] = name;
+        }
+        return index;
+    }
+    static void APIENTRY UniformBlockBinding(GLuint program, GLuint index, GLuint binding)
+    {
+        sNextUniformBlockBinding(program, index, binding);
+        if (!Rec()) return;
+
+        auto& names = R()->mBlockNames[program];
+        auto iter = names.find(index);
+        if (iter == names.end()) return;
+
+        auto w = W();
+        w.Begin(Op::UniformBlockBinding);
+        w.Put<uint32_t>(program);
+        w.PutString(iter->second);
+        w.Put<uint32_t>(binding);
+    }
+
+    // uniform は今のプログラムの名前で記録（名前が分からない location は捨てる）
+    static void RecordUniform(UniformKind kind, GLint location, GLsizei count, GLboolean transpose,
+                              const void* data, size_t bytes)
+    {
+        if (!Rec() || location < 0) return;
+
+        auto& names = R()->mUniformNames[R()->mCurrentProgram];
+        auto iter = names.find(location);
+        if (iter == names.end()) return;
+
+        auto w = W();
+        w.Begin(Op::Uniform);
+        w.Put<uint8_t>(static_cast<uint8_t>(kind));
+        w.PutString(iter->second);
+        w.Put<int32_t>(count);
+        w.Put<uint8_t>(transpose);
+        w.PutBytes(data, bytes);
+    }
+    static void APIENTRY Uniform1i(GLint location, GLint v)
+    {
+        sNextUniform1i(location, v);
+        RecordUniform(UniformKind::Int1, location, 1, GL_FALSE, &v, sizeof(v));
+    }
+    static void APIENTRY Uniform1f(GLint location, GLfloat v)
+    {
+        sNextUniform1f(location, v);
+        RecordUniform(UniformKind::Float1, location, 1, GL_FALSE, &v, sizeof(v));
+    }
+    static void APIENTRY Uniform2fv(GLint location, GLsizei count, const GLfloat* v)
+    {
+        sNextUniform2fv(location, count, v);
+        RecordUniform(UniformKind::Float2, location, count, GL_FALSE, v, sizeof(GLfloat) * 2 * count);
+    }
+    static void APIENTRY Uniform3fv(GLint location, GLsizei count, const GLfloat* v)
+    {
+        sNextUniform3fv(location, count, v);
+        RecordUniform(UniformKind::Float3, location, count, GL_FALSE, v, sizeof(GLfloat) * 3 * count);
+    }
+    static void APIENTRY Uniform4fv(GLint location, GLsizei count, const GLfloat* v)
+    {
+        sNextUniform4fv(location, count, v);
+        RecordUniform(UniformKind::Float4, location, count, GL_FALSE, v, sizeof(GLfloat) * 4 * count);
+    }
+    static void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* v)
+    {
+        sNextUniformMatrix4fv(location, count, transpose, v);
+        RecordUniform(UniformKind::Matrix4, location, count, transpose, v, sizeof(GLfloat) * 16 * count);
+    }
+
+    //---------------------------------------------------------
+    // バッファ
+    //---------------------------------------------------------
+    static void APIENTRY BindBuffer(GLenum target, GLuint buffer)
+    {
+        sNextBindBuffer(target, buffer);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindBuffer);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(buffer);
+    }
+    static void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        sNextBindBufferBase(target, index, buffer);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindBufferBase);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(index);
+        w.Put<uint32_t>(buffer);
+    }
+    static void APIENTRY BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        sNextBindBufferRange(target, index, buffer, offset, size);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindBufferRange);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(index);
+        w.Put<uint32_t>(buffer);
+        w.Put<int64_t>(offset);
+        w.Put<int64_t>(size);
+    }
+    static void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+    {
+        sNextBufferData(target, size, data, usage);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BufferData);
+        w.Put<uint32_t>(target);
+        w.Put<int64_t>(size);
+        w.Put<uint32_t>(usage);
+        w.PutBytes(data, static_cast<size_t>(size));
+    }
+    static void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+    {
+        sNextBufferSubData(target, offset, size, data);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BufferSubData);
+        w.Put<uint32_t>(target);
+        w.Put<int64_t>(offset);
+        w.PutBytes(data, static_cast<size_t>(size));
+    }
+    static void* APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+    {
+        void* pointer = sNextMapBufferRange(target, offset, length, access);
+        if (R() && pointer)
+        {
+            MapInfo& info = R()->mMapped[target];
+            info.offset  = offset;
+            info.length  = length;
+            info.access  = access;
+            info.pointer = pointer;
+        }
+        return pointer;
+    }
+    static GLboolean APIENTRY UnmapBuffer(GLenum target)
+    {
+        // 書き込んだ範囲は Unmap の前に中身を写しておく
+        if (R())
+        {
+            auto iter = R()->mMapped.find(target);
+            if (iter != R()->mMapped.end())
+            {
+                const MapInfo& info = iter->second;
+                if (Rec() && (info.access & GL_MAP_WRITE_BIT))
+                {
+                    auto w = W();
+                    w.Begin(Op::BufferSubData);
+                    w.Put<uint32_t>(target);
+                    w.Put<int64_t>(info.offset);
+                    w.PutBytes(info.pointer, static_cast<size_t>(info.length));
+                }
+                R()->mMapped.erase(iter);
+            }
+        }
+        return sNextUnmapBuffer(target);
+    }
+
+    //---------------------------------------------------------
+    // 頂点配列
+    //---------------------------------------------------------
+    static void APIENTRY BindVertexArray(GLuint vao)
+    {
+        sNextBindVertexArray(vao);
+        RecordNames(Op::BindVertexArray, 1, &vao);
+    }
+    static void APIENTRY EnableVertexAttribArray(GLuint index)
+    {
+        sNextEnableVertexAttribArray(index);
+        RecordNames(Op::EnableVertexAttribArray, 1, &index);
+    }
+    static void APIENTRY DisableVertexAttribArray(GLuint index)
+    {
+        sNextDisableVertexAttribArray(index);
+        RecordNames(Op::DisableVertexAttribArray, 1, &index);
+    }
+    static void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                             GLsizei stride, const void* pointer)
+    {
+        sNextVertexAttribPointer(index, size, type, normalized, stride, pointer);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::VertexAttribPointer);
+        w.Put<uint32_t>(index);
+        w.Put<int32_t>(size);
+        w.Put<uint32_t>(type);
+        w.Put<uint8_t>(normalized);
+        w.Put<int32_t>(stride);
+        w.Put<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    }
+    static void APIENTRY VertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
+    {
+        sNextVertexAttribIPointer(index, size, type, stride, pointer);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::VertexAttribIPointer);
+        w.Put<uint32_t>(index);
+        w.Put<int32_t>(size);
+        w.Put<uint32_t>(type);
+        w.Put<int32_t>(stride);
+        w.Put<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    }
+    static void APIENTRY VertexAttribDivisor(GLuint index, GLuint divisor)
+    {
+        sNextVertexAttribDivisor(index, divisor);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::VertexAttribDivisor);
+        w.Put<uint32_t>(index);
+        w.Put<uint32_t>(divisor);
+    }
+
+    //---------------------------------------------------------
+    // テクスチャ
+    //---------------------------------------------------------
+    static void APIENTRY ActiveTexture(GLenum unit)
+    {
+        sNextActiveTexture(unit);
+        RecordNames(Op::ActiveTexture, 1, &unit);
+    }
+    static void APIENTRY BindTexture(GLenum target, GLuint texture)
+    {
+        sNextBindTexture(target, texture);
+        if (!R()) return;
+
+        auto iter = R()->mTextures.find(texture);
+        if (iter != R()->mTextures.end() && iter->second.bindTarget == 0)
+        {
+            iter->second.bindTarget = target;
+        }
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindTexture);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(texture);
+    }
+    static void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                    GLint border, GLenum format, GLenum type, const void* pixels)
+    {
+        sNextTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+        if (!R()) return;
+
+        R()->OnTexImage(target, TexImage{ target, level, internalFormat, width, height, format, type });
+        if (!Rec()) return;
+
+        auto w = W();
+        w.Begin(Op::TexImage2D);
+        w.Put<uint32_t>(target);
+        w.Put<int32_t>(level);
+        w.Put<int32_t>(internalFormat);
+        w.Put<int32_t>(width);
+        w.Put<int32_t>(height);
+        w.Put<uint32_t>(format);
+        w.Put<uint32_t>(type);
+        w.PutBytes(pixels, ImageBytes(width, height, format, type, R()->mUnpackAlignment));
+    }
+    static void APIENTRY TexParameteri(GLenum target, GLenum pname, GLint param)
+    {
+        sNextTexParameteri(target, pname, param);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::TexParameteri);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(pname);
+        w.Put<int32_t>(param);
+    }
+    static void APIENTRY GenerateMipmap(GLenum target)
+    {
+        sNextGenerateMipmap(target);
+        RecordNames(Op::GenerateMipmap, 1, &target);
+    }
+    static void APIENTRY PixelStorei(GLenum pname, GLint param)
+    {
+        sNextPixelStorei(pname, param);
+        if (!R()) return;
+        if (pname == GL_UNPACK_ALIGNMENT) R()->mUnpackAlignment = param;
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::PixelStorei);
+        w.Put<uint32_t>(pname);
+        w.Put<int32_t>(param);
+    }
+
+    //---------------------------------------------------------
+    // フレームバッファ
+    //---------------------------------------------------------
+    static void APIENTRY BindFramebuffer(GLenum target, GLuint fbo)
+    {
+        sNextBindFramebuffer(target, fbo);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindFramebuffer);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(fbo);
+    }
+    static void APIENTRY FramebufferTexture2D(GLenum target, GLenum attachment, GLenum texTarget, GLuint texture, GLint level)
+    {
+        sNextFramebufferTexture2D(target, attachment, texTarget, texture, level);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::FramebufferTexture2D);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(attachment);
+        w.Put<uint32_t>(texTarget);
+        w.Put<uint32_t>(texture);
+        w.Put<int32_t>(level);
+    }
+    static void APIENTRY FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum rbTarget, GLuint rb)
+    {
+        sNextFramebufferRenderbuffer(target, attachment, rbTarget, rb);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::FramebufferRenderbuffer);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(attachment);
+        w.Put<uint32_t>(rbTarget);
+        w.Put<uint32_t>(rb);
+    }
+    static void APIENTRY BindRenderbuffer(GLenum target, GLuint rb)
+    {
+        sNextBindRenderbuffer(target, rb);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindRenderbuffer);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(rb);
+    }
+    static void APIENTRY RenderbufferStorage(GLenum target, GLenum internalFormat, GLsizei width, GLsizei height)
+    {
+        sNextRenderbufferStorage(target, internalFormat, width, height);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::RenderbufferStorage);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(internalFormat);
+        w.Put<int32_t>(width);
+        w.Put<int32_t>(height);
+    }
+    static void APIENTRY DrawBuffers(GLsizei n, const GLenum* bufs)
+    {
+        sNextDrawBuffers(n, bufs);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::DrawBuffers);
+        w.Put<int32_t>(n);
+        for (GLsizei i = 0; i < n; ++i) w.Put<uint32_t>(bufs[i]);
+    }
+    static void APIENTRY DrawBuffer(GLenum buf)
+    {
+        sNextDrawBuffer(buf);
+        RecordNames(Op::DrawBuffer, 1, &buf);
+    }
+    static void APIENTRY ReadBuffer(GLenum buf)
+    {
+        sNextReadBuffer(buf);
+        RecordNames(Op::ReadBuffer, 1, &buf);
+    }
+
+    //---------------------------------------------------------
+    // 固定機能の状態
+    //---------------------------------------------------------
+    static void APIENTRY Enable(GLenum cap)
+    {
+        sNextEnable(cap);
+        RecordNames(Op::Enable, 1, &cap);
+    }
+    static void APIENTRY Disable(GLenum cap)
+    {
+        sNextDisable(cap);
+        RecordNames(Op::Disable, 1, &cap);
+    }
+    static void APIENTRY BlendFunc(GLenum src, GLenum dst)
+    {
+        sNextBlendFunc(src, dst);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BlendFunc);
+        w.Put<uint32_t>(src);
+        w.Put<uint32_t>(dst);
+    }
+    static void APIENTRY BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcA, GLenum dstA)
+    {
+        sNextBlendFuncSeparate(srcRGB, dstRGB, srcA, dstA);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BlendFuncSeparate);
+        w.Put<uint32_t>(srcRGB);
+        w.Put<uint32_t>(dstRGB);
+        w.Put<uint32_t>(srcA);
+        w.Put<uint32_t>(dstA);
+    }
+    static void APIENTRY DepthMask(GLboolean flag)
+    {
+        sNextDepthMask(flag);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::DepthMask);
+        w.Put<uint8_t>(flag);
+    }
+    static void APIENTRY ColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a)
+    {
+        sNextColorMask(r, g, b, a);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::ColorMask);
+        w.Put<uint8_t>(r);
+        w.Put<uint8_t>(g);
+        w.Put<uint8_t>(b);
+        w.Put<uint8_t>(a);
+    }
+    static void APIENTRY FrontFace(GLenum mode)
+    {
+        sNextFrontFace(mode);
+        RecordNames(Op::FrontFace, 1, &mode);
+    }
+    static void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        sNextViewport(x, y, width, height);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::Viewport);
+        w.Put<int32_t>(x);
+        w.Put<int32_t>(y);
+        w.Put<int32_t>(width);
+        w.Put<int32_t>(height);
+    }
+    static void APIENTRY Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        sNextScissor(x, y, width, height);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::Scissor);
+        w.Put<int32_t>(x);
+        w.Put<int32_t>(y);
+        w.Put<int32_t>(width);
+        w.Put<int32_t>(height);
+    }
+    static void APIENTRY ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+    {
+        sNextClearColor(r, g, b, a);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::ClearColor);
+        w.Put<float>(r);
+        w.Put<float>(g);
+        w.Put<float>(b);
+        w.Put<float>(a);
+    }
+    static void APIENTRY Clear(GLbitfield mask)
+    {
+        sNextClear(mask);
+        RecordNames(Op::Clear, 1, &mask);
+    }
+
+    //---------------------------------------------------------
+    // 描画
+    //---------------------------------------------------------
+    static void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        sNextDrawArrays(mode, first, count);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::DrawArrays);
+        w.Put<uint32_t>(mode);
+        w.Put<int32_t>(first);
+        w.Put<int32_t>(count);
+    }
+    static void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+    {
+        sNextDrawElements(mode, count, type, indices);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::DrawElements);
+        w.Put<uint32_t>(mode);
+        w.Put<int32_t>(count);
+        w.Put<uint32_t>(type);
+        w.Put<uint64_t>(reinterpret_cast<uintptr_t>(indices));
+    }
+    static void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+    {
+        sNextDrawElementsInstanced(mode, count, type, indices, instances);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::DrawElementsInstanced);
+        w.Put<uint32_t>(mode);
+        w.Put<int32_t>(count);
+        w.Put<uint32_t>(type);
+        w.Put<uint64_t>(reinterpret_cast<uintptr_t>(indices));
+        w.Put<int32_t>(instances);
+    }
+    static void APIENTRY MultiDrawElements(GLenum mode, const GLsizei* counts, GLenum type,
+                                           const void* const* indices, GLsizei drawCount)
+    {
+        sNextMultiDrawElements(mode, counts, type, indices, drawCount);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::MultiDrawElements);
+        w.Put<uint32_t>(mode);
+        w.Put<uint32_t>(type);
+        w.Put<int32_t>(drawCount);
+        for (GLsizei i = 0; i < drawCount; ++i)
+        {
+            w.Put<int32_t>(counts[i]);
+            w.Put<uint64_t>(reinterpret_cast<uintptr_t>(indices[i]));
+        }
+    }
+    static void APIENTRY BindTransformFeedback(GLenum target, GLuint tf)
+    {
+        sNextBindTransformFeedback(target, tf);
+        if (!Rec()) return;
+        auto w = W();
+        w.Begin(Op::BindTransformFeedback);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(tf);
+    }
+    static void APIENTRY BeginTransformFeedback(GLenum mode)
+    {
+        sNextBeginTransformFeedback(mode);
+        RecordNames(Op::BeginTransformFeedback, 1, &mode);
+    }
+    static void APIENTRY EndTransformFeedback()
+    {
+        sNextEndTransformFeedback();
+        if (!Rec()) return;
+        W().Begin(Op::EndTransformFeedback);
+    }
+
+    // PBO への読み戻しだけ記録（クライアントメモリへのものは再生しても意味が無い）
+    static void APIENTRY ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+    {
+        sNextReadPixels(x, y, width, height, format, type, pixels);
+        if (!Rec()) return;
+
+        GLint packBuffer = 0;
+        glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &packBuffer);
+        if (packBuffer == 0) return;
+
+        auto w = W();
+        w.Begin(Op::ReadPixels);
+        w.Put<int32_t>(x);
+        w.Put<int32_t>(y);
+        w.Put<int32_t>(width);
+        w.Put<int32_t>(height);
+        w.Put<uint32_t>(format);
+        w.Put<uint32_t>(type);
+        w.Put<uint64_t>(reinterpret_cast<uintptr_t>(pixels));
+    }
+};
+
+
+GLRecorder::GLRecorder()
+: mCurrentProgram(0)
+, mUnpackAlignment(4)
+, mPendingFrames(0)
+, mFramesLeft(0)
+, mFrameCount(0)
+, mIsSnapshotting(false)
+, mLastCaptureBytes(0)
+{
+}
+
+GLRecorder::~GLRecorder()
+{
+    Uninstall();
+}
+
+//=============================================================
+// 差し替え
+//=============================================================
+
+bool GLRecorder::Install()
+{
+    if (sInstance == this) return true;
+    if (sInstance)
+    {
+        std::cerr << "GLRecorder: another recorder is already installed" << std::endl;
+        return false;
+    }
+
+#define TOY_GL_INSTALL(name) sNext##name = glad_debug_gl##name; glad_debug_gl##name = &Hooks::name;
+    TOY_GL_RECORDER_HOOKS(TOY_GL_INSTALL)
+#undef TOY_GL_INSTALL
+
+    sInstance = this;
+    return true;
+}
+
+void GLRecorder::Uninstall()
+{
+    if (sInstance != this) return;
+
+#define TOY_GL_UNINSTALL(name) glad_debug_gl##name = sNext##name; sNext##name = nullptr;
+    TOY_GL_RECORDER_HOOKS(TOY_GL_UNINSTALL)
+#undef TOY_GL_UNINSTALL
+
+    sInstance = nullptr;
+    mPendingFrames = 0;
+    mFramesLeft    = 0;
+    mStream.clear();
+}
+
+//=============================================================
+// 追跡
+//=============================================================
+
+void GLRecorder::OnTexImage(GLenum target, const TexImage& image)
+{
+    // 今バインドされているテクスチャ
+    GLenum binding = GL_TEXTURE_BINDING_2D;
+    if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+    {
+        binding = GL_TEXTURE_BINDING_CUBE_MAP;
+    }
+    GLint texture = 0;
+    glGetIntegerv(binding, &texture);
+
+    auto iter = mTextures.find(static_cast<GLuint>(texture));
+    if (iter == mTextures.end()) return;
+
+    auto& images = iter->second.images;
+    images.erase(std::remove_if(images.begin(), images.end(), [&](const TexImage& i) {
+        return i.target == image.target && i.level == image.level;
+    }), images.end());
+    images.push_back(image);
+}
+
+//-------------------------------------------------------------
+// リンク直後に全 uniform の location → 名前を引いておく
+//   Shader 側が location をキャッシュしていても記録できるように
+//-------------------------------------------------------------
+void GLRecorder::OnLinkProgram(GLuint program)
+{
+    auto& names = mUniformNames[program];
+    names.clear();
+    mBlockNames[program].clear();
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) return;
+
+    GLint count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        char    name[256];
+        GLsizei length = 0;
+        GLint   size   = 0;
+        GLenum  type   = 0;
+        glGetActiveUniform(program, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+
+        std::string base(name, length);
+        if (size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+        {
+            base.resize(base.size() - 3);
+        }
+        for (GLint e = 0; e < size; ++e)
+        {
+            std::string element = (size > 1) ? base + "[" + std::to_string(e) + "]" : base;
+            GLint location = glGetUniformLocation(program, element.c_str());
+            if (location >= 0) names[location] = element;
+        }
+    }
+}
+
+//=============================================================
+// キャプチャ
+//=============================================================
+
+bool GLRecorder::BeginCapture(const std::string& filePath, int frameCount)
+{
+    if (!IsInstalled())
+    {
+        std::cerr << "GLRecorder: not installed (enable \"debug\": { \"gl_recorder\": true })" << std::endl;
+        return false;
+    }
+    if (IsCapturing())
+    {
+        std::cerr << "GLRecorder: capture already in progress" << std::endl;
+        return false;
+    }
+
+    mFilePath      = filePath;
+    mPendingFrames = std::max(frameCount, 1);
+    return true;
+}
+
+void GLRecorder::EndFrame()
+{
+    if (!IsInstalled()) return;
+
+    // 開始：フレームの区切りで今のオブジェクトと状態を書く
+    if (mPendingFrames > 0)
+    {
+        mStream.clear();
+        mFrameCount = 0;
+
+        mIsSnapshotting = true;
+        WriteSetup();
+        mIsSnapshotting = false;
+        GLCapture::Writer(mStream).Begin(Op::EndSetup);
+
+        mFramesLeft    = mPendingFrames;
+        mPendingFrames = 0;
+        return;
+    }
+
+    if (mFramesLeft <= 0) return;
+
+    GLCapture::Writer(mStream).Begin(Op::EndFrame);
+    ++mFrameCount;
+    if (--mFramesLeft == 0)
+    {
+        Flush();
+        mStream.clear();
+        mStream.shrink_to_fit();
+    }
+}
+
+bool GLRecorder::Flush()
+{
+    std::ofstream file(mFilePath, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "GLRecorder: failed to open " << mFilePath << std::endl;
+        return false;
+    }
+
+    GLCapture::Header header;
+    header.frameCount = mFrameCount;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(mStream.data()), static_cast<std::streamsize>(mStream.size()));
+    if (!file)
+    {
+        std::cerr << "GLRecorder: failed to write " << mFilePath << std::endl;
+        return false;
+    }
+
+    mLastCaptureBytes = sizeof(header) + mStream.size();
+    std::cout << "GLRecorder: wrote " << mFrameCount << " frame(s), "
+              << mLastCaptureBytes << " bytes to " << mFilePath << std::endl;
+    return true;
+}
+
+//=============================================================
+// セットアップ部
+//   GL から今の状態を読み出して、同じ状態を作るコマンド列として書く
+//   （読み出しのためのバインド変更は最後に書く現在の状態で上書きされる）
+//=============================================================
+
+void GLRecorder::WriteSetup()
+{
+    WriteObjects();
+    WriteBuffers();
+    WriteTextures();
+    WriteRenderbuffers();
+    WritePrograms();
+    WriteVertexArrays();
+    WriteFramebuffers();
+    WriteGlobalState();
+}
+
+void GLRecorder::WriteObjects()
+{
+    GLCapture::Writer w(mStream);
+    auto gen = [&](Op op, GLuint name) {
+        w.Begin(op);
+        w.Put<uint32_t>(name);
+    };
+
+    for (GLuint b : mBuffers)            gen(Op::GenBuffer, b);
+    for (auto& t : mTextures)            gen(Op::GenTexture, t.first);
+    for (GLuint v : mVertexArrays)       gen(Op::GenVertexArray, v);
+    for (GLuint f : mFramebuffers)       gen(Op::GenFramebuffer, f);
+    for (GLuint r : mRenderbuffers)      gen(Op::GenRenderbuffer, r);
+    for (GLuint t : mTransformFeedbacks) gen(Op::GenTransformFeedback, t);
+}
+
+//-------------------------------------------------------------
+// バッファの中身（マップ中のものは中身を読めないので大きさだけ）
+//-------------------------------------------------------------
+void GLRecorder::WriteBuffers()
+{
+    GLCapture::Writer w(mStream);
+    std::vector<uint8_t> data;
+
+    GLint prevRead = 0;
+    glGetIntegerv(GL_COPY_READ_BUFFER, &prevRead);     // GL_COPY_READ_BUFFER_BINDING と同値
+
+    for (GLuint b : mBuffers)
+    {
+        if (!glIsBuffer(b)) continue;
+
+        glBindBuffer(GL_COPY_READ_BUFFER, b);
+        GLint size = 0, usage = GL_STATIC_DRAW, mapped = GL_FALSE;
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE,   &size);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_USAGE,  &usage);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_MAPPED, &mapped);
+
+        data.resize(static_cast<size_t>(size));
+        if (size > 0 && !mapped)
+        {
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, data.data());
+        }
+
+        w.Begin(Op::BindBuffer);
+        w.Put<uint32_t>(GL_COPY_WRITE_BUFFER);
+        w.Put<uint32_t>(b);
+        w.Begin(Op::BufferData);
+        w.Put<uint32_t>(GL_COPY_WRITE_BUFFER);
+        w.Put<int64_t>(size);
+        w.Put<uint32_t>(static_cast<uint32_t>(usage));
+        w.PutBytes((size > 0 && !mapped) ? data.data() : nullptr, data.size());
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, static_cast<GLuint>(prevRead));
+}
+
+//-------------------------------------------------------------
+// テクスチャ：glTexImage2D で作ったイメージを読み戻し、パラメータを写す
+//-------------------------------------------------------------
+void GLRecorder::WriteTextures()
+{
+    static const GLenum kParams[] = {
+        GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER,
+        GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_WRAP_R,
+        GL_TEXTURE_COMPARE_MODE, GL_TEXTURE_COMPARE_FUNC,
+        GL_TEXTURE_BASE_LEVEL, GL_TEXTURE_MAX_LEVEL,
+    };
+
+    GLCapture::Writer w(mStream);
+    std::vector<uint8_t> data;
+
+    GLint prevPackBuffer = 0, prevPackAlign = 4, prevUnit = GL_TEXTURE0;
+    glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &prevPackBuffer);
+    glGetIntegerv(GL_PACK_ALIGNMENT, &prevPackAlign);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevUnit);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLint prevTex2D = 0, prevTexCube = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTex2D);
+    glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &prevTexCube);
+
+    w.Begin(Op::ActiveTexture);
+    w.Put<uint32_t>(GL_TEXTURE0);
+    w.Begin(Op::PixelStorei);
+    w.Put<uint32_t>(GL_UNPACK_ALIGNMENT);
+    w.Put<int32_t>(1);
+
+    for (auto& entry : mTextures)
+    {
+        const TextureInfo& info = entry.second;
+        if (info.bindTarget == 0 || info.images.empty()) continue;
+
+        glBindTexture(info.bindTarget, entry.first);
+        w.Begin(Op::BindTexture);
+        w.Put<uint32_t>(info.bindTarget);
+        w.Put<uint32_t>(entry.first);
+
+        for (const TexImage& image : info.images)
+        {
+            data.resize(ImageBytes(image.width, image.height, image.format, image.type, 1));
+            if (!data.empty())
+            {
+                glGetTexImage(image.target, image.level, image.format, image.type, data.data());
+            }
+
+            w.Begin(Op::TexImage2D);
+            w.Put<uint32_t>(image.target);
+            w.Put<int32_t>(image.level);
+            w.Put<int32_t>(image.internalFormat);
+            w.Put<int32_t>(image.width);
+            w.Put<int32_t>(image.height);
+            w.Put<uint32_t>(image.format);
+            w.Put<uint32_t>(image.type);
+            w.PutBytes(data.empty() ? nullptr : data.data(), data.size());
+        }
+
+        GLint minFilter = GL_NEAREST;
+        for (GLenum pname : kParams)
+        {
+            GLint value = 0;
+            glGetTexParameteriv(info.bindTarget, pname, &value);
+            if (pname == GL_TEXTURE_MIN_FILTER) minFilter = value;
+
+            w.Begin(Op::TexParameteri);
+            w.Put<uint32_t>(info.bindTarget);
+            w.Put<uint32_t>(pname);
+            w.Put<int32_t>(value);
+        }
+
+        // 下位レベルは記録していないので作り直す
+        if (IsMipmapFilter(minFilter))
+        {
+            w.Begin(Op::GenerateMipmap);
+            w.Put<uint32_t>(info.bindTarget);
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(prevTex2D));
+    glBindTexture(GL_TEXTURE_CUBE_MAP, static_cast<GLuint>(prevTexCube));
+    glActiveTexture(static_cast<GLenum>(prevUnit));
+    glPixelStorei(GL_PACK_ALIGNMENT, prevPackAlign);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(prevPackBuffer));
+}
+
+void GLRecorder::WriteRenderbuffers()
+{
+    GLCapture::Writer w(mStream);
+
+    GLint prev = 0;
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, &prev);
+
+    for (GLuint rb : mRenderbuffers)
+    {
+        if (!glIsRenderbuffer(rb)) continue;
+
+        glBindRenderbuffer(GL_RENDERBUFFER, rb);
+        GLint format = 0, width = 0, height = 0;
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &format);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH,  &width);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &height);
+
+        w.Begin(Op::BindRenderbuffer);
+        w.Put<uint32_t>(GL_RENDERBUFFER);
+        w.Put<uint32_t>(rb);
+        if (width > 0 && height > 0)
+        {
+            w.Begin(Op::RenderbufferStorage);
+            w.Put<uint32_t>(GL_RENDERBUFFER);
+            w.Put<uint32_t>(static_cast<uint32_t>(format));
+            w.Put<int32_t>(width);
+            w.Put<int32_t>(height);
+        }
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, static_cast<GLuint>(prev));
+}
+
+//-------------------------------------------------------------
+// シェーダとプログラム
+//   ソース・変換フィードバックの出力・ブロックの割り当て・uniform の今の値
+//   （削除済みでもプログラムに付いたままのシェーダはここで作る）
+//-------------------------------------------------------------
+void GLRecorder::WritePrograms()
+{
+    GLCapture::Writer w(mStream);
+    std::unordered_set<GLuint> written;
+
+    auto writeShader = [&](GLuint shader) {
+        if (!written.insert(shader).second) return;
+
+        GLint type = 0, length = 0;
+        glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+        glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &length);
+        std::string source(static_cast<size_t>(std::max(length, 1)), '\0');
+        GLsizei sourceLength = 0;
+        glGetShaderSource(shader, static_cast<GLsizei>(source.size()), &sourceLength, &source[0]);
+        source.resize(static_cast<size_t>(sourceLength));
+
+        w.Begin(Op::CreateShader);
+        w.Put<uint32_t>(static_cast<uint32_t>(type));
+        w.Put<uint32_t>(shader);
+        w.Begin(Op::ShaderSource);
+        w.Put<uint32_t>(shader);
+        w.PutString(source);
+        w.Begin(Op::CompileShader);
+        w.Put<uint32_t>(shader);
+    };
+
+    for (auto& s : mShaders) writeShader(s.first);
+
+    GLint prevProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+
+    for (GLuint program : mPrograms)
+    {
+        w.Begin(Op::CreateProgram);
+        w.Put<uint32_t>(program);
+
+        GLuint  shaders[8];
+        GLsizei numShaders = 0;
+        glGetAttachedShaders(program, 8, &numShaders, shaders);
+        for (GLsizei i = 0; i < numShaders; ++i)
+        {
+            writeShader(shaders[i]);
+            w.Begin(Op::AttachShader);
+            w.Put<uint32_t>(program);
+            w.Put<uint32_t>(shaders[i]);
+        }
+
+        GLint numVaryings = 0, tfMode = GL_INTERLEAVED_ATTRIBS;
+        glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_VARYINGS, &numVaryings);
+        glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_BUFFER_MODE, &tfMode);
+        if (numVaryings > 0)
+        {
+            w.Begin(Op::TransformFeedbackVaryings);
+            w.Put<uint32_t>(program);
+            w.Put<uint32_t>(static_cast<uint32_t>(tfMode));
+            w.Put<int32_t>(numVaryings);
+            for (GLint i = 0; i < numVaryings; ++i)
+            {
+                char    name[256];
+                GLsizei length = 0;
+                GLsizei size   = 0;
+                GLenum  type   = 0;
+                glGetTransformFeedbackVarying(program, static_cast<GLuint>(i), sizeof(name), &length, &size, &type, name);
+                w.PutString(std::string(name, length));
+            }
+        }
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) continue;
+
+        w.Begin(Op::LinkProgram);
+        w.Put<uint32_t>(program);
+
+        // uniform ブロックの割り当て
+        GLint numBlocks = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &numBlocks);
+        for (GLint i = 0; i < numBlocks; ++i)
+        {
+            char    name[256];
+            GLsizei length  = 0;
+            GLint   binding = 0;
+            glGetActiveUniformBlockName(program, static_cast<GLuint>(i), sizeof(name), &length, name);
+            glGetActiveUniformBlockiv(program, static_cast<GLuint>(i), GL_UNIFORM_BLOCK_BINDING, &binding);
+
+            w.Begin(Op::UniformBlockBinding);
+            w.Put<uint32_t>(program);
+            w.PutString(std::string(name, length));
+            w.Put<uint32_t>(static_cast<uint32_t>(binding));
+        }
+
+        // uniform の今の値（ブロック内のものはバッファ側にある）
+        w.Begin(Op::UseProgram);
+        w.Put<uint32_t>(program);
+        for (auto& entry : mUniformNames[program])
+        {
+            GLint location = entry.first;
+            GLint blockIndex = -1;
+            GLuint index = GL_INVALID_INDEX;
+            const char* name = entry.second.c_str();
+            glGetUniformIndices(program, 1, &name, &index);
+            if (index == GL_INVALID_INDEX) continue;
+            glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+            if (blockIndex >= 0) continue;
+
+            GLint type = 0;
+            glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_TYPE, &type);
+
+            UniformKind kind;
+            size_t      count = 1;
+            switch (type)
+            {
+            case GL_FLOAT:      kind = UniformKind::Float1;  count = 1;  break;
+            case GL_FLOAT_VEC2: kind = UniformKind::Float2;  count = 2;  break;
+            case GL_FLOAT_VEC3: kind = UniformKind::Float3;  count = 3;  break;
+            case GL_FLOAT_VEC4: kind = UniformKind::Float4;  count = 4;  break;
+            case GL_FLOAT_MAT4: kind = UniformKind::Matrix4; count = 16; break;
+            case GL_INT:
+            case GL_BOOL:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_3D:
+                kind = UniformKind::Int1; count = 1; break;
+            default:
+                continue;
+            }
+
+            float values[16];
+            GLint ivalue = 0;
+            const void* data = values;
+            size_t bytes = sizeof(float) * count;
+            if (kind == UniformKind::Int1)
+            {
+                glGetUniformiv(program, location, &ivalue);
+                data  = &ivalue;
+                bytes = sizeof(ivalue);
+            }
+            else
+            {
+                glGetUniformfv(program, location, values);
+            }
+
+            w.Begin(Op::Uniform);
+            w.Put<uint8_t>(static_cast<uint8_t>(kind));
+            w.PutString(entry.second);
+            w.Put<int32_t>(1);
+            w.Put<uint8_t>(GL_FALSE);       // glGetUniformfv は列優先で返す
+            w.PutBytes(data, bytes);
+        }
+    }
+
+    glUseProgram(static_cast<GLuint>(prevProgram));
+}
+
+//-------------------------------------------------------------
+// 頂点配列：属性と要素バッファ
+//-------------------------------------------------------------
+void GLRecorder::WriteVertexArrays()
+{
+    GLCapture::Writer w(mStream);
+
+    GLint prevVAO = 0, maxAttribs = 16;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &prevVAO);
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttribs);
+    maxAttribs = std::min(maxAttribs, 16);
+
+    for (GLuint vao : mVertexArrays)
+    {
+        if (!glIsVertexArray(vao)) continue;
+
+        glBindVertexArray(vao);
+        w.Begin(Op::BindVertexArray);
+        w.Put<uint32_t>(vao);
+
+        for (GLint i = 0; i < maxAttribs; ++i)
+        {
+            GLint enabled = 0, size = 4, type = GL_FLOAT, normalized = 0, integer = 0;
+            GLint stride = 0, buffer = 0, divisor = 0;
+            void* pointer = nullptr;
+            GLuint index = static_cast<GLuint>(i);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &buffer);
+            if (buffer == 0) continue;
+
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_ENABLED,    &enabled);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_SIZE,       &size);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_TYPE,       &type);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_INTEGER,    &integer);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_STRIDE,     &stride);
+            glGetVertexAttribiv(index, GL_VERTEX_ATTRIB_ARRAY_DIVISOR,    &divisor);
+            glGetVertexAttribPointerv(index, GL_VERTEX_ATTRIB_ARRAY_POINTER, &pointer);
+
+            w.Begin(Op::BindBuffer);
+            w.Put<uint32_t>(GL_ARRAY_BUFFER);
+            w.Put<uint32_t>(static_cast<uint32_t>(buffer));
+
+            w.Begin(integer ? Op::VertexAttribIPointer : Op::VertexAttribPointer);
+            w.Put<uint32_t>(index);
+            w.Put<int32_t>(size);
+            w.Put<uint32_t>(static_cast<uint32_t>(type));
+            if (!integer) w.Put<uint8_t>(normalized ? GL_TRUE : GL_FALSE);
+            w.Put<int32_t>(stride);
+            w.Put<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+
+            w.Begin(Op::VertexAttribDivisor);
+            w.Put<uint32_t>(index);
+            w.Put<uint32_t>(static_cast<uint32_t>(divisor));
+
+            w.Begin(enabled ? Op::EnableVertexAttribArray : Op::DisableVertexAttribArray);
+            w.Put<uint32_t>(index);
+        }
+
+        GLint elementBuffer = 0;
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+        w.Begin(Op::BindBuffer);
+        w.Put<uint32_t>(GL_ELEMENT_ARRAY_BUFFER);
+        w.Put<uint32_t>(static_cast<uint32_t>(elementBuffer));
+    }
+
+    glBindVertexArray(static_cast<GLuint>(prevVAO));
+}
+
+//-------------------------------------------------------------
+// フレームバッファ：アタッチメントと描画先・読み出し元
+//-------------------------------------------------------------
+void GLRecorder::WriteFramebuffers()
+{
+    GLCapture::Writer w(mStream);
+
+    GLint prevDraw = 0, prevRead = 0, maxDrawBuffers = 8;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDraw);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevRead);
+    glGetIntegerv(GL_MAX_DRAW_BUFFERS, &maxDrawBuffers);
+    maxDrawBuffers = std::min(maxDrawBuffers, 8);
+
+    std::vector<GLenum> attachments = { GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT };
+    for (GLint i = 0; i < maxDrawBuffers; ++i)
+    {
+        attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+    }
+
+    for (GLuint fbo : mFramebuffers)
+    {
+        if (!glIsFramebuffer(fbo)) continue;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        w.Begin(Op::BindFramebuffer);
+        w.Put<uint32_t>(GL_FRAMEBUFFER);
+        w.Put<uint32_t>(fbo);
+
+        for (GLenum attachment : attachments)
+        {
+            GLint type = GL_NONE, name = 0;
+            glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                                  GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+            if (type == GL_NONE) continue;
+            glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                                  GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &name);
+
+            if (type == GL_RENDERBUFFER)
+            {
+                w.Begin(Op::FramebufferRenderbuffer);
+                w.Put<uint32_t>(GL_FRAMEBUFFER);
+                w.Put<uint32_t>(attachment);
+                w.Put<uint32_t>(GL_RENDERBUFFER);
+                w.Put<uint32_t>(static_cast<uint32_t>(name));
+                continue;
+            }
+
+            GLint level = 0, face = 0;
+            glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                                  GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &level);
+            glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, attachment,
+                                                  GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE, &face);
+
+            GLenum texTarget = GL_TEXTURE_2D;
+            if (face != 0)
+            {
+                texTarget = static_cast<GLenum>(face);
+            }
+
+            w.Begin(Op::FramebufferTexture2D);
+            w.Put<uint32_t>(GL_FRAMEBUFFER);
+            w.Put<uint32_t>(attachment);
+            w.Put<uint32_t>(texTarget);
+            w.Put<uint32_t>(static_cast<uint32_t>(name));
+            w.Put<int32_t>(level);
+        }
+
+        std::vector<uint32_t> drawBuffers;
+        for (GLint i = 0; i < maxDrawBuffers; ++i)
+        {
+            GLint buf = GL_NONE;
+            glGetIntegerv(GL_DRAW_BUFFER0 + i, &buf);
+            drawBuffers.push_back(static_cast<uint32_t>(buf));
+        }
+        while (drawBuffers.size() > 1 && drawBuffers.back() == GL_NONE) drawBuffers.pop_back();
+
+        w.Begin(Op::DrawBuffers);
+        w.Put<int32_t>(static_cast<int32_t>(drawBuffers.size()));
+        for (uint32_t buf : drawBuffers) w.Put<uint32_t>(buf);
+
+        GLint readBuffer = GL_NONE;
+        glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+        w.Begin(Op::ReadBuffer);
+        w.Put<uint32_t>(static_cast<uint32_t>(readBuffer));
+    }
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(prevDraw));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevRead));
+}
+
+//-------------------------------------------------------------
+// 今のバインドと固定機能の状態
+//-------------------------------------------------------------
+void GLRecorder::WriteGlobalState()
+{
+    GLCapture::Writer w(mStream);
+
+    auto getInt = [](GLenum pname) {
+        GLint v = 0;
+        glGetIntegerv(pname, &v);
+        return v;
+    };
+    auto bind = [&](Op op, GLenum target, GLint name) {
+        w.Begin(op);
+        w.Put<uint32_t>(target);
+        w.Put<uint32_t>(static_cast<uint32_t>(name));
+    };
+
+    // uniform バッファの割り当て
+    GLint maxUBO = std::min(getInt(GL_MAX_UNIFORM_BUFFER_BINDINGS), 32);
+    for (GLint i = 0; i < maxUBO; ++i)
+    {
+        GLint     buffer = 0;
+        GLint64   start = 0, size = 0;
+        GLuint index = static_cast<GLuint>(i);
+        glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, index, &buffer);
+        if (buffer == 0) continue;
+        glGetInteger64i_v(GL_UNIFORM_BUFFER_START, index, &start);
+        glGetInteger64i_v(GL_UNIFORM_BUFFER_SIZE,  index, &size);
+
+        if (size == 0)
+        {
+            w.Begin(Op::BindBufferBase);
+            w.Put<uint32_t>(GL_UNIFORM_BUFFER);
+            w.Put<uint32_t>(index);
+            w.Put<uint32_t>(static_cast<uint32_t>(buffer));
+        }
+        else
+        {
+            w.Begin(Op::BindBufferRange);
+            w.Put<uint32_t>(GL_UNIFORM_BUFFER);
+            w.Put<uint32_t>(index);
+            w.Put<uint32_t>(static_cast<uint32_t>(buffer));
+            w.Put<int64_t>(start);
+            w.Put<int64_t>(size);
+        }
+    }
+
+    // テクスチャユニット
+    GLint activeUnit = getInt(GL_ACTIVE_TEXTURE);
+    GLint maxUnits   = std::min(getInt(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS), 16);
+    for (GLint u = 0; u < maxUnits; ++u)
+    {
+        glActiveTexture(GL_TEXTURE0 + u);
+        GLint tex2D   = getInt(GL_TEXTURE_BINDING_2D);
+        GLint texCube = getInt(GL_TEXTURE_BINDING_CUBE_MAP);
+        GLint texArr  = getInt(GL_TEXTURE_BINDING_2D_ARRAY);
+
+        w.Begin(Op::ActiveTexture);
+        w.Put<uint32_t>(GL_TEXTURE0 + u);
+        bind(Op::BindTexture, GL_TEXTURE_2D,       tex2D);
+        bind(Op::BindTexture, GL_TEXTURE_CUBE_MAP, texCube);
+        bind(Op::BindTexture, GL_TEXTURE_2D_ARRAY, texArr);
+    }
+    glActiveTexture(static_cast<GLenum>(activeUnit));
+    w.Begin(Op::ActiveTexture);
+    w.Put<uint32_t>(static_cast<uint32_t>(activeUnit));
+
+    // バッファ・頂点配列・プログラム・フレームバッファ
+    bind(Op::BindBuffer, GL_ARRAY_BUFFER,              getInt(GL_ARRAY_BUFFER_BINDING));
+    bind(Op::BindBuffer, GL_UNIFORM_BUFFER,            getInt(GL_UNIFORM_BUFFER_BINDING));
+    bind(Op::BindBuffer, GL_PIXEL_PACK_BUFFER,         getInt(GL_PIXEL_PACK_BUFFER_BINDING));
+    bind(Op::BindBuffer, GL_PIXEL_UNPACK_BUFFER,       getInt(GL_PIXEL_UNPACK_BUFFER_BINDING));
+    bind(Op::BindBuffer, GL_COPY_READ_BUFFER,          getInt(GL_COPY_READ_BUFFER));
+    bind(Op::BindBuffer, GL_COPY_WRITE_BUFFER,         getInt(GL_COPY_WRITE_BUFFER));
+    bind(Op::BindTransformFeedback, GL_TRANSFORM_FEEDBACK, getInt(GL_TRANSFORM_FEEDBACK_BINDING));
+    bind(Op::BindBuffer, GL_TRANSFORM_FEEDBACK_BUFFER, getInt(GL_TRANSFORM_FEEDBACK_BUFFER_BINDING));
+
+    w.Begin(Op::BindVertexArray);
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_VERTEX_ARRAY_BINDING)));
+    w.Begin(Op::UseProgram);
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_CURRENT_PROGRAM)));
+    bind(Op::BindFramebuffer,  GL_DRAW_FRAMEBUFFER, getInt(GL_DRAW_FRAMEBUFFER_BINDING));
+    bind(Op::BindFramebuffer,  GL_READ_FRAMEBUFFER, getInt(GL_READ_FRAMEBUFFER_BINDING));
+    bind(Op::BindRenderbuffer, GL_RENDERBUFFER,     getInt(GL_RENDERBUFFER_BINDING));
+
+    // 有効・無効
+    static const GLenum kCaps[] = {
+        GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST,
+        GL_POLYGON_OFFSET_FILL, GL_RASTERIZER_DISCARD, GL_PROGRAM_POINT_SIZE,
+        GL_MULTISAMPLE, GL_FRAMEBUFFER_SRGB,
+    };
+    for (GLenum cap : kCaps)
+    {
+        w.Begin(glIsEnabled(cap) ? Op::Enable : Op::Disable);
+        w.Put<uint32_t>(cap);
+    }
+
+    w.Begin(Op::BlendFuncSeparate);
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_BLEND_SRC_RGB)));
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_BLEND_DST_RGB)));
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_BLEND_SRC_ALPHA)));
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_BLEND_DST_ALPHA)));
+
+    GLboolean depthMask = GL_TRUE;
+    GLboolean colorMask[4] = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+    w.Begin(Op::DepthMask);
+    w.Put<uint8_t>(depthMask);
+    w.Begin(Op::ColorMask);
+    for (GLboolean m : colorMask) w.Put<uint8_t>(m);
+
+    w.Begin(Op::FrontFace);
+    w.Put<uint32_t>(static_cast<uint32_t>(getInt(GL_FRONT_FACE)));
+
+    GLint viewport[4], scissor[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_SCISSOR_BOX, scissor);
+    w.Begin(Op::Viewport);
+    for (GLint v : viewport) w.Put<int32_t>(v);
+    w.Begin(Op::Scissor);
+    for (GLint v : scissor) w.Put<int32_t>(v);
+
+    GLfloat clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    w.Begin(Op::ClearColor);
+    for (GLfloat c : clearColor) w.Put<float>(c);
+
+    w.Begin(Op::PixelStorei);
+    w.Put<uint32_t>(GL_UNPACK_ALIGNMENT);
+    w.Put<int32_t>(getInt(GL_UNPACK_ALIGNMENT));
+    w.Begin(Op::PixelStorei);
+    w.Put<uint32_t>(GL_PACK_ALIGNMENT);
+    w.Put<int32_t>(getInt(GL_PACK_ALIGNMENT));
+}
+
+} // namespace toy
@@ -24,6 +24,12 @@ LightingManager::~LightingManager()
 //-------------------------------------------------------------
 void LightingManager::ApplyToShader(std::shared_ptr<Shader> shader,
                                     const Matrix4& viewMatrix)
+{
+    ApplyToShader(shader.get(), viewMatrix);
+}
+
+void LightingManager::ApplyToShader(Shader* shader,
+                                    const Matrix4& viewMatrix)
 {
     //---------------------------------------------------------
     // カメラ位置（シェーダーで Specular 計算等に利用）
@@ -0,0 +1,145 @@
+#include "Engine/Render/MaterialBuffer.h"
+#include "Engine/Render/Shader.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace toy {
+
+MaterialBuffer::MaterialBuffer()
+: mUBO(0)
+, mStride(0)
+, mCapacity(0)
+, mNextSlot(0)
+, mBoundSlot(-1)
+{
+}
+
+MaterialBuffer::~MaterialBuffer()
+{
+    // 実際の解放処理は Shutdown() 側で行う前提
+}
+
+//-------------------------------------------------------------
+// 初期化
+//   - スロット間隔は GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT に揃える
+//     （glBindBufferRange のオフセット制約）
+//-------------------------------------------------------------
+bool MaterialBuffer::Initialize(int capacity)
+{
+    GLint align = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+    if (align <= 0)
+    {
+        align = 256;
+    }
+
+    const GLsizeiptr blockSize = static_cast<GLsizeiptr>(sizeof(MaterialBlock));
+    mStride = ((blockSize + align - 1) / align) * align;
+
+    glGenBuffers(1, &mUBO);
+    if (mUBO == 0)
+    {
+        std::cerr << "[MaterialBuffer] Failed to create UBO" << std::endl;
+        return false;
+    }
+
+    Grow(capacity > 0 ? capacity : 1);
+    return true;
+}
+
+void MaterialBuffer::Shutdown()
+{
+    if (mUBO)
+    {
+        glDeleteBuffers(1, &mUBO);
+        mUBO = 0;
+    }
+    mCapacity  = 0;
+    mNextSlot  = 0;
+    mBoundSlot = -1;
+    mFreeSlots.clear();
+    mMirror.clear();
+}
+
+//-------------------------------------------------------------
+// スロット確保／解放
+//-------------------------------------------------------------
+int MaterialBuffer::Allocate()
+{
+    if (!mFreeSlots.empty())
+    {
+        int slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        return slot;
+    }
+
+    if (mNextSlot >= mCapacity)
+    {
+        Grow(mCapacity * 2);
+    }
+    return mNextSlot++;
+}
+
+void MaterialBuffer::Release(int slot)
+{
+    if (slot < 0 || slot >= mNextSlot) return;
+    mFreeSlots.push_back(slot);
+}
+
+//-------------------------------------------------------------
+// 書き込み
+//-------------------------------------------------------------
+void MaterialBuffer::Upload(int slot, const MaterialBlock& block)
+{
+    if (!mUBO || slot < 0 || slot >= mCapacity) return;
+
+    mMirror[slot] = block;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER,
+                    slot * mStride,
+                    sizeof(MaterialBlock),
+                    &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+//-------------------------------------------------------------
+// バインド
+//-------------------------------------------------------------
+void MaterialBuffer::Bind(int slot)
+{
+    if (!mUBO || slot < 0 || slot == mBoundSlot) return;
+
+    glBindBufferRange(GL_UNIFORM_BUFFER,
+                      UBB_MATERIAL,
+                      mUBO,
+                      slot * mStride,
+                      sizeof(MaterialBlock));
+    mBoundSlot = slot;
+}
+
+//-------------------------------------------------------------
+// 容量拡張
+//   - glBufferData で確保し直し、ミラーから全スロットを詰め直す
+//-------------------------------------------------------------
+void MaterialBuffer::Grow(int newCapacity)
+{
+    mCapacity = newCapacity;
+    mMirror.resize(mCapacity);
+
+    std::vector<unsigned char> staging(static_cast<size_t>(mStride * mCapacity), 0);
+    for (int i = 0; i < mNextSlot; ++i)
+    {
+        std::memcpy(&staging[static_cast<size_t>(i * mStride)], &mMirror[i], sizeof(MaterialBlock));
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, mUBO);
+    glBufferData(GL_UNIFORM_BUFFER, mStride * mCapacity, staging.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // ストレージが変わったのでバインドし直させる
+    mBoundSlot = -1;
+}
+
+} // namespace toy
@@ -0,0 +1,194 @@
+#include "Engine/Render/MeshDrawQueue.h"
+#include "Engine/Render/Renderer.h"
+#include "Engine/Render/Shader.h"
+#include "Engine/Render/LightingManager.h"
+#include "Engine/Render/MaterialBuffer.h"
+#include "Graphics/Mesh/MeshComponent.h"
+#include "Asset/Material/Material.h"
+#include "Asset/Material/Texture.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Asset/Geometry/Meshlet.h"
+#include "glad/glad.h"
+
+#include <algorithm>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// ソートキーのビット割り当て
+//   [63..62] パス
+//   [61..46] シェーダプログラム ID
+//   [45..24] マテリアルスロット
+//   [23.. 0] コンポーネントの追加順
+//-------------------------------------------------------------
+namespace {
+
+uint64_t MakeSortKey(MeshDrawPass pass, uint32_t program, uint32_t material, uint32_t sequence)
+{
+    return (static_cast<uint64_t>(pass)                   << 62)
+         | (static_cast<uint64_t>(program  & 0xFFFF)      << 46)
+         | (static_cast<uint64_t>(material & 0x3FFFFF)    << 24)
+         |  static_cast<uint64_t>(sequence & 0xFFFFFF);
+}
+
+} // namespace
+
+
+MeshDrawQueue::MeshDrawQueue()
+: mSequence(0)
+, mShaderSwitches(0)
+, mMaterialBinds(0)
+, mMultiDraws(0)
+{
+}
+
+void MeshDrawQueue::Clear()
+{
+    mItems.clear();
+    mSequence = 0;
+}
+
+//-------------------------------------------------------------
+// 要求を追加
+//   - 同じコンポーネントから続けて積まれたものは同じ追加順を持つ
+//-------------------------------------------------------------
+void MeshDrawQueue::Add(const MeshDrawItem& item, int materialSlot)
+{
+    if (!item.comp || !item.va || !item.shader) return;
+
+    if (mItems.empty() || mItems.back().comp != item.comp)
+    {
+        ++mSequence;
+    }
+
+    mItems.push_back(item);
+    mItems.back().sortKey = MakeSortKey(item.pass,
+                                        item.shader->GetProgramID(),
+                                        static_cast<uint32_t>(materialSlot < 0 ? 0 : materialSlot),
+                                        mSequence);
+}
+
+//-------------------------------------------------------------
+// ソートして描画
+//   - シェーダが変わった時だけフレーム共通 uniform を設定
+//   - コンポーネントが変わった時だけワールド行列等を設定
+//   - マテリアルが変わった時だけ UBO スロットをバインド
+//-------------------------------------------------------------
+void MeshDrawQueue::Execute(Renderer* renderer)
+{
+    mShaderSwitches = 0;
+    mMaterialBinds  = 0;
+    mMultiDraws     = 0;
+    if (mItems.empty()) return;
+
+    std::sort(mItems.begin(), mItems.end(),
+              [](const MeshDrawItem& a, const MeshDrawItem& b)
+              {
+                  return a.sortKey < b.sortKey;
+              });
+
+    Matrix4 view     = renderer->GetViewMatrix();
+    Matrix4 viewProj = view * renderer->GetProjectionMatrix();
+    Matrix4 light    = renderer->GetLightSpaceMatrix();
+    auto lighting    = renderer->GetLightingManager();
+    auto materials   = renderer->GetMaterialBuffer();
+    bool  useShadow  = renderer->IsShadowMapActive();
+
+    // シャドウマップはユニット1に固定
+    if (useShadow)
+    {
+        renderer->GetShadowMapTexture()->SetActive(1);
+    }
+
+    // 別の描画が UBO を触っている可能性があるので最初は必ずバインド
+    materials->InvalidateBinding();
+
+    Shader*        curShader = nullptr;
+    MeshComponent* curComp   = nullptr;
+    Material*      curMat    = nullptr;
+    MeshDrawPass   curPass   = MeshDrawPass::Main;
+
+    glFrontFace(GL_CCW);
+
+    for (const auto& item : mItems)
+    {
+        //-----------------------------------------------------
+        // パス切り替え（輪郭は裏面を描く）
+        //-----------------------------------------------------
+        if (item.pass != curPass)
+        {
+            glFrontFace(item.pass == MeshDrawPass::Outline ? GL_CW : GL_CCW);
+            curPass = item.pass;
+            curComp = nullptr;   // 輪郭はワールド行列が異なる
+        }
+
+        //-----------------------------------------------------
+        // シェーダ切り替え → フレーム共通 uniform
+        //-----------------------------------------------------
+        if (item.shader != curShader)
+        {
+            curShader = item.shader;
+            curShader->SetActive();
+            ++mShaderSwitches;
+
+            lighting->ApplyToShader(curShader, view);
+
+            curShader->SetMatrixUniform("uViewProj", viewProj);
+            curShader->SetTextureUniform("uTexture", 0);
+            if (useShadow)
+            {
+                curShader->SetMatrixUniform("uLightSpaceMatrix", light);
+                curShader->SetTextureUniform("uShadowMap", 1);
+                curShader->SetFloatUniform("uShadowBias", 0.005f);
+            }
+            curComp = nullptr;
+        }
+
+        //-----------------------------------------------------
+        // オブジェクト単位の uniform（ワールド行列・ボーン等）
+        //-----------------------------------------------------
+        if (item.comp != curComp)
+        {
+            curComp = item.comp;
+            curComp->SetObjectUniforms(curShader, item.pass);
+        }
+
+        //-----------------------------------------------------
+        // マテリアル
+        //-----------------------------------------------------
+        if (item.pass == MeshDrawPass::Main)
+        {
+            if (item.material && item.material != curMat)
+            {
+                item.material->Bind(materials, 0);
+                curMat = item.material;
+                ++mMaterialBinds;
+            }
+        }
+        else
+        {
+            Vector3 color = (item.pass == MeshDrawPass::OverrideColor && item.material)
+                          ? item.material->GetUniformColor()
+                          : Vector3(0.f, 0.f, 0.f);
+            curShader->SetVectorUniform("uUniformColor", color);
+        }
+
+        item.va->SetActive();
+        if (item.ranges)
+        {
+            // カリングを通ったメッシュレットだけ（連続したものは 1 範囲）
+            glMultiDrawElements(GL_TRIANGLES, item.ranges->counts.data(), GL_UNSIGNED_INT,
+                                item.ranges->offsets.data(),
+                                static_cast<GLsizei>(item.ranges->counts.size()));
+            ++mMultiDraws;
+        }
+        else
+        {
+            glDrawElements(GL_TRIANGLES, item.va->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+        }
+    }
+
+    glFrontFace(GL_CCW);
+}
+
+} // namespace toy
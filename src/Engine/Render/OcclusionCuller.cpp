@@ -0,0 +1,344 @@
+#include "Engine/Render/OcclusionCuller.h"
+#include "Asset/Geometry/Polygon.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TOY_OCCLUSION_SSE 1
+#endif
+
+namespace toy {
+
+namespace {
+
+// これより w が小さい（カメラ近傍・背後）頂点を含むものは扱わない
+//   - 遮蔽物側：描かない（遮蔽が減るだけなので安全）
+//   - 判定側  ：見えるとする
+const float kNearW = 0.01f;
+
+struct ClipPos
+{
+    float x, y, z, w;
+};
+
+// 行ベクトル規約（v * M）でクリップ座標へ
+inline ClipPos ToClip(const Vector3& v, const Matrix4& m)
+{
+    ClipPos c;
+    c.x = v.x * m.mat[0][0] + v.y * m.mat[1][0] + v.z * m.mat[2][0] + m.mat[3][0];
+    c.y = v.x * m.mat[0][1] + v.y * m.mat[1][1] + v.z * m.mat[2][1] + m.mat[3][1];
+    c.z = v.x * m.mat[0][2] + v.y * m.mat[1][2] + v.z * m.mat[2][2] + m.mat[3][2];
+    c.w = v.x * m.mat[0][3] + v.y * m.mat[1][3] + v.z * m.mat[2][3] + m.mat[3][3];
+    return c;
+}
+
+// クリップ座標 → ピクセル座標
+inline float ToScreenX(const ClipPos& c)
+{
+    return (c.x / c.w * 0.5f + 0.5f) * OcclusionCuller::kWidth;
+}
+
+inline float ToScreenY(const ClipPos& c)
+{
+    return (c.y / c.w * 0.5f + 0.5f) * OcclusionCuller::kHeight;
+}
+
+} // namespace
+
+
+OcclusionCuller::OcclusionCuller()
+: mViewProj(Matrix4::Identity)
+, mDepth(static_cast<size_t>(kWidth * kHeight), 0.0f)
+, mGeneration(0)
+, mPending(0)
+, mIsQuitting(false)
+{
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    Shutdown();
+}
+
+//-------------------------------------------------------------
+// 初期化／終了
+//-------------------------------------------------------------
+void OcclusionCuller::Initialize(unsigned int numWorkers)
+{
+    Shutdown();
+
+    mIsQuitting = false;
+    for (unsigned int i = 0; i < numWorkers; ++i)
+    {
+        mWorkers.emplace_back(&OcclusionCuller::WorkerMain, this, i);
+    }
+}
+
+void OcclusionCuller::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsQuitting = true;
+    }
+    mStartCV.notify_all();
+
+    for (auto& t : mWorkers)
+    {
+        if (t.joinable()) t.join();
+    }
+    mWorkers.clear();
+}
+
+//-------------------------------------------------------------
+// フレーム開始
+//-------------------------------------------------------------
+void OcclusionCuller::BeginFrame(const Matrix4& viewProj)
+{
+    mViewProj = viewProj;
+    mTris.clear();
+    mStats = OcclusionStats();
+    std::fill(mDepth.begin(), mDepth.end(), 0.0f);
+}
+
+//-------------------------------------------------------------
+// 遮蔽物の追加
+//   - 三角形をここで画面空間へ変換しておき、帯ごとの処理では
+//     ピクセルを塗るだけにする
+//-------------------------------------------------------------
+void OcclusionCuller::AddOccluder(const Polygon* polys, size_t count, const Matrix4& world)
+{
+    if (!polys || count == 0) return;
+
+    Matrix4 m = world * mViewProj;
+    ++mStats.occluders;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ClipPos c[3] =
+        {
+            ToClip(polys[i].a, m),
+            ToClip(polys[i].b, m),
+            ToClip(polys[i].c, m),
+        };
+        if (c[0].w < kNearW || c[1].w < kNearW || c[2].w < kNearW) continue;
+
+        ScreenTri tri;
+        for (int k = 0; k < 3; ++k)
+        {
+            tri.x[k] = ToScreenX(c[k]);
+            tri.y[k] = ToScreenY(c[k]);
+            tri.z[k] = 1.0f / c[k].w;
+        }
+
+        // 画面外は捨てる
+        float minX = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+        float maxX = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+        float minY = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+        float maxY = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+        if (maxX < 0.0f || minX >= kWidth || maxY < 0.0f || minY >= kHeight) continue;
+
+        mTris.push_back(tri);
+    }
+    mStats.occluderTris = static_cast<unsigned int>(mTris.size());
+}
+
+//-------------------------------------------------------------
+// ラスタライズ
+//   - 帯 0 はメインスレッド、帯 1.. は各ワーカーが担当
+//-------------------------------------------------------------
+void OcclusionCuller::Rasterize()
+{
+    if (mTris.empty()) return;
+
+    if (mWorkers.empty())
+    {
+        RasterizeBand(0, kHeight);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending = static_cast<unsigned int>(mWorkers.size());
+        ++mGeneration;
+    }
+    mStartCV.notify_all();
+
+    const int numBands = static_cast<int>(mWorkers.size()) + 1;
+    RasterizeBand(0, kHeight / numBands);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCV.wait(lock, [this] { return mPending == 0; });
+}
+
+void OcclusionCuller::WorkerMain(unsigned int index)
+{
+    unsigned int seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStartCV.wait(lock, [&] { return mIsQuitting || mGeneration != seen; });
+            if (mIsQuitting) return;
+            seen = mGeneration;
+        }
+
+        const int numBands = static_cast<int>(mWorkers.size()) + 1;
+        const int band     = static_cast<int>(index) + 1;
+        RasterizeBand(kHeight * band / numBands, kHeight * (band + 1) / numBands);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mPending;
+        }
+        mDoneCV.notify_one();
+    }
+}
+
+//-------------------------------------------------------------
+// 帯のラスタライズ
+//   - エッジ関数でピクセル中心の内外判定、1/w は重心座標で補間
+//   - 巻き順はどちらでも良い（面積の符号で揃える）
+//-------------------------------------------------------------
+void OcclusionCuller::RasterizeBand(int rowBegin, int rowEnd)
+{
+    for (const auto& t : mTris)
+    {
+        float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0])
+                   - (t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+        if (std::fabs(area) < Math::NearZeroEpsilon) continue;
+        float sign = (area > 0.0f) ? 1.0f : -1.0f;
+        float invArea = 1.0f / (area * sign);
+
+        int minX = std::max(0,           static_cast<int>(std::floor(std::min({ t.x[0], t.x[1], t.x[2] }))));
+        int maxX = std::min(kWidth - 1,  static_cast<int>(std::ceil (std::max({ t.x[0], t.x[1], t.x[2] }))));
+        int minY = std::max(rowBegin,    static_cast<int>(std::floor(std::min({ t.y[0], t.y[1], t.y[2] }))));
+        int maxY = std::min(rowEnd - 1,  static_cast<int>(std::ceil (std::max({ t.y[0], t.y[1], t.y[2] }))));
+        if (minX > maxX || minY > maxY) continue;
+
+        // エッジ i は頂点 (i+1, i+2) を結ぶ辺（重心座標 i に対応）
+        float stepX[3], stepY[3], rowStart[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            int a = (i + 1) % 3;
+            int b = (i + 2) % 3;
+            stepX[i] = -(t.y[b] - t.y[a]) * sign;
+            stepY[i] =  (t.x[b] - t.x[a]) * sign;
+
+            float px = minX + 0.5f;
+            float py = minY + 0.5f;
+            rowStart[i] = ((t.x[b] - t.x[a]) * (py - t.y[a])
+                         - (t.y[b] - t.y[a]) * (px - t.x[a])) * sign;
+        }
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            float w0 = rowStart[0];
+            float w1 = rowStart[1];
+            float w2 = rowStart[2];
+            float* row = &mDepth[static_cast<size_t>(y * kWidth)];
+
+            for (int x = minX; x <= maxX; ++x)
+            {
+                if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f)
+                {
+                    float d = (w0 * t.z[0] + w1 * t.z[1] + w2 * t.z[2]) * invArea;
+                    if (d > row[x])
+                    {
+                        row[x] = d;
+                    }
+                }
+                w0 += stepX[0];
+                w1 += stepX[1];
+                w2 += stepX[2];
+            }
+
+            rowStart[0] += stepY[0];
+            rowStart[1] += stepY[1];
+            rowStart[2] += stepY[2];
+        }
+    }
+}
+
+//-------------------------------------------------------------
+// 可視判定
+//   - AABB の 8 隅を投影した矩形と、その中で最も手前の 1/w を使う
+//-------------------------------------------------------------
+bool OcclusionCuller::IsVisible(const Cube& aabb)
+{
+    ++mStats.tested;
+
+    float minX =  Math::Infinity, minY =  Math::Infinity;
+    float maxX = -Math::Infinity, maxY = -Math::Infinity;
+    float nearest = 0.0f;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        Vector3 p((i & 1) ? aabb.max.x : aabb.min.x,
+                  (i & 2) ? aabb.max.y : aabb.min.y,
+                  (i & 4) ? aabb.max.z : aabb.min.z);
+        ClipPos c = ToClip(p, mViewProj);
+
+        // カメラをまたぐ箱は判定しない
+        if (c.w < kNearW) return true;
+
+        float sx = ToScreenX(c);
+        float sy = ToScreenY(c);
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+        nearest = std::max(nearest, 1.0f / c.w);
+    }
+
+    int x0 = std::max(0,           static_cast<int>(std::floor(minX)));
+    int x1 = std::min(kWidth - 1,  static_cast<int>(std::ceil(maxX)));
+    int y0 = std::max(0,           static_cast<int>(std::floor(minY)));
+    int y1 = std::min(kHeight - 1, static_cast<int>(std::ceil(maxY)));
+    if (x0 > x1 || y0 > y1) return true;
+
+    if (IsRectOccluded(x0, y0, x1, y1, nearest))
+    {
+        ++mStats.culled;
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------
+// 矩形判定
+//   - 1 ピクセルでも「遮蔽物が無い／箱より奥」なら見える
+//   - SSE2 があれば 4 ピクセルずつ比較
+//-------------------------------------------------------------
+bool OcclusionCuller::IsRectOccluded(int x0, int y0, int x1, int y1, float depth) const
+{
+    for (int y = y0; y <= y1; ++y)
+    {
+        const float* row = &mDepth[static_cast<size_t>(y * kWidth)];
+        int x = x0;
+
+#ifdef TOY_OCCLUSION_SSE
+        const __m128 ref = _mm_set1_ps(depth);
+        for (; x + 3 <= x1; x += 4)
+        {
+            __m128 occ = _mm_loadu_ps(row + x);
+            if (_mm_movemask_ps(_mm_cmple_ps(occ, ref)) != 0)
+            {
+                return false;
+            }
+        }
+#endif
+
+        for (; x <= x1; ++x)
+        {
+            if (row[x] <= depth)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace toy
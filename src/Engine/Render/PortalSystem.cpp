@@ -0,0 +1,427 @@
+#include "Engine/Render/PortalSystem.h"
+#include "Engine/Core/Actor.h"
+#include "Utils/JsonHelper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace toy {
+
+namespace {
+
+// 再帰の深さ（通り抜けるポータルの数）の上限
+const int kMaxDepth = 16;
+
+// 1 セルが持てる視錐台の数（超えたらカメラの視錐台で代用＝保守的）
+const size_t kMaxViewsPerCell = 4;
+
+// カメラがポータル面にこれより近ければ切り詰めずに通す（戸口に立っている）
+const float kDoorwayEpsilon = 0.05f;
+
+// 凸多角形を平面の表側（Distance >= 0）で切る
+void ClipPolygon(const std::vector<Vector3>& in, const Plane& plane, std::vector<Vector3>& out)
+{
+    out.clear();
+    size_t count = in.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vector3& a = in[i];
+        const Vector3& b = in[(i + 1) % count];
+        float da = plane.Distance(a);
+        float db = plane.Distance(b);
+
+        if (da >= 0.0f)
+        {
+            out.push_back(a);
+        }
+        if ((da >= 0.0f) != (db >= 0.0f))
+        {
+            float t = da / (da - db);
+            out.push_back(a + (b - a) * t);
+        }
+    }
+}
+
+// AABB が全平面の表側に少しでもかかっているか
+bool PlanesIntersectAABB(const Plane* planes, uint32_t count, const Cube& box)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const Plane& p = planes[i];
+
+        // 法線方向に最も進んだ頂点
+        Vector3 v(p.normal.x >= 0.0f ? box.max.x : box.min.x,
+                  p.normal.y >= 0.0f ? box.max.y : box.min.y,
+                  p.normal.z >= 0.0f ? box.max.z : box.min.z);
+        if (p.Distance(v) < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ContainsPoint(const Cube& box, const Vector3& p)
+{
+    return p.x >= box.min.x && p.x <= box.max.x
+        && p.y >= box.min.y && p.y <= box.max.y
+        && p.z >= box.min.z && p.z <= box.max.z;
+}
+
+} // namespace
+
+
+PortalSystem::PortalSystem()
+: mEye(Vector3::Zero)
+, mFarPlane{ Vector3::Zero, 0.0f }
+, mIsActive(false)
+{
+}
+
+//=============================================================
+// レベルデータ
+//=============================================================
+
+int PortalSystem::AddCell(const std::string& name, const Cube& bounds)
+{
+    if (FindCell(name) >= 0)
+    {
+        std::cerr << "PortalSystem: duplicate cell " << name << std::endl;
+        return -1;
+    }
+
+    Cell cell;
+    cell.name   = name;
+    cell.bounds = bounds;
+    mCells.push_back(cell);
+    return static_cast<int>(mCells.size()) - 1;
+}
+
+bool PortalSystem::AddPortal(int cellA, int cellB, const Vector3 corners[4])
+{
+    int numCells = static_cast<int>(mCells.size());
+    if (cellA < 0 || cellA >= numCells || cellB < 0 || cellB >= numCells || cellA == cellB)
+    {
+        std::cerr << "PortalSystem: invalid portal cells " << cellA << ", " << cellB << std::endl;
+        return false;
+    }
+
+    Portal portal;
+    portal.cells[0] = cellA;
+    portal.cells[1] = cellB;
+    for (int i = 0; i < 4; ++i)
+    {
+        portal.corners[i] = corners[i];
+    }
+
+    Vector3 n = Vector3::Cross(corners[1] - corners[0], corners[2] - corners[0]);
+    if (n.Length() < Math::NearZeroEpsilon)
+    {
+        std::cerr << "PortalSystem: degenerate portal" << std::endl;
+        return false;
+    }
+    n.Normalize();
+    portal.plane.normal = n;
+    portal.plane.d      = -Vector3::Dot(n, corners[0]);
+
+    int index = static_cast<int>(mPortals.size());
+    mPortals.push_back(portal);
+    mCells[cellA].portals.push_back(index);
+    mCells[cellB].portals.push_back(index);
+    return true;
+}
+
+bool PortalSystem::LoadFromFile(const std::string& filePath)
+{
+    nlohmann::json data;
+    if (!JsonHelper::LoadFromFile(filePath, data))
+    {
+        std::cerr << "PortalSystem: failed to load " << filePath << std::endl;
+        return false;
+    }
+
+    Clear();
+
+    if (data.contains("cells") && data["cells"].is_array())
+    {
+        for (const auto& jc : data["cells"])
+        {
+            std::string name;
+            Cube bounds;
+            if (!JsonHelper::GetString(jc, "name", name) ||
+                !JsonHelper::GetVector3(jc, "min", bounds.min) ||
+                !JsonHelper::GetVector3(jc, "max", bounds.max))
+            {
+                std::cerr << "PortalSystem: cell needs name/min/max" << std::endl;
+                continue;
+            }
+            AddCell(name, bounds);
+        }
+    }
+
+    if (data.contains("portals") && data["portals"].is_array())
+    {
+        for (const auto& jp : data["portals"])
+        {
+            std::vector<std::string> names;
+            JsonHelper::GetStringArray(jp, "cells", names);
+            if (names.size() != 2 || !jp.contains("corners") ||
+                !jp["corners"].is_array() || jp["corners"].size() != 4)
+            {
+                std::cerr << "PortalSystem: portal needs 2 cells and 4 corners" << std::endl;
+                continue;
+            }
+
+            Vector3 corners[4];
+            bool valid = true;
+            for (int i = 0; i < 4; ++i)
+            {
+                const auto& jv = jp["corners"][i];
+                if (!jv.is_array() || jv.size() != 3)
+                {
+                    valid = false;
+                    break;
+                }
+                corners[i] = Vector3(jv[0].get<float>(), jv[1].get<float>(), jv[2].get<float>());
+            }
+            if (!valid)
+            {
+                std::cerr << "PortalSystem: invalid portal corner" << std::endl;
+                continue;
+            }
+
+            AddPortal(FindCell(names[0]), FindCell(names[1]), corners);
+        }
+    }
+
+    return true;
+}
+
+void PortalSystem::Clear()
+{
+    mCells.clear();
+    mPortals.clear();
+    mViewPlanes.clear();
+    mIsActive = false;
+}
+
+int PortalSystem::FindCell(const std::string& name) const
+{
+    for (size_t i = 0; i < mCells.size(); ++i)
+    {
+        if (mCells[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int PortalSystem::FindCellAt(const Vector3& pos) const
+{
+    for (size_t i = 0; i < mCells.size(); ++i)
+    {
+        if (ContainsPoint(mCells[i].bounds, pos)) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+//=============================================================
+// Actor の登録
+//=============================================================
+
+void PortalSystem::RegisterActor(Actor* actor, bool dynamic)
+{
+    if (!actor) return;
+    actor->SetPortalCell(FindCellAt(actor->GetWorldTransform().GetTranslation()), dynamic);
+}
+
+bool PortalSystem::RegisterActorInCell(Actor* actor, const std::string& cellName)
+{
+    if (!actor) return false;
+
+    int cell = FindCell(cellName);
+    if (cell < 0)
+    {
+        std::cerr << "PortalSystem: unknown cell " << cellName << std::endl;
+        return false;
+    }
+    actor->SetPortalCell(cell, false);
+    return true;
+}
+
+//=============================================================
+// 可視判定
+//=============================================================
+
+//-------------------------------------------------------------
+// フレーム開始
+//   - カメラのセルはカメラの視錐台（ニア面を除く）を使う
+//   - そこからポータルを通るたびに視錐台を切り詰めて隣へ
+//-------------------------------------------------------------
+bool PortalSystem::BeginFrame(const Frustum& cameraFrustum, const Vector3& eye)
+{
+    mStats = PortalStats();
+    mViewPlanes.clear();
+    for (auto& cell : mCells)
+    {
+        cell.views.clear();
+        cell.fullView = false;
+        cell.onPath   = false;
+    }
+
+    int start = FindCellAt(eye);
+    mIsActive = (start >= 0);
+    if (!mIsActive) return false;
+
+    mEye      = eye;
+    mFarPlane = cameraFrustum.planes[5];
+
+    // カメラのニア面（planes[4]）は使わない
+    //   戸口の手前ではポータルがニア面より手前に来て、丸ごと切り捨てられてしまうため
+    //   （通り抜けた先の視錐台はポータル面がニア面の代わりになる）
+    std::vector<Plane> planes = {
+        cameraFrustum.planes[0], cameraFrustum.planes[1],
+        cameraFrustum.planes[2], cameraFrustum.planes[3],
+        cameraFrustum.planes[5]
+    };
+    mCells[start].fullView = true;
+    Traverse(start, planes, 0);
+
+    for (const auto& cell : mCells)
+    {
+        if (IsReached(cell)) ++mStats.cellsReached;
+    }
+    return true;
+}
+
+void PortalSystem::Traverse(int cellIndex, const std::vector<Plane>& planes, int depth)
+{
+    Cell& cell = mCells[cellIndex];
+    if (depth > 0 && !cell.fullView)
+    {
+        if (cell.views.size() < kMaxViewsPerCell)
+        {
+            CellView view;
+            view.first = static_cast<uint32_t>(mViewPlanes.size());
+            view.count = static_cast<uint32_t>(planes.size());
+            mViewPlanes.insert(mViewPlanes.end(), planes.begin(), planes.end());
+            cell.views.push_back(view);
+        }
+        else
+        {
+            cell.fullView = true;
+        }
+    }
+
+    if (depth >= kMaxDepth) return;
+
+    cell.onPath = true;
+
+    std::vector<Vector3> poly;
+    std::vector<Vector3> clipped;
+    for (int portalIndex : cell.portals)
+    {
+        const Portal& portal = mPortals[portalIndex];
+        int next = (portal.cells[0] == cellIndex) ? portal.cells[1] : portal.cells[0];
+        if (mCells[next].onPath) continue;
+
+        // 戸口に立っているときは切り詰めずに通す
+        float eyeDist = portal.plane.Distance(mEye);
+        bool inDoorway = std::fabs(eyeDist) < kDoorwayEpsilon;
+
+        // ポータルを現在の視錐台で切る
+        poly.assign(portal.corners, portal.corners + 4);
+        for (const Plane& p : planes)
+        {
+            ClipPolygon(poly, p, clipped);
+            poly.swap(clipped);
+            if (poly.size() < 3) break;
+        }
+        if (poly.size() < 3) continue;
+
+        ++mStats.portalsPassed;
+
+        if (inDoorway)
+        {
+            Traverse(next, planes, depth + 1);
+            continue;
+        }
+
+        //-----------------------------------------------------
+        // 視点と切った多角形の各辺で側面を作る
+        //   + ポータル面（手前を捨てる）+ カメラのファー面
+        //-----------------------------------------------------
+        Vector3 center = Vector3::Zero;
+        for (const auto& v : poly) center += v;
+        center *= 1.0f / static_cast<float>(poly.size());
+
+        std::vector<Plane> sub;
+        sub.reserve(poly.size() + 2);
+        for (size_t i = 0; i < poly.size(); ++i)
+        {
+            const Vector3& a = poly[i];
+            const Vector3& b = poly[(i + 1) % poly.size()];
+            Vector3 n = Vector3::Cross(a - mEye, b - mEye);
+            float len = n.Length();
+            if (len < Math::NearZeroEpsilon) continue;
+            n *= 1.0f / len;
+
+            Plane side;
+            side.normal = n;
+            side.d      = -Vector3::Dot(n, mEye);
+            if (side.Distance(center) < 0.0f)
+            {
+                side.normal = side.normal * -1.0f;
+                side.d      = -side.d;
+            }
+            sub.push_back(side);
+        }
+
+        Plane nearPlane = portal.plane;
+        if (eyeDist > 0.0f)
+        {
+            nearPlane.normal = nearPlane.normal * -1.0f;
+            nearPlane.d      = -nearPlane.d;
+        }
+        sub.push_back(nearPlane);
+        sub.push_back(mFarPlane);
+
+        Traverse(next, sub, depth + 1);
+    }
+
+    cell.onPath = false;
+}
+
+//-------------------------------------------------------------
+// Actor の可視判定
+//   - セル外の Actor は判定しない（フラスタムのみ）
+//   - dynamic な Actor は AABB の中心からセルを引き直す
+//-------------------------------------------------------------
+bool PortalSystem::IsVisible(Actor* actor, const Cube& aabb)
+{
+    if (!mIsActive || !actor) return true;
+
+    if (actor->IsPortalCellDynamic())
+    {
+        Vector3 center = (aabb.min + aabb.max) * 0.5f;
+        actor->SetPortalCell(FindCellAt(center), true);
+    }
+
+    int cellIndex = actor->GetPortalCell();
+    if (cellIndex < 0 || cellIndex >= static_cast<int>(mCells.size())) return true;
+
+    const Cell& cell = mCells[cellIndex];
+    if (cell.fullView) return true;
+
+    for (const auto& view : cell.views)
+    {
+        if (PlanesIntersectAABB(&mViewPlanes[view.first], view.count, aabb))
+        {
+            return true;
+        }
+    }
+
+    ++mStats.culled;
+    return false;
+}
+
+} // namespace toy
@@ -0,0 +1,276 @@
+#include "Engine/Render/QualityGovernor.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace toy {
+
+QualityGovernor::QualityGovernor()
+: mBeginTicks(0)
+, mFrame(0)
+, mCpuMs(0.0f)
+, mGpuMs(0.0f)
+, mHasSample(false)
+, mHasGpu(false)
+, mOverFrames(0)
+, mUnderFrames(0)
+, mCooldown(0)
+{
+}
+
+void QualityGovernor::SetSettings(const QualityGovernorSettings& settings)
+{
+    mSettings = settings;
+    mSettings.smoothing      = std::min(std::max(mSettings.smoothing, 0.01f), 1.0f);
+    mSettings.holdFrames     = std::max(mSettings.holdFrames, 1);
+    mSettings.cooldownFrames = std::max(mSettings.cooldownFrames, 0);
+    mOverFrames  = 0;
+    mUnderFrames = 0;
+}
+
+//-------------------------------------------------------------
+// ノブ
+//-------------------------------------------------------------
+void QualityGovernor::AddKnob(const std::string& name, const std::vector<float>& values, int level,
+                              QualityBound bound, const ApplyFunc& apply)
+{
+    if (values.empty()) return;
+    RemoveKnob(name);
+
+    Knob knob;
+    knob.name     = name;
+    knob.values   = values;
+    knob.level    = std::min(std::max(level, 0), static_cast<int>(values.size()) - 1);
+    knob.maxLevel = knob.level;
+    knob.bound    = bound;
+    knob.apply    = apply;
+    if (knob.apply)
+    {
+        knob.apply(knob.values[knob.level]);
+    }
+    mKnobs.push_back(knob);
+}
+
+void QualityGovernor::RemoveKnob(const std::string& name)
+{
+    mKnobs.erase(std::remove_if(mKnobs.begin(), mKnobs.end(),
+                                [&name](const Knob& k) { return k.name == name; }),
+                 mKnobs.end());
+    mLowered.erase(std::remove(mLowered.begin(), mLowered.end(), name), mLowered.end());
+}
+
+bool QualityGovernor::SetKnobLevel(const std::string& name, int level)
+{
+    Knob* knob = FindKnob(name);
+    if (!knob) return false;
+
+    level = std::min(std::max(level, 0), static_cast<int>(knob->values.size()) - 1);
+    knob->maxLevel = level;
+    mLowered.erase(std::remove(mLowered.begin(), mLowered.end(), name), mLowered.end());
+    if (level != knob->level)
+    {
+        knob->level = level;
+        if (knob->apply)
+        {
+            knob->apply(knob->values[level]);
+        }
+    }
+    return true;
+}
+
+int QualityGovernor::GetKnobLevel(const std::string& name) const
+{
+    const Knob* knob = FindKnob(name);
+    return knob ? knob->level : -1;
+}
+
+QualityGovernor::Knob* QualityGovernor::FindKnob(const std::string& name)
+{
+    for (auto& k : mKnobs)
+    {
+        if (k.name == name) return &k;
+    }
+    return nullptr;
+}
+
+const QualityGovernor::Knob* QualityGovernor::FindKnob(const std::string& name) const
+{
+    for (const auto& k : mKnobs)
+    {
+        if (k.name == name) return &k;
+    }
+    return nullptr;
+}
+
+//-------------------------------------------------------------
+// フレーム
+//-------------------------------------------------------------
+void QualityGovernor::BeginFrame()
+{
+    mBeginTicks = SDL_GetTicksNS();
+}
+
+//-------------------------------------------------------------
+// EndFrame()
+//  1) CPU 時間（BeginFrame から）と GPU 時間を平滑化
+//  2) 重い方を目標と比べ、帯の外に居続けたフレーム数を数える
+//  3) holdFrames 続いたら 1 段下げる（戻すのは 2 倍続いたら）
+//-------------------------------------------------------------
+void QualityGovernor::EndFrame(float gpuMs)
+{
+    ++mFrame;
+    if (mBeginTicks == 0) return;
+
+    float cpuMs = static_cast<float>(static_cast<double>(SDL_GetTicksNS() - mBeginTicks) * 1.0e-6);
+    float a = mSettings.smoothing;
+    if (!mHasSample)
+    {
+        mCpuMs = cpuMs;
+        mHasSample = true;
+    }
+    else
+    {
+        mCpuMs += (cpuMs - mCpuMs) * a;
+    }
+    if (gpuMs >= 0.0f)
+    {
+        mGpuMs  = mHasGpu ? mGpuMs + (gpuMs - mGpuMs) * a : gpuMs;
+        mHasGpu = true;
+    }
+
+    if (!mSettings.enabled || mKnobs.empty()) return;
+
+    if (mCooldown > 0)
+    {
+        --mCooldown;
+        return;
+    }
+
+    float frameMs = mHasGpu ? std::max(mCpuMs, mGpuMs) : mCpuMs;
+    if (frameMs > mSettings.targetMs * mSettings.downRatio)
+    {
+        ++mOverFrames;
+        mUnderFrames = 0;
+    }
+    else if (frameMs < mSettings.targetMs * mSettings.upRatio)
+    {
+        ++mUnderFrames;
+        mOverFrames = 0;
+    }
+    else
+    {
+        mOverFrames  = 0;
+        mUnderFrames = 0;
+    }
+
+    bool changed = false;
+    if (mOverFrames >= mSettings.holdFrames)
+    {
+        changed = StepDown(mHasGpu && mGpuMs > mCpuMs);
+        mOverFrames = 0;
+    }
+    else if (mUnderFrames >= mSettings.holdFrames * 2)
+    {
+        changed = StepUp();
+        mUnderFrames = 0;
+    }
+
+    if (changed)
+    {
+        mCooldown = mSettings.cooldownFrames;
+    }
+}
+
+//-------------------------------------------------------------
+// StepDown()
+//  - ボトルネック側に効くノブを登録順に探す。無ければどれでも
+//-------------------------------------------------------------
+bool QualityGovernor::StepDown(bool isGpuBound)
+{
+    uint8_t want = static_cast<uint8_t>(isGpuBound ? QualityBound::GPU : QualityBound::CPU);
+
+    Knob* target = nullptr;
+    for (auto& k : mKnobs)
+    {
+        if (k.level > 0 && (static_cast<uint8_t>(k.bound) & want))
+        {
+            target = &k;
+            break;
+        }
+    }
+    if (!target)
+    {
+        for (auto& k : mKnobs)
+        {
+            if (k.level > 0)
+            {
+                target = &k;
+                break;
+            }
+        }
+    }
+    if (!target) return false;
+
+    ChangeLevel(*target, target->level - 1);
+    mLowered.push_back(target->name);
+    return true;
+}
+
+//-------------------------------------------------------------
+// StepUp()
+//  - 最後に下げたノブから 1 段戻す（上限は開始時の段）
+//-------------------------------------------------------------
+bool QualityGovernor::StepUp()
+{
+    while (!mLowered.empty())
+    {
+        Knob* knob = FindKnob(mLowered.back());
+        mLowered.pop_back();
+        if (knob && knob->level < knob->maxLevel)
+        {
+            ChangeLevel(*knob, knob->level + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void QualityGovernor::ChangeLevel(Knob& knob, int level)
+{
+    QualityDecision decision;
+    decision.frame     = mFrame;
+    decision.knob      = knob.name;
+    decision.fromLevel = knob.level;
+    decision.toLevel   = level;
+    decision.value     = knob.values[level];
+    decision.cpuMs     = mCpuMs;
+    decision.gpuMs     = mHasGpu ? mGpuMs : -1.0f;
+
+    knob.level = level;
+    if (knob.apply)
+    {
+        knob.apply(decision.value);
+    }
+
+    mDecisions.push_back(decision);
+    if (mDecisions.size() > kMaxDecisions)
+    {
+        mDecisions.pop_front();
+    }
+
+    if (mSettings.log)
+    {
+        std::cout << "[QualityGovernor] " << decision.knob << " " << decision.fromLevel
+                  << " -> " << decision.toLevel << " (" << decision.value << ")"
+                  << "  cpu " << decision.cpuMs << " ms / gpu " << decision.gpuMs << " ms"
+                  << std::endl;
+    }
+    if (mOnDecision)
+    {
+        mOnDecision(decision);
+    }
+}
+
+} // namespace toy
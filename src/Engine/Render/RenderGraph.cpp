@@ -0,0 +1,656 @@
+#include "Engine/Render/RenderGraph.h"
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace toy {
+
+namespace {
+
+// プールの実体をこのフレーム数使わなければ破棄
+const uint64_t kMaxIdleFrames = 120;
+
+bool IsDepthFormat(unsigned int format)
+{
+    switch (format)
+    {
+        case GL_DEPTH_COMPONENT16:
+        case GL_DEPTH_COMPONENT24:
+        case GL_DEPTH_COMPONENT32F:
+        case GL_DEPTH24_STENCIL8:
+        case GL_DEPTH32F_STENCIL8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool HasStencil(unsigned int format)
+{
+    return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+}
+
+// glTexImage2D に渡す format / type
+void GetUploadFormat(unsigned int internalFormat, GLenum& format, GLenum& type)
+{
+    switch (internalFormat)
+    {
+        case GL_DEPTH_COMPONENT16:
+        case GL_DEPTH_COMPONENT24:  format = GL_DEPTH_COMPONENT; type = GL_UNSIGNED_INT;  break;
+        case GL_DEPTH_COMPONENT32F: format = GL_DEPTH_COMPONENT; type = GL_FLOAT;         break;
+        case GL_DEPTH24_STENCIL8:   format = GL_DEPTH_STENCIL;   type = GL_UNSIGNED_INT_24_8; break;
+        case GL_DEPTH32F_STENCIL8:  format = GL_DEPTH_STENCIL;   type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV; break;
+        case GL_RGBA16F:
+        case GL_RGBA32F:            format = GL_RGBA;            type = GL_FLOAT;         break;
+        case GL_RGB16F:
+        case GL_R11F_G11F_B10F:     format = GL_RGB;             type = GL_FLOAT;         break;
+        case GL_RG16F:              format = GL_RG;              type = GL_FLOAT;         break;
+        case GL_RG8:                format = GL_RG;              type = GL_UNSIGNED_BYTE; break;
+        case GL_R16F:
+        case GL_R32F:               format = GL_RED;             type = GL_FLOAT;         break;
+        case GL_R8:                 format = GL_RED;             type = GL_UNSIGNED_BYTE; break;
+        default:                    format = GL_RGBA;            type = GL_UNSIGNED_BYTE; break;
+    }
+}
+
+} // namespace
+
+
+//=============================================================
+// PassBuilder
+//=============================================================
+
+void RenderGraph::PassBuilder::Read(RGResource res)
+{
+    if (!mGraph->IsValid(res)) return;
+    mGraph->mPasses[mPass].reads.push_back(res);
+}
+
+void RenderGraph::PassBuilder::Write(RGResource res)
+{
+    if (!mGraph->IsValid(res)) return;
+    mGraph->mPasses[mPass].writes.push_back(res);
+}
+
+void RenderGraph::PassBuilder::SetSideEffect()
+{
+    mGraph->mPasses[mPass].sideEffect = true;
+}
+
+
+//=============================================================
+// コンストラクタ／破棄
+//=============================================================
+
+RenderGraph::RenderGraph()
+: mFrame(0)
+, mIsCompiled(false)
+, mCulledPasses(0)
+, mTransientCount(0)
+, mIsTiming(false)
+, mTimingIndex(0)
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+void RenderGraph::Shutdown()
+{
+    for (auto& fb : mFramebuffers)
+    {
+        glDeleteFramebuffers(1, &fb.second);
+    }
+    mFramebuffers.clear();
+
+    for (auto& phys : mPool)
+    {
+        glDeleteTextures(1, &phys.texture);
+    }
+    mPool.clear();
+
+    for (auto& frame : mTimingFrames)
+    {
+        if (!frame.queries.empty())
+        {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+        frame.queries.clear();
+        frame.names.clear();
+        frame.used    = 0;
+        frame.pending = false;
+    }
+
+    Reset();
+}
+
+
+//=============================================================
+// フレームの宣言
+//=============================================================
+
+void RenderGraph::Reset()
+{
+    mResources.clear();
+    mPasses.clear();
+    mOrder.clear();
+    mIsCompiled = false;
+}
+
+RGResource RenderGraph::ImportTexture(const std::string& name, unsigned int texture)
+{
+    ResourceNode node;
+    node.name     = name;
+    node.imported = true;
+    node.texture  = texture;
+    mResources.push_back(node);
+    return static_cast<RGResource>(mResources.size()) - 1;
+}
+
+RGResource RenderGraph::CreateTexture(const std::string& name, const RGTextureDesc& desc)
+{
+    ResourceNode node;
+    node.name = name;
+    node.desc = desc;
+    mResources.push_back(node);
+    return static_cast<RGResource>(mResources.size()) - 1;
+}
+
+void RenderGraph::MarkOutput(RGResource res)
+{
+    if (IsValid(res))
+    {
+        mResources[res].isOutput = true;
+    }
+}
+
+void RenderGraph::AddPass(const std::string& name, const SetupFunc& setup, const ExecuteFunc& execute)
+{
+    PassNode pass;
+    pass.name    = name;
+    pass.execute = execute;
+    mPasses.push_back(pass);
+
+    PassBuilder builder(this, static_cast<int>(mPasses.size()) - 1);
+    if (setup)
+    {
+        setup(builder);
+    }
+    mIsCompiled = false;
+}
+
+
+//=============================================================
+// Compile
+//=============================================================
+
+//-------------------------------------------------------------
+// 1) 出力から逆にたどって必要なパスに印を付ける
+// 2) 依存順に並べる
+// 3) 並んだ順に一時テクスチャの寿命を求め、プールの実体を割り当てる
+//-------------------------------------------------------------
+bool RenderGraph::Compile()
+{
+    ++mFrame;
+    mOrder.clear();
+    mCulledPasses   = 0;
+    mTransientCount = 0;
+
+    //---------------------------------------------------------
+    // 不要パスの除去
+    //   後ろからたどり、印が増えなくなるまで繰り返す
+    //   （普通は読み手が後に宣言されるので 1 周で収束する）
+    //---------------------------------------------------------
+    std::vector<bool> needed(mResources.size(), false);
+    for (size_t r = 0; r < mResources.size(); ++r)
+    {
+        needed[r] = mResources[r].isOutput;
+    }
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int i = static_cast<int>(mPasses.size()) - 1; i >= 0; --i)
+        {
+            PassNode& pass = mPasses[i];
+            if (pass.live) continue;
+
+            bool live = pass.sideEffect;
+            for (RGResource w : pass.writes)
+            {
+                live = live || needed[w];
+            }
+            if (!live) continue;
+
+            pass.live = true;
+            changed   = true;
+            for (RGResource r : pass.reads)
+            {
+                needed[r] = true;
+            }
+        }
+    }
+
+    for (const auto& pass : mPasses)
+    {
+        if (!pass.live) ++mCulledPasses;
+    }
+
+    //---------------------------------------------------------
+    // 並べ替え
+    //---------------------------------------------------------
+    if (!SortPasses())
+    {
+        std::cerr << "RenderGraph: dependency cycle, using declaration order" << std::endl;
+        mOrder.clear();
+        for (size_t i = 0; i < mPasses.size(); ++i)
+        {
+            if (mPasses[i].live) mOrder.push_back(static_cast<int>(i));
+        }
+    }
+
+    //---------------------------------------------------------
+    // 一時テクスチャの寿命（mOrder 上の最初と最後）
+    //---------------------------------------------------------
+    std::vector<int> firstUse(mResources.size(), -1);
+    std::vector<int> lastUse(mResources.size(), -1);
+    for (int pos = 0; pos < static_cast<int>(mOrder.size()); ++pos)
+    {
+        const PassNode& pass = mPasses[mOrder[pos]];
+        auto touch = [&](RGResource res)
+        {
+            if (mResources[res].imported) return;
+            if (firstUse[res] < 0) firstUse[res] = pos;
+            lastUse[res] = pos;
+        };
+        for (RGResource r : pass.reads)  touch(r);
+        for (RGResource w : pass.writes) touch(w);
+    }
+
+    //---------------------------------------------------------
+    // 割り当て：使い始めで借り、使い終わりで返す
+    //   返した実体は、後のパスで始まる同仕様の資源がそのまま使う
+    //---------------------------------------------------------
+    CollectIdlePhysical();
+    for (auto& phys : mPool)
+    {
+        phys.inUse = false;
+    }
+
+    for (int pos = 0; pos < static_cast<int>(mOrder.size()); ++pos)
+    {
+        for (size_t r = 0; r < mResources.size(); ++r)
+        {
+            if (firstUse[r] != pos) continue;
+
+            ResourceNode& res = mResources[r];
+            res.physical = AcquirePhysical(res.desc);
+            res.texture  = (res.physical >= 0) ? mPool[res.physical].texture : 0;
+            ++mTransientCount;
+        }
+        for (size_t r = 0; r < mResources.size(); ++r)
+        {
+            if (lastUse[r] != pos || mResources[r].physical < 0) continue;
+            mPool[mResources[r].physical].inUse = false;
+        }
+    }
+
+    mIsCompiled = true;
+    return true;
+}
+
+//-------------------------------------------------------------
+// 依存順に並べる
+//   - 同じ資源への書き込みは宣言順
+//   - 読み手は「宣言が前にある最後の書き手」の後
+//     （前に書き手が無ければ最後の書き手の後）
+//   - 読み手の後に宣言された書き手は、読み手の後
+//   - 依存の無いもの同士は宣言順（小さい添字から取り出す）
+//-------------------------------------------------------------
+bool RenderGraph::SortPasses()
+{
+    size_t numPasses = mPasses.size();
+    std::vector<std::vector<int>> edges(numPasses);
+    std::vector<int> inDegree(numPasses, 0);
+
+    auto addEdge = [&](int from, int to)
+    {
+        if (from == to || !mPasses[from].live || !mPasses[to].live) return;
+        edges[from].push_back(to);
+        ++inDegree[to];
+    };
+
+    std::vector<int> writers;
+    for (RGResource res = 0; res < static_cast<RGResource>(mResources.size()); ++res)
+    {
+        writers.clear();
+        for (size_t i = 0; i < numPasses; ++i)
+        {
+            const auto& w = mPasses[i].writes;
+            if (std::find(w.begin(), w.end(), res) != w.end())
+            {
+                writers.push_back(static_cast<int>(i));
+            }
+        }
+        if (writers.empty()) continue;
+
+        for (size_t k = 1; k < writers.size(); ++k)
+        {
+            addEdge(writers[k - 1], writers[k]);
+        }
+
+        for (size_t i = 0; i < numPasses; ++i)
+        {
+            const auto& r = mPasses[i].reads;
+            if (std::find(r.begin(), r.end(), res) == r.end()) continue;
+
+            int reader = static_cast<int>(i);
+            auto next = std::upper_bound(writers.begin(), writers.end(), reader);
+            if (next == writers.begin())
+            {
+                addEdge(writers.back(), reader);
+                continue;
+            }
+            addEdge(*(next - 1), reader);
+            if (next != writers.end())
+            {
+                addEdge(reader, *next);
+            }
+        }
+    }
+
+    size_t numLive = 0;
+    for (const auto& pass : mPasses)
+    {
+        if (pass.live) ++numLive;
+    }
+
+    std::vector<bool> done(numPasses, false);
+    while (mOrder.size() < numLive)
+    {
+        int pick = -1;
+        for (size_t i = 0; i < numPasses; ++i)
+        {
+            if (mPasses[i].live && !done[i] && inDegree[i] == 0)
+            {
+                pick = static_cast<int>(i);
+                break;
+            }
+        }
+        if (pick < 0) return false;
+
+        done[pick] = true;
+        mOrder.push_back(pick);
+        for (int to : edges[pick])
+        {
+            --inDegree[to];
+        }
+    }
+    return true;
+}
+
+int RenderGraph::AcquirePhysical(const RGTextureDesc& desc)
+{
+    for (size_t i = 0; i < mPool.size(); ++i)
+    {
+        auto& phys = mPool[i];
+        if (!phys.inUse && phys.desc == desc)
+        {
+            phys.inUse    = true;
+            phys.lastUsed = mFrame;
+            return static_cast<int>(i);
+        }
+    }
+
+    if (desc.width <= 0 || desc.height <= 0)
+    {
+        std::cerr << "RenderGraph: invalid texture size" << std::endl;
+        return -1;
+    }
+
+    GLenum format, type;
+    GetUploadFormat(desc.format, format, type);
+
+    PhysicalTexture phys;
+    phys.desc = desc;
+    glGenTextures(1, &phys.texture);
+    glBindTexture(GL_TEXTURE_2D, phys.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, desc.format, desc.width, desc.height, 0, format, type, nullptr);
+    GLint filter = IsDepthFormat(desc.format) ? GL_NEAREST : GL_LINEAR;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    phys.inUse    = true;
+    phys.lastUsed = mFrame;
+    mPool.push_back(phys);
+    return static_cast<int>(mPool.size()) - 1;
+}
+
+//-------------------------------------------------------------
+// しばらく使っていない実体を破棄
+//   （解像度変更などで仕様が変わった古いものが残り続けないように）
+//-------------------------------------------------------------
+void RenderGraph::CollectIdlePhysical()
+{
+    bool removed = false;
+    for (size_t i = 0; i < mPool.size();)
+    {
+        if (mFrame - mPool[i].lastUsed > kMaxIdleFrames)
+        {
+            glDeleteTextures(1, &mPool[i].texture);
+            mPool.erase(mPool.begin() + i);
+            removed = true;
+            continue;
+        }
+        ++i;
+    }
+
+    // 消えたテクスチャを参照する FBO が残らないよう作り直す
+    if (removed)
+    {
+        for (auto& fb : mFramebuffers)
+        {
+            glDeleteFramebuffers(1, &fb.second);
+        }
+        mFramebuffers.clear();
+    }
+}
+
+
+//=============================================================
+// Execute
+//=============================================================
+
+void RenderGraph::Execute()
+{
+    if (!mIsCompiled)
+    {
+        Compile();
+    }
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    //---------------------------------------------------------
+    // 計測：数フレーム前に使ったスロットの結果を読んでから再利用
+    //---------------------------------------------------------
+    TimingFrame* timing = nullptr;
+    if (mIsTiming)
+    {
+        timing = &mTimingFrames[mTimingIndex];
+        if (timing->pending)
+        {
+            ReadTimings(*timing);
+        }
+        timing->used = 0;
+        timing->names.clear();
+    }
+
+    for (int index : mOrder)
+    {
+        const PassNode& pass = mPasses[index];
+        bool offscreen = BindTargets(pass);
+
+        if (timing)
+        {
+            if (timing->used == timing->queries.size())
+            {
+                GLuint query = 0;
+                glGenQueries(1, &query);
+                timing->queries.push_back(query);
+            }
+            glBeginQuery(GL_TIME_ELAPSED, timing->queries[timing->used]);
+        }
+
+        if (pass.execute)
+        {
+            pass.execute(*this);
+        }
+
+        if (timing)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            timing->names.push_back(pass.name);
+            ++timing->used;
+        }
+
+        if (offscreen)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        }
+    }
+
+    if (timing)
+    {
+        timing->pending = (timing->used > 0);
+        mTimingIndex = (mTimingIndex + 1) % kTimingFrames;
+    }
+}
+
+//-------------------------------------------------------------
+// 一時テクスチャへ書くパスの FBO をバインド
+//   戻り値：バインドしたら true（取り込み資源だけなら何もしない）
+//-------------------------------------------------------------
+bool RenderGraph::BindTargets(const PassNode& pass)
+{
+    std::vector<unsigned int> colors;
+    unsigned int depth     = 0;
+    unsigned int depthFmt  = 0;
+    const RGTextureDesc* size = nullptr;
+
+    for (RGResource w : pass.writes)
+    {
+        const ResourceNode& res = mResources[w];
+        if (res.imported || res.texture == 0) continue;
+
+        if (IsDepthFormat(res.desc.format))
+        {
+            depth    = res.texture;
+            depthFmt = res.desc.format;
+        }
+        else
+        {
+            colors.push_back(res.texture);
+        }
+        if (!size) size = &res.desc;
+    }
+    if (!size) return false;
+
+    // キー：カラー… , 区切り, 深度
+    std::vector<unsigned int> key = colors;
+    key.push_back(0xFFFFFFFFu);
+    key.push_back(depth);
+
+    GLuint fbo = 0;
+    auto iter = mFramebuffers.find(key);
+    if (iter != mFramebuffers.end())
+    {
+        fbo = iter->second;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    }
+    else
+    {
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+        std::vector<GLenum> drawBuffers;
+        for (size_t i = 0; i < colors.size(); ++i)
+        {
+            GLenum attachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, colors[i], 0);
+            drawBuffers.push_back(attachment);
+        }
+        if (depth)
+        {
+            GLenum attachment = HasStencil(depthFmt) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, depth, 0);
+        }
+
+        if (drawBuffers.empty())
+        {
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+        else
+        {
+            glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+        }
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            std::cerr << "RenderGraph: incomplete framebuffer for pass " << pass.name << std::endl;
+        }
+        mFramebuffers[key] = fbo;
+    }
+
+    glViewport(0, 0, size->width, size->height);
+    return true;
+}
+
+//-------------------------------------------------------------
+// GPU 時間を読む（まだ結果が無ければ前回の値を残す）
+//-------------------------------------------------------------
+void RenderGraph::ReadTimings(TimingFrame& frame)
+{
+    frame.pending = false;
+
+    for (size_t i = 0; i < frame.used; ++i)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return;
+    }
+
+    mTimings.resize(frame.used);
+    for (size_t i = 0; i < frame.used; ++i)
+    {
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &ns);
+        mTimings[i].name  = frame.names[i];
+        mTimings[i].gpuMs = static_cast<float>(static_cast<double>(ns) * 1.0e-6);
+    }
+}
+
+//=============================================================
+// パス実行中
+//=============================================================
+
+unsigned int RenderGraph::GetTexture(RGResource res) const
+{
+    return IsValid(res) ? mResources[res].texture : 0;
+}
+
+const RGTextureDesc& RenderGraph::GetDesc(RGResource res) const
+{
+    static const RGTextureDesc empty;
+    return IsValid(res) ? mResources[res].desc : empty;
+}
+
+} // namespace toy
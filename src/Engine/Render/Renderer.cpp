@@ -1,12 +1,27 @@
 #include "Engine/Render/Renderer.h"
 #include "Engine/Render/Shader.h"
 #include "Engine/Render/LightingManager.h"
+#include "Engine/Render/MaterialBuffer.h"
+#include "Engine/Render/BonePaletteBuffer.h"
+#include "Engine/Render/SkinningStage.h"
+#include "Engine/Render/DebugDraw.h"
+#include "Engine/Render/OcclusionCuller.h"
+#include "Engine/Render/PortalSystem.h"
+#include "Engine/Render/RenderGraph.h"
+#include "Engine/Render/FrameCapture.h"
+#include "Engine/Render/GLRecorder.h"
+#include "Engine/Render/UILayerCache.h"
+#include "Engine/Render/QualityGovernor.h"
+#include "Engine/Runtime/SignificanceManager.h"
+#include "Asset/Material/Material.h"
 #include "Graphics/Sprite/SpriteComponent.h"
 #include "Asset/Material/Texture.h"
 #include "Asset/Geometry/VertexArray.h"
 #include "Asset/Geometry/Mesh.h"
 #include "Graphics/Mesh/MeshComponent.h"
 #include "Graphics/Mesh/SkeletalMeshComponent.h"
+#include "Graphics/Mesh/LightBaker.h"
+#include "Graphics/Mesh/StaticBatcher.h"
 #include "Graphics/Effect/ParticleComponent.h"
 #include "Graphics/Sprite/BillboardComponent.h"
 #include "Graphics/VisualComponent.h"
@@ -19,7 +34,9 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_set>
 #include <iostream>
+#include <thread>
 
 namespace toy {
 
@@ -35,6 +52,8 @@ Renderer::Renderer()
 , mVirtualHeight(0.f)
 , mPerspectiveFOV(45.f)
 , mIsDebugMode(false)
+, mIsGLRecorder(false)
+, mIsMeshletCulling(true)
 , mClearColor(Vector3(0.2f, 0.5f, 0.8f))
 , mWireColor(Vector3(1.f, 1.f, 1.f))
 , mShadowNear(10.f)
@@ -49,10 +68,41 @@ Renderer::Renderer()
 , mCntDrawObject(0)
 , mSkyDomeComp(nullptr)
 , mLightSpaceMatrix(Matrix4::Identity)
+, mIsShadowMapActive(false)
+, mShadowUpdateInterval(1)
+, mShadowFrameCount(0)
+, mIsShadowRefresh(true)
+, mIsShadowMapValid(false)
+, mIsTransparencySort(true)
+, mIsPreSkinning(true)
+, mIsOcclusionCulling(true)
+, mIsPortalCulling(true)
+, mIsRetainedUI(false)
+, mDrawVisible(mLayerVisible)
+, mNextViewID(1)
+, mMainLayerMask(ALL_LAYERS_MASK)
+, mScatterDensity(1.0f)
+, mScatterDistanceScale(1.0f)
+, mRenderScale(1.0f)
+, mParticleBudget(1.0f)
+, mOverlayScale(1.0f)
+, mIsOverlayDepthAware(true)
+, mSceneDepthTexture(0)
+, mTargetWidth(0.0f)
+, mTargetHeight(0.0f)
+, mSignificance(nullptr)
 , mWindowDisplayScale(1.0f)
 {
+    for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+    {
+        mIsLayerDirty[i] = false;
+    }
+
     // ライティング管理クラス
     mLightingManager = std::make_shared<LightingManager>();
+    
+    // 品質ガバナー（設定ファイルの "quality_governor" を受け取るので先に作る）
+    mQualityGovernor = std::make_unique<QualityGovernor>();
 
     // Renderer の初期設定（タイトルや解像度など）を外部ファイルから読み込む
     // 例: ToyLib/Settings/Renderer_Settings.json
@@ -135,6 +185,16 @@ bool Renderer::Initialize(SDL_Window* window)
         return false;
     }
 
+    // GL コマンドの記録（以降に作る GL オブジェクトをすべて追跡するため、ここで入れる）
+    if (mIsGLRecorder)
+    {
+        mGLRecorder = std::make_unique<GLRecorder>();
+        if (!mGLRecorder->Install())
+        {
+            mGLRecorder = nullptr;
+        }
+    }
+
     //---------------------------------------------------------
     // シェーダーのロード
     //---------------------------------------------------------
@@ -143,124 +203,1003 @@ bool Renderer::Initialize(SDL_Window* window)
         return false;
     }
 
+    //---------------------------------------------------------
+    // マテリアル用 UBO
+    //---------------------------------------------------------
+    mMaterialBuffer = std::make_shared<MaterialBuffer>();
+    if (!mMaterialBuffer->Initialize())
+    {
+        return false;
+    }
+    mDefaultMaterial = std::make_shared<Material>();
+
+    //---------------------------------------------------------
+    // ボーンパレット用 UBO
+    //---------------------------------------------------------
+    mBonePaletteBuffer = std::make_shared<BonePaletteBuffer>();
+    if (!mBonePaletteBuffer->Initialize())
+    {
+        return false;
+    }
+
+    //---------------------------------------------------------
+    // スキニング前処理（失敗してもシェーダ内スキニングで続行）
+    //---------------------------------------------------------
+    mSkinningStage = std::make_unique<SkinningStage>();
+    if (!mSkinningStage->Initialize(mShaderPath))
+    {
+        std::cerr << "[Renderer] Pre-skinning disabled. Falling back to in-shader skinning." << std::endl;
+        mSkinningStage->Shutdown();
+        mSkinningStage = nullptr;
+    }
+
+    //---------------------------------------------------------
+    // デバッグ線描画
+    //---------------------------------------------------------
+    mDebugDraw = std::make_unique<DebugDraw>();
+    if (!mDebugDraw->Initialize(mShaders["DebugLine"]))
+    {
+        return false;
+    }
+    mDebugDraw->SetEnabled(mIsDebugMode);
+
+    //---------------------------------------------------------
+    // オクルージョンカリング（ラスタライズ用ワーカーは最大 3 本）
+    //---------------------------------------------------------
+    unsigned int cores = std::thread::hardware_concurrency();
+    mOcclusionCuller = std::make_unique<OcclusionCuller>();
+    mOcclusionCuller->Initialize(cores > 1 ? std::min(cores - 1, 3u) : 0u);
+
+    // セル＆ポータル（レベルデータは GetPortalSystem()->LoadFromFile で読む）
+    mPortalSystem = std::make_unique<PortalSystem>();
+
+    // 描画パスのグラフ（一時レンダーターゲットはここのプールから借りる）
+    mRenderGraph = std::make_unique<RenderGraph>();
+
+    // 画面キャプチャ（PNG 書き出し用のワーカーを 1 本）
+    mFrameCapture = std::make_unique<FrameCapture>();
+    mFrameCapture->Initialize();
+
+    // 静的バッチ（MeshComponent::SetStaticBatching で候補が登録される）
+    mStaticBatcher = std::make_unique<StaticBatcher>();
+
+    // 焼き込みライティング（MeshComponent::SetLightBaking で候補が登録される）
+    mLightBaker = std::make_unique<LightBaker>();
+
+    // 保持モード UI のキャッシュ（FBO は最初の Update で作る）
+    mUILayerCache = std::make_unique<UILayerCache>();
+
     //---------------------------------------------------------
     // 各種描画用 VAO 準備
     //---------------------------------------------------------
     CreateSpriteVerts();
     CreateFullScreenQuad();
 
-    //---------------------------------------------------------
-    // シャドウマッピング初期化
-    //---------------------------------------------------------
-    if (!InitializeShadowMapping())
+    //---------------------------------------------------------
+    // シャドウマッピング初期化
+    //---------------------------------------------------------
+    if (!InitializeShadowMapping())
+    {
+        return false;
+    }
+
+    //---------------------------------------------------------
+    // 品質ガバナーのノブ（設定ファイルの値を上限として登録）
+    //---------------------------------------------------------
+    RegisterQualityKnobs();
+    
+    //---------------------------------------------------------
+    // クリアカラーの初期設定
+    //---------------------------------------------------------
+    SetClearColor(mClearColor);
+
+    mSkyDomeComp   = nullptr;
+    mCntDrawObject = 0;
+
+    //---------------------------------------------------------
+    // ビューポート＆射影行列など、サイズ依存の状態をまとめて更新
+    //---------------------------------------------------------
+    OnWindowResized(pixelW, pixelH);
+
+    std::cout << "[Renderer] GL Init Complete. "
+              << "Pixels("  << pixelW   << "x" << pixelH   << ") "
+              << "Scale="   << mWindowDisplayScale
+              << std::endl;
+
+    return true;
+}
+// リリース処理
+void Renderer::Shutdown()
+{
+    for (auto& v : mShaderVariants)
+    {
+        v.second->Clear();
+    }
+    mShaderVariants.clear();
+
+    if (mMaterialBuffer)
+    {
+        mMaterialBuffer->Shutdown();
+    }
+    if (mBonePaletteBuffer)
+    {
+        mBonePaletteBuffer->Shutdown();
+    }
+    if (mSkinningStage)
+    {
+        mSkinningStage->Shutdown();
+        mSkinningStage = nullptr;
+    }
+    if (mDebugDraw)
+    {
+        mDebugDraw->Shutdown();
+        mDebugDraw = nullptr;
+    }
+    if (mOcclusionCuller)
+    {
+        mOcclusionCuller->Shutdown();
+        mOcclusionCuller = nullptr;
+    }
+    mPortalSystem = nullptr;
+    mStaticBatcher = nullptr;
+    mLightBaker = nullptr;
+    if (mUILayerCache)
+    {
+        mUILayerCache->Shutdown();
+        mUILayerCache = nullptr;
+    }
+    if (mFrameCapture)
+    {
+        mFrameCapture->Shutdown();
+        mFrameCapture = nullptr;
+    }
+    if (mRenderGraph)
+    {
+        mRenderGraph->Shutdown();
+        mRenderGraph = nullptr;
+    }
+
+    if (mShadowFBO)
+    {
+        glDeleteFramebuffers(1, &mShadowFBO);
+        mShadowFBO = 0;
+    }
+    if (mGLRecorder)
+    {
+        mGLRecorder->Uninstall();
+        mGLRecorder = nullptr;
+    }
+    if (mGLContext)
+    {
+        SDL_GL_DestroyContext(mGLContext);
+        mGLContext = nullptr;
+    }
+}
+
+
+//=============================================================
+// メイン描画パス
+//=============================================================
+
+void Renderer::Draw()
+{
+    // 0) ボーンパレットを一括書き込み（シャドウ／通常描画で共有）
+    UpdateBonePalettes();
+    
+    // 1) 登録変更の反映と、カメラ／ライト両方の可視リスト作成
+    FlushVisualChanges();
+    UpdateLightSpaceMatrix();
+    BuildVisibleLists();
+    PreSkinVisible();
+    
+    // 2) パスを組み立てて実行（影 → シーン → オーバーレイ → UI）
+    BuildRenderGraph();
+    mRenderGraph->Compile();
+    mRenderGraph->Execute();
+    
+    // 3) キャプチャ要求があればバックバッファを読み戻す（スワップ前）
+    mFrameCapture->EndFrame(static_cast<int>(mScreenWidth), static_cast<int>(mScreenHeight));
+    if (mGLRecorder)
+    {
+        mGLRecorder->EndFrame();
+    }
+    
+    // 4) 品質ガバナー（GPU 時間はパス別計測の合計。数フレーム遅れの値）
+    if (mQualityGovernor->IsEnabled() && !mRenderGraph->IsTiming())
+    {
+        mRenderGraph->SetTiming(true);
+    }
+    float gpuMs = -1.0f;
+    if (mRenderGraph->IsTiming() && !mRenderGraph->GetTimings().empty())
+    {
+        gpuMs = 0.0f;
+        for (const auto& t : mRenderGraph->GetTimings())
+        {
+            gpuMs += t.gpuMs;
+        }
+    }
+    mQualityGovernor->EndFrame(gpuMs);
+    
+    // Debug 用カウンタリセット
+    // std::cout << "Render 3D Objects Count = " << mCntDrawObject << std::endl;
+    mCntDrawObject = 0;
+    
+    // バッファ入れ替え
+    SDL_GL_SwapWindow(mWindow);
+}
+
+//-------------------------------------------------------------
+// フレームのパス構成
+//   - バックバッファが最終出力
+//   - シーンが影を読まないフレーム（影なし）はシャドウパスが省かれる
+//   - 新しいパスは一時テクスチャ（CreateTexture）を読み書きして
+//     ここに足す（寿命が重ならなければ実体は使い回される）
+//-------------------------------------------------------------
+void Renderer::BuildRenderGraph()
+{
+    mRenderGraph->Reset();
+    
+    RGResource backBuffer = mRenderGraph->ImportTexture("BackBuffer", 0);
+    RGResource shadowMap  = mRenderGraph->ImportTexture(
+        "ShadowMap", mShadowMapTexture ? mShadowMapTexture->GetTextureID() : 0);
+    mRenderGraph->MarkOutput(backBuffer);
+    
+    mRenderGraph->AddPass("Shadow",
+        [&](RenderGraph::PassBuilder& builder)
+        {
+            builder.Write(shadowMap);
+        },
+        [this](RenderGraph&)
+        {
+            RenderShadowMap();
+        });
+    
+    //---------------------------------------------------------
+    // シーン（縮小描画なら一時バッファへ描いて、画面へ拡大する）
+    //   縮小オーバーレイが深度を見るときは等倍でも一時バッファへ描き、
+    //   深度をテクスチャとして Overlay パスまで残す
+    //   （このフレーム実際に描くオーバーレイがあるときだけ）
+    //---------------------------------------------------------
+    int sceneW = static_cast<int>(mScreenWidth  * mRenderScale + 0.5f);
+    int sceneH = static_cast<int>(mScreenHeight * mRenderScale + 0.5f);
+    bool isScaled = (mRenderScale < 1.0f && sceneW > 0 && sceneH > 0);
+    bool needDepth = false;
+    if (mOverlayScale < 1.0f && mIsOverlayDepthAware)
+    {
+        for (auto comp : mLayerVisible[static_cast<int>(VisualLayer::OverlayScreen)])
+        {
+            if (comp->NeedsSceneDepth())
+            {
+                needDepth = true;
+                break;
+            }
+        }
+    }
+    if (!isScaled)
+    {
+        sceneW = static_cast<int>(mScreenWidth);
+        sceneH = static_cast<int>(mScreenHeight);
+    }
+    bool isOffscreen = isScaled || (needDepth && sceneW > 0 && sceneH > 0);
+    
+    RGResource sceneColor = backBuffer;
+    RGResource sceneDepth = -1;
+    if (isOffscreen)
+    {
+        sceneColor = mRenderGraph->CreateTexture("SceneColor", RGTextureDesc{ sceneW, sceneH, GL_RGBA8 });
+        sceneDepth = mRenderGraph->CreateTexture("SceneDepth", RGTextureDesc{ sceneW, sceneH, GL_DEPTH_COMPONENT24 });
+    }
+    
+    mRenderGraph->AddPass("Scene",
+        [&](RenderGraph::PassBuilder& builder)
+        {
+            if (mIsShadowMapActive)
+            {
+                builder.Read(shadowMap);
+            }
+            builder.Write(sceneColor);
+            if (isOffscreen)
+            {
+                builder.Write(sceneDepth);
+            }
+        },
+        [this, sceneW, sceneH, isOffscreen](RenderGraph&)
+        {
+            mTargetWidth  = isOffscreen ? static_cast<float>(sceneW) : mScreenWidth;
+            mTargetHeight = isOffscreen ? static_cast<float>(sceneH) : mScreenHeight;
+            DrawScenePass();
+            mTargetWidth  = mScreenWidth;
+            mTargetHeight = mScreenHeight;
+        });
+    
+    if (isOffscreen)
+    {
+        mRenderGraph->AddPass("Upscale",
+            [&](RenderGraph::PassBuilder& builder)
+            {
+                builder.Read(sceneColor);
+                builder.Write(backBuffer);
+            },
+            [this, sceneColor](RenderGraph& graph)
+            {
+                // バイリニアで画面全体へ（等倍ならコピー）。深度はシーンのものが無いのでクリアだけ
+                glViewport(0, 0, (GLsizei)mScreenWidth, (GLsizei)mScreenHeight);
+                glDepthMask(GL_TRUE);
+                glClear(GL_DEPTH_BUFFER_BIT);
+                glDisable(GL_DEPTH_TEST);
+                glDisable(GL_BLEND);
+                
+                auto shader = mShaders["UIComposite"];
+                shader->SetActive();
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, graph.GetTexture(sceneColor));
+                shader->SetTextureUniform("uTexture", 0);
+                mFullScreenQuad->SetActive();
+                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+                
+                glEnable(GL_BLEND);
+                glEnable(GL_DEPTH_TEST);
+            });
+    }
+    
+    mRenderGraph->AddPass("Overlay",
+        [&](RenderGraph::PassBuilder& builder)
+        {
+            if (isOffscreen)
+            {
+                builder.Read(sceneDepth);
+            }
+            builder.Write(backBuffer);
+        },
+        [this, sceneDepth, isOffscreen](RenderGraph& graph)
+        {
+            mSceneDepthTexture = isOffscreen ? graph.GetTexture(sceneDepth) : 0;
+            DrawVisualLayer(VisualLayer::OverlayScreen);
+            mSceneDepthTexture = 0;
+        });
+    
+    mRenderGraph->AddPass("UI",
+        [&](RenderGraph::PassBuilder& builder)
+        {
+            builder.Write(backBuffer);
+        },
+        [this](RenderGraph&)
+        {
+            if (mIsRetainedUI)
+            {
+                DrawRetainedUI();
+            }
+            else
+            {
+                DrawVisualLayer(VisualLayer::UI);
+            }
+        });
+}
+
+//-------------------------------------------------------------
+// 保持モード UI
+//   - 可視リストの並びが前回と違えば全体を描き直す
+//     （追加・削除・表示切り替え・描画順の変更）
+//   - 各コンポーネントに変化を聞き、汚れた矩形を集める
+//   - 何も変わっていなければキャッシュを合成するだけ
+//-------------------------------------------------------------
+void Renderer::DrawRetainedUI()
+{
+    const auto& list = mLayerVisible[static_cast<int>(VisualLayer::UI)];
+    if (list != mLastUIVisible)
+    {
+        mUILayerCache->MarkDirty();
+        mLastUIVisible = list;
+    }
+
+    for (auto comp : list)
+    {
+        UIRect rect;
+        UIChange change = comp->CheckUIChange(rect);
+        if (change == UIChange::Full)
+        {
+            mUILayerCache->MarkDirty();
+        }
+        else if (change == UIChange::Rect)
+        {
+            mUILayerCache->MarkDirty(rect);
+        }
+    }
+
+    mUILayerCache->Update(static_cast<int>(mScreenWidth), static_cast<int>(mScreenHeight),
+                          [this]() { DrawVisualLayer(VisualLayer::UI); });
+    mUILayerCache->Composite(mShaders["UIComposite"].get(), mFullScreenQuad.get());
+}
+
+void Renderer::SetRetainedUI(bool b)
+{
+    if (b && !mIsRetainedUI)
+    {
+        mUILayerCache->MarkDirty();
+    }
+    mIsRetainedUI = b;
+}
+
+//-------------------------------------------------------------
+// シーンパス：クリア → スカイ → 背景 2D → 3D → エフェクト → デバッグ線
+//-------------------------------------------------------------
+void Renderer::DrawScenePass()
+{
+    // カラーバッファ／デプスバッファ初期化
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    
+    glEnable(GL_CULL_FACE);
+    glFrontFace(GL_CCW);
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    // メインビュー（画面全体のクリアは済んでいる）
+    DrawSceneView(mViewMatrix, mProjectionMatrix, mMainViewport, mMainLayerMask,
+                  mLayerVisible, false);
+    
+    // デバッグ線（コライダー・レイ・フラスタム）をまとめて描画
+    if (mIsDebugMode)
+    {
+        mDebugDraw->Flush(mViewMatrix * mProjectionMatrix);
+    }
+    mDebugDraw->Clear();
+    mDebugDraw->SetEnabled(mIsDebugMode);
+    
+    //---------------------------------------------------------
+    // 追加ビュー（描画中だけカメラ行列を差し替える）
+    //---------------------------------------------------------
+    if (!mViews.empty())
+    {
+        Matrix4 mainView = mViewMatrix;
+        Matrix4 mainProj = mProjectionMatrix;
+        
+        for (auto& v : mViews)
+        {
+            if (!v.desc.enabled) continue;
+            DrawSceneView(v.desc.view, v.desc.projection, v.desc.viewport, v.desc.layerMask,
+                          v.visible, v.desc.clear);
+        }
+        
+        SetViewMatrix(mainView);
+        mProjectionMatrix = mainProj;
+        mDrawVisible      = mLayerVisible;
+    }
+    
+    glViewport(0, 0, (GLsizei)mTargetWidth, (GLsizei)mTargetHeight);
+}
+
+//-------------------------------------------------------------
+// ビュー 1 つ分のシーン
+//   - 行列を差し替えるので、コンポーネントの Draw は
+//     GetViewMatrix() などからこのビューの行列を受け取る
+//-------------------------------------------------------------
+void Renderer::DrawSceneView(const Matrix4& view, const Matrix4& projection,
+                             const RenderViewport& viewport, uint32_t layerMask,
+                             std::vector<VisualComponent*>* visible, bool clear)
+{
+    GLint   x = static_cast<GLint>(viewport.x * mTargetWidth);
+    GLint   y = static_cast<GLint>(viewport.y * mTargetHeight);
+    GLsizei w = static_cast<GLsizei>(viewport.w * mTargetWidth);
+    GLsizei h = static_cast<GLsizei>(viewport.h * mTargetHeight);
+    if (w <= 0 || h <= 0) return;
+    
+    glViewport(x, y, w, h);
+    if (clear)
+    {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x, y, w, h);
+        glDepthMask(GL_TRUE);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+    }
+    
+    SetViewMatrix(view);
+    mProjectionMatrix = projection;
+    mDrawVisible      = visible;
+    
+    // スカイドーム（背景）
+    if (layerMask & LayerMaskBit(VisualLayer::Background2D))
+    {
+        DrawSky();
+    }
+    
+    // レイヤー別描画（奥から順に）
+    const VisualLayer layers[] =
+    {
+        VisualLayer::Background2D,
+        VisualLayer::Object3D,
+        VisualLayer::Effect3D,
+    };
+    for (auto layer : layers)
+    {
+        if (layerMask & LayerMaskBit(layer))
+        {
+            DrawVisualLayer(layer);
+        }
+    }
+}
+
+//-------------------------------------------------------------
+// 追加ビュー
+//-------------------------------------------------------------
+int Renderer::AddView(const RenderView& view)
+{
+    ViewSlot slot;
+    slot.id   = mNextViewID++;
+    slot.desc = view;
+    
+    // order 順（同じなら追加順）に並べておく
+    auto iter = std::upper_bound(mViews.begin(), mViews.end(), view.order,
+                                 [](int order, const ViewSlot& v) { return order < v.desc.order; });
+    mViews.insert(iter, std::move(slot));
+    return mNextViewID - 1;
+}
+
+void Renderer::RemoveView(int id)
+{
+    mViews.erase(std::remove_if(mViews.begin(), mViews.end(),
+                                [id](const ViewSlot& v) { return v.id == id; }),
+                 mViews.end());
+}
+
+RenderView* Renderer::GetView(int id)
+{
+    for (auto& v : mViews)
+    {
+        if (v.id == id) return &v.desc;
+    }
+    return nullptr;
+}
+
+//-------------------------------------------------------------
+// 画面キャプチャ
+//-------------------------------------------------------------
+void Renderer::SaveScreenshot(const std::string& filePath)
+{
+    mFrameCapture->RequestScreenshot(filePath);
+}
+
+void Renderer::StartFrameCapture(const std::string& pathPrefix, int everyNthFrame)
+{
+    mFrameCapture->StartSequence(pathPrefix, everyNthFrame);
+}
+
+void Renderer::StopFrameCapture()
+{
+    mFrameCapture->StopSequence();
+}
+
+bool Renderer::CaptureGLFrames(const std::string& filePath, int frames)
+{
+    if (!mGLRecorder)
+    {
+        std::cerr << "[Renderer] GL recorder is disabled. Set \"debug\": { \"gl_recorder\": true }." << std::endl;
+        return false;
+    }
+    return mGLRecorder->BeginCapture(filePath, frames);
+}
+
+// スカイドーム描画
+void Renderer::DrawSky()
+{
+    if (!mSkyDomeComp)
+        return;
+
+    mSkyDomeComp->Draw();
+}
+
+
+//=============================================================
+// VisualComponent 管理
+//=============================================================
+
+void Renderer::AddVisualComp(VisualComponent* comp)
+{
+    // レイヤー・描画順は派生クラスのコンストラクタで変わることがあるので、
+    // 実際の挿入は FlushVisualChanges() まで遅らせる
+    mPendingVisuals.push_back(comp);
+}
+
+void Renderer::RemoveVisualComp(VisualComponent* comp)
+{
+    // まだ保留中ならそこから外すだけ
+    auto iter = std::find(mPendingVisuals.begin(), mPendingVisuals.end(), comp);
+    if (iter != mPendingVisuals.end())
+    {
+        mPendingVisuals.erase(iter);
+        return;
+    }
+
+    // 登録済みなら削除セットへ（所属レイヤーは次の反映時に詰める）
+    mRemovedVisuals.insert(comp);
+    mIsLayerDirty[static_cast<int>(comp->GetLayer())] = true;
+}
+
+//-------------------------------------------------------------
+// 登録変更の反映
+//   - 先に削除（同じアドレスで再登録されたものを誤って消さないため）
+//   - 保留分は DrawOrder で安定ソートしてから各レイヤーへマージ
+//     （同じ DrawOrder なら既存 → 新規、新規同士は登録順）
+//-------------------------------------------------------------
+void Renderer::FlushVisualChanges()
+{
+    if (!mRemovedVisuals.empty())
+    {
+        for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+        {
+            if (!mIsLayerDirty[i]) continue;
+
+            auto& list = mLayerComps[i];
+            list.erase(std::remove_if(list.begin(), list.end(),
+                                      [this](VisualComponent* c)
+                                      {
+                                          return mRemovedVisuals.count(c) != 0;
+                                      }),
+                       list.end());
+            mIsLayerDirty[i] = false;
+        }
+        mRemovedVisuals.clear();
+    }
+
+    if (mPendingVisuals.empty()) return;
+
+    auto byOrder = [](const VisualComponent* a, const VisualComponent* b)
+    {
+        return a->GetDrawOrder() < b->GetDrawOrder();
+    };
+
+    std::stable_sort(mPendingVisuals.begin(), mPendingVisuals.end(), byOrder);
+
+    size_t oldSize[NUM_VISUAL_LAYERS];
+    for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+    {
+        oldSize[i] = mLayerComps[i].size();
+    }
+    for (auto comp : mPendingVisuals)
+    {
+        mLayerComps[static_cast<int>(comp->GetLayer())].push_back(comp);
+    }
+    for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+    {
+        auto& list = mLayerComps[i];
+        if (list.size() == oldSize[i]) continue;
+
+        // 既存分と追加分はそれぞれ整列済みなので inplace_merge で O(n)
+        std::inplace_merge(list.begin(), list.begin() + oldSize[i], list.end(), byOrder);
+    }
+    mPendingVisuals.clear();
+}
+
+//-------------------------------------------------------------
+// 可視リスト作成
+//   - 全コンポーネントを 1 回だけ走査し、AABB も 1 回だけ取得する
+//   - 3D レイヤーはカメラフラスタム、影はライトフラスタムで判定
+//   - セル＆ポータルがあれば、到達しなかったセルの Actor を外す
+//   - 遮蔽物（SetOccluder）があれば CPU の低解像度デプスで
+//     オクルージョン判定し、隠れたものをカメラ側の可視リストから外す
+//-------------------------------------------------------------
+void Renderer::BuildVisibleLists()
+{
+    Matrix4 viewProj      = mViewMatrix * mProjectionMatrix;
+    Frustum cameraFrustum = BuildFrustumFromMatrix(viewProj);
+    Frustum shadowFrustum = BuildFrustumFromMatrix(mLightSpaceMatrix);
+
+    // 遮蔽物はカメラのフラスタムに入ったものだけを積む
+    bool useOcclusion = mIsOcclusionCulling && mOcclusionCuller;
+    if (useOcclusion)
+    {
+        mOcclusionCuller->BeginFrame(viewProj);
+    }
+    mOcclusionCandidates.clear();
+
+    // カメラがセル内にいれば、ポータルをたどって到達セルを求める
+    bool usePortals = mIsPortalCulling && mPortalSystem && mPortalSystem->HasCells() &&
+                      mPortalSystem->BeginFrame(cameraFrustum, mInvView.GetTranslation());
+
+    mShadowVisible.clear();
+
+    // 追加ビューのフラスタム（同じ走査でまとめて判定する）
+    mViewFrustums.clear();
+    for (auto& v : mViews)
+    {
+        mViewFrustums.push_back(BuildFrustumFromMatrix(v.desc.view * v.desc.projection));
+        for (auto& list : v.visible)
+        {
+            list.clear();
+        }
+    }
+
+    for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+    {
+        auto& visible = mLayerVisible[i];
+        visible.clear();
+
+        VisualLayer layer = static_cast<VisualLayer>(i);
+        bool is3DLayer =
+            (layer == VisualLayer::Object3D ||
+             layer == VisualLayer::Effect3D);
+        uint32_t layerBit = LayerMaskBit(layer);
+
+        for (auto comp : mLayerComps[i])
+        {
+            if (!comp->IsVisible()) continue;
+
+            // 2D レイヤーはカリングなし（影も描かない）
+            if (!is3DLayer)
+            {
+                visible.push_back(comp);
+                for (auto& v : mViews)
+                {
+                    if (v.desc.enabled && (v.desc.layerMask & layerBit)) v.visible[i].push_back(comp);
+                }
+                continue;
+            }
+
+            bool castShadow = mIsShadowMapActive && comp->GetEnableShadow();
+
+            // 重要度の低い Actor は影を落とさない
+            Actor* owner = comp->GetOwner();
+            if (castShadow && owner && mSignificance)
+            {
+                castShadow = mSignificance->GetPolicy(owner->GetSignificance()).castShadow;
+            }
+
+            // Actor の BoundingVolumeComponent から AABB を取得
+            //   （持たないものは常に可視扱い）
+            auto bv = owner ? owner->GetComponent<BoundingVolumeComponent>() : nullptr;
+            if (!bv)
+            {
+                visible.push_back(comp);
+                if (castShadow) mShadowVisible.push_back(comp);
+                for (auto& v : mViews)
+                {
+                    if (v.desc.enabled && (v.desc.layerMask & layerBit)) v.visible[i].push_back(comp);
+                }
+                continue;
+            }
+
+            Cube aabb = bv->GetWorldAABB();
+
+            // 追加ビュー（フラスタムのみ）
+            for (size_t k = 0; k < mViews.size(); ++k)
+            {
+                auto& v = mViews[k];
+                if (v.desc.enabled && (v.desc.layerMask & layerBit) &&
+                    FrustumIntersectsAABB(mViewFrustums[k], aabb))
+                {
+                    v.visible[i].push_back(comp);
+                }
+            }
+            if (FrustumIntersectsAABB(cameraFrustum, aabb) &&
+                (!usePortals || mPortalSystem->IsVisible(owner, aabb)))
+            {
+                if (useOcclusion)
+                {
+                    if (comp->IsOccluder())
+                    {
+                        comp->CollectOccluder(*mOcclusionCuller);
+                    }
+                    else
+                    {
+                        mOcclusionCandidates.push_back({ i, visible.size(), aabb });
+                    }
+                }
+                visible.push_back(comp);
+            }
+
+            // 影はカメラから隠れていても落ちるので、オクルージョンは見ない
+            if (castShadow && FrustumIntersectsAABB(shadowFrustum, aabb))
+            {
+                mShadowVisible.push_back(comp);
+            }
+        }
+    }
+
+    if (!useOcclusion || !mOcclusionCuller->HasOccluders())
     {
-        return false;
+        return;
     }
 
     //---------------------------------------------------------
-    // クリアカラーの初期設定
+    // 遮蔽物をラスタライズし、隠れたものを可視リストから外す
     //---------------------------------------------------------
-    SetClearColor(mClearColor);
+    mOcclusionCuller->Rasterize();
 
-    mSkyDomeComp   = nullptr;
-    mCntDrawObject = 0;
+    bool anyCulled = false;
+    for (const auto& c : mOcclusionCandidates)
+    {
+        if (!mOcclusionCuller->IsVisible(c.aabb))
+        {
+            mLayerVisible[c.layer][c.index] = nullptr;
+            anyCulled = true;
+        }
+    }
 
-    //---------------------------------------------------------
-    // ビューポート＆射影行列など、サイズ依存の状態をまとめて更新
-    //---------------------------------------------------------
-    OnWindowResized(pixelW, pixelH);
+    if (anyCulled)
+    {
+        for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+        {
+            auto& visible = mLayerVisible[i];
+            visible.erase(std::remove(visible.begin(), visible.end(), nullptr), visible.end());
+        }
+    }
+}
 
-    std::cout << "[Renderer] GL Init Complete. "
-              << "Pixels("  << pixelW   << "x" << pixelH   << ") "
-              << "Scale="   << mWindowDisplayScale
-              << std::endl;
+const OcclusionStats& Renderer::GetOcclusionStats() const
+{
+    static const OcclusionStats empty;
+    return mOcclusionCuller ? mOcclusionCuller->GetStats() : empty;
+}
 
-    return true;
+void Renderer::SetScatterQuality(float density, float distanceScale)
+{
+    mScatterDensity       = Math::Clamp(density, 0.0f, 1.0f);
+    mScatterDistanceScale = std::max(distanceScale, 0.0f);
 }
-// リリース処理
-void Renderer::Shutdown()
+
+//-------------------------------------------------------------
+// 品質ガバナーが動かす値
+//-------------------------------------------------------------
+void Renderer::SetRenderScale(float scale)
 {
-    if (mShadowFBO)
-    {
-        glDeleteFramebuffers(1, &mShadowFBO);
-        mShadowFBO = 0;
-    }
-    if (mGLContext)
-    {
-        SDL_GL_DestroyContext(mGLContext);
-        mGLContext = nullptr;
-    }
+    mRenderScale = Math::Clamp(scale, 0.25f, 1.0f);
 }
 
+void Renderer::SetParticleBudget(float budget)
+{
+    mParticleBudget = Math::Clamp(budget, 0.0f, 1.0f);
+}
 
-//=============================================================
-// メイン描画パス
-//=============================================================
+void Renderer::SetOverlayScale(float scale)
+{
+    mOverlayScale = Math::Clamp(scale, 0.25f, 1.0f);
+}
 
-void Renderer::Draw()
+//-------------------------------------------------------------
+// 標準のノブ（見た目の損が小さい順＝ガバナーが先に下げる順）
+//   - 各ノブの最上段は設定ファイルの値（それより上げない）
+//   - lod_bias は散布物の距離倍率に掛ける
+//-------------------------------------------------------------
+void Renderer::RegisterQualityKnobs()
 {
-    // カラーバッファ／デプスバッファ初期化
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    // 1) ライト視点でのシャドウマップ描画
-    RenderShadowMap();
+    // overlay_scale は 1/4・1/2 の固定段＋設定値（設定値以上の段は作らない）
+    float overlay = mOverlayScale;
+    std::vector<float> overlayLevels;
+    for (float level : { 0.25f, 0.5f })
+    {
+        if (level < overlay) overlayLevels.push_back(level);
+    }
+    overlayLevels.push_back(overlay);
+    mQualityGovernor->AddKnob("overlay_scale", overlayLevels, static_cast<int>(overlayLevels.size()) - 1,
+                              QualityBound::GPU,
+                              [this](float v) { SetOverlayScale(v); });
     
-    // 2) 通常描画パス
-    glEnable(GL_CULL_FACE);
-    glFrontFace(GL_CCW);
+    float budget = mParticleBudget;
+    mQualityGovernor->AddKnob("particle_budget", { budget * 0.25f, budget * 0.5f, budget * 0.75f, budget }, 3,
+                              QualityBound::Both,
+                              [this](float v) { SetParticleBudget(v); });
     
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    float distance = mScatterDistanceScale;
+    mQualityGovernor->AddKnob("lod_bias", { distance * 0.5f, distance * 0.75f, distance }, 2,
+                              QualityBound::Both,
+                              [this](float v) { SetScatterQuality(mScatterDensity, v); });
     
-    // スカイドーム（背景）
-    DrawSky();
-
-    // レイヤー別描画（奥から順に）
-    DrawVisualLayer(VisualLayer::Background2D);
-    DrawVisualLayer(VisualLayer::Object3D);
-    DrawVisualLayer(VisualLayer::Effect3D);
-    DrawVisualLayer(VisualLayer::OverlayScreen);
-    DrawVisualLayer(VisualLayer::UI);
+    float interval = static_cast<float>(mShadowUpdateInterval);
+    mQualityGovernor->AddKnob("shadow_update", { interval * 4.0f, interval * 2.0f, interval }, 2,
+                              QualityBound::Both,
+                              [this](float v) { SetShadowUpdateInterval(static_cast<int>(v)); });
     
-    // Debug 用カウンタリセット
-    // std::cout << "Render 3D Objects Count = " << mCntDrawObject << std::endl;
-    mCntDrawObject = 0;
+    float res = static_cast<float>(mShadowFBOWidth);
+    float aspect = static_cast<float>(mShadowFBOHeight) / static_cast<float>(std::max(mShadowFBOWidth, 1));
+    mQualityGovernor->AddKnob("shadow_resolution", { std::max(res * 0.25f, 256.0f), std::max(res * 0.5f, 256.0f), res }, 2,
+                              QualityBound::GPU,
+                              [this, aspect](float v)
+                              {
+                                  SetShadowMapResolution(static_cast<int>(v), static_cast<int>(v * aspect));
+                              });
     
-    // バッファ入れ替え
-    SDL_GL_SwapWindow(mWindow);
+    float scale = mRenderScale;
+    mQualityGovernor->AddKnob("render_scale", { scale * 0.5f, scale * 0.67f, scale * 0.85f, scale }, 3,
+                              QualityBound::GPU,
+                              [this](float v) { SetRenderScale(v); });
 }
 
-// スカイドーム描画
-void Renderer::DrawSky()
+void Renderer::AddSkinnedComp(SkeletalMeshComponent* comp)
 {
-    if (!mSkyDomeComp)
-        return;
+    mSkinnedComps.push_back(comp);
+}
 
-    mSkyDomeComp->Draw();
+void Renderer::RemoveSkinnedComp(SkeletalMeshComponent* comp)
+{
+    auto iter = std::find(mSkinnedComps.begin(), mSkinnedComps.end(), comp);
+    if (iter != mSkinnedComps.end())
+        mSkinnedComps.erase(iter);
 }
 
+//-------------------------------------------------------------
+// ボーンパレット更新
+//   - 必要サイズを先に合計し、UBO を 1 回だけマップして全員分を書く
+//   - 各コンポーネントは得たオフセットをこのフレームの描画で使う
+//-------------------------------------------------------------
+void Renderer::UpdateBonePalettes()
+{
+    if (!mBonePaletteBuffer || mSkinnedComps.empty()) return;
 
-//=============================================================
-// VisualComponent 管理
-//=============================================================
+    GLsizeiptr total = 0;
+    for (auto comp : mSkinnedComps)
+    {
+        total += mBonePaletteBuffer->GetAlignedSize(comp->GetPaletteBoneCount());
+    }
 
-void Renderer::AddVisualComp(VisualComponent* comp)
-{
-    // DrawOrder 昇順で挿入
-    auto iter = mVisualComps.begin();
-    for (; iter != mVisualComps.end(); ++iter)
+    if (!mBonePaletteBuffer->BeginFrame(total))
+    {
+        for (auto comp : mSkinnedComps)
+        {
+            comp->InvalidatePalette();
+            comp->PreSkin(nullptr);
+        }
+        return;
+    }
+
+    for (auto comp : mSkinnedComps)
     {
-        if (comp->GetDrawOrder() < (*iter)->GetDrawOrder())
-            break;
+        comp->WritePalette(*mBonePaletteBuffer);
     }
-    mVisualComps.insert(iter, comp);
+
+    mBonePaletteBuffer->EndFrame();
 }
 
-void Renderer::RemoveVisualComp(VisualComponent* comp)
+//-------------------------------------------------------------
+// スキニング前処理
+//   - ここで 1 回だけスキニングし、シャドウ／通常／輪郭の
+//     各パスは結果のバッファを通常メッシュとして描く
+//   - どの可視リストにも入らなかったもの（画面外・影の外）は描かれないので
+//     スキニングしない（受け皿の中身は次に見えたときに作り直す）
+//-------------------------------------------------------------
+void Renderer::PreSkinVisible()
 {
-    auto iter = std::find(mVisualComps.begin(), mVisualComps.end(), comp);
-    if (iter != mVisualComps.end())
-        mVisualComps.erase(iter);
+    if (mSkinnedComps.empty()) return;
+
+    if (!IsPreSkinningActive())
+    {
+        for (auto comp : mSkinnedComps)
+        {
+            comp->PreSkin(nullptr);
+        }
+        return;
+    }
+
+    std::unordered_set<const VisualComponent*> drawn;
+    for (const auto& list : mLayerVisible)
+    {
+        drawn.insert(list.begin(), list.end());
+    }
+    drawn.insert(mShadowVisible.begin(), mShadowVisible.end());
+    for (const auto& v : mViews)
+    {
+        if (!v.desc.enabled) continue;
+        for (const auto& list : v.visible)
+        {
+            drawn.insert(list.begin(), list.end());
+        }
+    }
+
+    bool isBegun = false;
+    for (auto comp : mSkinnedComps)
+    {
+        if (drawn.find(comp) == drawn.end()) continue;
+        if (!isBegun)
+        {
+            mSkinningStage->Begin();
+            isBegun = true;
+        }
+        comp->PreSkin(mSkinningStage.get());
+    }
+    if (isBegun)
+    {
+        mSkinningStage->End();
+    }
 }
 
 
@@ -270,18 +1209,6 @@ void Renderer::RemoveVisualComp(VisualComponent* comp)
 
 void Renderer::DrawVisualLayer(VisualLayer layer)
 {
-    bool is3DLayer =
-        (layer == VisualLayer::Object3D ||
-         layer == VisualLayer::Effect3D);
-    
-    Frustum frustum;
-    if (is3DLayer)
-    {
-        // View * Projection からフラスタムを生成
-        Matrix4 vp = mViewMatrix * mProjectionMatrix;
-        frustum = BuildFrustumFromMatrix(vp);
-    }
-    
     //---------------------------------------------------------
     // レイヤーごとのデプス設定
     //---------------------------------------------------------
@@ -304,37 +1231,67 @@ void Renderer::DrawVisualLayer(VisualLayer layer)
         glDepthMask(GL_TRUE);
     }
     
+    //---------------------------------------------------------
+    // 不透明 3D はメッシュ描画キューに集めてソート描画
+    //   （シェーダ→マテリアル順。キューに積めないものは後で個別描画）
+    //---------------------------------------------------------
+    bool useQueue = (layer == VisualLayer::Object3D);
+    if (useQueue)
+    {
+        mMeshQueue.Clear();
+        mDeferredComps.clear();
+    }
+    
+    //---------------------------------------------------------
+    // 3D エフェクトは奥から手前へソートして描画
+    //   （深度を書かないので、並びがそのまま重なり順になる）
+    //---------------------------------------------------------
+    bool useSort = (layer == VisualLayer::Effect3D) && mIsTransparencySort;
+    if (useSort)
+    {
+        mTransparentQueue.Clear();
+    }
+    
     //---------------------------------------------------------
     // コンポーネント描画ループ
+    //   - 可視判定は BuildVisibleLists() で済んでいる
     //---------------------------------------------------------
-    for (auto& comp : mVisualComps)
+    for (auto comp : mDrawVisible[static_cast<int>(layer)])
     {
-        if (!comp->IsVisible() || comp->GetLayer() != layer)
-            continue;
+        mCntDrawObject++;
         
-        // 3Dレイヤーのみフラスタムカリング
-        if (is3DLayer)
+        if (useQueue)
         {
-            // Actor の BoundingVolumeComponent から AABB を取得
-            Actor* owner = comp->GetOwner();
-            if (owner)
+            if (!comp->SubmitDrawItems(mMeshQueue))
             {
-                auto bv = owner->GetComponent<BoundingVolumeComponent>();
-                if (bv)
-                {
-                    Cube aabb = bv->GetWorldAABB();
-
-                    // 視錐台外ならスキップ
-                    if (!FrustumIntersectsAABB(frustum, aabb))
-                    {
-                        continue;
-                    }
-                }
+                mDeferredComps.push_back(comp);
             }
+            continue;
+        }
+        
+        if (useSort)
+        {
+            mTransparentQueue.Add(comp, mViewMatrix);
+            continue;
         }
         
         comp->Draw();
-        mCntDrawObject++;
+    }
+    
+    if (useSort)
+    {
+        mTransparentQueue.Execute();
+    }
+    
+    if (useQueue)
+    {
+        mMeshQueue.Execute(this);
+        
+        // キューに載らなかったもの（加算ブレンド等）は DrawOrder 順に描画
+        for (auto comp : mDeferredComps)
+        {
+            comp->Draw();
+        }
     }
     
     // 状態戻し（保険）
@@ -399,7 +1356,19 @@ void Renderer::UnloadData()
 {
     // VisualComponent の登録だけをクリア
     // 実際の Mesh/Texture などのリソースは AssetManager 側で管理する想定
-    mVisualComps.clear();
+    for (int i = 0; i < NUM_VISUAL_LAYERS; ++i)
+    {
+        mLayerComps[i].clear();
+        mLayerVisible[i].clear();
+        for (auto& v : mViews)
+        {
+            v.visible[i].clear();
+        }
+        mIsLayerDirty[i] = false;
+    }
+    mShadowVisible.clear();
+    mPendingVisuals.clear();
+    mRemovedVisuals.clear();
 }
 
 //=============================================================
@@ -412,6 +1381,8 @@ void Renderer::OnWindowResized(int pixelW, int pixelH)
 
     mScreenWidth  = static_cast<float>(pixelW);
     mScreenHeight = static_cast<float>(pixelH);
+    mTargetWidth  = mScreenWidth;
+    mTargetHeight = mScreenHeight;
 
     glViewport(0, 0, pixelW, pixelH);
 
@@ -508,24 +1479,48 @@ bool Renderer::InitializeShadowMapping()
     return true;
 }
 
-// シャドウマップのレンダリング
-void Renderer::RenderShadowMap()
+// シャドウマップの解像度変更
+//  - テクスチャ ID はそのまま（FBO・各メッシュが持つ参照も有効なまま）
+void Renderer::SetShadowMapResolution(int width, int height)
+{
+    width  = std::max(width, 1);
+    height = std::max(height, 1);
+    if (width == mShadowFBOWidth && height == mShadowFBOHeight)
+        return;
+    
+    mShadowFBOWidth  = width;
+    mShadowFBOHeight = height;
+    if (mShadowMapTexture)
+    {
+        mShadowMapTexture->CreateShadowMap(mShadowFBOWidth, mShadowFBOHeight);
+        mIsShadowMapValid = false;
+    }
+}
+
+void Renderer::SetShadowUpdateInterval(int frames)
+{
+    mShadowUpdateInterval = std::max(frames, 1);
+}
+
+// ライト視点行列の更新
+//  - 可視リスト作成でライトフラスタムを使うため、描画より先に求める
+//  - 間引き中のフレームは前回の行列を残す（前回のマップと対になるように）
+void Renderer::UpdateLightSpaceMatrix()
 {
     // 太陽がほぼ消えている時はシャドウをスキップ
+    //   （メッシュ側はシャドウ参照なしのバリアントに切り替わる）
     float sunIntensity = mLightingManager->GetSunIntensity();
-    if (sunIntensity <= 0.01f)
+    mIsShadowMapActive = (sunIntensity > 0.01f);
+    if (!mIsShadowMapActive)
+    {
+        mIsShadowMapValid = false;
         return;
+    }
     
-    //---------------------------------------------------------
-    // シャドウ FBO バインド
-    //---------------------------------------------------------
-    glBindFramebuffer(GL_FRAMEBUFFER, mShadowFBO);
-    glViewport(0, 0,
-               (GLsizei)mShadowFBOWidth,
-               (GLsizei)mShadowFBOHeight);
-
-    glEnable(GL_DEPTH_TEST);
-    glClear(GL_DEPTH_BUFFER_BIT);
+    mIsShadowRefresh = !mIsShadowMapValid || ++mShadowFrameCount >= mShadowUpdateInterval;
+    if (!mIsShadowRefresh)
+        return;
+    mShadowFrameCount = 0;
     
     //---------------------------------------------------------
     // ライト視点行列を構築
@@ -554,35 +1549,37 @@ void Renderer::RenderShadowMap()
     Matrix4 lightVP = lightView * lightProj;
     mLightSpaceMatrix = lightVP;
     
-    // ライト側フラスタム（影用）を作成
-    Frustum shadowFrustum = BuildFrustumFromMatrix(lightVP);
+    // デバッグ表示：シャドウマップが覆う範囲
+    mDebugDraw->AddFrustum(lightVP, Vector3(1.0f, 0.8f, 0.2f));
+}
+
+// シャドウマップのレンダリング
+//  - 描画対象は BuildVisibleLists() でライトフラスタム判定済み
+void Renderer::RenderShadowMap()
+{
+    if (!mIsShadowMapActive || !mIsShadowRefresh)
+        return;
+    
+    //---------------------------------------------------------
+    // シャドウ FBO バインド
+    //---------------------------------------------------------
+    glBindFramebuffer(GL_FRAMEBUFFER, mShadowFBO);
+    glViewport(0, 0,
+               (GLsizei)mShadowFBOWidth,
+               (GLsizei)mShadowFBOHeight);
+
+    glEnable(GL_DEPTH_TEST);
+    glClear(GL_DEPTH_BUFFER_BIT);
     
     //---------------------------------------------------------
     // 影描画ループ
     //---------------------------------------------------------
-    for (auto& visual : mVisualComps)
+    for (auto visual : mShadowVisible)
     {
-        if (!visual->GetEnableShadow() || !visual->IsVisible())
-            continue;
-        
-        // ライト側フラスタムカリング
-        Actor* owner = visual->GetOwner();
-        if (owner)
-        {
-            auto bv = owner->GetComponent<BoundingVolumeComponent>();
-            if (bv)
-            {
-                Cube aabb = bv->GetWorldAABB();
-                // 必要なら aabb.Expand(…) 等で少し余裕を持たせる
-                
-                if (!FrustumIntersectsAABB(shadowFrustum, aabb))
-                    continue;
-            }
-        }
-        
         // 影用描画（VisualComponent 側でシャドウシェーダーを使う）
         visual->DrawShadow();
     }
+    mIsShadowMapValid = true;
     
     //---------------------------------------------------------
     // 元のフレームバッファとビューポートに戻す
@@ -635,25 +1632,62 @@ bool Renderer::LoadShaders()
     {
         return false;
     }
-
-    //---------------------------------------------------------
-    // メッシュ用 Phong シェーダー
-    //---------------------------------------------------------
-    vShaderName = mShaderPath + "Phong.vert";
-    fShaderName = mShaderPath + "Phong.frag";
-    mShaders["Mesh"] = std::make_shared<Shader>();
-    if (!mShaders["Mesh"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    
+    // 縮小オーバーレイの拡大合成（深度を見るバイラテラル）
+    vShaderName = mShaderPath + "WeatherScreen.vert";
+    fShaderName = mShaderPath + "WeatherUpsample.frag";
+    mShaders["WeatherUpsample"] = std::make_shared<Shader>();
+    if (!mShaders["WeatherUpsample"]->Load(vShaderName.c_str(), fShaderName.c_str()))
     {
         return false;
     }
 
     //---------------------------------------------------------
-    // スキンメッシュ用（頂点のみ差し替え）
+    // メッシュ用 Phong シェーダー（パーミュテーション）
+    //   - Phong.vert / Phong.frag を共通ソースとして、
+    //     スキニング・トゥーン・影・フォグ・単色を #define で切り替える
+    //   - 各バリアントは MeshComponent 等から要求された時にコンパイル
+    //---------------------------------------------------------
+    mShaderVariants["Phong"] = std::make_unique<ShaderVariantCache>(
+        mShaderPath + "Phong.vert",
+        mShaderPath + "Phong.frag");
+
+    //---------------------------------------------------------
+    // シャドウマップ用（USE_SKINNING / USE_INSTANCING の有無のみ）
+    //---------------------------------------------------------
+    mShaderVariants["Shadow"] = std::make_unique<ShaderVariantCache>(
+        mShaderPath + "ShadowMapping.vert",
+        mShaderPath + "ShadowMapping.frag");
+
+    //---------------------------------------------------------
+    // 地形用（高さテクスチャを頂点シェーダで引く。フラグメントは Phong 共通）
+    //---------------------------------------------------------
+    mShaderVariants["Terrain"] = std::make_unique<ShaderVariantCache>(
+        mShaderPath + "Terrain.vert",
+        mShaderPath + "Phong.frag");
+
+    //---------------------------------------------------------
+    // 八面体インポスター
+    //   - 描画：Billboard.vert（USE_IMPOSTOR）+ Impostor.frag
+    //   - ベイク：Phong.vert + ImpostorBake.frag（アルベド／法線・奥行きの MRT）
+    //---------------------------------------------------------
+    mShaderVariants["Impostor"] = std::make_unique<ShaderVariantCache>(
+        mShaderPath + "Billboard.vert",
+        mShaderPath + "Impostor.frag");
+    mShaderVariants["ImpostorBake"] = std::make_unique<ShaderVariantCache>(
+        mShaderPath + "Phong.vert",
+        mShaderPath + "ImpostorBake.frag");
+
+    //---------------------------------------------------------
+    // よく使うバリアントは起動時に作っておき、従来の名前でも引けるようにする
+    //   ここで失敗する場合はシェーダーソース自体が壊れている
     //---------------------------------------------------------
-    vShaderName = mShaderPath + "Skinned.vert";
-    fShaderName = mShaderPath + "Phong.frag";
-    mShaders["Skinned"] = std::make_shared<Shader>();
-    if (!mShaders["Skinned"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    mShaders["Mesh"]          = GetShaderVariant("Phong",  SF_SHADOW | SF_FOG);
+    mShaders["Skinned"]       = GetShaderVariant("Phong",  SF_SKINNED | SF_SHADOW | SF_FOG);
+    mShaders["ShadowMesh"]    = GetShaderVariant("Shadow", SF_NONE);
+    mShaders["ShadowSkinned"] = GetShaderVariant("Shadow", SF_SKINNED);
+    if (!mShaders["Mesh"] || !mShaders["Skinned"] ||
+        !mShaders["ShadowMesh"] || !mShaders["ShadowSkinned"])
     {
         return false;
     }
@@ -673,6 +1707,15 @@ bool Renderer::LoadShaders()
     Matrix4 viewProj = Matrix4::CreateSimpleViewProj(mScreenWidth, mScreenHeight);
     mShaders["Sprite"]->SetMatrixUniform("uViewProj", viewProj);
 
+    // 保持モード UI のキャッシュ合成（頂点はフルスクリーンクアッド）
+    vShaderName = mShaderPath + "WeatherScreen.vert";
+    fShaderName = mShaderPath + "UIComposite.frag";
+    mShaders["UIComposite"] = std::make_shared<Shader>();
+    if (!mShaders["UIComposite"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    {
+        return false;
+    }
+
     //---------------------------------------------------------
     // ビルボード
     //---------------------------------------------------------
@@ -695,6 +1738,17 @@ bool Renderer::LoadShaders()
         return false;
     }
 
+    //---------------------------------------------------------
+    // デバッグ線（DebugDraw）
+    //---------------------------------------------------------
+    vShaderName = mShaderPath + "DebugLine.vert";
+    fShaderName = mShaderPath + "DebugLine.frag";
+    mShaders["DebugLine"] = std::make_shared<Shader>();
+    if (!mShaders["DebugLine"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    {
+        return false;
+    }
+
     //---------------------------------------------------------
     // ソリッドカラー（ワイヤーフレーム／デバッグ用など）
     //---------------------------------------------------------
@@ -707,34 +1761,31 @@ bool Renderer::LoadShaders()
     }
 
     //---------------------------------------------------------
-    // シャドウマップ（スキンメッシュ）
+    // スカイドーム（時間帯・天候ベースの空）
     //---------------------------------------------------------
-    vShaderName = mShaderPath + "ShadowMapping_Skinned.vert";
-    fShaderName = mShaderPath + "ShadowMapping.frag";
-    mShaders["ShadowSkinned"] = std::make_shared<Shader>();
-    if (!mShaders["ShadowSkinned"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    vShaderName = mShaderPath + "WeatherDome.vert";
+    fShaderName = mShaderPath + "WeatherDome.frag";
+    mShaders["SkyDome"] = std::make_shared<Shader>();
+    if (!mShaders["SkyDome"]->Load(vShaderName.c_str(), fShaderName.c_str()))
     {
         return false;
     }
 
     //---------------------------------------------------------
-    // シャドウマップ（通常メッシュ）
+    // スカイキャッシュ（キューブマップへの焼き込み／参照）
     //---------------------------------------------------------
-    vShaderName = mShaderPath + "ShadowMapping_Mesh.vert";
-    fShaderName = mShaderPath + "ShadowMapping.frag";
-    mShaders["ShadowMesh"] = std::make_shared<Shader>();
-    if (!mShaders["ShadowMesh"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    vShaderName = mShaderPath + "SkyCapture.vert";
+    fShaderName = mShaderPath + "WeatherDome.frag";
+    mShaders["SkyCapture"] = std::make_shared<Shader>();
+    if (!mShaders["SkyCapture"]->Load(vShaderName.c_str(), fShaderName.c_str()))
     {
         return false;
     }
 
-    //---------------------------------------------------------
-    // スカイドーム（時間帯・天候ベースの空）
-    //---------------------------------------------------------
     vShaderName = mShaderPath + "WeatherDome.vert";
-    fShaderName = mShaderPath + "WeatherDome.frag";
-    mShaders["SkyDome"] = std::make_shared<Shader>();
-    if (!mShaders["SkyDome"]->Load(vShaderName.c_str(), fShaderName.c_str()))
+    fShaderName = mShaderPath + "SkyCube.frag";
+    mShaders["SkyCube"] = std::make_shared<Shader>();
+    if (!mShaders["SkyCube"]->Load(vShaderName.c_str(), fShaderName.c_str()))
     {
         return false;
     }
@@ -759,6 +1810,19 @@ bool Renderer::LoadShaders()
 }
 
 
+// パーミュテーション付きシェーダ取得
+std::shared_ptr<Shader> Renderer::GetShaderVariant(const std::string& name, uint32_t features)
+{
+    auto iter = mShaderVariants.find(name);
+    if (iter == mShaderVariants.end())
+    {
+        std::cerr << "[Renderer] Unknown shader variant source: " << name << std::endl;
+        return nullptr;
+    }
+    return iter->second->GetVariant(features);
+}
+
+
 //=============================================================
 // テキスト → テクスチャ生成（SDL3_ttf）
 //=============================================================
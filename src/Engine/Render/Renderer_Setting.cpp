@@ -1,5 +1,6 @@
 #include "Engine/Render/Renderer.h"
 #include "Engine/Render/LightingManager.h"
+#include "Engine/Render/QualityGovernor.h"
 #include "Utils/JsonHelper.h"
 #include <fstream>
 #include <iostream>
@@ -65,11 +66,13 @@ bool Renderer::LoadSettings(const std::string& filePath)
     
     //---------------------------------------------------------
     // デバッグモード
-    //   "debug": { "enabled": true }
+    //   "debug": { "enabled": true, "gl_recorder": false }
+    //   gl_recorder : GL コマンドのキャプチャ用フック（CaptureGLFrames）
     //---------------------------------------------------------
     if (data.contains("debug"))
     {
         JsonHelper::GetBool(data["debug"], "enabled", mIsDebugMode);
+        JsonHelper::GetBool(data["debug"], "gl_recorder", mIsGLRecorder);
     }
     
     //---------------------------------------------------------
@@ -123,6 +126,70 @@ bool Renderer::LoadSettings(const std::string& filePath)
         JsonHelper::GetInt  (data["shadow"], "resolution_height", mShadowFBOHeight);
     }
     
+    //---------------------------------------------------------
+    // 品質設定
+    //   "quality": {
+    //       "scatter_density":  1.0,
+    //       "scatter_distance": 1.0,
+    //       "meshlet_culling":  true,
+    //       "render_scale":     1.0,
+    //       "particle_budget":  1.0,
+    //       "shadow_update_interval": 1,
+    //       "overlay_scale":    1.0,
+    //       "overlay_depth_aware": true
+    //   }
+    //---------------------------------------------------------
+    if (data.contains("quality"))
+    {
+        float density  = mScatterDensity;
+        float distance = mScatterDistanceScale;
+        float scale    = mRenderScale;
+        float budget   = mParticleBudget;
+        int   interval = mShadowUpdateInterval;
+        float overlay  = mOverlayScale;
+        JsonHelper::GetFloat(data["quality"], "scatter_density",  density);
+        JsonHelper::GetFloat(data["quality"], "scatter_distance", distance);
+        SetScatterQuality(density, distance);
+        JsonHelper::GetBool(data["quality"], "meshlet_culling", mIsMeshletCulling);
+        JsonHelper::GetFloat(data["quality"], "render_scale",    scale);
+        JsonHelper::GetFloat(data["quality"], "particle_budget", budget);
+        JsonHelper::GetInt  (data["quality"], "shadow_update_interval", interval);
+        JsonHelper::GetFloat(data["quality"], "overlay_scale",   overlay);
+        JsonHelper::GetBool (data["quality"], "overlay_depth_aware", mIsOverlayDepthAware);
+        SetRenderScale(scale);
+        SetParticleBudget(budget);
+        SetShadowUpdateInterval(interval);
+        SetOverlayScale(overlay);
+    }
+    
+    //---------------------------------------------------------
+    // 品質ガバナー（"quality" と "shadow" の値を上限に自動で下げる）
+    //   "quality_governor": {
+    //       "enabled":         false,
+    //       "target_ms":       16.6,
+    //       "down_ratio":      1.10,
+    //       "up_ratio":        0.80,
+    //       "hold_frames":     30,
+    //       "cooldown_frames": 60,
+    //       "smoothing":       0.1,
+    //       "log":             false
+    //   }
+    //---------------------------------------------------------
+    if (data.contains("quality_governor"))
+    {
+        const auto& g = data["quality_governor"];
+        QualityGovernorSettings settings = mQualityGovernor->GetSettings();
+        JsonHelper::GetBool (g, "enabled",         settings.enabled);
+        JsonHelper::GetFloat(g, "target_ms",       settings.targetMs);
+        JsonHelper::GetFloat(g, "down_ratio",      settings.downRatio);
+        JsonHelper::GetFloat(g, "up_ratio",        settings.upRatio);
+        JsonHelper::GetInt  (g, "hold_frames",     settings.holdFrames);
+        JsonHelper::GetInt  (g, "cooldown_frames", settings.cooldownFrames);
+        JsonHelper::GetFloat(g, "smoothing",       settings.smoothing);
+        JsonHelper::GetBool (g, "log",             settings.log);
+        mQualityGovernor->SetSettings(settings);
+    }
+    
     std::cerr << "Loaded Renderer settings from "
               << filePath.c_str() << std::endl;
     return true;
@@ -2,6 +2,8 @@
 
 namespace toy {
 
+GLuint Shader::sActiveProgram = 0;
+
 //=============================================================
 // コンストラクタ／デストラクタ
 //=============================================================
@@ -24,17 +26,19 @@ Shader::~Shader()
 
 // シェーダー読み込み
 //  - 頂点シェーダー／フラグメントシェーダーをコンパイルしてリンクする
+//  - defines は両方のソースの #version 直後に差し込まれる
 //  - 成功すると mShaderProgramID が有効なプログラムになる
-bool Shader::Load(const std::string& vertName, const std::string& fragName)
+bool Shader::Load(const std::string& vertName, const std::string& fragName,
+                  const std::string& defines)
 {
     // 頂点シェーダーコンパイル
-    if (!CompileShader(vertName, GL_VERTEX_SHADER, mVertexShaderID))
+    if (!CompileShader(vertName, GL_VERTEX_SHADER, defines, mVertexShaderID))
     {
         return false;
     }
     
     // フラグメントシェーダーコンパイル
-    if (!CompileShader(fragName, GL_FRAGMENT_SHADER, mFragShaderID))
+    if (!CompileShader(fragName, GL_FRAGMENT_SHADER, defines, mFragShaderID))
     {
         return false;
     }
@@ -51,12 +55,58 @@ bool Shader::Load(const std::string& vertName, const std::string& fragName)
         return false;
     }
     
+    // 共有 UBO のバインディングポイントを設定
+    BindUniformBlocks();
+    
+    return true;
+}
+
+// トランスフォームフィードバック用プログラム読み込み
+//  - フラグメントシェーダは持たない（描画時は GL_RASTERIZER_DISCARD 前提）
+//  - varyings は GL_SEPARATE_ATTRIBS で 1 変数 = 1 バッファに書き出す
+//  - glTransformFeedbackVaryings はリンク前に指定する必要がある
+bool Shader::LoadTransformFeedback(const std::string& vertName,
+                                   const std::vector<std::string>& varyings,
+                                   const std::string& defines)
+{
+    if (!CompileShader(vertName, GL_VERTEX_SHADER, defines, mVertexShaderID))
+    {
+        return false;
+    }
+    
+    std::vector<const char*> names;
+    names.reserve(varyings.size());
+    for (const auto& v : varyings)
+    {
+        names.push_back(v.c_str());
+    }
+    
+    mShaderProgramID = glCreateProgram();
+    glAttachShader(mShaderProgramID, mVertexShaderID);
+    glTransformFeedbackVaryings(mShaderProgramID,
+                                static_cast<GLsizei>(names.size()),
+                                names.data(),
+                                GL_SEPARATE_ATTRIBS);
+    glLinkProgram(mShaderProgramID);
+    
+    if (!IsValidProgram())
+    {
+        return false;
+    }
+    
+    BindUniformBlocks();
+    
     return true;
 }
 
 // GL リソース解放
 void Shader::Unload()
 {
+    // 削除した ID は再利用されうるのでキャッシュも捨てる
+    if (sActiveProgram == mShaderProgramID)
+    {
+        sActiveProgram = 0;
+    }
     glDeleteProgram(mShaderProgramID);
     glDeleteShader(mVertexShaderID);
     glDeleteShader(mFragShaderID);
@@ -65,7 +115,10 @@ void Shader::Unload()
 // このシェーダープログラムを OpenGL にバインド
 void Shader::SetActive()
 {
+    if (sActiveProgram == mShaderProgramID) return;
+    
     glUseProgram(mShaderProgramID);
+    sActiveProgram = mShaderProgramID;
 }
 
 
@@ -81,7 +134,7 @@ void Shader::SetMatrixUniform(const char* name, const Matrix4& matrix)
 }
 
 // 4x4 行列配列を uniform に送る（スキンメッシュのボーン行列など）
-void Shader::SetMatrixUniforms(const char* name, Matrix4* matrices, unsigned count)
+void Shader::SetMatrixUniforms(const char* name, const Matrix4* matrices, unsigned count)
 {
     GLuint loc = glGetUniformLocation(mShaderProgramID, name);
     glUniformMatrix4fv(loc, count, GL_TRUE, matrices[0].GetAsFloatPtr());
@@ -137,8 +190,10 @@ void Shader::SetIntUniform(const char* name, int value)
 // シェーダーファイルを読み込んでコンパイル
 //  - fileName  : GLSL ファイルパス
 //  - shaderType: GL_VERTEX_SHADER / GL_FRAGMENT_SHADER など
+//  - defines   : #version 行の直後に挿入する文字列（空なら何もしない）
 //  - outShader : コンパイル済みシェーダー ID を返す
-bool Shader::CompileShader(const std::string& fileName, GLenum shaderType, GLuint& outShader)
+bool Shader::CompileShader(const std::string& fileName, GLenum shaderType,
+                           const std::string& defines, GLuint& outShader)
 {
     std::ifstream shaderFile(fileName);
     if (shaderFile.is_open())
@@ -147,6 +202,20 @@ bool Shader::CompileShader(const std::string& fileName, GLenum shaderType, GLuin
         std::stringstream sstream;
         sstream << shaderFile.rdbuf();
         std::string contents = sstream.str();
+
+        // #define の差し込み
+        //   #version は必ず先頭に置く必要があるため、その次の行に入れる
+        if (!defines.empty())
+        {
+            size_t insertPos = 0;
+            size_t verPos = contents.find("#version");
+            if (verPos != std::string::npos)
+            {
+                size_t eol = contents.find('\n', verPos);
+                insertPos = (eol == std::string::npos) ? contents.size() : eol + 1;
+            }
+            contents.insert(insertPos, defines);
+        }
         const char* contentsChar = contents.c_str();
         
         // シェーダー作成＆コンパイル
@@ -209,4 +278,30 @@ bool Shader::IsValidProgram()
     return true;
 }
 
+// 既知の uniform ブロックをバインディングポイントへ結び付ける
+//  - GLSL 4.1 では layout(binding = N) が使えないため C++ 側で行う
+//  - ブロックを持たないプログラムでは何もしない
+void Shader::BindUniformBlocks()
+{
+    struct BlockBinding
+    {
+        const char* name;
+        GLuint      binding;
+    };
+    static const BlockBinding kBlocks[] =
+    {
+        { "MaterialBlock", UBB_MATERIAL },
+        { "BonePalette",   UBB_BONES    },
+    };
+    
+    for (const auto& b : kBlocks)
+    {
+        GLuint index = glGetUniformBlockIndex(mShaderProgramID, b.name);
+        if (index != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(mShaderProgramID, index, b.binding);
+        }
+    }
+}
+
 } // namespace toy
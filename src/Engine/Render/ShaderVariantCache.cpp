@@ -0,0 +1,103 @@
+#include "Engine/Render/ShaderVariantCache.h"
+#include "Engine/Render/Shader.h"
+
+#include <iostream>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// 機能ビットと #define 名の対応表
+//-------------------------------------------------------------
+namespace {
+
+struct FeatureDefine
+{
+    uint32_t    bit;
+    const char* name;
+};
+
+const FeatureDefine kFeatureDefines[] =
+{
+    { SF_SKINNED,        "USE_SKINNING"       },
+    { SF_TOON,           "USE_TOON"           },
+    { SF_SHADOW,         "USE_SHADOW"         },
+    { SF_FOG,            "USE_FOG"            },
+    { SF_OVERRIDE_COLOR, "USE_OVERRIDE_COLOR" },
+    { SF_INSTANCED,      "USE_INSTANCING"     },
+    { SF_IMPOSTOR,       "USE_IMPOSTOR"       },
+    { SF_BAKED_LIGHTING, "USE_BAKED_LIGHTING" },
+};
+
+} // namespace
+
+
+ShaderVariantCache::ShaderVariantCache(const std::string& vertName,
+                                       const std::string& fragName)
+: mVertName(vertName)
+, mFragName(fragName)
+{
+}
+
+ShaderVariantCache::~ShaderVariantCache()
+{
+    Clear();
+}
+
+//-------------------------------------------------------------
+// バリアント取得
+//   - 初回はその場でコンパイル（ロード時に全組み合わせは作らない）
+//   - 失敗したマスクは nullptr として記録しておく
+//-------------------------------------------------------------
+std::shared_ptr<Shader> ShaderVariantCache::GetVariant(uint32_t features)
+{
+    auto iter = mVariants.find(features);
+    if (iter != mVariants.end())
+    {
+        return iter->second;
+    }
+
+    auto shader = std::make_shared<Shader>();
+    if (!shader->Load(mVertName, mFragName, BuildDefines(features)))
+    {
+        std::cerr << "[ShaderVariantCache] Failed to build variant 0x"
+                  << std::hex << features << std::dec
+                  << " (" << mVertName << ", " << mFragName << ")" << std::endl;
+        shader->Unload();
+        shader = nullptr;
+    }
+
+    mVariants[features] = shader;
+    return shader;
+}
+
+void ShaderVariantCache::Clear()
+{
+    for (auto& v : mVariants)
+    {
+        if (v.second)
+        {
+            v.second->Unload();
+        }
+    }
+    mVariants.clear();
+}
+
+//-------------------------------------------------------------
+// "#define USE_XXX" の列を生成
+//-------------------------------------------------------------
+std::string ShaderVariantCache::BuildDefines(uint32_t features)
+{
+    std::string defines;
+    for (const auto& f : kFeatureDefines)
+    {
+        if (features & f.bit)
+        {
+            defines += "#define ";
+            defines += f.name;
+            defines += "\n";
+        }
+    }
+    return defines;
+}
+
+} // namespace toy
@@ -0,0 +1,101 @@
+#include "Engine/Render/SkinningStage.h"
+#include "Engine/Render/Shader.h"
+#include "Asset/Geometry/VertexArray.h"
+
+#include <iostream>
+#include <vector>
+
+namespace toy {
+
+SkinningStage::SkinningStage()
+: mShader(nullptr)
+, mTFO(0)
+, mSkinnedVerts(0)
+{
+}
+
+SkinningStage::~SkinningStage()
+{
+    // 実際の解放処理は Shutdown() 側で行う前提
+}
+
+//-------------------------------------------------------------
+// 初期化
+//   - 失敗した場合 Renderer は従来のシェーダ内スキニングを使う
+//-------------------------------------------------------------
+bool SkinningStage::Initialize(const std::string& shaderPath)
+{
+    mShader = std::make_shared<Shader>();
+    const std::vector<std::string> varyings = { "outPosition", "outNormal" };
+    if (!mShader->LoadTransformFeedback(shaderPath + "SkinningTF.vert", varyings))
+    {
+        std::cerr << "[SkinningStage] Failed to load SkinningTF shader" << std::endl;
+        mShader->Unload();
+        mShader = nullptr;
+        return false;
+    }
+
+    glGenTransformFeedbacks(1, &mTFO);
+    if (mTFO == 0)
+    {
+        std::cerr << "[SkinningStage] Failed to create transform feedback object" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void SkinningStage::Shutdown()
+{
+    if (mTFO)
+    {
+        glDeleteTransformFeedbacks(1, &mTFO);
+        mTFO = 0;
+    }
+    if (mShader)
+    {
+        mShader->Unload();
+        mShader = nullptr;
+    }
+}
+
+//-------------------------------------------------------------
+// 開始／終了
+//   - ラスタライズは不要なので RASTERIZER_DISCARD で頂点処理だけ行う
+//-------------------------------------------------------------
+void SkinningStage::Begin()
+{
+    mSkinnedVerts = 0;
+
+    mShader->SetActive();
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, mTFO);
+    glEnable(GL_RASTERIZER_DISCARD);
+}
+
+void SkinningStage::End()
+{
+    glDisable(GL_RASTERIZER_DISCARD);
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+    glBindVertexArray(0);
+}
+
+//-------------------------------------------------------------
+// スキニング
+//   - 頂点ごとに 1 回（GL_POINTS）流し、出力は頂点順にそのまま並ぶ
+//     → インデックスバッファは元メッシュのものを共有できる
+//-------------------------------------------------------------
+void SkinningStage::Skin(VertexArray* source, VertexArray* dest)
+{
+    if (!source || !dest) return;
+
+    source->SetActive();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, dest->GetVertexBuffer(0));
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 1, dest->GetVertexBuffer(1));
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, source->GetNumVerts());
+    glEndTransformFeedback();
+
+    mSkinnedVerts += source->GetNumVerts();
+}
+
+} // namespace toy
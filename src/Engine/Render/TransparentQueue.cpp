@@ -0,0 +1,101 @@
+#include "Engine/Render/TransparentQueue.h"
+#include "Engine/Render/Shader.h"
+#include "Graphics/VisualComponent.h"
+#include "Asset/Material/Texture.h"
+#include "Utils/RadixSort.h"
+
+#include <algorithm>
+
+namespace toy {
+
+//-------------------------------------------------------------
+// ソートキーのビット割り当て
+//   [31.. 8] 奥行き（遠いほど小さい値 → 昇順で奥から手前）
+//   [ 7.. 0] ステート ID
+//-------------------------------------------------------------
+namespace {
+
+const int kDepthBits = 24;
+
+uint32_t MakeStateId(const VisualComponent* comp)
+{
+    // シェーダ・テクスチャ・ブレンドを 8bit に畳む
+    //   衝突しても並びが少し変わるだけ（描画結果は変わらない）
+    auto shader  = comp->GetShader();
+    auto texture = comp->GetTexture();
+    uint32_t h = 2166136261u;
+    h = (h ^ (shader  ? shader->GetProgramID()  : 0u)) * 16777619u;
+    h = (h ^ (texture ? texture->GetTextureID() : 0u)) * 16777619u;
+    h = (h ^ (comp->IsBlendAdd() ? 1u : 0u))          * 16777619u;
+    return (h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24)) & 0xFF;
+}
+
+} // namespace
+
+
+TransparentQueue::TransparentQueue()
+: mStateChanges(0)
+{
+}
+
+void TransparentQueue::Clear()
+{
+    mItems.clear();
+}
+
+void TransparentQueue::Add(VisualComponent* comp, const Matrix4& view)
+{
+    if (!comp) return;
+
+    TransparentDrawItem item;
+    item.comp      = comp;
+    item.viewDepth = Vector3::Transform(comp->GetSortPosition(), view).z;
+    item.stateId   = MakeStateId(comp);
+    mItems.push_back(item);
+}
+
+//-------------------------------------------------------------
+// ソートして描画
+//   - 奥行きはこのフレームの最小〜最大で正規化して量子化する
+//     （範囲が狭くても 24bit の分解能をすべて使える）
+//-------------------------------------------------------------
+void TransparentQueue::Execute()
+{
+    mStateChanges = 0;
+    if (mItems.empty()) return;
+
+    float minDepth = mItems[0].viewDepth;
+    float maxDepth = mItems[0].viewDepth;
+    for (const auto& item : mItems)
+    {
+        minDepth = std::min(minDepth, item.viewDepth);
+        maxDepth = std::max(maxDepth, item.viewDepth);
+    }
+    float range = maxDepth - minDepth;
+    float invRange = (range > 0.0f) ? 1.0f / range : 0.0f;
+
+    const uint32_t depthMask = (1u << kDepthBits) - 1u;
+    mKeys.resize(mItems.size());
+    for (size_t i = 0; i < mItems.size(); ++i)
+    {
+        float t = (mItems[i].viewDepth - minDepth) * invRange;
+        uint32_t depth = depthMask - RadixSort::Quantize(t, kDepthBits);
+        mKeys[i] = (depth << 8) | mItems[i].stateId;
+    }
+
+    RadixSort::SortIndices(mKeys, mOrder, mScratch);
+
+    uint32_t lastState = 0xFFFFFFFFu;
+    for (uint32_t index : mOrder)
+    {
+        const auto& item = mItems[index];
+        if (item.stateId != lastState)
+        {
+            ++mStateChanges;
+            lastState = item.stateId;
+        }
+        item.comp->Draw();
+    }
+}
+
+} // namespace toy
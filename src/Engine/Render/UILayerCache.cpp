@@ -0,0 +1,213 @@
+#include "Engine/Render/UILayerCache.h"
+#include "Engine/Render/Shader.h"
+#include "Asset/Geometry/VertexArray.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace toy {
+
+UILayerCache::UILayerCache()
+: mFBO(0)
+, mTexture(0)
+, mWidth(0)
+, mHeight(0)
+, mIsFullDirty(true)
+, mIsPartialRedraw(true)
+, mRedrawCount(0)
+, mPartialRedrawCount(0)
+{
+}
+
+UILayerCache::~UILayerCache()
+{
+    Shutdown();
+}
+
+void UILayerCache::Shutdown()
+{
+    if (mFBO)
+    {
+        glDeleteFramebuffers(1, &mFBO);
+        mFBO = 0;
+    }
+    if (mTexture)
+    {
+        glDeleteTextures(1, &mTexture);
+        mTexture = 0;
+    }
+    mWidth  = 0;
+    mHeight = 0;
+    mIsFullDirty = true;
+}
+
+//=============================================================
+// 汚れ範囲
+//=============================================================
+
+void UILayerCache::MarkDirty()
+{
+    mIsFullDirty = true;
+}
+
+void UILayerCache::MarkDirty(const UIRect& rect)
+{
+    if (rect.IsEmpty()) return;
+
+    if (mDirtyRect.IsEmpty())
+    {
+        mDirtyRect = rect;
+        return;
+    }
+
+    int x0 = std::min(mDirtyRect.x, rect.x);
+    int y0 = std::min(mDirtyRect.y, rect.y);
+    int x1 = std::max(mDirtyRect.x + mDirtyRect.w, rect.x + rect.w);
+    int y1 = std::max(mDirtyRect.y + mDirtyRect.h, rect.y + rect.h);
+    mDirtyRect = UIRect{ x0, y0, x1 - x0, y1 - y0 };
+}
+
+//=============================================================
+// キャッシュ更新
+//=============================================================
+
+//-------------------------------------------------------------
+// 画面サイズのカラーテクスチャ + FBO（深度は不要）
+//-------------------------------------------------------------
+bool UILayerCache::Resize(int width, int height)
+{
+    if (!mFBO)
+    {
+        glGenFramebuffers(1, &mFBO);
+        glGenTextures(1, &mTexture);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, mTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint prevFBO = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTexture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "UILayerCache: framebuffer incomplete (" << status << ")" << std::endl;
+        Shutdown();
+        return false;
+    }
+
+    mWidth  = width;
+    mHeight = height;
+    mIsFullDirty = true;
+    return true;
+}
+
+//-------------------------------------------------------------
+// 汚れていれば描き直す
+//   - 部分再描画：矩形をシザーで切ってクリアし、UI を全部描く
+//     （矩形の外はシザーで捨てられるので、重なり順もそのまま）
+//   - 矩形が画面の半分を超えるなら全体を描き直す方が安い
+//-------------------------------------------------------------
+bool UILayerCache::Update(int width, int height, const std::function<void()>& drawUI)
+{
+    if (width <= 0 || height <= 0) return false;
+
+    if (width != mWidth || height != mHeight || !mFBO)
+    {
+        if (!Resize(width, height)) return false;
+    }
+
+    if (!IsDirty()) return false;
+
+    // 画面外を切り落とす
+    UIRect rect = mDirtyRect;
+    bool partial = mIsPartialRedraw && !mIsFullDirty;
+    if (partial)
+    {
+        int x0 = std::max(rect.x, 0);
+        int y0 = std::max(rect.y, 0);
+        int x1 = std::min(rect.x + rect.w, mWidth);
+        int y1 = std::min(rect.y + rect.h, mHeight);
+        rect = UIRect{ x0, y0, x1 - x0, y1 - y0 };
+
+        if (rect.IsEmpty())
+        {
+            mDirtyRect = UIRect();
+            return false;
+        }
+        if (static_cast<long long>(rect.w) * rect.h * 2 > static_cast<long long>(mWidth) * mHeight)
+        {
+            partial = false;
+        }
+    }
+
+    //---------------------------------------------------------
+    // キャッシュへ描画（FBO・ビューポート・クリア色は戻す）
+    //---------------------------------------------------------
+    GLint   prevFBO = 0;
+    GLint   viewport[4];
+    GLfloat clearColor[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+    glViewport(0, 0, mWidth, mHeight);
+
+    if (partial)
+    {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(rect.x, rect.y, rect.w, rect.h);
+        ++mPartialRedrawCount;
+    }
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    drawUI();
+
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    mIsFullDirty = false;
+    mDirtyRect   = UIRect();
+    ++mRedrawCount;
+    return true;
+}
+
+//-------------------------------------------------------------
+// 合成（乗算済みアルファの over）
+//-------------------------------------------------------------
+void UILayerCache::Composite(Shader* shader, VertexArray* quad)
+{
+    if (!mTexture || !shader || !quad) return;
+
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader->SetActive();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, mTexture);
+    shader->SetTextureUniform("uTexture", 0);
+
+    quad->SetActive();
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+}
+
+} // namespace toy
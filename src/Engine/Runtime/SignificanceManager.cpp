@@ -0,0 +1,144 @@
+#include "Engine/Runtime/SignificanceManager.h"
+#include "Engine/Core/Actor.h"
+#include "Physics/BoundingVolumeComponent.h"
+#include "Asset/Geometry/Polygon.h"
+#include "Utils/FrustumUtil.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace toy {
+
+//======================================================================
+// SignificanceManager
+//   - 既定の間引き方（段階が 1 つ下がるごとにおおむね半分）
+//     High    : すべて毎フレーム
+//     Medium  : アニメ・音は 2 フレームに 1 回、パーティクルは 3/4 だけ描く
+//     Low     : アニメ・音は 4 フレームに 1 回、パーティクルは半分、影を落とさない
+//     Dormant : アニメを止め、ループ音は一時停止、パーティクルは 8 フレームに 1 回
+//======================================================================
+SignificanceManager::SignificanceManager()
+: mFrame(0)
+{
+    mPolicies[static_cast<int>(Significance::Medium)]  = { 2, 1, 0.75f, 2, true };
+    mPolicies[static_cast<int>(Significance::Low)]     = { 4, 2, 0.5f,  4, false };
+    mPolicies[static_cast<int>(Significance::Dormant)] = { 0, 8, 0.25f, 0, false };
+
+    for (int i = 0; i < NUM_SIGNIFICANCE; ++i)
+    {
+        mCounts[i] = 0;
+    }
+}
+
+//----------------------------------------------------------------------
+// Update
+//   - 位置と半径は BoundingVolumeComponent のワールド AABB（無ければ Actor 位置）
+//   - 画面上の大きさ = 半径 / (距離 * tan(fov/2))  ※ 射影行列の [1][1] が cot(fov/2)
+//----------------------------------------------------------------------
+void SignificanceManager::Update(const std::vector<std::unique_ptr<Actor>>& actors,
+                                 const Matrix4& view, const Matrix4& projection)
+{
+    ++mFrame;
+    for (int i = 0; i < NUM_SIGNIFICANCE; ++i)
+    {
+        mCounts[i] = 0;
+    }
+
+    if (!mSettings.enabled)
+    {
+        for (auto& a : actors)
+        {
+            a->SetSignificance(Significance::High, 1.0f);
+        }
+        mCounts[static_cast<int>(Significance::High)] = static_cast<int>(actors.size());
+        return;
+    }
+
+    Matrix4 invView = view;
+    invView.Invert();
+    Vector3 cameraPos = invView.GetTranslation();
+    Frustum frustum   = BuildFrustumFromMatrix(view * projection);
+    float   yScale    = projection.mat[1][1];
+
+    for (auto& a : actors)
+    {
+        Vector3 center;
+        float   radius;
+        auto bv = a->GetComponent<BoundingVolumeComponent>();
+        bool hasBounds = (bv && bv->GetAABB());
+        Cube box;
+        if (hasBounds)
+        {
+            box    = bv->GetWorldAABB();
+            center = (box.min + box.max) * 0.5f;
+            radius = (box.max - box.min).Length() * 0.5f;
+        }
+        else
+        {
+            center = a->GetWorldTransform().GetTranslation();
+            radius = mSettings.defaultRadius * a->GetScale();
+            box.min = center - Vector3(radius, radius, radius);
+            box.max = center + Vector3(radius, radius, radius);
+        }
+
+        float distance = (center - cameraPos).Length();
+        Significance s;
+        float score;
+        if (distance - radius <= mSettings.nearDistance)
+        {
+            s     = Significance::High;
+            score = std::max(mSettings.highSize, 1.0f);
+        }
+        else
+        {
+            score = radius * yScale / distance;
+            if (!FrustumIntersectsAABB(frustum, box))
+            {
+                score *= mSettings.hiddenWeight;
+            }
+            s = Classify(score, a->GetSignificance());
+        }
+
+        a->SetSignificance(s, score);
+        ++mCounts[static_cast<int>(s)];
+    }
+}
+
+//----------------------------------------------------------------------
+// 段階の決定（下がる時だけしきい値を緩めて判定し直す）
+//----------------------------------------------------------------------
+Significance SignificanceManager::Classify(float score, Significance current) const
+{
+    auto classify = [this](float v)
+    {
+        if (v >= mSettings.highSize)   return Significance::High;
+        if (v >= mSettings.mediumSize) return Significance::Medium;
+        if (v >= mSettings.lowSize)    return Significance::Low;
+        return Significance::Dormant;
+    };
+
+    Significance raw = classify(score);
+    if (raw <= current)
+    {
+        return raw;
+    }
+
+    float keep = std::max(1.0f - mSettings.hysteresis, 0.01f);
+    Significance held = classify(score / keep);
+    return (held <= current) ? current : held;
+}
+
+//----------------------------------------------------------------------
+// 間引き更新のタイミング
+//   - 同じ段階の Actor が同じフレームに固まらないよう、アドレスで位相をずらす
+//----------------------------------------------------------------------
+bool SignificanceManager::IsUpdateFrame(int interval, const Actor* actor) const
+{
+    if (interval <= 0) return false;
+    if (interval == 1) return true;
+
+    uint64_t phase = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(actor) >> 6);
+    return ((mFrame + phase) % static_cast<uint64_t>(interval)) == 0;
+}
+
+} // namespace toy
@@ -0,0 +1,493 @@
+#include "Environment/ScatterComponent.h"
+#include "Physics/HeightField.h"
+#include "Graphics/Mesh/ImpostorAtlas.h"
+#include "Asset/Geometry/Mesh.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Asset/Material/Material.h"
+#include "Asset/Material/Texture.h"
+#include "Engine/Core/Actor.h"
+#include "Engine/Core/Application.h"
+#include "Engine/Render/Renderer.h"
+#include "Engine/Render/Shader.h"
+#include "Engine/Render/LightingManager.h"
+#include "Engine/Render/DebugDraw.h"
+#include "Utils/FrustumUtil.h"
+
+#include "glad/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace toy {
+
+namespace {
+
+// AABB とカメラ位置の距離の 2 乗
+float DistanceSqToBox(const Cube& box, const Vector3& p)
+{
+    float dx = std::max({ box.min.x - p.x, 0.0f, p.x - box.max.x });
+    float dy = std::max({ box.min.y - p.y, 0.0f, p.y - box.max.y });
+    float dz = std::max({ box.min.z - p.z, 0.0f, p.z - box.max.z });
+    return dx * dx + dy * dy + dz * dz;
+}
+
+} // namespace
+
+
+ScatterComponent::ScatterComponent(Actor* owner, int drawOrder)
+: VisualComponent(owner, drawOrder, VisualLayer::Object3D)
+, mCellSize(16.0f)
+, mFadeStart(80.0f)
+, mFadeEnd(100.0f)
+, mInstanceCount(0)
+, mMaxRadius(0.0f)
+, mNumLODs(0)
+, mRandom(1u)
+, mInstanceBuffer(0)
+, mInstanceCapacity(0)
+, mDrawnCount(0)
+{
+}
+
+ScatterComponent::~ScatterComponent()
+{
+    // インスタンス VAO はバッファを共有しているだけなので先に破棄
+    for (auto& lod : mLODs)
+    {
+        lod.instanceVAs.clear();
+    }
+    if (mInstanceBuffer)
+    {
+        glDeleteBuffers(1, &mInstanceBuffer);
+    }
+}
+
+//------------------------------------------------------------------
+// 設定
+//------------------------------------------------------------------
+void ScatterComponent::SetCellSize(float size)
+{
+    if (mInstanceCount > 0)
+    {
+        std::cerr << "[ScatterComponent] SetCellSize must be called before adding instances" << std::endl;
+        return;
+    }
+    mCellSize = (size > 0.0f) ? size : 16.0f;
+}
+
+ScatterComponent::ScatterLOD* ScatterComponent::ResetLOD(int lod, float maxDistance)
+{
+    if (lod < 0 || lod >= kMaxLODs)
+    {
+        std::cerr << "[ScatterComponent] Invalid LOD index: " << lod << std::endl;
+        return nullptr;
+    }
+
+    EnsureInstanceBuffer();
+
+    ScatterLOD& dst = mLODs[lod];
+    dst.mesh        = nullptr;
+    dst.impostor    = nullptr;
+    dst.maxDistance = maxDistance;
+    dst.radius      = 0.0f;
+    dst.instanceVAs.clear();
+    return &dst;
+}
+
+void ScatterComponent::UpdateLODBounds()
+{
+    mNumLODs   = 0;
+    mMaxRadius = 0.0f;
+    for (int i = 0; i < kMaxLODs; ++i)
+    {
+        if (mLODs[i].mesh || mLODs[i].impostor)
+        {
+            mNumLODs   = i + 1;
+            mMaxRadius = std::max(mMaxRadius, mLODs[i].radius);
+        }
+    }
+}
+
+void ScatterComponent::SetLODMesh(int lod, std::shared_ptr<Mesh> mesh, float maxDistance)
+{
+    if (!mesh) return;
+    ScatterLOD* dst = ResetLOD(lod, maxDistance);
+    if (!dst) return;
+
+    dst->mesh = mesh;
+
+    // サブメッシュごとにインスタンス属性付きの VAO を作る
+    for (const auto& va : mesh->GetVertexArray())
+    {
+        dst->instanceVAs.emplace_back(std::make_unique<VertexArray>(va.get(), mInstanceBuffer));
+
+        for (const auto& poly : va->GetPolygons())
+        {
+            dst->radius = std::max({ dst->radius, poly.a.Length(), poly.b.Length(), poly.c.Length() });
+        }
+    }
+
+    UpdateLODBounds();
+}
+
+void ScatterComponent::SetLODImpostor(int lod, std::shared_ptr<ImpostorAtlas> impostor, float maxDistance)
+{
+    if (!impostor || !impostor->IsValid()) return;
+    ScatterLOD* dst = ResetLOD(lod, maxDistance);
+    if (!dst) return;
+
+    dst->impostor = impostor;
+    dst->radius   = impostor->GetCenter().Length() + impostor->GetRadius();
+    dst->instanceVAs.emplace_back(std::make_unique<VertexArray>(impostor->GetQuad().get(), mInstanceBuffer));
+
+    UpdateLODBounds();
+}
+
+void ScatterComponent::SetFadeRange(float start, float end)
+{
+    mFadeEnd   = std::max(end, 0.0f);
+    mFadeStart = Math::Clamp(start, 0.0f, mFadeEnd);
+}
+
+void ScatterComponent::EnsureInstanceBuffer()
+{
+    if (!mInstanceBuffer)
+    {
+        glGenBuffers(1, &mInstanceBuffer);
+    }
+}
+
+//------------------------------------------------------------------
+// インスタンス追加
+//------------------------------------------------------------------
+ScatterComponent::ScatterCell& ScatterComponent::GetCell(const Vector3& pos)
+{
+    int32_t cx = static_cast<int32_t>(std::floor(pos.x / mCellSize));
+    int32_t cz = static_cast<int32_t>(std::floor(pos.z / mCellSize));
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32)
+                 | static_cast<uint32_t>(cz);
+
+    auto it = mCellIndex.find(key);
+    if (it != mCellIndex.end())
+    {
+        return mCells[it->second];
+    }
+
+    mCellIndex.emplace(key, mCells.size());
+    mCells.emplace_back();
+    ScatterCell& cell = mCells.back();
+    cell.bounds.min = pos;
+    cell.bounds.max = pos;
+    cell.maxScale   = 0.0f;
+    return cell;
+}
+
+void ScatterComponent::AddInstance(const Vector3& pos, float yaw, float scale)
+{
+    Matrix4 world = Matrix4::CreateScale(scale)
+                  * Matrix4::CreateRotationY(yaw)
+                  * Matrix4::CreateTranslation(pos);
+    AddInstance(world);
+}
+
+void ScatterComponent::AddInstance(const Matrix4& world)
+{
+    Vector3 pos = world.GetTranslation();
+    ScatterCell& cell = GetCell(pos);
+
+    ScatterInstance inst;
+    for (int j = 0; j < 3; ++j)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            inst.col[j][i] = world.mat[i][j];
+        }
+    }
+
+    cell.bounds.min.x = std::min(cell.bounds.min.x, pos.x);
+    cell.bounds.min.y = std::min(cell.bounds.min.y, pos.y);
+    cell.bounds.min.z = std::min(cell.bounds.min.z, pos.z);
+    cell.bounds.max.x = std::max(cell.bounds.max.x, pos.x);
+    cell.bounds.max.y = std::max(cell.bounds.max.y, pos.y);
+    cell.bounds.max.z = std::max(cell.bounds.max.z, pos.z);
+    cell.maxScale = std::max(cell.maxScale, world.GetScale().x);
+    cell.maxScale = std::max(cell.maxScale, world.GetScale().y);
+    cell.maxScale = std::max(cell.maxScale, world.GetScale().z);
+
+    // 挿入しながらシャッフル（先頭の一部だけ描いても偏らない）
+    auto& list = cell.instances;
+    list.push_back(inst);
+    size_t j = mRandom() % list.size();
+    std::swap(list[j], list.back());
+
+    ++mInstanceCount;
+}
+
+void ScatterComponent::ScatterRandom(const Vector3& min, const Vector3& max, int count,
+                                     float minScale, float maxScale, unsigned int seed,
+                                     const HeightField* ground)
+{
+    std::minstd_rand rng(seed);
+    std::uniform_real_distribution<float> rx(min.x, max.x);
+    std::uniform_real_distribution<float> ry(min.y, max.y);
+    std::uniform_real_distribution<float> rz(min.z, max.z);
+    std::uniform_real_distribution<float> rs(minScale, maxScale);
+    std::uniform_real_distribution<float> ryaw(0.0f, Math::TwoPi);
+
+    for (int i = 0; i < count; ++i)
+    {
+        Vector3 pos(rx(rng), ry(rng), rz(rng));
+        if (ground && ground->Contains(pos.x, pos.z))
+        {
+            pos.y = ground->GetHeight(pos.x, pos.z);
+        }
+        AddInstance(pos, ryaw(rng), rs(rng));
+    }
+}
+
+void ScatterComponent::ClearInstances()
+{
+    mCells.clear();
+    mCellIndex.clear();
+    mInstanceCount = 0;
+}
+
+//------------------------------------------------------------------
+// GatherInstances
+//  - セル単位でフラスタム／距離カリング
+//  - 密度に応じてセルの先頭から一部だけ取り出す
+//  - インスタンスごとにカメラ距離で LOD を選び、LOD 順に 1 本の
+//    バッファへ詰める（毎回 orphan してから転送）
+//------------------------------------------------------------------
+size_t ScatterComponent::GatherInstances(const Frustum& frustum, const Vector3& camPos)
+{
+    for (auto& s : mStaging)
+    {
+        s.clear();
+    }
+    if (mNumLODs == 0 || mCells.empty()) return 0;
+
+    Renderer* renderer = GetOwner()->GetApp()->GetRenderer();
+    float density   = renderer->GetScatterDensity();
+    float distScale = renderer->GetScatterDistanceScale();
+    if (density <= 0.0f || distScale <= 0.0f) return 0;
+
+    float fadeEnd   = mFadeEnd * distScale;
+    float fadeEndSq = fadeEnd * fadeEnd;
+
+    float lodMaxSq[kMaxLODs];
+    for (int i = 0; i < mNumLODs; ++i)
+    {
+        float d = mLODs[i].maxDistance * distScale;
+        lodMaxSq[i] = d * d;
+    }
+
+    for (const auto& cell : mCells)
+    {
+        float pad = mMaxRadius * cell.maxScale;
+        Cube box;
+        box.min = cell.bounds.min - Vector3(pad, pad, pad);
+        box.max = cell.bounds.max + Vector3(pad, pad, pad);
+
+        if (DistanceSqToBox(box, camPos) > fadeEndSq) continue;
+        if (!FrustumIntersectsAABB(frustum, box)) continue;
+
+        size_t count = static_cast<size_t>(std::ceil(cell.instances.size() * density));
+        for (size_t i = 0; i < count; ++i)
+        {
+            const ScatterInstance& inst = cell.instances[i];
+            float dx = inst.col[0][3] - camPos.x;
+            float dy = inst.col[1][3] - camPos.y;
+            float dz = inst.col[2][3] - camPos.z;
+            float distSq = dx * dx + dy * dy + dz * dz;
+            if (distSq > fadeEndSq) continue;
+
+            for (int lod = 0; lod < mNumLODs; ++lod)
+            {
+                if (distSq <= lodMaxSq[lod])
+                {
+                    if (mLODs[lod].mesh || mLODs[lod].impostor)
+                    {
+                        mStaging[lod].push_back(inst);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < mNumLODs; ++i)
+    {
+        total += mStaging[i].size();
+    }
+    if (total == 0) return 0;
+
+    //------------------------------------------------------------------
+    // 転送（足りなければ拡張、足りていれば orphan して詰め直す）
+    //------------------------------------------------------------------
+    size_t bytes = total * sizeof(ScatterInstance);
+    if (bytes > mInstanceCapacity)
+    {
+        mInstanceCapacity = std::max(bytes, mInstanceCapacity * 2);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, mInstanceCapacity, nullptr, GL_STREAM_DRAW);
+
+    size_t offset = 0;
+    for (int i = 0; i < mNumLODs; ++i)
+    {
+        size_t size = mStaging[i].size() * sizeof(ScatterInstance);
+        if (size == 0) continue;
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, mStaging[i].data());
+        offset += size;
+    }
+
+    return total;
+}
+
+void ScatterComponent::DrawLODs(Shader* shader, bool impostors, bool bindMaterial, bool depthOnly)
+{
+    Renderer* renderer = GetOwner()->GetApp()->GetRenderer();
+    auto materials = renderer->GetMaterialBuffer();
+
+    size_t offset = 0;
+    for (int lod = 0; lod < mNumLODs; ++lod)
+    {
+        const ScatterLOD& src = mLODs[lod];
+        size_t  bytes = mStaging[lod].size() * sizeof(ScatterInstance);
+        GLsizei count = static_cast<GLsizei>(mStaging[lod].size());
+        bool isImpostor = (src.impostor != nullptr);
+        if (count == 0 || isImpostor != impostors)
+        {
+            offset += bytes;
+            continue;
+        }
+
+        if (isImpostor)
+        {
+            src.impostor->Apply(shader);
+        }
+
+        for (size_t i = 0; i < src.instanceVAs.size(); ++i)
+        {
+            VertexArray* va = src.instanceVAs[i].get();
+            if (bindMaterial && src.mesh)
+            {
+                auto mat = src.mesh->GetMaterial(src.mesh->GetVertexArray()[i]->GetTextureID());
+                Material* material = mat ? mat.get() : renderer->GetDefaultMaterial().get();
+                material->Bind(materials, 0);
+            }
+
+            va->SetInstanceOffset(offset, depthOnly);
+            glDrawElementsInstanced(GL_TRIANGLES, va->GetNumIndices(), GL_UNSIGNED_INT, nullptr, count);
+        }
+        offset += bytes;
+    }
+}
+
+//------------------------------------------------------------------
+// Draw
+//------------------------------------------------------------------
+void ScatterComponent::Draw()
+{
+    mDrawnCount = 0;
+
+    Renderer* renderer = GetOwner()->GetApp()->GetRenderer();
+    Matrix4 view     = renderer->GetViewMatrix();
+    Matrix4 viewProj = view * renderer->GetProjectionMatrix();
+    Vector3 camPos   = renderer->GetInvViewMatrix().GetTranslation();
+    Frustum frustum  = BuildFrustumFromMatrix(viewProj);
+
+    size_t total = GatherInstances(frustum, camPos);
+    if (total == 0) return;
+
+    //------------------------------------------------------------------
+    // シェーダ（影・フォグは MeshComponent と同じ条件）
+    //------------------------------------------------------------------
+    bool useShadow = renderer->IsShadowMapActive();
+    uint32_t features = SF_INSTANCED | SF_FOG | (useShadow ? SF_SHADOW : SF_NONE);
+    auto shader = renderer->GetShaderVariant("Phong", features);
+    if (!shader) return;
+
+    shader->SetActive();
+    mLightingManager->ApplyToShader(shader, view);
+    shader->SetMatrixUniform("uViewProj", viewProj);
+    shader->SetTextureUniform("uTexture", 0);
+    if (useShadow)
+    {
+        renderer->GetShadowMapTexture()->SetActive(1);
+        shader->SetMatrixUniform("uLightSpaceMatrix", renderer->GetLightSpaceMatrix());
+        shader->SetTextureUniform("uShadowMap", 1);
+        shader->SetFloatUniform("uShadowBias", 0.005f);
+    }
+
+    float distScale = renderer->GetScatterDistanceScale();
+    Vector2 fadeRange(mFadeStart * distScale, mFadeEnd * distScale);
+    shader->SetVector2Uniform("uFadeRange", fadeRange);
+
+    DrawLODs(shader.get(), false, true);
+
+    //------------------------------------------------------------------
+    // インポスターの LOD（板ポリの向きはシェーダで決まるのでカリングなし）
+    //------------------------------------------------------------------
+    bool hasImpostor = false;
+    for (int i = 0; i < mNumLODs; ++i)
+    {
+        hasImpostor |= (mLODs[i].impostor && !mStaging[i].empty());
+    }
+    if (hasImpostor)
+    {
+        auto impostorShader = renderer->GetShaderVariant("Impostor", SF_IMPOSTOR | SF_INSTANCED | SF_FOG);
+        if (impostorShader)
+        {
+            impostorShader->SetActive();
+            mLightingManager->ApplyToShader(impostorShader, view);
+            impostorShader->SetMatrixUniform("uViewProj", viewProj);
+            impostorShader->SetVector2Uniform("uFadeRange", fadeRange);
+
+            glDisable(GL_CULL_FACE);
+            DrawLODs(impostorShader.get(), true, false);
+            glEnable(GL_CULL_FACE);
+        }
+    }
+    mDrawnCount = static_cast<unsigned int>(total);
+
+    //------------------------------------------------------------------
+    // デバッグ時はセルの範囲を表示
+    //------------------------------------------------------------------
+    DebugDraw* debug = renderer->GetDebugDraw();
+    if (debug && debug->IsEnabled())
+    {
+        for (const auto& cell : mCells)
+        {
+            debug->AddBox(cell.bounds.min, cell.bounds.max, Vector3(0.3f, 0.9f, 0.3f));
+        }
+    }
+}
+
+//------------------------------------------------------------------
+// DrawShadow
+//  - ライト空間のフラスタムで集め直す（LOD・フェードはカメラ距離）
+//  - インポスターの LOD は影に描かない
+//------------------------------------------------------------------
+void ScatterComponent::DrawShadow()
+{
+    Renderer* renderer = GetOwner()->GetApp()->GetRenderer();
+    Matrix4 light   = renderer->GetLightSpaceMatrix();
+    Vector3 camPos  = renderer->GetInvViewMatrix().GetTranslation();
+    Frustum frustum = BuildFrustumFromMatrix(light);
+
+    if (GatherInstances(frustum, camPos) == 0) return;
+
+    auto shader = renderer->GetShaderVariant("Shadow", SF_INSTANCED);
+    if (!shader) return;
+
+    shader->SetActive();
+    shader->SetMatrixUniform("uLightSpaceMatrix", light);
+
+    DrawLODs(shader.get(), false, false, true);
+}
+
+} // namespace toy
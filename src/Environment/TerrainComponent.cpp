@@ -0,0 +1,429 @@
+#include "Environment/TerrainComponent.h"
+#include "Physics/HeightField.h"
+#include "Physics/PhysWorld.h"
+#include "Asset/AssetManager.h"
+#include "Asset/Geometry/Polygon.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Asset/Material/Material.h"
+#include "Asset/Material/Texture.h"
+#include "Engine/Core/Actor.h"
+#include "Engine/Core/Application.h"
+#include "Engine/Render/Renderer.h"
+#include "Engine/Render/Shader.h"
+#include "Engine/Render/LightingManager.h"
+#include "Engine/Render/DebugDraw.h"
+#include "Utils/FrustumUtil.h"
+
+#include "glad/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace toy {
+
+namespace {
+
+// モーフを始める位置（前段の距離 → この段の距離 の割合）
+const float kMorphStartRatio = 0.7f;
+
+// ハイトマップのサンプラーユニット（0:地表, 1:シャドウマップ）
+const int kHeightMapUnit = 2;
+
+// AABB と球の交差
+bool BoxIntersectsSphere(const Cube& box, const Vector3& center, float radius)
+{
+    float dx = std::max({ box.min.x - center.x, 0.0f, center.x - box.max.x });
+    float dy = std::max({ box.min.y - center.y, 0.0f, center.y - box.max.y });
+    float dz = std::max({ box.min.z - center.z, 0.0f, center.z - box.max.z });
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+} // namespace
+
+
+TerrainComponent::TerrainComponent(Actor* owner, int drawOrder)
+: VisualComponent(owner, drawOrder, VisualLayer::Object3D)
+, mHeightField(std::make_shared<HeightField>())
+, mMaterial(std::make_shared<Material>())
+, mGridDim(32)
+, mLODLevels(5)
+, mLOD0Range(0.0f)
+, mTexTiling(8.0f)
+{
+    // シャドウマップには描かない（Shadow 系シェーダは高さテクスチャを引けない）
+    mEnableShadow = false;
+}
+
+TerrainComponent::~TerrainComponent()
+{
+    // PhysWorld に残っていると破棄後に参照されるので外しておく
+    auto phys = GetOwner()->GetApp()->GetPhysWorld();
+    if (phys && phys->GetHeightField() == mHeightField.get())
+    {
+        phys->SetHeightField(nullptr);
+    }
+}
+
+//----------------------------------------------------------------------
+// ハイトマップ読み込み
+//  - HeightField（CPU）と R16 テクスチャ（GPU）に同じデータを置く
+//  - 読み込めたら PhysWorld の地面判定に登録
+//----------------------------------------------------------------------
+bool TerrainComponent::LoadHeightMap(const std::string& fileName,
+                                     int width, int depth,
+                                     float cellSize, float heightScale)
+{
+    Application* app = GetOwner()->GetApp();
+    std::string fullName = app->GetAssetManager()->GetAssetsPath() + fileName;
+
+    if (!mHeightField->LoadRaw16(fullName, width, depth))
+    {
+        return false;
+    }
+
+    // Actor の位置を地形の中心にする
+    Vector3 pos = GetOwner()->GetPosition();
+    Vector3 origin(pos.x - (width - 1) * cellSize * 0.5f,
+                   pos.y,
+                   pos.z - (depth - 1) * cellSize * 0.5f);
+    mHeightField->SetPlacement(origin, cellSize, heightScale);
+
+    mHeightMap = std::make_shared<Texture>();
+    if (!mHeightMap->CreateHeightMap(mHeightField->GetSamples().data(), width, depth))
+    {
+        std::cerr << "[TerrainComponent] Failed to create height texture: " << fileName << std::endl;
+        mHeightMap = nullptr;
+        return false;
+    }
+
+    CreateGridMesh();
+    BuildQuadTree();
+
+    app->GetPhysWorld()->SetHeightField(mHeightField.get());
+    return true;
+}
+
+void TerrainComponent::SetLODSettings(int gridDim, int lodLevels, float lod0Range)
+{
+    // モーフで奇数頂点を寄せるため、セル数は 2 のべき乗にする
+    int dim = 2;
+    while (dim < gridDim && dim < 256)
+    {
+        dim *= 2;
+    }
+
+    bool gridChanged = (dim != mGridDim);
+    mGridDim   = dim;
+    mLODLevels = std::clamp(lodLevels, 1, 12);
+    mLOD0Range = lod0Range;
+
+    if (mHeightField->IsValid())
+    {
+        if (gridChanged) CreateGridMesh();
+        BuildQuadTree();
+    }
+}
+
+void TerrainComponent::SetTexture(std::shared_ptr<Texture> tex)
+{
+    mTexture = tex;
+    mMaterial->SetDiffuseMap(tex);
+}
+
+float TerrainComponent::GetHeightAt(float x, float z) const
+{
+    return mHeightField->GetHeight(x, z);
+}
+
+//----------------------------------------------------------------------
+// 共有格子メッシュ
+//  - (mGridDim + 1)^2 頂点、XZ を 0〜1 で持つ（高さはシェーダで付ける）
+//  - 上から見て反時計回り
+//----------------------------------------------------------------------
+void TerrainComponent::CreateGridMesh()
+{
+    const int n = mGridDim;
+    const int stride = n + 1;
+
+    std::vector<float> verts;
+    verts.reserve(static_cast<size_t>(stride * stride * 2));
+    for (int z = 0; z <= n; ++z)
+    {
+        for (int x = 0; x <= n; ++x)
+        {
+            verts.push_back(static_cast<float>(x) / n);
+            verts.push_back(static_cast<float>(z) / n);
+        }
+    }
+
+    std::vector<unsigned int> indices;
+    indices.reserve(static_cast<size_t>(n * n * 6));
+    for (int z = 0; z < n; ++z)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            unsigned int i00 = z * stride + x;
+            unsigned int i10 = i00 + 1;
+            unsigned int i01 = i00 + stride;
+            unsigned int i11 = i01 + 1;
+
+            indices.push_back(i00); indices.push_back(i10); indices.push_back(i01);
+            indices.push_back(i10); indices.push_back(i11); indices.push_back(i01);
+        }
+    }
+
+    mGridVAO = std::make_shared<VertexArray>(verts.data(),
+                                             static_cast<unsigned int>(stride * stride),
+                                             indices.data(),
+                                             static_cast<unsigned int>(indices.size()),
+                                             true);
+}
+
+//----------------------------------------------------------------------
+// 四分木の構築
+//  - 最下段（LOD 0）のチャンクは格子 1 枚 = mGridDim セル分
+//  - 根（LOD mLODLevels-1）のチャンクを地形全体に敷き詰める
+//  - LOD 距離は 1 段ごとに 2 倍。隣接チャンクの LOD 差が 1 段以内に
+//    収まるよう、LOD 0 の距離はチャンクの対角線より十分大きくする
+//----------------------------------------------------------------------
+void TerrainComponent::BuildQuadTree()
+{
+    mNodes.clear();
+    mRoots.clear();
+
+    const float cell     = mHeightField->GetCellSize();
+    const float leafSize = mGridDim * cell;
+    const float rootSize = leafSize * static_cast<float>(1 << (mLODLevels - 1));
+    const Vector3& origin = mHeightField->GetOrigin();
+
+    int rootsX = std::max(1, static_cast<int>(std::ceil(mHeightField->GetSizeX() / rootSize)));
+    int rootsZ = std::max(1, static_cast<int>(std::ceil(mHeightField->GetSizeZ() / rootSize)));
+
+    for (int rz = 0; rz < rootsZ; ++rz)
+    {
+        for (int rx = 0; rx < rootsX; ++rx)
+        {
+            mRoots.push_back(BuildNode(origin.x + rx * rootSize,
+                                       origin.z + rz * rootSize,
+                                       rootSize, mLODLevels - 1));
+        }
+    }
+
+    mLODRanges.resize(mLODLevels);
+    mMorphStarts.resize(mLODLevels);
+
+    float range = std::max(mLOD0Range, leafSize * 3.0f);
+    float prev  = 0.0f;
+    for (int i = 0; i < mLODLevels; ++i)
+    {
+        mLODRanges[i]   = range;
+        mMorphStarts[i] = prev + (range - prev) * kMorphStartRatio;
+        prev   = range;
+        range *= 2.0f;
+    }
+}
+
+int TerrainComponent::BuildNode(float x, float z, float size, int level)
+{
+    int index = static_cast<int>(mNodes.size());
+    mNodes.push_back({ x, z, size, 0.0f, 0.0f, { -1, -1, -1, -1 } });
+
+    const Vector3& origin = mHeightField->GetOrigin();
+
+    if (level == 0)
+    {
+        const float cell = mHeightField->GetCellSize();
+        int ix0 = static_cast<int>(std::floor((x - origin.x) / cell));
+        int iz0 = static_cast<int>(std::floor((z - origin.z) / cell));
+        int ix1 = static_cast<int>(std::ceil((x + size - origin.x) / cell));
+        int iz1 = static_cast<int>(std::ceil((z + size - origin.z) / cell));
+
+        float minY, maxY;
+        mHeightField->GetRangeMinMax(ix0, iz0, ix1, iz1, minY, maxY);
+        mNodes[index].minY = minY;
+        mNodes[index].maxY = maxY;
+        return index;
+    }
+
+    // 子の高さ範囲をまとめる（地形外に出る子は作らない）
+    const float half = size * 0.5f;
+    const float endX = origin.x + mHeightField->GetSizeX();
+    const float endZ = origin.z + mHeightField->GetSizeZ();
+
+    float minY =  Math::Infinity;
+    float maxY = -Math::Infinity;
+    for (int i = 0; i < 4; ++i)
+    {
+        float cx = x + (i & 1) * half;
+        float cz = z + (i >> 1) * half;
+        if (cx >= endX || cz >= endZ) continue;
+
+        // push_back で mNodes が再配置されるので参照は持たない
+        int c = BuildNode(cx, cz, half, level - 1);
+        mNodes[index].child[i] = c;
+        minY = std::min(minY, mNodes[c].minY);
+        maxY = std::max(maxY, mNodes[c].maxY);
+    }
+    mNodes[index].minY = minY;
+    mNodes[index].maxY = maxY;
+    return index;
+}
+
+Cube TerrainComponent::GetNodeBox(const TerrainNode& node) const
+{
+    Cube box;
+    box.min = Vector3(node.x,             node.minY, node.z);
+    box.max = Vector3(node.x + node.size, node.maxY, node.z + node.size);
+    return box;
+}
+
+//----------------------------------------------------------------------
+// CDLOD のノード選択
+//  - 自分の LOD 距離に入っていなければ false（親の LOD で描かれる）
+//  - 1 段細かい距離に入っていなければ、このノードをこの LOD で描く
+//  - 入っていれば子へ。子が距離外なら、その範囲は子のサイズのまま
+//    完全にモーフした状態（= この LOD の密度）で描く
+//----------------------------------------------------------------------
+bool TerrainComponent::SelectNode(int index, int level,
+                                  const Vector3& camPos, const Frustum& frustum)
+{
+    const TerrainNode& node = mNodes[index];
+    Cube box = GetNodeBox(node);
+
+    if (!BoxIntersectsSphere(box, camPos, mLODRanges[level]))
+    {
+        return false;
+    }
+
+    // 見えないノードは「処理済み」として描かない
+    if (!FrustumIntersectsAABB(frustum, box))
+    {
+        return true;
+    }
+
+    if (level == 0 || !BoxIntersectsSphere(box, camPos, mLODRanges[level - 1]))
+    {
+        AddChunk(index, level, camPos, frustum);
+        return true;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int c = node.child[i];
+        if (c < 0) continue;
+
+        if (!SelectNode(c, level - 1, camPos, frustum))
+        {
+            AddChunk(c, level - 1, camPos, frustum);
+        }
+    }
+    return true;
+}
+
+void TerrainComponent::AddChunk(int index, int level,
+                                const Vector3& camPos, const Frustum& frustum)
+{
+    const TerrainNode& node = mNodes[index];
+    Cube box = GetNodeBox(node);
+    if (!FrustumIntersectsAABB(frustum, box)) return;
+
+    Vector3 center = (box.min + box.max) * 0.5f;
+    mSelected.push_back({ index, level, (center - camPos).LengthSq() });
+}
+
+//----------------------------------------------------------------------
+// 描画
+//  - チャンクを選んで手前から描く（早期 Z 棄却が効くように）
+//  - 格子メッシュ・シェーダ・マテリアルは全チャンク共通で 1 回だけ設定し、
+//    チャンクごとには位置とモーフ距離の uniform だけを変える
+//----------------------------------------------------------------------
+void TerrainComponent::Draw()
+{
+    mSelected.clear();
+    if (!mHeightField->IsValid() || !mGridVAO || !mHeightMap) return;
+
+    Renderer* renderer = GetOwner()->GetApp()->GetRenderer();
+    Matrix4 view     = renderer->GetViewMatrix();
+    Matrix4 viewProj = view * renderer->GetProjectionMatrix();
+    Vector3 camPos   = renderer->GetInvViewMatrix().GetTranslation();
+    Frustum frustum  = BuildFrustumFromMatrix(viewProj);
+
+    //------------------------------------------------------------------
+    // チャンク選択
+    //------------------------------------------------------------------
+    const int top = mLODLevels - 1;
+    for (int root : mRoots)
+    {
+        if (!SelectNode(root, top, camPos, frustum))
+        {
+            AddChunk(root, top, camPos, frustum);
+        }
+    }
+    if (mSelected.empty()) return;
+
+    std::sort(mSelected.begin(), mSelected.end(),
+              [](const SelectedChunk& a, const SelectedChunk& b)
+              {
+                  return a.distSq < b.distSq;
+              });
+
+    //------------------------------------------------------------------
+    // シェーダ（影・フォグは MeshComponent と同じ条件）
+    //------------------------------------------------------------------
+    bool useShadow = renderer->IsShadowMapActive();
+    uint32_t features = SF_FOG | (useShadow ? SF_SHADOW : SF_NONE);
+    auto shader = renderer->GetShaderVariant("Terrain", features);
+    if (!shader) return;
+
+    shader->SetActive();
+    mLightingManager->ApplyToShader(shader, view);
+    shader->SetMatrixUniform("uViewProj", viewProj);
+    shader->SetTextureUniform("uTexture", 0);
+    if (useShadow)
+    {
+        renderer->GetShadowMapTexture()->SetActive(1);
+        shader->SetMatrixUniform("uLightSpaceMatrix", renderer->GetLightSpaceMatrix());
+        shader->SetTextureUniform("uShadowMap", 1);
+        shader->SetFloatUniform("uShadowBias", 0.005f);
+    }
+
+    mHeightMap->SetActive(kHeightMapUnit);
+    shader->SetTextureUniform("uHeightMap", kHeightMapUnit);
+
+    const Vector3& origin = mHeightField->GetOrigin();
+    shader->SetVectorUniform ("uTerrainOrigin", origin);
+    shader->SetVector2Uniform("uTerrainSize",   Vector2(mHeightField->GetSizeX(), mHeightField->GetSizeZ()));
+    shader->SetVector2Uniform("uHeightMapSize", Vector2(static_cast<float>(mHeightField->GetWidth()),
+                                                        static_cast<float>(mHeightField->GetDepth())));
+    shader->SetFloatUniform("uCellSize",    mHeightField->GetCellSize());
+    shader->SetFloatUniform("uHeightScale", mHeightField->GetHeightScale());
+    shader->SetFloatUniform("uTexTiling",   mTexTiling);
+    shader->SetFloatUniform("uGridDim",     static_cast<float>(mGridDim));
+
+    mMaterial->Bind(renderer->GetMaterialBuffer(), 0);
+    mGridVAO->SetActive();
+
+    //------------------------------------------------------------------
+    // チャンクごとの描画
+    //------------------------------------------------------------------
+    DebugDraw* debug = renderer->GetDebugDraw();
+    bool drawBounds = debug && debug->IsEnabled();
+
+    for (const auto& sel : mSelected)
+    {
+        const TerrainNode& node = mNodes[sel.node];
+        shader->SetVectorUniform ("uChunk", Vector3(node.x, node.z, node.size));
+        shader->SetVector2Uniform("uMorph", Vector2(mMorphStarts[sel.level], mLODRanges[sel.level]));
+        glDrawElements(GL_TRIANGLES, mGridVAO->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+
+        // デバッグ時は LOD ごとに色を変えてチャンクの範囲を表示
+        if (drawBounds)
+        {
+            float t = (mLODLevels > 1) ? static_cast<float>(sel.level) / (mLODLevels - 1) : 0.0f;
+            Cube box = GetNodeBox(node);
+            debug->AddBox(box.min, box.max, Vector3(t, 1.0f - t, 0.3f));
+        }
+    }
+}
+
+} // namespace toy
@@ -10,6 +10,7 @@
 #include "Engine/Runtime/TimeOfDaySystem.h"
 #include <algorithm>
 #include <cmath>
+#include <iostream>
 
 namespace toy {
 
@@ -24,6 +25,23 @@ WeatherDomeComponent::WeatherDomeComponent(Actor* a)
 , mTime(0.5f)                        // 1日(0〜1)中の現在時間
 , mSunDir(Vector3::UnitY)            // 初期は真上
 , mWeatherType(WeatherType::CLEAR)   // 初期天気：快晴
+, mCacheMode(SkyCacheMode::Off)
+, mCacheSize(128)
+, mSkyCube(0)
+, mCaptureFBO(0)
+, mIsCacheValid(false)
+, mNextFace(0)
+, mCachedTime(0.0f)
+, mCachedSunDir(Vector3::UnitY)
+, mCachedWeather(WeatherType::CLEAR)
+, mCachedTicks(0)
+, mTimeThreshold(1.0f / 1440.0f)     // ゲーム内 1 分
+, mSunCosThreshold(cosf(Math::ToRadians(0.5f)))
+, mRefreshSeconds(2.0f)              // 雲の流れは 60 秒で 0.03 程度なので 2 秒毎で十分
+, mIsSkyAmbient(false)
+, mSkyAmbientWeight(0.5f)
+, mSkyAmbientColor(Vector3::Zero)
+, mHasSkyAmbient(false)
 {
     // 半球メッシュ（頂点/インデックスバッファ）を生成
     mSkyVAO = SkyDomeMeshGenerator::CreateSkyDomeVAO(32, 16, 1.0f);
@@ -35,6 +53,11 @@ WeatherDomeComponent::WeatherDomeComponent(Actor* a)
     mShader = GetOwner()->GetApp()->GetRenderer()->GetShader("SkyDome");
 }
 
+WeatherDomeComponent::~WeatherDomeComponent()
+{
+    DestroySkyCache();
+}
+
 //======================================
 // 時間設定（0〜1）
 //  1日を 0.0〜1.0 で表現しているので fmod でループ
@@ -74,34 +97,315 @@ void WeatherDomeComponent::Draw()
     Matrix4 proj  = GetOwner()->GetApp()->GetRenderer()->GetProjectionMatrix();
     Matrix4 mvp   = model * view * proj;
     
-    // シェーダ有効化
-    mShader->SetActive();
-    mShader->SetMatrixUniform("uMVP", mvp);
+    // キャッシュ中はキューブマップを引くだけ（STORM は雷があるので直接描く）
+    bool useCache = (mCacheMode != SkyCacheMode::Off) && mSkyCube &&
+                    (mWeatherType != WeatherType::STORM);
+    if (useCache)
+    {
+        UpdateSkyCache();
+        
+        mCubeShader->SetActive();
+        mCubeShader->SetMatrixUniform("uMVP", mvp);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, mSkyCube);
+        mCubeShader->SetIntUniform("uSkyCube", 0);
+    }
+    else
+    {
+        // シェーダ有効化
+        mShader->SetActive();
+        mShader->SetMatrixUniform("uMVP", mvp);
+        SetSkyUniforms(mShader.get());
+    }
+    
+    // 背景なのでカリング/深度書き込みを一時的に無効化して描画
+    glDisable(GL_CULL_FACE);
+    glDepthMask(GL_FALSE); // 背景なので Z 書き込み不要
+    mSkyVAO->SetActive();
+    glDrawElements(GL_TRIANGLES, mSkyVAO->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+    glDepthMask(GL_TRUE);
+    glEnable(GL_CULL_FACE);
     
+    if (useCache)
+    {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    }
+}
+
+//======================================
+// 空のシェーダ共通 uniform
+//  - ドームの直接描画とキューブマップへのキャプチャで共通
+//======================================
+void WeatherDomeComponent::SetSkyUniforms(Shader* shader)
+{
     // 雲のアニメーション用時間（60秒で0〜1を1周）
     float t = fmod(SDL_GetTicks() / 1000.0f, 60.0f) / 60.0f;
-    mShader->SetFloatUniform("uTime", t);
+    shader->SetFloatUniform("uTime", t);
     
     // 天候タイプ（GLSL側では int で受け取る）
-    mShader->SetIntUniform("uWeatherType", static_cast<int>(mWeatherType));
+    shader->SetIntUniform("uWeatherType", static_cast<int>(mWeatherType));
     
     // 1日を0.0〜1.0で表現した時間帯（朝/昼/夕/夜のベース）
-    mShader->SetFloatUniform("uTimeOfDay", fmod(mTime, 1.0f));
+    shader->SetFloatUniform("uTimeOfDay", fmod(mTime, 1.0f));
     
     // 太陽の方向（ライティング＆レイマーチ等で使用）
-    mShader->SetVectorUniform("uSunDir", mSunDir);
+    shader->SetVectorUniform("uSunDir", mSunDir);
     
     // CPU側で計算した生の空色・雲色（GLSLでの補正のベース）
-    mShader->SetVectorUniform("uRawSkyColor",   mRawSkyColor);
-    mShader->SetVectorUniform("uRawCloudColor", mRawCloudColor);
+    shader->SetVectorUniform("uRawSkyColor",   mRawSkyColor);
+    shader->SetVectorUniform("uRawCloudColor", mRawCloudColor);
+}
+
+//======================================
+// スカイキャッシュの設定
+//  - Off にするとキューブマップと FBO を破棄して従来の描画に戻る
+//  - 解像度が変わった時だけ作り直す
+//======================================
+void WeatherDomeComponent::SetSkyCache(SkyCacheMode mode, int resolution)
+{
+    if (mode == SkyCacheMode::Off)
+    {
+        DestroySkyCache();
+        mCacheMode = SkyCacheMode::Off;
+        return;
+    }
     
-    // 背景なのでカリング/深度書き込みを一時的に無効化して描画
+    resolution = std::max(resolution, 8);
+    if (!mSkyCube || resolution != mCacheSize)
+    {
+        DestroySkyCache();
+        mCacheSize = resolution;
+        if (!CreateSkyCache())
+        {
+            mCacheMode = SkyCacheMode::Off;
+            return;
+        }
+    }
+    
+    mCacheMode    = mode;
+    mIsCacheValid = false;
+    mNextFace     = 0;
+}
+
+void WeatherDomeComponent::SetSkyCacheThreshold(float timeOfDay, float sunAngle, float refreshSeconds)
+{
+    mTimeThreshold   = std::max(timeOfDay, 0.0f);
+    mSunCosThreshold = cosf(Math::ToRadians(std::max(sunAngle, 0.0f)));
+    mRefreshSeconds  = std::max(refreshSeconds, 0.0f);
+}
+
+void WeatherDomeComponent::SetSkyAmbient(bool enable, float weight)
+{
+    mIsSkyAmbient     = enable;
+    mSkyAmbientWeight = Math::Clamp(weight, 0.0f, 1.0f);
+    if (enable)
+    {
+        // 次の更新で平均色を読み戻す
+        mIsCacheValid = false;
+    }
+}
+
+//======================================
+// キューブマップ（RGB16F）とキャプチャ用 FBO の作成
+//======================================
+bool WeatherDomeComponent::CreateSkyCache()
+{
+    auto renderer  = GetOwner()->GetApp()->GetRenderer();
+    mCaptureShader = renderer->GetShader("SkyCapture");
+    mCubeShader    = renderer->GetShader("SkyCube");
+    if (!mCaptureShader || !mCubeShader || !renderer->GetFullScreenQuad())
+    {
+        std::cerr << "WeatherDomeComponent: sky cache shaders not loaded" << std::endl;
+        return false;
+    }
+    
+    glGenTextures(1, &mSkyCube);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, mSkyCube);
+    for (int face = 0; face < 6; ++face)
+    {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGB16F,
+                     mCacheSize, mCacheSize, 0, GL_RGB, GL_FLOAT, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    
+    // 面の継ぎ目を目立たせない
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+    
+    GLint prevFBO = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGenFramebuffers(1, &mCaptureFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_CUBE_MAP_POSITIVE_X, mSkyCube, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+    
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "WeatherDomeComponent: sky cache framebuffer incomplete (" << status << ")" << std::endl;
+        DestroySkyCache();
+        return false;
+    }
+    
+    mIsCacheValid = false;
+    mNextFace     = 0;
+    return true;
+}
+
+void WeatherDomeComponent::DestroySkyCache()
+{
+    if (mCaptureFBO)
+    {
+        glDeleteFramebuffers(1, &mCaptureFBO);
+        mCaptureFBO = 0;
+    }
+    if (mSkyCube)
+    {
+        glDeleteTextures(1, &mSkyCube);
+        mSkyCube = 0;
+    }
+    mIsCacheValid  = false;
+    mHasSkyAmbient = false;
+}
+
+//======================================
+// スカイキャッシュの更新判定
+//  - 天気が変わった／未作成 → 6 面まとめて
+//  - Amortized              → 毎フレーム 1 面
+//  - OnChange               → 時刻・太陽方向・経過時間のどれかがしきい値を超えたら 6 面
+//======================================
+void WeatherDomeComponent::UpdateSkyCache()
+{
+    float    timeOfDay = fmod(mTime, 1.0f);
+    uint64_t now       = SDL_GetTicks();
+    
+    bool refreshAll = !mIsCacheValid || (mWeatherType != mCachedWeather);
+    if (!refreshAll && mCacheMode == SkyCacheMode::OnChange)
+    {
+        // 0 時をまたいだ場合も近い方の差で比べる
+        float dt = fabsf(timeOfDay - mCachedTime);
+        dt = std::min(dt, 1.0f - dt);
+        
+        bool expired = (mRefreshSeconds > 0.0f) &&
+                       (static_cast<float>(now - mCachedTicks) >= mRefreshSeconds * 1000.0f);
+        
+        refreshAll = (dt > mTimeThreshold) ||
+                     (Vector3::Dot(mSunDir, mCachedSunDir) < mSunCosThreshold) ||
+                     expired;
+    }
+    
+    if (refreshAll)
+    {
+        RenderCacheFaces(0, 6);
+        mNextFace = 0;
+    }
+    else if (mCacheMode == SkyCacheMode::Amortized)
+    {
+        RenderCacheFaces(mNextFace, 1);
+        mNextFace = (mNextFace + 1) % 6;
+        if (mNextFace != 0) return;
+    }
+    else
+    {
+        return;
+    }
+    
+    mIsCacheValid  = true;
+    mCachedTime    = timeOfDay;
+    mCachedSunDir  = mSunDir;
+    mCachedWeather = mWeatherType;
+    mCachedTicks   = now;
+}
+
+//======================================
+// キューブマップの face 番目から count 面を描く
+//  - 1 面 = フルスクリーン四角形 1 枚（SkyCapture.vert + WeatherDome.frag）
+//  - 最後の面まで描いたらミップを作り、必要なら平均色を読み戻す
+//  - FBO・ビューポート・ブレンド／深度／カリングは元に戻す
+//======================================
+void WeatherDomeComponent::RenderCacheFaces(int first, int count)
+{
+    auto quad = GetOwner()->GetApp()->GetRenderer()->GetFullScreenQuad();
+    if (!quad || !mCaptureFBO) return;
+    
+    GLint prevFBO = 0;
+    GLint viewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    GLboolean isBlend = glIsEnabled(GL_BLEND);
+    GLboolean isDepth = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean isCull  = glIsEnabled(GL_CULL_FACE);
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, mCaptureFBO);
+    glViewport(0, 0, mCacheSize, mCacheSize);
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
     glDisable(GL_CULL_FACE);
-    glDepthMask(GL_FALSE); // 背景なので Z 書き込み不要
-    mSkyVAO->SetActive();
-    glDrawElements(GL_TRIANGLES, mSkyVAO->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
-    glDepthMask(GL_TRUE);
-    glEnable(GL_CULL_FACE);
+    
+    mCaptureShader->SetActive();
+    SetSkyUniforms(mCaptureShader.get());
+    quad->SetActive();
+    
+    for (int i = 0; i < count; ++i)
+    {
+        int face = first + i;
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mSkyCube, 0);
+        mCaptureShader->SetIntUniform("uFace", face);
+        glDrawElements(GL_TRIANGLES, quad->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+    }
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    if (isBlend) glEnable(GL_BLEND);
+    if (isDepth) glEnable(GL_DEPTH_TEST);
+    if (isCull)  glEnable(GL_CULL_FACE);
+    
+    if (first + count == 6)
+    {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, mSkyCube);
+        glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        
+        if (mIsSkyAmbient)
+        {
+            ReadSkyAmbient();
+        }
+    }
+}
+
+//======================================
+// 空の平均色（環境光用）
+//  - 最小ミップ（1x1）を -Y 以外の 5 面から読み戻して平均
+//  - 読み戻しは GPU を待つので、6 面が揃った時だけ行う
+//======================================
+void WeatherDomeComponent::ReadSkyAmbient()
+{
+    int level = 0;
+    for (int size = mCacheSize; size > 1; size >>= 1)
+    {
+        ++level;
+    }
+    
+    const int faces[] = { 0, 1, 2, 4, 5 };   // +X, -X, +Y, +Z, -Z
+    Vector3 sum = Vector3::Zero;
+    float   texel[3];
+    
+    glBindTexture(GL_TEXTURE_CUBE_MAP, mSkyCube);
+    for (int face : faces)
+    {
+        glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGB, GL_FLOAT, texel);
+        sum += Vector3(texel[0], texel[1], texel[2]);
+    }
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    
+    mSkyAmbientColor = sum * (1.0f / 5.0f);
+    mHasSkyAmbient   = true;
 }
 
 //======================================
@@ -444,6 +748,12 @@ void WeatherDomeComponent::ApplyTime()
     Vector3 nightAmbient = Vector3(0.25f, 0.2f, 0.3f);
     Vector3 finalAmbient =
         (dayAmbient * dayStrength + nightAmbient * nightStrength) * weatherDim;
+    
+    // スカイキャッシュの平均色を混ぜる（空の色が地表の陰にも乗る）
+    if (mIsSkyAmbient && mHasSkyAmbient && mCacheMode != SkyCacheMode::Off)
+    {
+        finalAmbient = Vector3::Lerp(finalAmbient, mSkyAmbientColor, mSkyAmbientWeight);
+    }
     mLightingManager->SetAmbientColor(finalAmbient);
     
     // --- フォグ色＋密度を時間・天候から決定 ---
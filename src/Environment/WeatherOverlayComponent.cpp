@@ -6,6 +6,9 @@
 #include "Engine/Render/Renderer.h"
 #include "Utils/MathUtil.h"
 
+#include <algorithm>
+#include <iostream>
+
 namespace toy {
 
 WeatherOverlayComponent::WeatherOverlayComponent(Actor* a, int drawOrder, VisualLayer layer)
@@ -13,19 +16,46 @@ WeatherOverlayComponent::WeatherOverlayComponent(Actor* a, int drawOrder, Visual
 , mRainAmount(0.f)
 , mFogAmount(0.f)
 , mSnowAmount(0.f)
+, mLowResFBO(0)
+, mLowResTexture(0)
+, mLowResWidth(0)
+, mLowResHeight(0)
 {
     //------ 必要リソースを取得 ------
     auto renderer   = GetOwner()->GetApp()->GetRenderer();
     mShader         = renderer->GetShader("WeatherOverlay");  // 雨/霧/雪 用シェーダ
+    mUpsampleShader = renderer->GetShader("WeatherUpsample"); // 縮小オーバーレイの拡大合成
     mVertexArray    = renderer->GetFullScreenQuad();          // フルスクリーン四角形
     mScreenWidth    = renderer->GetScreenWidth();
     mScreenHeight   = renderer->GetScreenHeight();
 }
 
+WeatherOverlayComponent::~WeatherOverlayComponent()
+{
+    DestroyLowRes();
+}
+
 void WeatherOverlayComponent::Draw()
 {
     if (!mShader || !mVertexArray) return;
 
+    // どのエフェクトも出ていなければ描かない
+    if (!IsActive()) return;
+
+    //------ 画面サイズ・縮小率（ウィンドウサイズやガバナーの変更に追従） ------
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    mScreenWidth  = renderer->GetScreenWidth();
+    mScreenHeight = renderer->GetScreenHeight();
+
+    float scale = renderer->GetOverlayScale();
+    int   lowW  = std::max(static_cast<int>(mScreenWidth  * scale + 0.5f), 1);
+    int   lowH  = std::max(static_cast<int>(mScreenHeight * scale + 0.5f), 1);
+
+    if (scale < 1.0f && DrawReduced(lowW, lowH))
+    {
+        return;
+    }
+
     //======================================================================
     // フルスクリーンオーバーレイ描画のための典型的な OpenGL 設定
     // ・深度テスト無効（画面全体に描く）
@@ -37,6 +67,20 @@ void WeatherOverlayComponent::Draw()
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    DrawOverlay(mScreenWidth, mScreenHeight);
+
+    //------ OpenGL ステート復帰 ------
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+}
+
+//----------------------------------------------------------------------
+// WeatherScreen.frag を描画先全体に描く
+//   uResolution は描画先のサイズ（gl_FragCoord から 0〜1 の UV を作るため）
+//----------------------------------------------------------------------
+void WeatherOverlayComponent::DrawOverlay(float width, float height)
+{
     //------ シェーダー有効化 ------
     mShader->SetActive();
 
@@ -47,8 +91,7 @@ void WeatherOverlayComponent::Draw()
     mShader->SetFloatUniform("uSnowAmount",  mSnowAmount);   // 雪（0〜1）
 
     //------ 画面解像度（スクリーンスペースエフェクト用） ------
-    mShader->SetVector2Uniform("uResolution",
-                               Vector2(mScreenWidth, mScreenHeight));
+    mShader->SetVector2Uniform("uResolution", Vector2(width, height));
 
     //------ フルスクリーン四角形を描画 ------
     mVertexArray->SetActive();
@@ -56,11 +99,134 @@ void WeatherOverlayComponent::Draw()
                    mVertexArray->GetNumIndices(),
                    GL_UNSIGNED_INT,
                    nullptr);
+}
+
+//----------------------------------------------------------------------
+// 縮小描画
+//  1) 縮小バッファを (0,0,0,0) でクリアし、ブレンドなしでオーバーレイを描く
+//  2) 画面へ WeatherUpsample.frag で拡大合成
+//     （シーンの深度が取れれば深度を見るバイラテラル、無ければバイリニア）
+//  FBO・ビューポート・クリア色は元に戻す
+//----------------------------------------------------------------------
+bool WeatherOverlayComponent::DrawReduced(int width, int height)
+{
+    if (!mUpsampleShader) return false;
+    if (width != mLowResWidth || height != mLowResHeight || !mLowResFBO)
+    {
+        if (!ResizeLowRes(width, height)) return false;
+    }
+
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+
+    //------ 1) 縮小バッファへ ------
+    GLint   prevFBO = 0;
+    GLint   viewport[4];
+    GLfloat clearColor[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mLowResFBO);
+    glViewport(0, 0, mLowResWidth, mLowResHeight);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_BLEND);
+
+    DrawOverlay(static_cast<float>(mLowResWidth), static_cast<float>(mLowResHeight));
+
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    //------ 2) 拡大合成 ------
+    GLuint depthTex = renderer->IsOverlayDepthAware() ? renderer->GetSceneDepthTexture() : 0;
+    const Matrix4& proj = renderer->GetProjectionMatrix();
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    mUpsampleShader->SetActive();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, mLowResTexture);
+    mUpsampleShader->SetTextureUniform("uOverlay", 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, depthTex);
+    mUpsampleShader->SetTextureUniform("uSceneDepth", 1);
+    glActiveTexture(GL_TEXTURE0);
+
+    mUpsampleShader->SetVector2Uniform("uLowResolution",
+                                       Vector2(static_cast<float>(mLowResWidth),
+                                               static_cast<float>(mLowResHeight)));
+    mUpsampleShader->SetVector2Uniform("uDepthParams", Vector2(proj.mat[2][2], proj.mat[3][2]));
+    mUpsampleShader->SetIntUniform("uDepthAware", depthTex ? 1 : 0);
+
+    mVertexArray->SetActive();
+    glDrawElements(GL_TRIANGLES, mVertexArray->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
 
     //------ OpenGL ステート復帰 ------
     glDisable(GL_BLEND);
     glDepthMask(GL_TRUE);
     glEnable(GL_DEPTH_TEST);
+    return true;
+}
+
+//----------------------------------------------------------------------
+// 縮小バッファ（RGBA8・リニア）の作り直し
+//----------------------------------------------------------------------
+bool WeatherOverlayComponent::ResizeLowRes(int width, int height)
+{
+    DestroyLowRes();
+
+    glGenTextures(1, &mLowResTexture);
+    glBindTexture(GL_TEXTURE_2D, mLowResTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint prevFBO = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFBO);
+    glGenFramebuffers(1, &mLowResFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, mLowResFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mLowResTexture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prevFBO));
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "WeatherOverlayComponent: framebuffer incomplete (" << status << ")" << std::endl;
+        DestroyLowRes();
+        return false;
+    }
+
+    mLowResWidth  = width;
+    mLowResHeight = height;
+    return true;
+}
+
+void WeatherOverlayComponent::DestroyLowRes()
+{
+    if (mLowResFBO)
+    {
+        glDeleteFramebuffers(1, &mLowResFBO);
+        mLowResFBO = 0;
+    }
+    if (mLowResTexture)
+    {
+        glDeleteTextures(1, &mLowResTexture);
+        mLowResTexture = 0;
+    }
+    mLowResWidth  = 0;
+    mLowResHeight = 0;
 }
 
 } // namespace toy
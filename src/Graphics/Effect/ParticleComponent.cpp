@@ -5,7 +5,10 @@
 #include "Asset/Material/Texture.h"
 #include "Engine/Core/Application.h"
 #include "Engine/Render/Renderer.h"
+#include "Engine/Runtime/SignificanceManager.h"
 #include "Asset/Geometry/VertexArray.h"
+#include "Utils/RadixSort.h"
+#include <cmath>
 #include <random>
 
 namespace toy {
@@ -15,9 +18,7 @@ namespace toy {
 //======================================================================
 ParticleComponent::ParticleComponent(Actor* owner, int drawOrder)
 : VisualComponent(owner, drawOrder)
-, mTexture(nullptr)
 , mDrawOrder(drawOrder)
-, mIsBlendAdd(true)
 , mNumParts(0)
 , mLifeTime(0.0f)
 , mTotalLife(0.0f)
@@ -25,10 +26,15 @@ ParticleComponent::ParticleComponent(Actor* owner, int drawOrder)
 , mPartSize(0.0f)
 , mPartSpeed(2.0f)
 , mParticleMode(P_SPARK)
+, mPendingTime(0.0f)
+, mPendingFrames(0)
 {
     // 3D エフェクト扱い（ライト・深度あり）
     mLayer = VisualLayer::Effect3D;
 
+    // デフォルトは加算合成（火花など）
+    mIsBlendAdd = true;
+
     // パーティクル用シェーダ
     mShader = GetOwner()->GetApp()->GetRenderer()->GetShader("Particle");
 }
@@ -104,9 +110,26 @@ void ParticleComponent::GenerateParts()
 // - パーティクル寿命管理
 // - モードごとの挙動（上昇/落下）
 // - ランダムに新規生成
+// - Actor の重要度が低い間は数フレームに 1 回（間のフレーム分をまとめて進める）
 //======================================================================
 void ParticleComponent::Update(float deltaTime)
 {
+    mPendingTime += deltaTime;
+    ++mPendingFrames;
+
+    Actor* owner = GetOwner();
+    auto significance = owner->GetApp()->GetSignificanceManager();
+    if (significance)
+    {
+        int interval = significance->GetPolicy(owner->GetSignificance()).particleInterval;
+        if (!significance->IsUpdateFrame(interval, owner)) return;
+    }
+
+    deltaTime  = mPendingTime;
+    int frames = mPendingFrames;
+    mPendingTime   = 0.0f;
+    mPendingFrames = 0;
+
     // コンポーネント寿命
     mLifeTime += deltaTime;
     if (mLifeTime > mTotalLife)
@@ -119,11 +142,11 @@ void ParticleComponent::Update(float deltaTime)
     {
         if (mParts[i].isVisible)
         {
-            // モード別上下方向の変化
+            // モード別上下方向の変化（1 フレームあたりの量）
             if (mParticleMode == P_WATER)
-                mParts[i].dir.y -= 0.04f;   // 落下
+                mParts[i].dir.y -= 0.04f * frames;   // 落下
             else if (mParticleMode == P_SMOKE)
-                mParts[i].dir.y += 0.04f;   // 上昇
+                mParts[i].dir.y += 0.04f * frames;   // 上昇
 
             // 位置更新
             mParts[i].lifeTime += deltaTime;
@@ -136,9 +159,12 @@ void ParticleComponent::Update(float deltaTime)
     }
 
     // ランダムに新規生成（負荷軽減の簡易実装）
-    if (rand() % 2 == 0)
+    for (int f = 0; f < frames; f++)
     {
-        GenerateParts();
+        if (rand() % 2 == 0)
+        {
+            GenerateParts();
+        }
     }
 }
 
@@ -195,17 +221,41 @@ void ParticleComponent::Draw()
 
     //------------------------------
     // パーティクルを 1 つずつ描画
+    //   通常ブレンドは重なり順が見た目に出るので奥から手前へ
+    //   （加算は順序に依らないので並べ替えない）
+    //   描く数は Renderer の予算（割合）と Actor の重要度の割合まで
+    //   通常ブレンドは奥のものから省く
     //------------------------------
+    float budget = renderer->GetParticleBudget();
+    if (auto significance = GetOwner()->GetApp()->GetSignificanceManager())
+    {
+        budget *= significance->GetPolicy(GetOwner()->GetSignificance()).particleBudget;
+    }
     mVertexArray->SetActive();
-    for (int i = 0; i < mNumParts; i++)
+    if (!mIsBlendAdd)
     {
-        if (mParts[i].isVisible)
+        SortParts(world * view);
+        size_t limit = static_cast<size_t>(std::ceil(mSortOrder.size() * budget));
+        for (size_t i = mSortOrder.size() - limit; i < mSortOrder.size(); i++)
         {
-            // 位置だけ更新して 6 ポリゴン描画
-            mShader->SetVectorUniform("uPosition", mParts[i].pos);
+            mShader->SetVectorUniform("uPosition", mParts[mVisibleParts[mSortOrder[i]]].pos);
             glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
         }
     }
+    else
+    {
+        int limit = static_cast<int>(std::ceil(mNumParts * budget));
+        for (int i = 0; i < mNumParts && limit > 0; i++)
+        {
+            if (mParts[i].isVisible)
+            {
+                // 位置だけ更新して 6 ポリゴン描画
+                mShader->SetVectorUniform("uPosition", mParts[i].pos);
+                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+                --limit;
+            }
+        }
+    }
 
     //------------------------------
     // ブレンド戻す
@@ -216,4 +266,26 @@ void ParticleComponent::Draw()
     }
 }
 
+//======================================================================
+// SortParts
+// - 粒の中心（uPosition をワールド行列で変換した点）のビュー奥行きを
+//   降順のキーにして基数ソートする
+// - 結果は mSortOrder（mVisibleParts への添字）
+//======================================================================
+void ParticleComponent::SortParts(const Matrix4& worldView)
+{
+    mVisibleParts.clear();
+    mSortKeys.clear();
+    for (int i = 0; i < mNumParts; i++)
+    {
+        if (!mParts[i].isVisible) continue;
+
+        float depth = Vector3::Transform(mParts[i].pos, worldView).z;
+        mVisibleParts.push_back(static_cast<uint32_t>(i));
+        mSortKeys.push_back(~RadixSort::FloatToKey(depth));
+    }
+
+    RadixSort::SortIndices(mSortKeys, mSortOrder, mSortScratch);
+}
+
 } // namespace toy
@@ -0,0 +1,392 @@
+#include "Graphics/Mesh/ImpostorAtlas.h"
+#include "Asset/Geometry/Mesh.h"
+#include "Asset/Geometry/Polygon.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Asset/Material/Material.h"
+#include "Asset/Material/Texture.h"
+#include "Engine/Render/Renderer.h"
+#include "Engine/Render/Shader.h"
+
+#include "glad/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace toy {
+
+namespace {
+
+// キャッシュファイルのヘッダ
+const char     kCacheMagic[4] = { 'T', 'I', 'M', 'P' };
+const uint32_t kCacheVersion  = 1;
+
+struct CacheHeader
+{
+    char     magic[4];
+    uint32_t version;
+    int32_t  framesPerSide;
+    int32_t  frameResolution;
+    int32_t  hemisphere;
+    float    center[3];
+    float    radius;
+};
+
+float SignNotZero(float v)
+{
+    return (v >= 0.0f) ? 1.0f : -1.0f;
+}
+
+// 八面体マップ [-1, 1]^2 → 方向（Impostor.frag の DecodeDir と同じ）
+Vector3 DecodeOctahedral(float ex, float ey, bool hemisphere)
+{
+    Vector3 d;
+    if (hemisphere)
+    {
+        float px = (ex + ey) * 0.5f;
+        float pz = (ex - ey) * 0.5f;
+        d = Vector3(px, 1.0f - std::fabs(px) - std::fabs(pz), pz);
+    }
+    else
+    {
+        d = Vector3(ex, 1.0f - std::fabs(ex) - std::fabs(ey), ey);
+        if (d.y < 0.0f)
+        {
+            float x = d.x;
+            d.x = (1.0f - std::fabs(d.z)) * SignNotZero(x);
+            d.z = (1.0f - std::fabs(x))   * SignNotZero(d.z);
+        }
+    }
+    d.Normalize();
+    return d;
+}
+
+} // namespace
+
+
+ImpostorAtlas::ImpostorAtlas()
+: mCenter(Vector3::Zero)
+, mRadius(0.0f)
+, mFramesPerSide(0)
+, mFrameResolution(0)
+, mIsHemisphere(true)
+{
+}
+
+Vector3 ImpostorAtlas::GetFrameDirection(int x, int y) const
+{
+    float n = static_cast<float>(mFramesPerSide - 1);
+    return DecodeOctahedral(x / n * 2.0f - 1.0f, y / n * 2.0f - 1.0f, mIsHemisphere);
+}
+
+void ImpostorAtlas::CreateQuad()
+{
+    if (mQuad) return;
+
+    const float verts[] =
+    {
+        -0.5f, -0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+         0.5f,  0.5f, 0.0f,
+        -0.5f,  0.5f, 0.0f,
+    };
+    const float norms[] =
+    {
+        0.0f, 0.0f, -1.0f,
+        0.0f, 0.0f, -1.0f,
+        0.0f, 0.0f, -1.0f,
+        0.0f, 0.0f, -1.0f,
+    };
+    const float uvs[] =
+    {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+        0.0f, 1.0f,
+    };
+    const unsigned int indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    mQuad = std::make_shared<VertexArray>(4, verts, norms, uvs, 6, indices);
+}
+
+//------------------------------------------------------------
+// Bake
+//  - 外接球を求め、中心を原点へ移したメッシュを各方向から
+//    正射影（幅 = 直径）で撮ってアトラスのタイルへ描く
+//  - 描画状態（FBO・ビューポート・ブレンド・クリア色）は戻す
+//------------------------------------------------------------
+bool ImpostorAtlas::Bake(Renderer* renderer,
+                         std::shared_ptr<Mesh> mesh,
+                         const ImpostorBakeSettings& settings)
+{
+    if (!renderer || !mesh || mesh->GetVertexArray().empty())
+    {
+        std::cerr << "[ImpostorAtlas] No mesh to bake" << std::endl;
+        return false;
+    }
+
+    //--------------------------------------------------------
+    // 外接球（AABB 中心 + 最遠頂点）
+    //--------------------------------------------------------
+    const auto& vaList = mesh->GetVertexArray();
+    Vector3 bmin = Vector3::Infinity;
+    Vector3 bmax = Vector3::NegInfinity;
+    for (const auto& va : vaList)
+    {
+        for (const auto& poly : va->GetPolygons())
+        {
+            for (const Vector3* v : { &poly.a, &poly.b, &poly.c })
+            {
+                bmin.x = std::min(bmin.x, v->x);
+                bmin.y = std::min(bmin.y, v->y);
+                bmin.z = std::min(bmin.z, v->z);
+                bmax.x = std::max(bmax.x, v->x);
+                bmax.y = std::max(bmax.y, v->y);
+                bmax.z = std::max(bmax.z, v->z);
+            }
+        }
+    }
+    Vector3 center = (bmin + bmax) * 0.5f;
+    float radius = 0.0f;
+    for (const auto& va : vaList)
+    {
+        for (const auto& poly : va->GetPolygons())
+        {
+            radius = std::max({ radius,
+                                (poly.a - center).Length(),
+                                (poly.b - center).Length(),
+                                (poly.c - center).Length() });
+        }
+    }
+    if (radius <= Math::NearZeroEpsilon)
+    {
+        std::cerr << "[ImpostorAtlas] Mesh has no extent" << std::endl;
+        return false;
+    }
+
+    auto shader = renderer->GetShaderVariant("ImpostorBake", SF_NONE);
+    if (!shader) return false;
+
+    mCenter          = center;
+    mRadius          = radius;
+    mFramesPerSide   = std::max(settings.framesPerSide, 2);
+    mFrameResolution = std::max(settings.frameResolution, 16);
+    mIsHemisphere    = settings.hemisphere;
+
+    //--------------------------------------------------------
+    // アトラスと FBO（カラー 2 枚 + 深度レンダーバッファ）
+    //--------------------------------------------------------
+    const int size = mFramesPerSide * mFrameResolution;
+
+    mAlbedo = std::make_shared<Texture>();
+    mAlbedo->LoadFromMemory(nullptr, size, size);
+    mNormalDepth = std::make_shared<Texture>();
+    mNormalDepth->LoadFromMemory(nullptr, size, size);
+
+    GLuint fbo = 0;
+    GLuint depth = 0;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mAlbedo->GetTextureID(), 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, mNormalDepth->GetTextureID(), 0);
+
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+
+    const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    bool ok = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+    if (!ok)
+    {
+        std::cerr << "[ImpostorAtlas] Bake framebuffer is not complete" << std::endl;
+    }
+    else
+    {
+        //----------------------------------------------------
+        // 描画状態の退避
+        //----------------------------------------------------
+        GLint   viewport[4];
+        GLfloat clearColor[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+        GLboolean blend = glIsEnabled(GL_BLEND);
+
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glViewport(0, 0, size, size);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        shader->SetActive();
+        shader->SetMatrixUniform("uWorldTransform", Matrix4::CreateTranslation(center * -1.0f));
+        shader->SetTextureUniform("uTexture", 0);
+        shader->SetFloatUniform("uImpostorRadius", radius);
+
+        // カメラは中心から 2r 離れた位置、奥行きは球が収まる範囲
+        Matrix4 proj = Matrix4::CreateOrtho(radius * 2.0f, radius * 2.0f, radius * 0.5f, radius * 3.5f);
+        auto materials = renderer->GetMaterialBuffer();
+
+        for (int y = 0; y < mFramesPerSide; ++y)
+        {
+            for (int x = 0; x < mFramesPerSide; ++x)
+            {
+                // フレームの基底は Impostor.frag の SampleFrame と同じ決め方
+                Vector3 dir = GetFrameDirection(x, y);
+                Vector3 up  = (std::fabs(dir.y) > 0.999f) ? Vector3::UnitZ : Vector3::UnitY;
+                Matrix4 view = Matrix4::CreateLookAt(dir * (radius * 2.0f), Vector3::Zero, up);
+
+                shader->SetMatrixUniform("uViewProj", view * proj);
+                shader->SetVectorUniform("uBakeDir", dir);
+                glViewport(x * mFrameResolution, y * mFrameResolution,
+                           mFrameResolution, mFrameResolution);
+
+                for (const auto& va : vaList)
+                {
+                    auto mat = mesh->GetMaterial(va->GetTextureID());
+                    Material* material = mat ? mat.get() : renderer->GetDefaultMaterial().get();
+                    material->Bind(materials, 0);
+
+                    va->SetActive();
+                    glDrawElements(GL_TRIANGLES, va->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+                }
+            }
+        }
+
+        //----------------------------------------------------
+        // 描画状態を戻す
+        //----------------------------------------------------
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+        if (blend) glEnable(GL_BLEND);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteRenderbuffers(1, &depth);
+    glDeleteFramebuffers(1, &fbo);
+
+    if (!ok)
+    {
+        mAlbedo      = nullptr;
+        mNormalDepth = nullptr;
+        return false;
+    }
+
+    mAlbedo->GenerateMipmaps();
+    mNormalDepth->GenerateMipmaps();
+    CreateQuad();
+    return true;
+}
+
+//------------------------------------------------------------
+// キャッシュ
+//  - ヘッダ + アルベド（RGBA8）+ 法線・奥行き（RGBA8）
+//------------------------------------------------------------
+bool ImpostorAtlas::SaveCache(const std::string& filePath) const
+{
+    if (!IsValid()) return false;
+
+    std::ofstream ofs(filePath, std::ios::binary);
+    if (!ofs)
+    {
+        std::cerr << "[ImpostorAtlas] Failed to open: " << filePath << std::endl;
+        return false;
+    }
+
+    CacheHeader header;
+    std::copy(kCacheMagic, kCacheMagic + 4, header.magic);
+    header.version         = kCacheVersion;
+    header.framesPerSide   = mFramesPerSide;
+    header.frameResolution = mFrameResolution;
+    header.hemisphere      = mIsHemisphere ? 1 : 0;
+    header.center[0]       = mCenter.x;
+    header.center[1]       = mCenter.y;
+    header.center[2]       = mCenter.z;
+    header.radius          = mRadius;
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const int size = mFramesPerSide * mFrameResolution;
+    std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 4);
+    for (const auto& tex : { mAlbedo, mNormalDepth })
+    {
+        glBindTexture(GL_TEXTURE_2D, tex->GetTextureID());
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        ofs.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+    }
+
+    if (!ofs)
+    {
+        std::cerr << "[ImpostorAtlas] Failed to write: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ImpostorAtlas::LoadCache(const std::string& filePath)
+{
+    std::ifstream ifs(filePath, std::ios::binary);
+    if (!ifs)
+    {
+        return false;
+    }
+
+    CacheHeader header;
+    ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!ifs || !std::equal(kCacheMagic, kCacheMagic + 4, header.magic) ||
+        header.version != kCacheVersion ||
+        header.framesPerSide < 2 || header.frameResolution < 1)
+    {
+        std::cerr << "[ImpostorAtlas] Invalid cache: " << filePath << std::endl;
+        return false;
+    }
+
+    const int size = header.framesPerSide * header.frameResolution;
+    std::vector<unsigned char> albedo(static_cast<size_t>(size) * size * 4);
+    std::vector<unsigned char> normalDepth(albedo.size());
+    ifs.read(reinterpret_cast<char*>(albedo.data()), albedo.size());
+    ifs.read(reinterpret_cast<char*>(normalDepth.data()), normalDepth.size());
+    if (!ifs)
+    {
+        std::cerr << "[ImpostorAtlas] Truncated cache: " << filePath << std::endl;
+        return false;
+    }
+
+    mFramesPerSide   = header.framesPerSide;
+    mFrameResolution = header.frameResolution;
+    mIsHemisphere    = (header.hemisphere != 0);
+    mCenter          = Vector3(header.center[0], header.center[1], header.center[2]);
+    mRadius          = header.radius;
+
+    mAlbedo = std::make_shared<Texture>();
+    mAlbedo->LoadFromMemory(albedo.data(), size, size);
+    mAlbedo->GenerateMipmaps();
+    mNormalDepth = std::make_shared<Texture>();
+    mNormalDepth->LoadFromMemory(normalDepth.data(), size, size);
+    mNormalDepth->GenerateMipmaps();
+
+    CreateQuad();
+    return true;
+}
+
+//------------------------------------------------------------
+// Apply
+//------------------------------------------------------------
+void ImpostorAtlas::Apply(Shader* shader) const
+{
+    mAlbedo->SetActive(0);
+    mNormalDepth->SetActive(kNormalDepthUnit);
+    shader->SetTextureUniform("uTexture", 0);
+    shader->SetTextureUniform("uNormalDepth", kNormalDepthUnit);
+
+    shader->SetVectorUniform("uImpostorCenter", mCenter);
+    shader->SetFloatUniform ("uImpostorRadius", mRadius);
+    shader->SetFloatUniform ("uFramesPerSide",  static_cast<float>(mFramesPerSide));
+    shader->SetFloatUniform ("uHemisphere",     mIsHemisphere ? 1.0f : 0.0f);
+    shader->SetFloatUniform ("uFrameTexel",     1.0f / static_cast<float>(mFrameResolution));
+}
+
+} // namespace toy
@@ -0,0 +1,87 @@
+#include "Graphics/Mesh/ImpostorComponent.h"
+#include "Graphics/Mesh/ImpostorAtlas.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Engine/Core/Actor.h"
+#include "Engine/Core/Application.h"
+#include "Engine/Render/Renderer.h"
+#include "Engine/Render/Shader.h"
+#include "Engine/Render/LightingManager.h"
+
+#include "glad/glad.h"
+
+namespace toy {
+
+ImpostorComponent::ImpostorComponent(Actor* a, int drawOrder)
+: MeshComponent(a, drawOrder, VisualLayer::Object3D)
+, mImpostor(nullptr)
+, mImpostorDistance(100.0f)
+{
+}
+
+ImpostorComponent::~ImpostorComponent()
+{
+}
+
+void ImpostorComponent::SetImpostor(std::shared_ptr<ImpostorAtlas> atlas, float distance)
+{
+    mImpostor         = atlas;
+    mImpostorDistance = distance;
+}
+
+//------------------------------------------------------------
+// UseImpostor()
+//  - 判定はアクター原点とカメラの距離
+//------------------------------------------------------------
+bool ImpostorComponent::UseImpostor() const
+{
+    if (!mImpostor || !mImpostor->IsValid()) return false;
+
+    auto renderer  = GetOwner()->GetApp()->GetRenderer();
+    Vector3 camPos = renderer->GetInvViewMatrix().GetTranslation();
+    Vector3 pos    = GetOwner()->GetWorldTransform().GetTranslation();
+    return (pos - camPos).LengthSq() > mImpostorDistance * mImpostorDistance;
+}
+
+bool ImpostorComponent::SubmitDrawItems(MeshDrawQueue& queue)
+{
+    if (UseImpostor()) return false;
+    return MeshComponent::SubmitDrawItems(queue);
+}
+
+void ImpostorComponent::Draw()
+{
+    if (UseImpostor())
+    {
+        DrawImpostor();
+        return;
+    }
+    MeshComponent::Draw();
+}
+
+//------------------------------------------------------------
+// DrawImpostor()
+//  - Billboard.vert（USE_IMPOSTOR）で外接球を覆う板ポリを描く
+//  - 板ポリの向きはシェーダ側で決まるので裏面カリングは切る
+//------------------------------------------------------------
+void ImpostorComponent::DrawImpostor()
+{
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    auto shader   = renderer->GetShaderVariant("Impostor", SF_IMPOSTOR | SF_FOG);
+    if (!shader) return;
+
+    Matrix4 view = renderer->GetViewMatrix();
+
+    shader->SetActive();
+    mLightingManger->ApplyToShader(shader, view);
+    shader->SetMatrixUniform("uViewProj", view * renderer->GetProjectionMatrix());
+    shader->SetMatrixUniform("uWorldTransform", GetOwner()->GetWorldTransform());
+    mImpostor->Apply(shader.get());
+
+    glDisable(GL_CULL_FACE);
+    auto quad = mImpostor->GetQuad();
+    quad->SetActive();
+    glDrawElements(GL_TRIANGLES, quad->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+    glEnable(GL_CULL_FACE);
+}
+
+} // namespace toy
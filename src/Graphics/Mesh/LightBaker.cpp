@@ -0,0 +1,645 @@
+#include "Graphics/Mesh/LightBaker.h"
+#include "Graphics/Mesh/MeshComponent.h"
+#include "Asset/Geometry/Mesh.h"
+#include "Asset/Geometry/Polygon.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Engine/Core/Actor.h"
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+
+namespace toy {
+
+namespace {
+
+const char     kCacheMagic[4] = { 'T', 'L', 'B', 'K' };
+const uint32_t kCacheVersion  = 2;    // 2: キーにワールド行列のハッシュを追加
+
+//------------------------------------------------------------
+// ワールド行列のハッシュ（1/1000 単位に丸めてから FNV-1a、16 進 16 桁）
+//   保存・読み込みの誤差でキーが変わらないように丸める
+//------------------------------------------------------------
+std::string TransformHash(const Matrix4& world)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            int32_t q = static_cast<int32_t>(std::lround(world.mat[r][c] * 1000.0f));
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(&q);
+            for (size_t i = 0; i < sizeof(q); ++i)
+            {
+                hash ^= p[i];
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+
+    static const char* kHex = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i)
+    {
+        text[i] = kHex[hash & 0xF];
+        hash >>= 4;
+    }
+    return text;
+}
+
+struct CacheHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+};
+
+//------------------------------------------------------------
+// BVH（遮蔽判定専用）
+//   ・三角形はワールド座標。葉は最大 kLeafSize 枚
+//   ・最も長い軸の重心の中央値で二分する
+//   ・どれか 1 枚に当たれば終わり（最近傍は求めない）
+//------------------------------------------------------------
+const size_t kLeafSize = 4;
+
+struct Triangle
+{
+    Vector3 v0, v1, v2;
+};
+
+struct BvhNode
+{
+    Vector3  boundsMin;
+    Vector3  boundsMax;
+    uint32_t first;     // 葉：三角形の先頭 / 節：右の子（左の子は自分の次）
+    uint32_t count;     // 0 なら節
+};
+
+class Bvh
+{
+public:
+    explicit Bvh(std::vector<Triangle>&& tris)
+    : mTris(std::move(tris))
+    {
+        if (mTris.empty()) return;
+        mNodes.reserve(mTris.size() * 2 / kLeafSize + 1);
+        Build(0, mTris.size());
+    }
+
+    size_t GetNodeCount() const { return mNodes.size(); }
+
+    // start から dir 方向へ maxDist 以内に三角形があるか
+    bool Occluded(const Ray& ray, float maxDist) const
+    {
+        if (mNodes.empty()) return false;
+
+        Vector3 invDir(1.0f / ray.dir.x, 1.0f / ray.dir.y, 1.0f / ray.dir.z);
+
+        uint32_t stack[64];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0)
+        {
+            const BvhNode& node = mNodes[stack[--sp]];
+            if (!HitBounds(node, ray.start, invDir, maxDist)) continue;
+
+            if (node.count > 0)
+            {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i)
+                {
+                    const Triangle& tri = mTris[i];
+                    float t = 0.0f;
+                    if (IntersectRayTriangle(ray, tri.v0, tri.v1, tri.v2, t) && t < maxDist)
+                    {
+                        return true;
+                    }
+                }
+            }
+            else if (sp + 2 <= 64)
+            {
+                uint32_t self = static_cast<uint32_t>(&node - mNodes.data());
+                stack[sp++] = node.first;
+                stack[sp++] = self + 1;
+            }
+        }
+        return false;
+    }
+
+private:
+    uint32_t Build(size_t begin, size_t end)
+    {
+        uint32_t index = static_cast<uint32_t>(mNodes.size());
+        mNodes.emplace_back();
+
+        Vector3 bmin(Math::Infinity, Math::Infinity, Math::Infinity);
+        Vector3 bmax(-Math::Infinity, -Math::Infinity, -Math::Infinity);
+        Vector3 cmin = bmin;
+        Vector3 cmax = bmax;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Triangle& t = mTris[i];
+            for (const Vector3& v : { t.v0, t.v1, t.v2 })
+            {
+                bmin = Vector3(std::min(bmin.x, v.x), std::min(bmin.y, v.y), std::min(bmin.z, v.z));
+                bmax = Vector3(std::max(bmax.x, v.x), std::max(bmax.y, v.y), std::max(bmax.z, v.z));
+            }
+            Vector3 c = Centroid(t);
+            cmin = Vector3(std::min(cmin.x, c.x), std::min(cmin.y, c.y), std::min(cmin.z, c.z));
+            cmax = Vector3(std::max(cmax.x, c.x), std::max(cmax.y, c.y), std::max(cmax.z, c.z));
+        }
+        mNodes[index].boundsMin = bmin;
+        mNodes[index].boundsMax = bmax;
+
+        if (end - begin <= kLeafSize)
+        {
+            mNodes[index].first = static_cast<uint32_t>(begin);
+            mNodes[index].count = static_cast<uint32_t>(end - begin);
+            return index;
+        }
+
+        // 重心の広がりが最大の軸で中央値分割
+        Vector3 extent = cmax - cmin;
+        int axis = 0;
+        if (extent.y > extent.x) axis = 1;
+        if (extent.z > (axis == 0 ? extent.x : extent.y)) axis = 2;
+
+        size_t mid = (begin + end) / 2;
+        std::nth_element(mTris.begin() + begin, mTris.begin() + mid, mTris.begin() + end,
+                         [axis](const Triangle& a, const Triangle& b)
+                         {
+                             return Axis(Centroid(a), axis) < Axis(Centroid(b), axis);
+                         });
+
+        Build(begin, mid);
+        uint32_t right = Build(mid, end);
+        mNodes[index].first = right;
+        mNodes[index].count = 0;
+        return index;
+    }
+
+    static Vector3 Centroid(const Triangle& t) { return (t.v0 + t.v1 + t.v2) * (1.0f / 3.0f); }
+    static float   Axis(const Vector3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+    // スラブ法
+    static bool HitBounds(const BvhNode& node, const Vector3& start, const Vector3& invDir, float maxDist)
+    {
+        float tmin = 0.0f;
+        float tmax = maxDist;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float s  = Axis(start, axis);
+            float id = Axis(invDir, axis);
+            float t0 = (Axis(node.boundsMin, axis) - s) * id;
+            float t1 = (Axis(node.boundsMax, axis) - s) * id;
+            if (t0 > t1) std::swap(t0, t1);
+            tmin = std::max(tmin, t0);
+            tmax = std::min(tmax, t1);
+            if (tmin > tmax) return false;
+        }
+        return true;
+    }
+
+    std::vector<Triangle> mTris;
+    std::vector<BvhNode>  mNodes;
+};
+
+//------------------------------------------------------------
+// 頂点ごとの乱数（焼くたびに同じ結果になるよう頂点番号から作る）
+//------------------------------------------------------------
+class SampleRandom
+{
+public:
+    explicit SampleRandom(uint64_t seed) : mState(seed * 6364136223846793005ull + 1442695040888963407ull) {}
+
+    // [0, 1)
+    float Next()
+    {
+        mState ^= mState >> 12;
+        mState ^= mState << 25;
+        mState ^= mState >> 27;
+        return static_cast<float>((mState * 2685821657736338717ull) >> 40) / 16777216.0f;
+    }
+
+private:
+    uint64_t mState;
+};
+
+// n に直交する 2 軸
+void MakeBasis(const Vector3& n, Vector3& outT, Vector3& outB)
+{
+    Vector3 up = (std::fabs(n.y) < 0.99f) ? Vector3(0.0f, 1.0f, 0.0f) : Vector3(1.0f, 0.0f, 0.0f);
+    outT = Vector3::Normalize(Vector3::Cross(up, n));
+    outB = Vector3::Cross(n, outT);
+}
+
+// GL バッファの先頭 count 要素を読み戻す（StaticBatcher と同じ）
+void ReadBuffer(unsigned int buffer, size_t count, std::vector<float>& out)
+{
+    out.resize(count);
+    if (count == 0 || buffer == 0) return;
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0,
+                       static_cast<GLsizeiptr>(count * sizeof(float)), out.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+// 焼く頂点の列（ワールド座標）と結果の書き込み先
+struct BakeTarget
+{
+    std::vector<float>  positions;
+    std::vector<float>  normals;
+    std::vector<float>* out;
+};
+
+} // namespace
+
+
+LightBaker::LightBaker()
+{
+}
+
+LightBaker::~LightBaker()
+{
+}
+
+void LightBaker::AddCandidate(MeshComponent* comp)
+{
+    if (std::find(mCandidates.begin(), mCandidates.end(), comp) == mCandidates.end())
+    {
+        mCandidates.push_back(comp);
+    }
+}
+
+void LightBaker::RemoveCandidate(MeshComponent* comp)
+{
+    mCandidates.erase(std::remove(mCandidates.begin(), mCandidates.end(), comp), mCandidates.end());
+    mApplied.erase(std::remove(mApplied.begin(), mApplied.end(), comp), mApplied.end());
+}
+
+void LightBaker::AddInstance(const std::string& key, std::shared_ptr<Mesh> mesh, const Matrix4& world)
+{
+    Instance inst;
+    inst.key   = key;
+    inst.mesh  = mesh;
+    inst.world = world;
+    mInstances.push_back(inst);
+}
+
+std::string LightBaker::MakeKey(const std::string& actorID, const Matrix4& world)
+{
+    return actorID + "@" + TransformHash(world);
+}
+
+//------------------------------------------------------------
+// CollectInstances()
+//  - 候補のキーは Actor の ID + "@" + ワールド行列のハッシュ
+//    （既定の ID の Actor が登録順だけで区別されないように）
+//    重複したら登録順に "#1", "#2" ... を付ける
+//------------------------------------------------------------
+std::vector<LightBaker::Instance> LightBaker::CollectInstances() const
+{
+    std::vector<Instance> result;
+    std::unordered_map<std::string, int> used;
+
+    for (auto comp : mCandidates)
+    {
+        auto mesh = comp->GetMesh();
+        if (!mesh || comp->GetIsSkeletal()) continue;
+
+        Actor* owner = comp->GetOwner();
+        std::string key = MakeKey(owner->GetActorID(), owner->GetWorldTransform());
+        int n = used[key]++;
+        if (n > 0) key += "#" + std::to_string(n);
+
+        Instance inst;
+        inst.key   = key;
+        inst.mesh  = mesh;
+        inst.world = owner->GetWorldTransform();
+        inst.comp  = comp;
+        result.push_back(inst);
+    }
+
+    for (const auto& inst : mInstances)
+    {
+        result.push_back(inst);
+    }
+    return result;
+}
+
+//------------------------------------------------------------
+// Bake()
+//   1) 全インスタンスの三角形（ワールド）で BVH を作る
+//   2) 頂点の位置・法線を GPU から読み戻してワールドへ
+//   3) 頂点をスレッドで分担し、太陽へのレイと AO のレイを飛ばす
+//------------------------------------------------------------
+size_t LightBaker::Bake(const LightBakeSettings& settings)
+{
+    mResults.clear();
+
+    std::vector<Instance> instances = CollectInstances();
+    if (instances.empty()) return 0;
+
+    //--------------------------------------------------------
+    // 遮蔽物
+    //--------------------------------------------------------
+    std::vector<Triangle> tris;
+    for (const auto& inst : instances)
+    {
+        for (const auto& va : inst.mesh->GetVertexArray())
+        {
+            for (const auto& poly : va->GetWorldPolygons(inst.world))
+            {
+                tris.push_back({ poly.a, poly.b, poly.c });
+            }
+        }
+    }
+    size_t triCount = tris.size();
+    Bvh bvh(std::move(tris));
+
+    //--------------------------------------------------------
+    // 焼く頂点（GL を触るのでメインスレッドで）
+    //--------------------------------------------------------
+    std::vector<BakeTarget> targets;
+    std::vector<size_t>     targetStart;    // 通し番号の先頭（乱数の種・分担用）
+    size_t totalVerts = 0;
+    for (const auto& inst : instances)
+    {
+        auto& result = mResults[inst.key];
+        const auto& vaList = inst.mesh->GetVertexArray();
+        result.resize(vaList.size());
+
+        for (size_t i = 0; i < vaList.size(); ++i)
+        {
+            VertexArray* va = vaList[i].get();
+            size_t numVerts = va->GetNumVerts();
+            result[i].assign(numVerts * 2, 1.0f);
+            if (va->GetVertexBuffer(0) == 0 || va->GetVertexBuffer(1) == 0) continue;
+
+            BakeTarget target;
+            ReadBuffer(va->GetVertexBuffer(0), numVerts * 3, target.positions);
+            ReadBuffer(va->GetVertexBuffer(1), numVerts * 3, target.normals);
+            for (size_t v = 0; v < numVerts; ++v)
+            {
+                Vector3 p(target.positions[v * 3 + 0], target.positions[v * 3 + 1], target.positions[v * 3 + 2]);
+                Vector3 n(target.normals[v * 3 + 0],   target.normals[v * 3 + 1],   target.normals[v * 3 + 2]);
+                p = Vector3::Transform(p, inst.world);
+                n = Vector3::Transform(n, inst.world, 0.0f);
+                if (n.Length() > Math::NearZeroEpsilon) n.Normalize();
+                target.positions[v * 3 + 0] = p.x; target.positions[v * 3 + 1] = p.y; target.positions[v * 3 + 2] = p.z;
+                target.normals[v * 3 + 0]   = n.x; target.normals[v * 3 + 1]   = n.y; target.normals[v * 3 + 2]   = n.z;
+            }
+            target.out = &result[i];
+            targets.push_back(std::move(target));
+            targetStart.push_back(totalVerts);
+            totalVerts += numVerts;
+        }
+    }
+
+    //--------------------------------------------------------
+    // レイトレース
+    //   仕事は 256 頂点ずつ、アトミックなカウンタで取り合う
+    //--------------------------------------------------------
+    Vector3 toSun = Vector3::Normalize(-1.0f * settings.sunDirection);
+    Vector3 sunT, sunB;
+    MakeBasis(toSun, sunT, sunB);
+    float sunRadius  = std::tan(Math::ToRadians(std::max(settings.sunAngle, 0.0f)));
+    int   sunSamples = std::max(settings.sunSamples, 1);
+    int   aoSamples  = std::max(settings.aoSamples, 0);
+
+    auto bakeVertex = [&](const BakeTarget& target, size_t v, size_t globalIndex)
+    {
+        Vector3 p(target.positions[v * 3 + 0], target.positions[v * 3 + 1], target.positions[v * 3 + 2]);
+        Vector3 n(target.normals[v * 3 + 0],   target.normals[v * 3 + 1],   target.normals[v * 3 + 2]);
+        Vector3 origin = p + n * settings.rayBias;
+        SampleRandom random(globalIndex);
+
+        // 太陽：円盤内に散らしたレイが何本抜けるか（裏向きは 0）
+        float sun = 0.0f;
+        if (Vector3::Dot(n, toSun) > 0.0f)
+        {
+            int lit = 0;
+            for (int s = 0; s < sunSamples; ++s)
+            {
+                Vector3 dir = toSun;
+                if (sunSamples > 1 && sunRadius > 0.0f)
+                {
+                    float r   = sunRadius * std::sqrt(random.Next());
+                    float phi = Math::TwoPi * random.Next();
+                    dir = toSun + sunT * (r * std::cos(phi)) + sunB * (r * std::sin(phi));
+                }
+                if (!bvh.Occluded(Ray(origin, dir), Math::Infinity)) ++lit;
+            }
+            sun = static_cast<float>(lit) / sunSamples;
+        }
+
+        // AO：法線まわりのコサイン分布で aoDistance 以内に当たる割合
+        float ao = 1.0f;
+        if (aoSamples > 0)
+        {
+            Vector3 t, b;
+            MakeBasis(n, t, b);
+            int hits = 0;
+            for (int s = 0; s < aoSamples; ++s)
+            {
+                float u1  = random.Next();
+                float phi = Math::TwoPi * random.Next();
+                float r   = std::sqrt(u1);
+                Vector3 dir = t * (r * std::cos(phi)) + b * (r * std::sin(phi)) + n * std::sqrt(1.0f - u1);
+                if (bvh.Occluded(Ray(origin, dir), settings.aoDistance)) ++hits;
+            }
+            ao = 1.0f - static_cast<float>(hits) / aoSamples;
+        }
+
+        (*target.out)[v * 2 + 0] = sun;
+        (*target.out)[v * 2 + 1] = ao;
+    };
+
+    const size_t kChunk = 256;
+    std::vector<std::pair<size_t, size_t>> chunks;     // (target, 先頭頂点)
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        size_t numVerts = targets[i].positions.size() / 3;
+        for (size_t v = 0; v < numVerts; v += kChunk)
+        {
+            chunks.emplace_back(i, v);
+        }
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t c = next++; c < chunks.size(); c = next++)
+        {
+            const BakeTarget& target = targets[chunks[c].first];
+            size_t numVerts = target.positions.size() / 3;
+            size_t end = std::min(chunks[c].second + kChunk, numVerts);
+            for (size_t v = chunks[c].second; v < end; ++v)
+            {
+                bakeVertex(target, v, targetStart[chunks[c].first] + v);
+            }
+        }
+    };
+
+    unsigned int threadCount = settings.threads ? settings.threads : std::thread::hardware_concurrency();
+    threadCount = std::max(1u, std::min<unsigned int>(threadCount, static_cast<unsigned int>(chunks.size())));
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+
+    std::cout << "[LightBaker] " << instances.size() << " instances, "
+              << triCount << " triangles (" << bvh.GetNodeCount() << " BVH nodes), "
+              << totalVerts << " vertices on " << threadCount << " thread(s)" << std::endl;
+    return totalVerts;
+}
+
+//------------------------------------------------------------
+// キャッシュ
+//  - ヘッダ + エントリごとに
+//    キー（長さ + 文字列）・サブメッシュ数・[頂点数・float x 2 x 頂点数]
+//------------------------------------------------------------
+bool LightBaker::SaveCache(const std::string& filePath) const
+{
+    std::ofstream ofs(filePath, std::ios::binary);
+    if (!ofs)
+    {
+        std::cerr << "[LightBaker] Failed to open: " << filePath << std::endl;
+        return false;
+    }
+
+    CacheHeader header;
+    std::copy(kCacheMagic, kCacheMagic + 4, header.magic);
+    header.version    = kCacheVersion;
+    header.entryCount = static_cast<uint32_t>(mResults.size());
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& entry : mResults)
+    {
+        uint32_t keyLength = static_cast<uint32_t>(entry.first.size());
+        uint32_t subCount  = static_cast<uint32_t>(entry.second.size());
+        ofs.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+        ofs.write(entry.first.data(), keyLength);
+        ofs.write(reinterpret_cast<const char*>(&subCount), sizeof(subCount));
+        for (const auto& values : entry.second)
+        {
+            uint32_t numVerts = static_cast<uint32_t>(values.size() / 2);
+            ofs.write(reinterpret_cast<const char*>(&numVerts), sizeof(numVerts));
+            ofs.write(reinterpret_cast<const char*>(values.data()), sizeof(float) * numVerts * 2);
+        }
+    }
+
+    if (!ofs)
+    {
+        std::cerr << "[LightBaker] Failed to write: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LightBaker::LoadCache(const std::string& filePath)
+{
+    std::ifstream ifs(filePath, std::ios::binary);
+    if (!ifs)
+    {
+        return false;
+    }
+
+    CacheHeader header;
+    ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!ifs || !std::equal(kCacheMagic, kCacheMagic + 4, header.magic) ||
+        header.version != kCacheVersion)
+    {
+        std::cerr << "[LightBaker] Invalid cache: " << filePath << std::endl;
+        return false;
+    }
+
+    std::unordered_map<std::string, std::vector<std::vector<float>>> results;
+    for (uint32_t e = 0; e < header.entryCount && ifs; ++e)
+    {
+        uint32_t keyLength = 0;
+        ifs.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+        std::string key(keyLength, '\0');
+        ifs.read(&key[0], keyLength);
+
+        uint32_t subCount = 0;
+        ifs.read(reinterpret_cast<char*>(&subCount), sizeof(subCount));
+        auto& entry = results[key];
+        for (uint32_t s = 0; s < subCount && ifs; ++s)
+        {
+            uint32_t numVerts = 0;
+            ifs.read(reinterpret_cast<char*>(&numVerts), sizeof(numVerts));
+            if (!ifs) break;
+            std::vector<float> values(static_cast<size_t>(numVerts) * 2);
+            ifs.read(reinterpret_cast<char*>(values.data()), sizeof(float) * values.size());
+            entry.push_back(std::move(values));
+        }
+    }
+
+    if (!ifs)
+    {
+        std::cerr << "[LightBaker] Truncated cache: " << filePath << std::endl;
+        return false;
+    }
+
+    mResults = std::move(results);
+    return true;
+}
+
+//------------------------------------------------------------
+// Apply()
+//  - キーで結果を引き、サブメッシュ数・頂点数が合うものだけ適用する
+//------------------------------------------------------------
+size_t LightBaker::Apply()
+{
+    ClearApplied();
+
+    for (const auto& inst : CollectInstances())
+    {
+        if (!inst.comp) continue;
+
+        auto found = mResults.find(inst.key);
+        if (found == mResults.end()) continue;
+
+        const auto& values = found->second;
+        const auto& vaList = inst.mesh->GetVertexArray();
+        bool matched = (values.size() == vaList.size());
+        for (size_t i = 0; matched && i < vaList.size(); ++i)
+        {
+            matched = (values[i].size() == static_cast<size_t>(vaList[i]->GetNumVerts()) * 2);
+        }
+        if (!matched)
+        {
+            std::cerr << "[LightBaker] Mesh changed since bake, skipped: " << inst.key << std::endl;
+            continue;
+        }
+
+        inst.comp->SetBakedLighting(values);
+        mApplied.push_back(inst.comp);
+    }
+    return mApplied.size();
+}
+
+void LightBaker::ClearApplied()
+{
+    for (auto comp : mApplied)
+    {
+        comp->ClearBakedLighting();
+    }
+    mApplied.clear();
+}
+
+} // namespace toy
@@ -8,6 +8,12 @@
 #include "Asset/Material/Texture.h"
 #include "Asset/Geometry/VertexArray.h"
 #include "Asset/Material/Material.h"
+#include "Asset/Geometry/Polygon.h"
+#include "Engine/Render/OcclusionCuller.h"
+#include "Graphics/Mesh/LightBaker.h"
+#include "Utils/FrustumUtil.h"
+#include "Graphics/Mesh/StaticBatcher.h"
+#include "Physics/BoundingVolumeComponent.h"
 
 #include "glad/glad.h"
 #include <vector>
@@ -18,18 +24,22 @@ namespace toy {
 // コンストラクタ
 //  - Renderer からシェーダやライト情報を取得
 //  - デフォルトでは 3Dオブジェクトレイヤー & 影あり
+//  - 通常描画用シェーダは Draw 時に状態から選ぶ（SelectShaders）
 //------------------------------------------------------------
 MeshComponent::MeshComponent(Actor* a, int drawOrder, VisualLayer layer, bool isSkeletal)
     : VisualComponent(a, drawOrder, layer)
     , mMesh(nullptr)
     , mTextureIndex(0)
     , mIsSkeletal(isSkeletal)
+    , mShadowFeatures(isSkeletal ? SF_SKINNED : SF_NONE)
+    , mShaderFeatures(SF_NONE)
     , mIsToon(false)
     , mContourFactor(1.0f)
+    , mIsStaticBatching(false)
+    , mIsLightBaking(false)
 {
     auto renderer = GetOwner()->GetApp()->GetRenderer();
-    mShader          = renderer->GetShader("Mesh");
-    mShadowShader    = renderer->GetShader("ShadowMesh");
+    mShadowShader    = renderer->GetShaderVariant("Shadow", mShadowFeatures);
     mLightingManger  = renderer->GetLightingManager();
     mShadowMapTexture = renderer->GetShadowMapTexture();
 
@@ -43,109 +53,280 @@ MeshComponent::MeshComponent(Actor* a, int drawOrder, VisualLayer layer, bool is
 //------------------------------------------------------------
 MeshComponent::~MeshComponent()
 {
+    SetStaticBatching(false);
+    SetLightBaking(false);
 }
 
 //------------------------------------------------------------
-// Draw()
-//  - 通常描画
-//  - シャドウマップ + ライティング + マテリアルを反映
-//  - オプションでトゥーン輪郭を追加描画
+// SetStaticBatching()
+//  - Renderer の StaticBatcher に候補として登録／解除する
 //------------------------------------------------------------
-void MeshComponent::Draw()
+void MeshComponent::SetStaticBatching(bool enable)
 {
-    if (!mMesh) return;
+    if (enable == mIsStaticBatching) return;
+    mIsStaticBatching = enable;
 
-    // 加算ブレンドが指定されている場合はブレンドモード変更
-    if (mIsBlendAdd)
+    auto batcher = GetOwner()->GetApp()->GetRenderer()->GetStaticBatcher();
+    if (!batcher) return;
+
+    if (enable)
     {
-        glBlendFunc(GL_ONE, GL_ONE);
+        batcher->AddCandidate(this);
+    }
+    else
+    {
+        batcher->RemoveCandidate(this);
+    }
+}
+
+//------------------------------------------------------------
+// SetLightBaking()
+//  - Renderer の LightBaker に候補として登録／解除する
+//------------------------------------------------------------
+void MeshComponent::SetLightBaking(bool enable)
+{
+    if (enable == mIsLightBaking) return;
+    mIsLightBaking = enable;
+
+    auto baker = GetOwner()->GetApp()->GetRenderer()->GetLightBaker();
+    if (!baker) return;
+
+    if (enable)
+    {
+        baker->AddCandidate(this);
+    }
+    else
+    {
+        baker->RemoveCandidate(this);
+        ClearBakedLighting();
     }
+}
 
-    // シャドウマップテクスチャ有効化（テクスチャユニット1）
-    mShadowMapTexture->SetActive(1);
+//------------------------------------------------------------
+// SetBakedLighting()
+//  - サブメッシュごとに焼いた値を持つ VertexArray を作る
+//    （頂点・インデックスは元のメッシュと共有）
+//------------------------------------------------------------
+void MeshComponent::SetBakedLighting(const std::vector<std::vector<float>>& bakedLighting)
+{
+    mBakedArrays.clear();
+    if (!mMesh || mIsSkeletal) return;
+
+    const auto& vaList = mMesh->GetVertexArray();
+    if (bakedLighting.size() != vaList.size()) return;
 
+    for (size_t i = 0; i < vaList.size(); ++i)
+    {
+        if (bakedLighting[i].size() != static_cast<size_t>(vaList[i]->GetNumVerts()) * 2)
+        {
+            mBakedArrays.clear();
+            return;
+        }
+        mBakedArrays.push_back(std::make_shared<VertexArray>(vaList[i].get(), bakedLighting[i].data()));
+    }
+}
+
+void MeshComponent::ClearBakedLighting()
+{
+    mBakedArrays.clear();
+}
+
+VertexArray* MeshComponent::GetDrawVertexArray(size_t index, VertexArray* source)
+{
+    if (index < mBakedArrays.size())
+    {
+        return mBakedArrays[index].get();
+    }
+    return source;
+}
+
+//------------------------------------------------------------
+// SelectShaders()
+//  - 現在の状態で必要な機能だけを持つバリアントを選ぶ
+//  - フォグは常時、影はこのフレームにシャドウマップがある時のみ
+//  - スキニングが前処理済みなら USE_SKINNING は付けない
+//  - 焼き込み済みならシャドウマップの代わりに焼いた値を使う
+//------------------------------------------------------------
+void MeshComponent::SelectShaders()
+{
     auto renderer = GetOwner()->GetApp()->GetRenderer();
-    Matrix4 view  = renderer->GetViewMatrix();
-    Matrix4 proj  = renderer->GetProjectionMatrix();
-    Matrix4 light = renderer->GetLightSpaceMatrix();
 
-    // メインのメッシュシェーダを使用
-    mShader->SetActive();
+    uint32_t features = SF_FOG;
+    if (mIsSkeletal && !IsPreSkinned())     features |= SF_SKINNED;
+    if (mIsToon)                            features |= SF_TOON;
+    if (HasBakedLighting())                 features |= SF_BAKED_LIGHTING;
+    else if (renderer->IsShadowMapActive()) features |= SF_SHADOW;
 
-    // ライティング情報をシェーダに反映
-    mLightingManger->ApplyToShader(mShader, view);
+    if (mShader && features == mShaderFeatures)
+    {
+        return;
+    }
 
-    // 行列類
-    mShader->SetMatrixUniform("uViewProj", view * proj);
-    mShader->SetMatrixUniform("uLightSpaceMatrix", light);
+    mShader         = renderer->GetShaderVariant("Phong", features);
+    mShaderFeatures = features;
 
-    // シャドウマップサンプラ設定
-    mShader->SetTextureUniform("uShadowMap", 1);
-    mShader->SetFloatUniform("uShadowBias", 0.005f);
+    // 単色用は使う時に取り直す
+    mOverrideShader = nullptr;
+}
+
+//------------------------------------------------------------
+// GetOverrideShader()
+//  - ライティング・影を持たない単色バリアント
+//  - スキニングとフォグだけは通常描画と揃える
+//------------------------------------------------------------
+std::shared_ptr<Shader> MeshComponent::GetOverrideShader()
+{
+    if (!mOverrideShader)
+    {
+        uint32_t features = (mShaderFeatures & (SF_SKINNED | SF_FOG)) | SF_OVERRIDE_COLOR;
+        mOverrideShader = GetOwner()->GetApp()->GetRenderer()->GetShaderVariant("Phong", features);
+    }
+    return mOverrideShader;
+}
 
-    // トゥーンレンダリングON/OFF
-    mShader->SetBooleanUniform("uUseToon", mIsToon);
+//------------------------------------------------------------
+// CollectDrawItems()
+//  - サブメッシュごとに描画要求を作ってキューへ積む
+//  - OverrideColor のマテリアルは単色パス
+//  - トゥーンなら輪郭パスも積む（キュー側で裏面描画に切り替わる）
+//  - メッシュレットを持つサブメッシュは、いま描いているビューで
+//    フラスタム／裏向きカリングし、残った範囲だけを積む（輪郭は全体）
+//------------------------------------------------------------
+void MeshComponent::CollectDrawItems(MeshDrawQueue& queue)
+{
+    SelectShaders();
+    if (!mShader) return;
 
-    // ワールド変換を送る
-    mShader->SetMatrixUniform("uWorldTransform", GetOwner()->GetWorldTransform());
+    auto renderer  = GetOwner()->GetApp()->GetRenderer();
+    auto materials = renderer->GetMaterialBuffer();
+
+    bool    useMeshlets = renderer->IsMeshletCulling();
+    bool    isCullReady = false;
+    Matrix4 world;
+    Frustum frustum;
+    Vector3 cameraPos;
 
     //--------------------------------------------------------
-    // メッシュ本体の描画
+    // メッシュ本体
     //  - Mesh は複数 VertexArray（サブメッシュ）を持つ前提
-    //  - 各サブメッシュに対応した Material をバインドして描画
+    //  - マテリアル未設定のサブメッシュは既定マテリアルを使う
     //--------------------------------------------------------
-    auto vaList = mMesh->GetVertexArray();
-    for (auto& v : vaList)
+    const auto& vaList = mMesh->GetVertexArray();
+    for (size_t i = 0; i < vaList.size(); ++i)
     {
+        auto& v = vaList[i];
         auto mat = mMesh->GetMaterial(v->GetTextureID());
-        if (mat)
+        Material* material = mat ? mat.get() : renderer->GetDefaultMaterial().get();
+
+        MeshDrawItem item;
+        item.comp     = this;
+        item.va       = GetDrawVertexArray(i, v.get());
+        item.material = material;
+
+        const MeshletSet* meshlets = v->GetMeshlets();
+        if (useMeshlets && meshlets)
         {
-            // Diffuse / Specular / Texture 等をまとめてバインド
-            mat->BindToShader(mShader, 0);
+            if (!isCullReady)
+            {
+                world     = GetOwner()->GetWorldTransform();
+                frustum   = BuildFrustumFromMatrix(renderer->GetViewProjMatrix());
+                cameraPos = renderer->GetInvViewMatrix().GetTranslation();
+                mMeshletRanges.resize(vaList.size());
+                isCullReady = true;
+            }
+            if (meshlets->Cull(world, frustum, cameraPos, mMeshletRanges[i]) == 0)
+            {
+                continue;
+            }
+            item.ranges = &mMeshletRanges[i];
         }
 
-        v->SetActive();
-        glDrawElements(GL_TRIANGLES, v->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+        if (material->GetOverrideColor())
+        {
+            auto shader = GetOverrideShader();
+            if (!shader) continue;
+            item.shader = shader.get();
+            item.pass   = MeshDrawPass::OverrideColor;
+            queue.Add(item, 0);
+        }
+        else
+        {
+            item.shader = mShader.get();
+            item.pass   = MeshDrawPass::Main;
+            queue.Add(item, material->PrepareSlot(materials));
+        }
     }
 
     //--------------------------------------------------------
-    // トゥーン輪郭描画（アウトライン）
+    // トゥーン輪郭（アウトライン）
     //  - 表面を少しスケールアップして黒で描画
-    //  - CW / CCW を反転して裏面を描くことで輪郭として見せる
+    //  - 単色バリアントを使うのでマテリアルのバインドは不要
     //--------------------------------------------------------
     if (mIsToon)
     {
-        // 反時計回り(CCW)→時計回り(CW)に変更し裏面描画にする
-        glFrontFace(GL_CW);
+        auto shader = GetOverrideShader();
+        if (!shader) return;
 
-        // わずかにスケールアップしたワールド行列
-        Matrix4 scaleOutline = Matrix4::CreateScale(mContourFactor);
-        mShader->SetMatrixUniform("uWorldTransform", scaleOutline * GetOwner()->GetWorldTransform());
-
-        for (auto& v : vaList)
+        for (size_t i = 0; i < vaList.size(); ++i)
         {
-            auto mat = mMesh->GetMaterial(v->GetTextureID());
-            if (mat)
-            {
-                // 色を強制的に黒に上書きするモード
-                mat->SetOverrideColor(true, Vector3(0.f, 0.f, 0.f));
-                mat->BindToShader(mShader, 0);
-            }
+            MeshDrawItem item;
+            item.comp   = this;
+            item.va     = GetDrawVertexArray(i, vaList[i].get());
+            item.shader = shader.get();
+            item.pass   = MeshDrawPass::Outline;
+            queue.Add(item, 0);
+        }
+    }
+}
 
-            v->SetActive();
-            glDrawElements(GL_TRIANGLES, v->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+//------------------------------------------------------------
+// SubmitDrawItems()
+//  - 加算ブレンドはブレンド状態を自前で切り替えるので即時描画に回す
+//------------------------------------------------------------
+bool MeshComponent::SubmitDrawItems(MeshDrawQueue& queue)
+{
+    if (!mMesh || mIsBlendAdd) return false;
 
-            // 上書きカラーを元に戻す
-            if (mat)
-            {
-                mat->SetOverrideColor(false, Vector3(0.f, 0.f, 0.f));
-            }
-        }
+    CollectDrawItems(queue);
+    return true;
+}
+
+//------------------------------------------------------------
+// SetObjectUniforms()
+//  - 輪郭パスはわずかにスケールアップしたワールド行列を使う
+//------------------------------------------------------------
+void MeshComponent::SetObjectUniforms(Shader* shader, MeshDrawPass pass)
+{
+    Matrix4 world = GetOwner()->GetWorldTransform();
+    if (pass == MeshDrawPass::Outline)
+    {
+        world = Matrix4::CreateScale(mContourFactor) * world;
+    }
+
+    shader->SetMatrixUniform("uWorldTransform", world);
+    SetSkinningUniforms(shader);
+}
 
-        // フロントフェイスを元に戻す
-        glFrontFace(GL_CCW);
+//------------------------------------------------------------
+// Draw()
+//  - 通常描画（このコンポーネントだけを即時描画）
+//  - 中身は SubmitDrawItems と同じ要求を一時キューで描くだけ
+//------------------------------------------------------------
+void MeshComponent::Draw()
+{
+    if (!mMesh) return;
+
+    // 加算ブレンドが指定されている場合はブレンドモード変更
+    if (mIsBlendAdd)
+    {
+        glBlendFunc(GL_ONE, GL_ONE);
     }
 
+    auto& queue = GetOwner()->GetApp()->GetRenderer()->GetImmediateDrawQueue();
+    queue.Clear();
+    CollectDrawItems(queue);
+    queue.Execute(GetOwner()->GetApp()->GetRenderer());
+
     // 加算ブレンドを戻す
     if (mIsBlendAdd)
     {
@@ -163,10 +344,43 @@ std::shared_ptr<VertexArray> MeshComponent::GetVertexArray(int id) const
     return mMesh->GetVertexArray()[id];
 }
 
+//------------------------------------------------------------
+// CollectOccluder()
+//  - 遮蔽物としての三角形を OcclusionCuller へ積む
+//  - 箱で代用する場合は BoundingVolume の 12 三角形を使う
+//  - スキンメッシュはバインドポーズの形状が当てにならないので、
+//    箱で代用する場合のみ対象にする
+//------------------------------------------------------------
+void MeshComponent::CollectOccluder(OcclusionCuller& culler)
+{
+    Matrix4 world = GetOwner()->GetWorldTransform();
+
+    if (mIsOccluderHull)
+    {
+        auto bv = GetOwner()->GetComponent<BoundingVolumeComponent>();
+        if (bv && bv->GetPolygons())
+        {
+            culler.AddOccluder(bv->GetPolygons().get(), NUM_VERTEX, world);
+        }
+        return;
+    }
+
+    if (!mMesh || mIsSkeletal) return;
+
+    for (auto& va : mMesh->GetVertexArray())
+    {
+        const auto& polys = va->GetPolygons();
+        culler.AddOccluder(polys.data(), polys.size(), world);
+    }
+}
+
 //------------------------------------------------------------
 // DrawShadow()
 //  - シャドウマップ用の深度描画
 //  - ライティングは不要で、LightSpaceMatrix と WorldTransform のみ
+//  - スキンメッシュは SetSkinningUniforms でボーン行列も送る
+//    （前処理済みなら結果のバッファを非スキニングのシェーダで描く）
+//  - 法線・UV を読まない深度用 VAO で描く
 //------------------------------------------------------------
 void MeshComponent::DrawShadow()
 {
@@ -175,19 +389,29 @@ void MeshComponent::DrawShadow()
     auto renderer = GetOwner()->GetApp()->GetRenderer();
     Matrix4 light = renderer->GetLightSpaceMatrix();
 
+    uint32_t features = (mIsSkeletal && !IsPreSkinned()) ? SF_SKINNED : SF_NONE;
+    if (!mShadowShader || features != mShadowFeatures)
+    {
+        mShadowShader   = renderer->GetShaderVariant("Shadow", features);
+        mShadowFeatures = features;
+    }
+    if (!mShadowShader) return;
+
     // シャドウ専用シェーダを有効化
     mShadowShader->SetActive();
 
     // ワールド行列＆ライト空間行列を送る
     mShadowShader->SetMatrixUniform("uWorldTransform", GetOwner()->GetWorldTransform());
     mShadowShader->SetMatrixUniform("uLightSpaceMatrix", light);
+    SetSkinningUniforms(mShadowShader.get());
 
-    // VAO を全サブメッシュ分描画
-    auto vaList = mMesh->GetVertexArray();
-    for (auto& v : vaList)
+    // VAO を全サブメッシュ分描画（位置だけの深度用 VAO）
+    const auto& vaList = mMesh->GetVertexArray();
+    for (size_t i = 0; i < vaList.size(); ++i)
     {
-        v->SetActive();
-        glDrawElements(GL_TRIANGLES, v->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+        VertexArray* va = GetDrawVertexArray(i, vaList[i].get());
+        va->SetDepthActive();
+        glDrawElements(GL_TRIANGLES, va->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
     }
 }
 
@@ -5,26 +5,40 @@
 #include "Engine/Core/Actor.h"
 #include "Engine/Core/Application.h"
 #include "Engine/Render/Renderer.h"
+#include "Engine/Render/BonePaletteBuffer.h"
+#include "Engine/Render/SkinningStage.h"
 #include "Asset/Material/Texture.h"
 #include "Asset/Geometry/VertexArray.h"
 #include "Asset/Material/Material.h"
 #include "Engine/Runtime/AnimationPlayer.h"
+#include "Engine/Runtime/SignificanceManager.h"
+
+#include <iostream>
 
 namespace toy {
 
 //----------------------------------------------------------------------
 // コンストラクタ
 //  - MeshComponent 側の isSkeletal = true を使う前提
-//  - スキニング用シェーダ／シャドウ用シェーダに差し替え
+//  - シェーダは MeshComponent が USE_SKINNING 付きのバリアントを選ぶ
+//  - ボーンパレットを書き込んでもらうため Renderer に登録
 //----------------------------------------------------------------------
 SkeletalMeshComponent::SkeletalMeshComponent(Actor* a, int drawOrder, VisualLayer layer)
 : MeshComponent(a, drawOrder, layer,  true)
 , mAnimTime(0.0f)
+, mPendingAnimTime(0.0f)
+, mIsPoseDirty(true)
+, mIsSkinCached(false)
 , mAnimPlayer(nullptr)
+, mPaletteOffset(-1)
+, mIsPreSkinned(false)
 {
-    auto renderer = GetOwner()->GetApp()->GetRenderer();
-    mShader       = renderer->GetShader("Skinned");
-    mShadowShader = renderer->GetShader("ShadowSkinned");
+    GetOwner()->GetApp()->GetRenderer()->AddSkinnedComp(this);
+}
+
+SkeletalMeshComponent::~SkeletalMeshComponent()
+{
+    GetOwner()->GetApp()->GetRenderer()->RemoveSkinnedComp(this);
 }
 
 //----------------------------------------------------------------------
@@ -40,131 +54,125 @@ void SkeletalMeshComponent::SetAnimID(const unsigned int animID, const bool mode
 }
 
 //----------------------------------------------------------------------
-// 通常描画
-//  - ボーン行列(uMatrixPalette)をシェーダへ渡してスキニング描画
-//  - MeshComponent::Draw とほぼ同じ構成＋スキニング用処理
+// このフレームに書き込むボーン数
+//  - 非表示／メッシュ未設定なら 0（UBO 領域を消費しない）
 //----------------------------------------------------------------------
-void SkeletalMeshComponent::Draw()
+unsigned int SkeletalMeshComponent::GetPaletteBoneCount() const
 {
-    if (!mMesh) return;
+    if (!mAnimPlayer || !mIsVisible) return 0;
 
-    // 加算ブレンド指定時
-    if (mIsBlendAdd)
+    size_t count = mAnimPlayer->GetFinalMatrices().size();
+    if (count > MAX_SKELETON_BONES)
     {
-        glBlendFunc(GL_ONE, GL_ONE);
+        count = MAX_SKELETON_BONES;
     }
-    
-    // シャドウマップテクスチャ
-    mShadowMapTexture->SetActive(1);
-
-    auto  renderer = GetOwner()->GetApp()->GetRenderer();
-    Matrix4 view   = renderer->GetViewMatrix();
-    Matrix4 proj   = renderer->GetProjectionMatrix();
-    Matrix4 light  = renderer->GetLightSpaceMatrix();
-    
-    mShader->SetActive();
-    mLightingManger->ApplyToShader(mShader, view);
-    mShader->SetMatrixUniform("uViewProj", view * proj);
-    mShader->SetMatrixUniform("uLightSpaceMatrix", light);
-    mShader->SetTextureUniform("uShadowMap", 1);
-    mShader->SetFloatUniform("uShadowBias", 0.005f);
-    mShader->SetBooleanUniform("uUseToon", mIsToon);
-    mShader->SetMatrixUniform("uWorldTransform", GetOwner()->GetWorldTransform());
-    
-    // ボーン行列パレットを取得してシェーダに送る
-    std::vector<Matrix4> transforms =
-        mAnimPlayer ? mAnimPlayer->GetFinalMatrices() : std::vector<Matrix4>();
-    
-    mShader->SetMatrixUniforms("uMatrixPalette",
-                               transforms.data(),
-                               static_cast<unsigned int>(transforms.size()));
-    mShader->SetFloatUniform("uSpecPower", mMesh->GetSpecPower());
-    
-    // メッシュ本体描画
-    auto va = mMesh->GetVertexArray();
-    for (auto v : va)
+    return static_cast<unsigned int>(count);
+}
+
+//----------------------------------------------------------------------
+// ボーンパレット書き込み
+//  - AnimationPlayer の行列をマップ済み UBO へ直接コピーする
+//----------------------------------------------------------------------
+void SkeletalMeshComponent::WritePalette(BonePaletteBuffer& buffer)
+{
+    unsigned int count = GetPaletteBoneCount();
+    if (count == 0)
     {
-        auto mat = mMesh->GetMaterial(v->GetTextureID());
-        if (mat)
-        {
-            mat->BindToShader(mShader);
-        }
-        v->SetActive();
-        glDrawElements(GL_TRIANGLES, v->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+        mPaletteOffset = -1;
+        return;
+    }
+
+    mPaletteOffset = static_cast<long>(
+        buffer.Write(mAnimPlayer->GetFinalMatrices().data(), count));
+}
+
+//----------------------------------------------------------------------
+// スキニング前処理
+//  - パレットをバインドし、全サブメッシュをトランスフォームフィードバックで
+//    受け皿へスキニングする（受け皿は初回に生成）
+//  - 以降のパスは受け皿を非スキニングのシェーダで描く
+//  - 間引きで姿勢が前回のままなら、受け皿の中身をそのまま使う
+//----------------------------------------------------------------------
+void SkeletalMeshComponent::PreSkin(SkinningStage* stage)
+{
+    mIsPreSkinned = false;
+    if (!stage || !mMesh || mPaletteOffset < 0)
+    {
+        mIsSkinCached = false;
+        return;
+    }
+    if (mIsSkinCached && !mIsPoseDirty)
+    {
+        mIsPreSkinned = true;
+        return;
     }
-    
-    // トゥーン輪郭描画（アウトライン用にスケール拡大＋表裏反転）
-    if (mIsToon)
+
+    const auto& vaList = mMesh->GetVertexArray();
+    if (mSkinnedVAs.size() != vaList.size())
     {
-        glFrontFace(GL_CW);
-        Matrix4 m = Matrix4::CreateScale(mContourFactor);
-        mShader->SetMatrixUniform("uWorldTransform",
-                                  m * GetOwner()->GetWorldTransform());
-        for (auto v : va)
+        mSkinnedVAs.clear();
+        for (auto& v : vaList)
         {
-            auto mat = mMesh->GetMaterial(v->GetTextureID());
-            if (mat)
-            {
-                mat->SetOverrideColor(true, Vector3(0.f, 0.f, 0.f));
-                mat->BindToShader(mShader, 0);
-            }
-            v->SetActive();
-            glDrawElements(GL_TRIANGLES, v->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
-            mat->SetOverrideColor(false, Vector3(0.f, 0.f, 0.f));
+            mSkinnedVAs.push_back(std::make_unique<VertexArray>(v.get()));
         }
-        glFrontFace(GL_CCW);
     }
-    
-    // 加算ブレンド解除
-    if (mIsBlendAdd)
+
+    auto palette = GetOwner()->GetApp()->GetRenderer()->GetBonePaletteBuffer();
+    palette->Bind(static_cast<GLintptr>(mPaletteOffset));
+
+    for (size_t i = 0; i < vaList.size(); ++i)
     {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        stage->Skin(vaList[i].get(), mSkinnedVAs[i].get());
     }
+    mIsPreSkinned = true;
+    mIsSkinCached = true;
+    mIsPoseDirty  = false;
 }
 
-//----------------------------------------------------------------------
-// シャドウ描画
-//  - 通常描画と同様にボーン行列を渡しつつ、深度のみ書き込む想定
-//----------------------------------------------------------------------
-void SkeletalMeshComponent::DrawShadow()
+VertexArray* SkeletalMeshComponent::GetDrawVertexArray(size_t index, VertexArray* source)
 {
-    if (!mMesh) return;
-    
-    auto   renderer = GetOwner()->GetApp()->GetRenderer();
-    Matrix4 light   = renderer->GetLightSpaceMatrix();
-    
-    mShadowShader->SetActive();
-    mShadowShader->SetMatrixUniform("uWorldTransform", GetOwner()->GetWorldTransform());
-    
-    // アニメーション行列（無ければ空配列）
-    static std::vector<Matrix4> gEmptyMatrixList;
-    std::vector<Matrix4> transforms =
-        mAnimPlayer ? mAnimPlayer->GetFinalMatrices() : gEmptyMatrixList;
-    
-    mShadowShader->SetMatrixUniforms("uMatrixPalette",
-                                     transforms.data(),
-                                     static_cast<unsigned int>(transforms.size()));
-    mShadowShader->SetMatrixUniform("uLightSpaceMatrix", light);
-    
-    // メッシュをシャドウマップ用に描画
-    auto va = mMesh->GetVertexArray();
-    for (auto v : va)
+    if (mIsPreSkinned && index < mSkinnedVAs.size())
     {
-        v->SetActive();
-        glDrawElements(GL_TRIANGLES, v->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+        return mSkinnedVAs[index].get();
     }
+    return source;
+}
+
+//----------------------------------------------------------------------
+// スキニング用 uniform
+//  - 通常描画／輪郭／シャドウのすべてから呼ばれる
+//  - 行列は書き込み済みなので、自分の領域をバインドするだけ
+//  - 前処理済みなら非スキニングのシェーダなので何もしない
+//----------------------------------------------------------------------
+void SkeletalMeshComponent::SetSkinningUniforms(Shader* shader)
+{
+    if (mPaletteOffset < 0 || mIsPreSkinned) return;
+
+    auto palette = GetOwner()->GetApp()->GetRenderer()->GetBonePaletteBuffer();
+    palette->Bind(static_cast<GLintptr>(mPaletteOffset));
 }
 
 //----------------------------------------------------------------------
 // Update
-//  - 毎フレーム AnimationPlayer を進めるだけ
+//  - AnimationPlayer を進める（重要度の間引き間隔ごと）
 //----------------------------------------------------------------------
 void SkeletalMeshComponent::Update(float deltaTime)
 {
-    if (mAnimPlayer)
+    if (!mAnimPlayer) return;
+
+    mPendingAnimTime += deltaTime;
+
+    Actor* owner = GetOwner();
+    auto significance = owner->GetApp()->GetSignificanceManager();
+    if (significance)
     {
-        mAnimPlayer->Update(deltaTime);
+        int interval = significance->GetPolicy(owner->GetSignificance()).animInterval;
+        if (!significance->IsUpdateFrame(interval, owner)) return;
     }
+
+    mAnimPlayer->Update(mPendingAnimTime);
+    mPendingAnimTime = 0.0f;
+    mIsPoseDirty     = true;
 }
 
 //----------------------------------------------------------------------
@@ -174,8 +182,22 @@ void SkeletalMeshComponent::Update(float deltaTime)
 //----------------------------------------------------------------------
 void SkeletalMeshComponent::SetMesh(std::shared_ptr<Mesh> mesh)
 {
+    // 受け皿は旧メッシュのバッファを参照しているので先に破棄
+    mSkinnedVAs.clear();
+    mIsPreSkinned = false;
+    mIsSkinCached = false;
+    mIsPoseDirty  = true;
+
     MeshComponent::SetMesh(mesh);
     mAnimPlayer = std::make_unique<AnimationPlayer>(mesh);
+
+    size_t numBones = mesh ? mesh->GetNumBones() : 0;
+    if (numBones > MAX_SKELETON_BONES)
+    {
+        std::cerr << "[SkeletalMeshComponent] Bone count " << numBones
+                  << " exceeds " << MAX_SKELETON_BONES
+                  << ". Extra bones are ignored." << std::endl;
+    }
 }
 
 } // namespace toy
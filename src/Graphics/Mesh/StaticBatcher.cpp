@@ -0,0 +1,335 @@
+#include "Graphics/Mesh/StaticBatcher.h"
+#include "Graphics/Mesh/MeshComponent.h"
+#include "Asset/Geometry/Mesh.h"
+#include "Asset/Geometry/VertexArray.h"
+#include "Asset/Material/Material.h"
+#include "Engine/Core/Actor.h"
+#include "Engine/Core/Application.h"
+#include "Physics/BoundingVolumeComponent.h"
+#include "glad/glad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+namespace toy {
+
+namespace {
+
+//------------------------------------------------------------
+// バッチ用の MeshComponent
+//   ・アプリ側で Actor ごと破棄された場合に StaticBatcher へ知らせる
+//------------------------------------------------------------
+class StaticBatchMeshComponent : public MeshComponent
+{
+public:
+    StaticBatchMeshComponent(Actor* owner, std::vector<Actor*>* batchActors)
+    : MeshComponent(owner, 100, VisualLayer::Object3D)
+    , mBatchActors(batchActors)
+    {
+    }
+
+    ~StaticBatchMeshComponent()
+    {
+        if (!mBatchActors) return;
+        auto& list = *mBatchActors;
+        list.erase(std::remove(list.begin(), list.end(), GetOwner()), list.end());
+    }
+
+    void Detach() { mBatchActors = nullptr; }
+
+private:
+    std::vector<Actor*>* mBatchActors;
+};
+
+// バッチの振り分けキー（格子セル・マテリアル・影・遮蔽物）
+using BatchKey = std::tuple<int, int, Material*, bool, bool>;
+
+// 組み立て中のバッチ
+struct BatchBuilder
+{
+    std::shared_ptr<Material> material;
+    std::vector<float>        positions;
+    std::vector<float>        normals;
+    std::vector<float>        uvs;
+    std::vector<unsigned int> indices;
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+    bool    castShadow = false;
+    bool    isOccluder = false;
+};
+
+// GL バッファの先頭 count 要素を読み戻す
+template <typename T>
+void ReadBuffer(unsigned int buffer, size_t count, std::vector<T>& out)
+{
+    out.resize(count);
+    if (count == 0 || buffer == 0) return;
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0,
+                       static_cast<GLsizeiptr>(count * sizeof(T)), out.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+} // namespace
+
+
+StaticBatcher::StaticBatcher()
+: mBatchCount(0)
+{
+}
+
+StaticBatcher::~StaticBatcher()
+{
+    // Actor はアプリ側が破棄するので、ここでは参照を切るだけ
+    for (auto actor : mBatchActors)
+    {
+        if (auto comp = actor->GetComponent<StaticBatchMeshComponent>())
+        {
+            comp->Detach();
+        }
+    }
+}
+
+void StaticBatcher::AddCandidate(MeshComponent* comp)
+{
+    if (std::find(mCandidates.begin(), mCandidates.end(), comp) == mCandidates.end())
+    {
+        mCandidates.push_back(comp);
+    }
+}
+
+void StaticBatcher::RemoveCandidate(MeshComponent* comp)
+{
+    mCandidates.erase(std::remove(mCandidates.begin(), mCandidates.end(), comp), mCandidates.end());
+
+    // まとめ済みなら戻す対象からも外す（形状はバッチに残る。作り直しで消える）
+    mBatchedComps.erase(std::remove(mBatchedComps.begin(), mBatchedComps.end(), comp), mBatchedComps.end());
+}
+
+//------------------------------------------------------------
+// GPU から読み戻し（VertexArray ごとに 1 回）
+//   位置 vec3 / 法線 vec3 / UV vec2 が別バッファの通常メッシュ前提
+//------------------------------------------------------------
+const StaticBatcher::SourceGeometry* StaticBatcher::ReadBack(VertexArray* va)
+{
+    auto iter = mGeometryCache.find(va);
+    if (iter != mGeometryCache.end())
+    {
+        return &iter->second;
+    }
+
+    if (va->GetVertexBuffer(0) == 0 || va->GetIndexBuffer() == 0)
+    {
+        return nullptr;
+    }
+
+    SourceGeometry& geo = mGeometryCache[va];
+    size_t numVerts = va->GetNumVerts();
+    ReadBuffer(va->GetVertexBuffer(0), numVerts * 3, geo.positions);
+    ReadBuffer(va->GetVertexBuffer(1), numVerts * 3, geo.normals);
+    ReadBuffer(va->GetVertexBuffer(2), numVerts * 2, geo.uvs);
+    ReadBuffer(va->GetIndexBuffer(),   va->GetNumIndices(), geo.indices);
+    return &geo;
+}
+
+//------------------------------------------------------------
+// Build
+//   1) 対象のサブメッシュを [セル][マテリアル][影][遮蔽物] で振り分け、
+//      頂点をワールドへ変換して連結
+//   2) バッチごとに Actor + MeshComponent + BoundingVolume を作る
+//   3) 元のコンポーネントを非表示にする
+//------------------------------------------------------------
+size_t StaticBatcher::Build(const StaticBatchSettings& settings)
+{
+    Clear();
+    if (mCandidates.empty()) return 0;
+
+    Application* app = mCandidates.front()->GetOwner()->GetApp();
+    float cellSize = std::max(settings.clusterSize, 1.0f);
+
+    std::map<BatchKey, BatchBuilder> builders;
+
+    for (auto comp : mCandidates)
+    {
+        auto mesh = comp->GetMesh();
+        if (!mesh || !comp->IsVisible()) continue;
+        if (comp->GetIsSkeletal() || comp->GetToon() || comp->IsBlendAdd()) continue;
+        if (comp->HasBakedLighting()) continue;
+        if (comp->GetLayer() != VisualLayer::Object3D) continue;
+
+        Actor* owner = comp->GetOwner();
+        Matrix4 world = owner->GetWorldTransform();
+        Vector3 origin = world.GetTranslation();
+
+        // 法線は逆行列の転置で変換する（非一様スケールで傾かないように）
+        //   w = 0 で変換するので平行移動の成分は効かない
+        Matrix4 inv = world;
+        inv.Invert();
+        Matrix4 normalMat = inv;
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                normalMat.mat[r][c] = inv.mat[c][r];
+            }
+        }
+        int cx = static_cast<int>(std::floor(origin.x / cellSize));
+        int cz = static_cast<int>(std::floor(origin.z / cellSize));
+
+        bool merged = false;
+        for (const auto& va : mesh->GetVertexArray())
+        {
+            const SourceGeometry* geo = ReadBack(va.get());
+            if (!geo || geo->positions.empty()) continue;
+
+            auto material = mesh->GetMaterial(va->GetTextureID());
+            BatchKey key(cx, cz, material.get(), comp->GetEnableShadow(), comp->IsOccluder());
+
+            auto found = builders.find(key);
+            bool isNew = (found == builders.end());
+            BatchBuilder& b = isNew ? builders[key] : found->second;
+            if (isNew)
+            {
+                b.material   = material;
+                b.castShadow = comp->GetEnableShadow();
+                b.isOccluder = comp->IsOccluder();
+                b.boundsMin  = Vector3(Math::Infinity, Math::Infinity, Math::Infinity);
+                b.boundsMax  = Vector3(-Math::Infinity, -Math::Infinity, -Math::Infinity);
+            }
+
+            unsigned int base = static_cast<unsigned int>(b.positions.size() / 3);
+            size_t numVerts = geo->positions.size() / 3;
+            for (size_t v = 0; v < numVerts; ++v)
+            {
+                Vector3 p(geo->positions[v * 3 + 0], geo->positions[v * 3 + 1], geo->positions[v * 3 + 2]);
+                Vector3 n(geo->normals[v * 3 + 0],   geo->normals[v * 3 + 1],   geo->normals[v * 3 + 2]);
+                p = Vector3::Transform(p, world);
+                n = Vector3::Transform(n, normalMat, 0.0f);
+                if (n.Length() > Math::NearZeroEpsilon) n.Normalize();
+
+                b.positions.insert(b.positions.end(), { p.x, p.y, p.z });
+                b.normals.insert(b.normals.end(), { n.x, n.y, n.z });
+                b.uvs.insert(b.uvs.end(), { geo->uvs[v * 2 + 0], geo->uvs[v * 2 + 1] });
+
+                b.boundsMin.x = std::min(b.boundsMin.x, p.x);
+                b.boundsMin.y = std::min(b.boundsMin.y, p.y);
+                b.boundsMin.z = std::min(b.boundsMin.z, p.z);
+                b.boundsMax.x = std::max(b.boundsMax.x, p.x);
+                b.boundsMax.y = std::max(b.boundsMax.y, p.y);
+                b.boundsMax.z = std::max(b.boundsMax.z, p.z);
+            }
+            for (unsigned int index : geo->indices)
+            {
+                b.indices.push_back(base + index);
+            }
+            merged = true;
+        }
+
+        if (merged)
+        {
+            mBatchedComps.push_back(comp);
+        }
+    }
+    mGeometryCache.clear();
+
+    //--------------------------------------------------------
+    // バッチ用 Actor の生成
+    //   同じセルのバッチは 1 つの Actor（= 1 つの AABB）にまとめ、
+    //   マテリアルごとのサブメッシュとして持たせる
+    //--------------------------------------------------------
+    struct CellKey
+    {
+        int  cx, cz;
+        bool castShadow, isOccluder;
+        bool operator<(const CellKey& o) const
+        {
+            return std::tie(cx, cz, castShadow, isOccluder) < std::tie(o.cx, o.cz, o.castShadow, o.isOccluder);
+        }
+    };
+    std::map<CellKey, StaticBatchMeshComponent*> cells;
+    std::map<StaticBatchMeshComponent*, std::pair<Vector3, Vector3>> bounds;
+
+    for (auto& entry : builders)
+    {
+        BatchBuilder& b = entry.second;
+        CellKey cellKey{ std::get<0>(entry.first), std::get<1>(entry.first), b.castShadow, b.isOccluder };
+
+        StaticBatchMeshComponent* comp = nullptr;
+        auto found = cells.find(cellKey);
+        if (found == cells.end())
+        {
+            Actor* actor = app->CreateActor<Actor>();
+            actor->SetActorID("StaticBatch");
+            actor->ComputeWorldTransform();
+            comp = actor->CreateComponent<StaticBatchMeshComponent>(&mBatchActors);
+            comp->SetMesh(std::make_shared<Mesh>());
+            comp->SetEnableShadow(b.castShadow);
+            comp->SetOccluder(b.isOccluder);
+            cells[cellKey] = comp;
+            bounds[comp]   = { b.boundsMin, b.boundsMax };
+            mBatchActors.push_back(actor);
+        }
+        else
+        {
+            comp = found->second;
+            auto& bb = bounds[comp];
+            bb.first.x  = std::min(bb.first.x,  b.boundsMin.x);
+            bb.first.y  = std::min(bb.first.y,  b.boundsMin.y);
+            bb.first.z  = std::min(bb.first.z,  b.boundsMin.z);
+            bb.second.x = std::max(bb.second.x, b.boundsMax.x);
+            bb.second.y = std::max(bb.second.y, b.boundsMax.y);
+            bb.second.z = std::max(bb.second.z, b.boundsMax.z);
+        }
+
+        auto va = std::make_shared<VertexArray>(
+            static_cast<unsigned int>(b.positions.size() / 3),
+            b.positions.data(), b.normals.data(), b.uvs.data(),
+            static_cast<unsigned int>(b.indices.size()), b.indices.data());
+        comp->GetMesh()->AddSubMesh(va, b.material);
+        ++mBatchCount;
+    }
+
+    for (auto& entry : bounds)
+    {
+        Actor* actor = entry.first->GetOwner();
+        auto bv = actor->CreateComponent<BoundingVolumeComponent>();
+        bv->ComputeBoundingVolume(entry.second.first, entry.second.second);
+    }
+
+    // まとめた元は描かない
+    for (auto comp : mBatchedComps)
+    {
+        comp->SetVisible(false);
+    }
+
+    std::cout << "StaticBatcher: " << mBatchedComps.size() << " components -> "
+              << mBatchCount << " batches in " << mBatchActors.size() << " clusters" << std::endl;
+    return mBatchCount;
+}
+
+void StaticBatcher::Clear()
+{
+    for (auto comp : mBatchedComps)
+    {
+        comp->SetVisible(true);
+    }
+    mBatchedComps.clear();
+
+    for (auto actor : mBatchActors)
+    {
+        if (auto comp = actor->GetComponent<StaticBatchMeshComponent>())
+        {
+            comp->Detach();
+        }
+        actor->GetApp()->DestroyActor(actor);
+    }
+    mBatchActors.clear();
+    mBatchCount = 0;
+}
+
+} // namespace toy
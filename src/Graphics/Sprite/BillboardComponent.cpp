@@ -6,6 +6,7 @@
 #include "Engine/Core/Application.h"
 #include "Engine/Core/Actor.h"
 #include "Engine/Render/Renderer.h"
+#include "Asset/Material/Material.h"
 #include "glad/glad.h"
 
 namespace toy {
@@ -15,7 +16,8 @@ BillboardComponent::BillboardComponent(class Actor* a, int drawOrder)
 , mScale(1.0f)
 {
     // メッシュ用シェーダーを流用（板ポリをメッシュ扱いで描画）
-    mShader = GetOwner()->GetApp()->GetRenderer()->GetShader("Mesh");
+    //   影は受けないのでフォグのみのバリアントを使う
+    mShader = GetOwner()->GetApp()->GetRenderer()->GetShaderVariant("Phong", SF_FOG);
 }
 
 BillboardComponent::~BillboardComponent()
@@ -104,6 +106,9 @@ void BillboardComponent::Draw()
     // ビュー・プロジェクション行列
     mShader->SetMatrixUniform("uViewProj", view * proj);
 
+    // マテリアル（スペキュラー等は既定値）
+    renderer->GetDefaultMaterial()->Bind(renderer->GetMaterialBuffer());
+
     // テクスチャ
     mTexture->SetActive(0);
     mShader->SetTextureUniform("uTexture", 0);
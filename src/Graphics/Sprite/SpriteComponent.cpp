@@ -8,6 +8,9 @@
 #include "Engine/Core/Actor.h"
 #include "glad/glad.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace toy {
 
 //==================================================
@@ -24,6 +27,8 @@ SpriteComponent::SpriteComponent(Actor* a, int drawOrder, VisualLayer layer)
 , mTexWidth(0)
 , mTexHeight(0)
 , mIsTopLeft(true)
+, mLastIsBlendAdd(false)
+, mIsUIDirty(true)
 {
     mDrawOrder = drawOrder;
 
@@ -57,58 +62,30 @@ void SpriteComponent::SetTexture(std::shared_ptr<Texture> tex)
         mTexWidth  = 0;
         mTexHeight = 0;
     }
+    mIsUIDirty = true;
 }
 
 //--------------------------------------------------
-// 描画
-//  ・Sprite は 2D なので深度テストを無効化
+// 画面上の配置
 //  ・Virtual 解像度 → 実解像度へのスケールで等倍表示を調整
 //--------------------------------------------------
-void SpriteComponent::Draw()
+void SpriteComponent::ComputePlacement(const UIScaleInfo& ui, Vector3& pos, float& width, float& height) const
 {
-    if (!mIsVisible || mTexture == nullptr)
-    {
-        return;
-    }
-
-    //==============================
-    // ブレンド/深度設定
-    //==============================
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glEnable(GL_BLEND);
-    glBlendFunc(
-        mIsBlendAdd ? GL_ONE : GL_SRC_ALPHA,
-        mIsBlendAdd ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA
-    );
-    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-
-    auto* renderer = GetOwner()->GetApp()->GetRenderer();
-
-    //==============================
-    // 画面サイズと Virtual 解像度（Renderer に計算させる）
-    //==============================
-    UIScaleInfo ui = renderer->GetUIScaleInfo();
-
     float sw    = ui.screenW;    // 物理解像度（ピクセル）
     float sh    = ui.screenH;
-    float vw    = ui.virtualW;   // 論理解像度
-    float vh    = ui.virtualH;
     float scale = ui.scale;      // 論理→物理の共通スケール
 
     //==============================
     // テクスチャサイズと表示サイズ（ピクセルベース）
     //==============================
-    float texW   = static_cast<float>(mTexWidth);
-    float texH   = static_cast<float>(mTexHeight);
-    float width  = texW * mScaleWidth  * scale;
-    float height = texH * mScaleHeight * scale;
+    float texW = static_cast<float>(mTexWidth);
+    float texH = static_cast<float>(mTexHeight);
+    width  = texW * mScaleWidth  * scale;
+    height = texH * mScaleHeight * scale;
 
     //==============================
     // 描画位置の決定
     //==============================
-    Vector3 pos;
-
     if (mIsTopLeft)
     {
         // 論理座標（左上原点 / 右+ / 下+）
@@ -145,6 +122,107 @@ void SpriteComponent::Draw()
         pos.y *= scale;
         // pos.z はそのまま
     }
+}
+
+UIRect SpriteComponent::ComputeScreenRect() const
+{
+    if (!mIsVisible || mTexture == nullptr)
+    {
+        return UIRect();
+    }
+
+    UIScaleInfo ui = GetOwner()->GetApp()->GetRenderer()->GetUIScaleInfo();
+
+    Vector3 pos;
+    float width, height;
+    ComputePlacement(ui, pos, width, height);
+
+    float x0 = pos.x + ui.screenW * 0.5f - width  * 0.5f;
+    float y0 = pos.y + ui.screenH * 0.5f - height * 0.5f;
+
+    UIRect rect;
+    rect.x = static_cast<int>(std::floor(x0)) - 1;
+    rect.y = static_cast<int>(std::floor(y0)) - 1;
+    rect.w = static_cast<int>(std::ceil(x0 + width))  + 1 - rect.x;
+    rect.h = static_cast<int>(std::ceil(y0 + height)) + 1 - rect.y;
+    return rect;
+}
+
+//--------------------------------------------------
+// 保持モード UI の変化判定
+//  ・変化があれば前回と今回の矩形の和を返す（移動・縮小でも跡が残らない）
+//--------------------------------------------------
+UIChange SpriteComponent::CheckUIChange(UIRect& outRect) const
+{
+    UIRect rect = ComputeScreenRect();
+    if (!mIsUIDirty && rect == mLastUIRect && mIsBlendAdd == mLastIsBlendAdd)
+    {
+        return UIChange::None;
+    }
+
+    if (mLastUIRect.IsEmpty())
+    {
+        outRect = rect;
+    }
+    else if (rect.IsEmpty())
+    {
+        outRect = mLastUIRect;
+    }
+    else
+    {
+        int x0 = std::min(rect.x, mLastUIRect.x);
+        int y0 = std::min(rect.y, mLastUIRect.y);
+        int x1 = std::max(rect.x + rect.w, mLastUIRect.x + mLastUIRect.w);
+        int y1 = std::max(rect.y + rect.h, mLastUIRect.y + mLastUIRect.h);
+        outRect = UIRect{ x0, y0, x1 - x0, y1 - y0 };
+    }
+    return outRect.IsEmpty() ? UIChange::None : UIChange::Rect;
+}
+
+//--------------------------------------------------
+// 描画
+//  ・Sprite は 2D なので深度テストを無効化
+//  ・アルファは乗算済みで積む（保持モード UI のキャッシュへ描いても
+//    合成後の見た目が直接描いた場合と同じになるように）
+//--------------------------------------------------
+void SpriteComponent::Draw()
+{
+    if (!mIsVisible || mTexture == nullptr)
+    {
+        mLastUIRect = UIRect();
+        mIsUIDirty  = false;
+        return;
+    }
+
+    //==============================
+    // ブレンド/深度設定
+    //==============================
+    glDisable(GL_DEPTH_TEST);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    if (mIsBlendAdd)
+    {
+        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE);
+    }
+    else
+    {
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    auto* renderer = GetOwner()->GetApp()->GetRenderer();
+
+    //==============================
+    // 画面サイズと Virtual 解像度（Renderer に計算させる）
+    //==============================
+    UIScaleInfo ui = renderer->GetUIScaleInfo();
+
+    //==============================
+    // 表示位置とサイズ
+    //==============================
+    Vector3 pos;
+    float width, height;
+    ComputePlacement(ui, pos, width, height);
 
     //==============================
     // ワールド・ビュー射影行列
@@ -153,7 +231,7 @@ void SpriteComponent::Draw()
     world *= Matrix4::CreateTranslation(pos);
 
     // 2D 用の ViewProj（中心原点 / 右+ / 上+）
-    Matrix4 viewProj = Matrix4::CreateSimpleViewProj(sw, sh);
+    Matrix4 viewProj = Matrix4::CreateSimpleViewProj(ui.screenW, ui.screenH);
 
     //==============================
     // シェーダー・テクスチャ設定
@@ -174,7 +252,13 @@ void SpriteComponent::Draw()
     mVertexArray->SetActive();
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
 
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_TRUE);
+
+    // 保持モード UI の比較用
+    mLastUIRect     = ComputeScreenRect();
+    mLastIsBlendAdd = mIsBlendAdd;
+    mIsUIDirty      = false;
 }
 } // namespace toy
@@ -14,6 +14,8 @@ VisualComponent::VisualComponent(Actor* owner, int drawOrder, VisualLayer layer)
 , mLayer(layer)          // 描画レイヤー
 , mDrawOrder(drawOrder)  // レイヤー内の描画順
 , mEnableShadow(false)   // 影を描かない（必要に応じて有効化）
+, mIsOccluder(false)     // 遮蔽物にはしない（大きな壁・建物などで有効化）
+, mIsOccluderHull(false)
 {
     // ------------------------------------------------------------
     // Renderer に登録
@@ -42,4 +44,37 @@ VisualComponent::~VisualComponent()
     renderer->RemoveVisualComp(this);
 }
 
+// ------------------------------------------------------------
+// レイヤー／描画順の変更
+//   Renderer はレイヤー別・描画順に並べて保持しているので、
+//   一度解除してから登録し直す（反映は次の描画の頭）。
+// ------------------------------------------------------------
+void VisualComponent::SetLayer(VisualLayer layer)
+{
+    if (layer == mLayer) return;
+
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    renderer->RemoveVisualComp(this);
+    mLayer = layer;
+    renderer->AddVisualComp(this);
+}
+
+void VisualComponent::SetDrawOrder(int order)
+{
+    if (order == mDrawOrder) return;
+
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    renderer->RemoveVisualComp(this);
+    mDrawOrder = order;
+    renderer->AddVisualComp(this);
+}
+
+// ------------------------------------------------------------
+// 半透明ソート用の位置
+// ------------------------------------------------------------
+Vector3 VisualComponent::GetSortPosition() const
+{
+    return GetOwner()->GetWorldTransform().GetTranslation();
+}
+
 } // namespace toy
@@ -1,12 +1,10 @@
 #include "Physics/BoundingVolumeComponent.h"
-#include "Graphics/Effect/WireframeComponent.h"
 #include "Engine/Core/Actor.h"
 #include "Asset/Geometry/Polygon.h"
 #include "Asset/Geometry/VertexArray.h"
-#include "Engine/Render/Shader.h"
 #include "Engine/Core/Application.h"
 #include "Engine/Render/Renderer.h"
-#include "Asset/Material/Texture.h"
+#include "Engine/Render/DebugDraw.h"
 
 #include <vector>
 #include <algorithm>
@@ -18,7 +16,6 @@ namespace toy {
 //------------------------------------------------------------------------------
 // コンストラクタ
 // ・AABB / OBB / Polygon を初期化
-// ・デバッグモード時はワイヤーフレーム用コンポーネントを生成
 //------------------------------------------------------------------------------
 BoundingVolumeComponent::BoundingVolumeComponent(Actor* a)
 : Component(a)
@@ -27,14 +24,6 @@ BoundingVolumeComponent::BoundingVolumeComponent(Actor* a)
     mBoundingBox = std::make_shared<Cube>();
     mObb         = std::make_shared<OBB>();
     mPolygons.reset(new Polygon[NUM_VERTEX]);
-    
-    // デバッグ時のみワイヤーフレームを生成して可視化
-    if (GetOwner()->GetApp()->GetRenderer()->IsDebugMode())
-    {
-        mWireframe = std::make_unique<WireframeComponent>(GetOwner(), 1000);
-        Vector3 color = GetOwner()->GetApp()->GetRenderer()->GetWireColor();
-        mWireframe->SetColor(color);
-    }
 }
 
 //------------------------------------------------------------------------------
@@ -44,6 +33,23 @@ BoundingVolumeComponent::~BoundingVolumeComponent()
 {
 }
 
+//------------------------------------------------------------------------------
+// Update
+// ・デバッグモード時のみ、ローカル AABB をワールド行列で変換したボックスを
+//   DebugDraw に積む（描画はフレーム末にまとめて 1 回）
+//------------------------------------------------------------------------------
+void BoundingVolumeComponent::Update(float deltaTime)
+{
+    auto renderer = GetOwner()->GetApp()->GetRenderer();
+    DebugDraw* debug = renderer->GetDebugDraw();
+    if (!debug || !debug->IsEnabled()) return;
+    
+    debug->AddBox(mBoundingBox->min,
+                  mBoundingBox->max,
+                  GetOwner()->GetWorldTransform(),
+                  renderer->GetWireColor());
+}
+
 //------------------------------------------------------------------------------
 // OnUpdateWorldTransform
 // ・アクターのワールド変換が更新されたタイミングで呼ばれる。
@@ -86,7 +92,7 @@ void BoundingVolumeComponent::OnUpdateWorldTransform()
 //------------------------------------------------------------------------------
 // ComputeBoundingVolume（VA から生成）
 // ・複数 VertexArray のポリゴン群からローカル AABB を計算。
-// ・その後、デバッグ用の VAO とポリゴン配列を生成する。
+// ・その後、ポリゴン配列を生成する。
 //------------------------------------------------------------------------------
 void BoundingVolumeComponent::ComputeBoundingVolume(const std::vector<std::shared_ptr<VertexArray>> va)
 {
@@ -107,8 +113,7 @@ void BoundingVolumeComponent::ComputeBoundingVolume(const std::vector<std::share
         }
     }
     
-    // デバッグ用の VAO と、AABB からのポリゴン配列を生成
-    CreateVArray();
+    // AABB からのポリゴン配列を生成
     CreatePolygons();
 }
 
@@ -162,7 +167,6 @@ void BoundingVolumeComponent::ComputeBoundingVolume(const Vector3& min, const Ve
     mBoundingBox->min = min;
     mBoundingBox->max = max;
     
-    CreateVArray();
     CreatePolygons();
 }
 
@@ -185,62 +189,9 @@ void BoundingVolumeComponent::AdjustBoundingBox(const Vector3& pos, const Vector
     mBoundingBox->max.z *= sc.z;
     mBoundingBox->min.z *= sc.z;
     
-    CreateVArray();
     CreatePolygons();
 }
 
-//------------------------------------------------------------------------------
-// CreateVArray
-// ・AABB をもとにボックス用頂点バッファを作り、デバッグ用 VAO を生成。
-// ・WireframeComponent に渡すことで境界ボックスを可視化する。
-//------------------------------------------------------------------------------
-void BoundingVolumeComponent::CreateVArray()
-{
-    // ボックス用頂点バッファ（座標、法線、UV）
-    float verts[] =
-    {
-        mBoundingBox->min.x, mBoundingBox->min.y, mBoundingBox->min.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, // 0
-        mBoundingBox->min.x, mBoundingBox->max.y, mBoundingBox->min.z, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, // 1
-        mBoundingBox->max.x, mBoundingBox->min.y, mBoundingBox->min.z, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, // 2
-        mBoundingBox->max.x, mBoundingBox->max.y, mBoundingBox->min.z, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, // 3
-        mBoundingBox->max.x, mBoundingBox->min.y, mBoundingBox->max.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, // 4
-        mBoundingBox->max.x, mBoundingBox->max.y, mBoundingBox->max.z, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, // 5
-        mBoundingBox->min.x, mBoundingBox->min.y, mBoundingBox->max.z, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, // 6
-        mBoundingBox->min.x, mBoundingBox->max.y, mBoundingBox->max.z, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f  // 7
-    };
-    
-    unsigned int index[] =
-    {
-        0, 1, 3,
-        3, 2, 0,
-        
-        4, 2, 3,
-        3, 5, 4,
-        
-        5, 4, 6,
-        6, 7, 5,
-        
-        0, 6, 7,
-        7, 1, 0,
-        
-        3, 1, 7,
-        7, 5, 3,
-        
-        2, 4, 6,
-        6, 0, 2
-    };
-    
-    if (mWireframe)
-    {
-        mWireframe->SetVertexArray(
-            std::make_shared<VertexArray>(
-                verts,
-                8,
-                (unsigned int*)index,
-                (unsigned int)36));
-    }
-}
-
 //------------------------------------------------------------------------------
 // GetWorldAABB
 // ・スケールと位置を反映した「ワールド空間の AABB」を返す。
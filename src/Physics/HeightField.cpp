@@ -0,0 +1,155 @@
+#include "Physics/HeightField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace toy {
+
+HeightField::HeightField()
+: mWidth(0)
+, mDepth(0)
+, mOrigin(Vector3::Zero)
+, mCellSize(1.0f)
+, mHeightScale(1.0f)
+{
+}
+
+//------------------------------------------------------------------------------
+// LoadRaw16
+//------------------------------------------------------------------------------
+// ・ヘッダなし 16bit（リトルエンディアン）を width x depth 個読み込む。
+// ・ファイルサイズが合わない場合は失敗とする。
+//------------------------------------------------------------------------------
+bool HeightField::LoadRaw16(const std::string& filePath, int width, int depth)
+{
+    if (width < 2 || depth < 2)
+    {
+        std::cerr << "[HeightField] Invalid size: " << width << "x" << depth << std::endl;
+        return false;
+    }
+
+    std::ifstream ifs(filePath, std::ios::binary | std::ios::ate);
+    if (!ifs)
+    {
+        std::cerr << "[HeightField] Failed to open: " << filePath << std::endl;
+        return false;
+    }
+
+    const size_t count = static_cast<size_t>(width) * depth;
+    const std::streamsize expected = static_cast<std::streamsize>(count * 2);
+    if (ifs.tellg() != expected)
+    {
+        std::cerr << "[HeightField] Size mismatch: " << filePath
+                  << " (expected " << expected << " bytes)" << std::endl;
+        return false;
+    }
+    ifs.seekg(0);
+
+    std::vector<unsigned char> bytes(static_cast<size_t>(expected));
+    ifs.read(reinterpret_cast<char*>(bytes.data()), expected);
+    if (!ifs)
+    {
+        std::cerr << "[HeightField] Failed to read: " << filePath << std::endl;
+        return false;
+    }
+
+    // ホストのエンディアンに依存しないよう 1 バイトずつ組み立てる
+    mSamples.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        mSamples[i] = static_cast<uint16_t>(bytes[i * 2] | (bytes[i * 2 + 1] << 8));
+    }
+    mWidth = width;
+    mDepth = depth;
+    return true;
+}
+
+void HeightField::SetPlacement(const Vector3& origin, float cellSize, float heightScale)
+{
+    mOrigin      = origin;
+    mCellSize    = (cellSize > 0.0f) ? cellSize : 1.0f;
+    mHeightScale = heightScale;
+}
+
+//------------------------------------------------------------------------------
+// 高さ問い合わせ
+//------------------------------------------------------------------------------
+bool HeightField::Contains(float x, float z) const
+{
+    if (!IsValid()) return false;
+
+    float lx = x - mOrigin.x;
+    float lz = z - mOrigin.z;
+    return lx >= 0.0f && lz >= 0.0f && lx <= GetSizeX() && lz <= GetSizeZ();
+}
+
+float HeightField::GetSampleHeight(int ix, int iz) const
+{
+    ix = std::clamp(ix, 0, mWidth - 1);
+    iz = std::clamp(iz, 0, mDepth - 1);
+    float s = mSamples[static_cast<size_t>(iz) * mWidth + ix] / 65535.0f;
+    return mOrigin.y + s * mHeightScale;
+}
+
+// GPU 側（R16 テクスチャの LINEAR サンプリング）と同じ双線形補間
+float HeightField::GetHeight(float x, float z) const
+{
+    if (!IsValid()) return mOrigin.y;
+
+    float gx = Math::Clamp((x - mOrigin.x) / mCellSize, 0.0f, static_cast<float>(mWidth - 1));
+    float gz = Math::Clamp((z - mOrigin.z) / mCellSize, 0.0f, static_cast<float>(mDepth - 1));
+
+    int   ix = static_cast<int>(gx);
+    int   iz = static_cast<int>(gz);
+    float fx = gx - ix;
+    float fz = gz - iz;
+
+    float h00 = GetSampleHeight(ix,     iz);
+    float h10 = GetSampleHeight(ix + 1, iz);
+    float h01 = GetSampleHeight(ix,     iz + 1);
+    float h11 = GetSampleHeight(ix + 1, iz + 1);
+
+    float h0 = h00 + (h10 - h00) * fx;
+    float h1 = h01 + (h11 - h01) * fx;
+    return h0 + (h1 - h0) * fz;
+}
+
+Vector3 HeightField::GetNormal(float x, float z) const
+{
+    float hL = GetHeight(x - mCellSize, z);
+    float hR = GetHeight(x + mCellSize, z);
+    float hD = GetHeight(x, z - mCellSize);
+    float hU = GetHeight(x, z + mCellSize);
+
+    Vector3 n(hL - hR, 2.0f * mCellSize, hD - hU);
+    n.Normalize();
+    return n;
+}
+
+void HeightField::GetRangeMinMax(int ix0, int iz0, int ix1, int iz1,
+                                 float& outMin, float& outMax) const
+{
+    ix0 = std::clamp(ix0, 0, mWidth - 1);
+    ix1 = std::clamp(ix1, 0, mWidth - 1);
+    iz0 = std::clamp(iz0, 0, mDepth - 1);
+    iz1 = std::clamp(iz1, 0, mDepth - 1);
+
+    uint16_t lo = 0xFFFF;
+    uint16_t hi = 0;
+    for (int iz = iz0; iz <= iz1; ++iz)
+    {
+        const uint16_t* row = &mSamples[static_cast<size_t>(iz) * mWidth];
+        for (int ix = ix0; ix <= ix1; ++ix)
+        {
+            lo = std::min(lo, row[ix]);
+            hi = std::max(hi, row[ix]);
+        }
+    }
+
+    outMin = mOrigin.y + lo / 65535.0f * mHeightScale;
+    outMax = mOrigin.y + hi / 65535.0f * mHeightScale;
+}
+
+} // namespace toy
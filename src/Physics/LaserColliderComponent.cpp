@@ -1,5 +1,8 @@
 #include "Physics/LaserColliderComponent.h"
 #include "Engine/Core/Actor.h"
+#include "Engine/Core/Application.h"
+#include "Engine/Render/Renderer.h"
+#include "Engine/Render/DebugDraw.h"
 
 namespace toy {
 
@@ -32,4 +35,20 @@ Ray LaserColliderComponent::GetRay() const
     return Ray(start, dir);
 }
 
+//------------------------------------------------------------------------------
+// Update
+//------------------------------------------------------------------------------
+// ・デバッグモード時のみ、射程 mLength 分のレイを DebugDraw に積む。
+//------------------------------------------------------------------------------
+void LaserColliderComponent::Update(float deltaTime)
+{
+    ColliderComponent::Update(deltaTime);
+    
+    DebugDraw* debug = GetOwner()->GetApp()->GetRenderer()->GetDebugDraw();
+    if (!debug || !debug->IsEnabled()) return;
+    
+    Ray ray = GetRay();
+    debug->AddRay(ray.start, ray.dir, mLength, Vector3(1.0f, 0.2f, 0.2f));
+}
+
 } // namespace toy
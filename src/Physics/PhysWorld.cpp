@@ -6,6 +6,7 @@
 #include "Physics/BoundingVolumeComponent.h"
 #include "Asset/Geometry/Polygon.h"
 #include "Physics/ColliderComponent.h"
+#include "Physics/HeightField.h"
 #include "Movement/MoveComponent.h"
 #include "Utils/MathUtil.h"
 
@@ -14,6 +15,7 @@
 namespace toy {
 
 PhysWorld::PhysWorld()
+: mHeightField(nullptr)
 {
 }
 
@@ -473,12 +475,19 @@ bool PhysWorld::GetNearestGroundY(const Actor* a, float& outY) const
 //------------------------------------------------------------------------------
 // GetGroundHeightAt
 //------------------------------------------------------------------------------
-// ・XZ 座標 pos を与えて、TerrainPolygon ベースの地表高さを返す。
-// ・該当ポリゴンがない場合は -∞ に近い値を返す（呼び出し側で扱う）。
+// ・XZ 座標 pos を与えて、TerrainPolygon／HeightField の地表高さを返す。
+// ・該当するものがない場合は -∞ に近い値を返す（呼び出し側で扱う）。
 //------------------------------------------------------------------------------
 float PhysWorld::GetGroundHeightAt(const Vector3& pos) const
 {
     float highestY = -std::numeric_limits<float>::max();
+    
+    // ハイトフィールドは格子から直接引く（ポリゴン走査なし）
+    if (mHeightField && mHeightField->Contains(pos.x, pos.z))
+    {
+        highestY = mHeightField->GetHeight(pos.x, pos.z);
+    }
+    
     for (const auto& poly : mTerrainPolygons)
     {
         if (IsInPolygon(&poly, pos))
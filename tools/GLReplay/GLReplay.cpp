@@ -0,0 +1,770 @@
+//=============================================================
+// GLReplay
+// ・GLRecorder（Renderer::CaptureGLFrames）で書き出したキャプチャを
+//   非表示ウィンドウの GL コンテキストで N 回再生し、フレームごとの時間を出す
+// ・ゲーム側のコードは一切使わない（シーン更新や可視判定を除いた、
+//   純粋な GL コマンドのコスト＝ドライバ＋GPU を測る）
+//
+// 使い方
+//   GLReplay <capture.tglc> [繰り返し回数=100] [幅=1280] [高さ=720]
+//
+// ビルド
+//   ToyLib と同じインクルードパス（include / External / External/glad/include）で、
+//   External/glad/src/glad.c と SDL3 をリンクする
+//=============================================================
+#include "Engine/Render/GLCaptureFormat.h"
+#include "glad/glad.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using toy::GLCapture::Op;
+using toy::GLCapture::Reader;
+using toy::GLCapture::UniformKind;
+
+namespace {
+
+//-------------------------------------------------------------
+// キャプチャの再生
+//   ・記録時の GL 名 → 再生側で作り直した名前 の対応を種類ごとに持つ
+//   ・uniform は名前から location を引き直す（プログラムごとにキャッシュ）
+//-------------------------------------------------------------
+class Replayer
+{
+public:
+    using NameMap = std::unordered_map<uint32_t, GLuint>;
+
+    bool Load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "GLReplay: failed to open " << path << std::endl;
+            return false;
+        }
+        file.read(reinterpret_cast<char*>(&mHeader), sizeof(mHeader));
+        if (!file || mHeader.magic != toy::GLCapture::kMagic || mHeader.version != toy::GLCapture::kVersion)
+        {
+            std::cerr << "GLReplay: not a capture file (or version mismatch): " << path << std::endl;
+            return false;
+        }
+        mData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    uint32_t GetFrameCount() const { return mHeader.frameCount; }
+    size_t   GetDataSize()   const { return mData.size(); }
+
+    // セットアップ部を実行し、各フレームの先頭位置を調べる
+    bool RunSetup()
+    {
+        Reader r(mData.data(), mData.size());
+        if (Execute(r) != Op::EndSetup)
+        {
+            std::cerr << "GLReplay: setup section is broken" << std::endl;
+            return false;
+        }
+
+        // フレームの区切りを探すため、1 回通して実行する（ウォームアップを兼ねる）
+        mFrameBegin.clear();
+        while (!r.IsEnd())
+        {
+            size_t begin = r.GetPos();
+            if (Execute(r) != Op::EndFrame) break;
+            mFrameBegin.push_back(begin);
+        }
+        glFinish();
+
+        if (mFrameBegin.empty())
+        {
+            std::cerr << "GLReplay: no frames in capture" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    size_t GetReplayableFrames() const { return mFrameBegin.size(); }
+
+    void RunFrame(size_t index)
+    {
+        Reader r(mData.data() + mFrameBegin[index], mData.size() - mFrameBegin[index]);
+        Execute(r);
+    }
+
+private:
+    static GLuint Find(const NameMap& map, uint32_t name)
+    {
+        if (name == 0) return 0;
+        auto iter = map.find(name);
+        return (iter != map.end()) ? iter->second : 0;
+    }
+
+    template <typename GenFunc>
+    static void Gen(NameMap& map, uint32_t name, GenFunc gen)
+    {
+        GLuint id = 0;
+        gen(1, &id);
+        map[name] = id;
+    }
+
+    template <typename DeleteFunc>
+    static void Delete(NameMap& map, uint32_t name, DeleteFunc del)
+    {
+        auto iter = map.find(name);
+        if (iter == map.end()) return;
+        del(1, &iter->second);
+        map.erase(iter);
+    }
+
+    static const void* Offset(uint64_t offset)
+    {
+        return reinterpret_cast<const void*>(static_cast<uintptr_t>(offset));
+    }
+
+    GLint UniformLocation(const std::string& name)
+    {
+        auto& cache = mLocations[mCurrentProgram];
+        auto iter = cache.find(name);
+        if (iter != cache.end()) return iter->second;
+
+        GLint location = glGetUniformLocation(mCurrentProgram, name.c_str());
+        cache[name] = location;
+        return location;
+    }
+
+    //---------------------------------------------------------
+    // EndSetup / EndFrame まで実行し、止まったコマンドを返す
+    //   （途中で壊れていたら EndSetup / EndFrame 以外を返す）
+    //---------------------------------------------------------
+    Op Execute(Reader& r)
+    {
+        while (!r.IsEnd())
+        {
+            Op op = r.GetOp();
+            if (!r.IsValid()) break;
+
+            switch (op)
+            {
+            case Op::EndSetup:
+            case Op::EndFrame:
+                return op;
+
+            // オブジェクト
+            case Op::GenBuffer:               Gen(mBuffers, r.Get<uint32_t>(), glGenBuffers); break;
+            case Op::DeleteBuffer:            Delete(mBuffers, r.Get<uint32_t>(), glDeleteBuffers); break;
+            case Op::GenTexture:              Gen(mTextures, r.Get<uint32_t>(), glGenTextures); break;
+            case Op::DeleteTexture:           Delete(mTextures, r.Get<uint32_t>(), glDeleteTextures); break;
+            case Op::GenVertexArray:          Gen(mVertexArrays, r.Get<uint32_t>(), glGenVertexArrays); break;
+            case Op::DeleteVertexArray:       Delete(mVertexArrays, r.Get<uint32_t>(), glDeleteVertexArrays); break;
+            case Op::GenFramebuffer:          Gen(mFramebuffers, r.Get<uint32_t>(), glGenFramebuffers); break;
+            case Op::DeleteFramebuffer:       Delete(mFramebuffers, r.Get<uint32_t>(), glDeleteFramebuffers); break;
+            case Op::GenRenderbuffer:         Gen(mRenderbuffers, r.Get<uint32_t>(), glGenRenderbuffers); break;
+            case Op::DeleteRenderbuffer:      Delete(mRenderbuffers, r.Get<uint32_t>(), glDeleteRenderbuffers); break;
+            case Op::GenTransformFeedback:    Gen(mTransformFeedbacks, r.Get<uint32_t>(), glGenTransformFeedbacks); break;
+            case Op::DeleteTransformFeedback: Delete(mTransformFeedbacks, r.Get<uint32_t>(), glDeleteTransformFeedbacks); break;
+
+            case Op::CreateShader:
+            {
+                GLenum   type = r.Get<uint32_t>();
+                uint32_t name = r.Get<uint32_t>();
+                mShaders[name] = glCreateShader(type);
+                break;
+            }
+            case Op::DeleteShader:
+            {
+                uint32_t name = r.Get<uint32_t>();
+                glDeleteShader(Find(mShaders, name));
+                mShaders.erase(name);
+                break;
+            }
+            case Op::CreateProgram:
+                mPrograms[r.Get<uint32_t>()] = glCreateProgram();
+                break;
+            case Op::DeleteProgram:
+            {
+                uint32_t name = r.Get<uint32_t>();
+                GLuint program = Find(mPrograms, name);
+                glDeleteProgram(program);
+                mLocations.erase(program);
+                mPrograms.erase(name);
+                break;
+            }
+
+            // シェーダ・プログラム
+            case Op::ShaderSource:
+            {
+                GLuint shader = Find(mShaders, r.Get<uint32_t>());
+                std::string source = r.GetString();
+                const char* text = source.c_str();
+                glShaderSource(shader, 1, &text, nullptr);
+                break;
+            }
+            case Op::CompileShader:
+            {
+                GLuint shader = Find(mShaders, r.Get<uint32_t>());
+                glCompileShader(shader);
+                GLint ok = GL_FALSE;
+                glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+                if (!ok)
+                {
+                    char log[1024];
+                    glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+                    std::cerr << "GLReplay: shader compile failed: " << log << std::endl;
+                }
+                break;
+            }
+            case Op::AttachShader:
+            {
+                GLuint program = Find(mPrograms, r.Get<uint32_t>());
+                GLuint shader  = Find(mShaders, r.Get<uint32_t>());
+                glAttachShader(program, shader);
+                break;
+            }
+            case Op::TransformFeedbackVaryings:
+            {
+                GLuint  program = Find(mPrograms, r.Get<uint32_t>());
+                GLenum  mode    = r.Get<uint32_t>();
+                int32_t count   = r.Get<int32_t>();
+                std::vector<std::string> names;
+                std::vector<const char*> ptrs;
+                for (int32_t i = 0; i < count; ++i) names.push_back(r.GetString());
+                for (auto& n : names) ptrs.push_back(n.c_str());
+                glTransformFeedbackVaryings(program, count, ptrs.data(), mode);
+                break;
+            }
+            case Op::LinkProgram:
+            {
+                GLuint program = Find(mPrograms, r.Get<uint32_t>());
+                glLinkProgram(program);
+                mLocations.erase(program);
+                GLint ok = GL_FALSE;
+                glGetProgramiv(program, GL_LINK_STATUS, &ok);
+                if (!ok)
+                {
+                    char log[1024];
+                    glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+                    std::cerr << "GLReplay: program link failed: " << log << std::endl;
+                }
+                break;
+            }
+            case Op::UseProgram:
+                mCurrentProgram = Find(mPrograms, r.Get<uint32_t>());
+                glUseProgram(mCurrentProgram);
+                break;
+            case Op::UniformBlockBinding:
+            {
+                GLuint      program = Find(mPrograms, r.Get<uint32_t>());
+                std::string name    = r.GetString();
+                GLuint      binding = r.Get<uint32_t>();
+                GLuint index = glGetUniformBlockIndex(program, name.c_str());
+                if (index != GL_INVALID_INDEX) glUniformBlockBinding(program, index, binding);
+                break;
+            }
+            case Op::Uniform:
+            {
+                UniformKind kind      = static_cast<UniformKind>(r.Get<uint8_t>());
+                std::string name      = r.GetString();
+                int32_t     count     = r.Get<int32_t>();
+                GLboolean   transpose = r.Get<uint8_t>();
+                size_t      size      = 0;
+                const uint8_t* data   = r.GetBytes(size);
+
+                GLint location = UniformLocation(name);
+                if (location < 0 || !data) break;
+
+                // 埋め込みデータは境界が揃っていないので写してから渡す
+                float values[16 * 64];
+                size = std::min(size, sizeof(values));
+                std::memcpy(values, data, size);
+                switch (kind)
+                {
+                case UniformKind::Int1:
+                {
+                    GLint v = 0;
+                    std::memcpy(&v, values, sizeof(v));
+                    glUniform1i(location, v);
+                    break;
+                }
+                case UniformKind::Float1:  glUniform1f(location, values[0]); break;
+                case UniformKind::Float2:  glUniform2fv(location, count, values); break;
+                case UniformKind::Float3:  glUniform3fv(location, count, values); break;
+                case UniformKind::Float4:  glUniform4fv(location, count, values); break;
+                case UniformKind::Matrix4: glUniformMatrix4fv(location, count, transpose, values); break;
+                }
+                break;
+            }
+
+            // バッファ
+            case Op::BindBuffer:
+            {
+                GLenum target = r.Get<uint32_t>();
+                glBindBuffer(target, Find(mBuffers, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::BindBufferBase:
+            {
+                GLenum target = r.Get<uint32_t>();
+                GLuint index  = r.Get<uint32_t>();
+                glBindBufferBase(target, index, Find(mBuffers, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::BindBufferRange:
+            {
+                GLenum  target = r.Get<uint32_t>();
+                GLuint  index  = r.Get<uint32_t>();
+                GLuint  buffer = Find(mBuffers, r.Get<uint32_t>());
+                int64_t offset = r.Get<int64_t>();
+                int64_t size   = r.Get<int64_t>();
+                glBindBufferRange(target, index, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+                break;
+            }
+            case Op::BufferData:
+            {
+                GLenum  target = r.Get<uint32_t>();
+                int64_t size   = r.Get<int64_t>();
+                GLenum  usage  = r.Get<uint32_t>();
+                size_t  bytes  = 0;
+                const uint8_t* data = r.GetBytes(bytes);
+                glBufferData(target, static_cast<GLsizeiptr>(size), data, usage);
+                break;
+            }
+            case Op::BufferSubData:
+            {
+                GLenum  target = r.Get<uint32_t>();
+                int64_t offset = r.Get<int64_t>();
+                size_t  bytes  = 0;
+                const uint8_t* data = r.GetBytes(bytes);
+                if (data) glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+                break;
+            }
+
+            // 頂点配列
+            case Op::BindVertexArray:
+                glBindVertexArray(Find(mVertexArrays, r.Get<uint32_t>()));
+                break;
+            case Op::EnableVertexAttribArray:
+                glEnableVertexAttribArray(r.Get<uint32_t>());
+                break;
+            case Op::DisableVertexAttribArray:
+                glDisableVertexAttribArray(r.Get<uint32_t>());
+                break;
+            case Op::VertexAttribPointer:
+            {
+                GLuint    index      = r.Get<uint32_t>();
+                GLint     size       = r.Get<int32_t>();
+                GLenum    type       = r.Get<uint32_t>();
+                GLboolean normalized = r.Get<uint8_t>();
+                GLsizei   stride     = r.Get<int32_t>();
+                uint64_t  offset     = r.Get<uint64_t>();
+                glVertexAttribPointer(index, size, type, normalized, stride, Offset(offset));
+                break;
+            }
+            case Op::VertexAttribIPointer:
+            {
+                GLuint   index  = r.Get<uint32_t>();
+                GLint    size   = r.Get<int32_t>();
+                GLenum   type   = r.Get<uint32_t>();
+                GLsizei  stride = r.Get<int32_t>();
+                uint64_t offset = r.Get<uint64_t>();
+                glVertexAttribIPointer(index, size, type, stride, Offset(offset));
+                break;
+            }
+            case Op::VertexAttribDivisor:
+            {
+                GLuint index = r.Get<uint32_t>();
+                glVertexAttribDivisor(index, r.Get<uint32_t>());
+                break;
+            }
+
+            // テクスチャ
+            case Op::ActiveTexture:
+                glActiveTexture(r.Get<uint32_t>());
+                break;
+            case Op::BindTexture:
+            {
+                GLenum target = r.Get<uint32_t>();
+                glBindTexture(target, Find(mTextures, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::TexImage2D:
+            {
+                GLenum target         = r.Get<uint32_t>();
+                GLint  level          = r.Get<int32_t>();
+                GLint  internalFormat = r.Get<int32_t>();
+                GLsizei width         = r.Get<int32_t>();
+                GLsizei height        = r.Get<int32_t>();
+                GLenum format         = r.Get<uint32_t>();
+                GLenum type           = r.Get<uint32_t>();
+                size_t bytes          = 0;
+                const uint8_t* data   = r.GetBytes(bytes);
+                glTexImage2D(target, level, internalFormat, width, height, 0, format, type, data);
+                break;
+            }
+            case Op::TexParameteri:
+            {
+                GLenum target = r.Get<uint32_t>();
+                GLenum pname  = r.Get<uint32_t>();
+                glTexParameteri(target, pname, r.Get<int32_t>());
+                break;
+            }
+            case Op::GenerateMipmap:
+                glGenerateMipmap(r.Get<uint32_t>());
+                break;
+            case Op::PixelStorei:
+            {
+                GLenum pname = r.Get<uint32_t>();
+                glPixelStorei(pname, r.Get<int32_t>());
+                break;
+            }
+
+            // フレームバッファ
+            case Op::BindFramebuffer:
+            {
+                GLenum target = r.Get<uint32_t>();
+                glBindFramebuffer(target, Find(mFramebuffers, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::FramebufferTexture2D:
+            {
+                GLenum target     = r.Get<uint32_t>();
+                GLenum attachment = r.Get<uint32_t>();
+                GLenum texTarget  = r.Get<uint32_t>();
+                GLuint texture    = Find(mTextures, r.Get<uint32_t>());
+                GLint  level      = r.Get<int32_t>();
+                glFramebufferTexture2D(target, attachment, texTarget, texture, level);
+                break;
+            }
+            case Op::FramebufferRenderbuffer:
+            {
+                GLenum target     = r.Get<uint32_t>();
+                GLenum attachment = r.Get<uint32_t>();
+                GLenum rbTarget   = r.Get<uint32_t>();
+                glFramebufferRenderbuffer(target, attachment, rbTarget, Find(mRenderbuffers, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::BindRenderbuffer:
+            {
+                GLenum target = r.Get<uint32_t>();
+                glBindRenderbuffer(target, Find(mRenderbuffers, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::RenderbufferStorage:
+            {
+                GLenum  target = r.Get<uint32_t>();
+                GLenum  format = r.Get<uint32_t>();
+                GLsizei width  = r.Get<int32_t>();
+                GLsizei height = r.Get<int32_t>();
+                glRenderbufferStorage(target, format, width, height);
+                break;
+            }
+            case Op::DrawBuffers:
+            {
+                int32_t n = r.Get<int32_t>();
+                std::vector<GLenum> bufs;
+                for (int32_t i = 0; i < n; ++i) bufs.push_back(r.Get<uint32_t>());
+                glDrawBuffers(n, bufs.data());
+                break;
+            }
+            case Op::DrawBuffer:
+                glDrawBuffer(r.Get<uint32_t>());
+                break;
+            case Op::ReadBuffer:
+                glReadBuffer(r.Get<uint32_t>());
+                break;
+
+            // 固定機能の状態
+            case Op::Enable:
+                glEnable(r.Get<uint32_t>());
+                break;
+            case Op::Disable:
+                glDisable(r.Get<uint32_t>());
+                break;
+            case Op::BlendFunc:
+            {
+                GLenum src = r.Get<uint32_t>();
+                glBlendFunc(src, r.Get<uint32_t>());
+                break;
+            }
+            case Op::BlendFuncSeparate:
+            {
+                GLenum srcRGB = r.Get<uint32_t>();
+                GLenum dstRGB = r.Get<uint32_t>();
+                GLenum srcA   = r.Get<uint32_t>();
+                glBlendFuncSeparate(srcRGB, dstRGB, srcA, r.Get<uint32_t>());
+                break;
+            }
+            case Op::DepthMask:
+                glDepthMask(r.Get<uint8_t>());
+                break;
+            case Op::ColorMask:
+            {
+                GLboolean m[4];
+                for (auto& v : m) v = r.Get<uint8_t>();
+                glColorMask(m[0], m[1], m[2], m[3]);
+                break;
+            }
+            case Op::FrontFace:
+                glFrontFace(r.Get<uint32_t>());
+                break;
+            case Op::Viewport:
+            case Op::Scissor:
+            {
+                GLint v[4];
+                for (auto& x : v) x = r.Get<int32_t>();
+                if (op == Op::Viewport) glViewport(v[0], v[1], v[2], v[3]);
+                else                    glScissor(v[0], v[1], v[2], v[3]);
+                break;
+            }
+            case Op::ClearColor:
+            {
+                GLfloat c[4];
+                for (auto& x : c) x = r.Get<float>();
+                glClearColor(c[0], c[1], c[2], c[3]);
+                break;
+            }
+            case Op::Clear:
+                glClear(r.Get<uint32_t>());
+                break;
+
+            // 描画
+            case Op::DrawArrays:
+            {
+                GLenum mode  = r.Get<uint32_t>();
+                GLint  first = r.Get<int32_t>();
+                glDrawArrays(mode, first, r.Get<int32_t>());
+                break;
+            }
+            case Op::DrawElements:
+            {
+                GLenum   mode   = r.Get<uint32_t>();
+                GLsizei  count  = r.Get<int32_t>();
+                GLenum   type   = r.Get<uint32_t>();
+                uint64_t offset = r.Get<uint64_t>();
+                glDrawElements(mode, count, type, Offset(offset));
+                break;
+            }
+            case Op::DrawElementsInstanced:
+            {
+                GLenum   mode   = r.Get<uint32_t>();
+                GLsizei  count  = r.Get<int32_t>();
+                GLenum   type   = r.Get<uint32_t>();
+                uint64_t offset = r.Get<uint64_t>();
+                GLsizei  instances = r.Get<int32_t>();
+                glDrawElementsInstanced(mode, count, type, Offset(offset), instances);
+                break;
+            }
+            case Op::MultiDrawElements:
+            {
+                GLenum  mode      = r.Get<uint32_t>();
+                GLenum  type      = r.Get<uint32_t>();
+                int32_t drawCount = r.Get<int32_t>();
+                std::vector<GLsizei>     counts;
+                std::vector<const void*> offsets;
+                for (int32_t i = 0; i < drawCount && r.IsValid(); ++i)
+                {
+                    counts.push_back(r.Get<int32_t>());
+                    offsets.push_back(Offset(r.Get<uint64_t>()));
+                }
+                if (!counts.empty())
+                {
+                    glMultiDrawElements(mode, counts.data(), type, offsets.data(),
+                                        static_cast<GLsizei>(counts.size()));
+                }
+                break;
+            }
+            case Op::BindTransformFeedback:
+            {
+                GLenum target = r.Get<uint32_t>();
+                glBindTransformFeedback(target, Find(mTransformFeedbacks, r.Get<uint32_t>()));
+                break;
+            }
+            case Op::BeginTransformFeedback:
+                glBeginTransformFeedback(r.Get<uint32_t>());
+                break;
+            case Op::EndTransformFeedback:
+                glEndTransformFeedback();
+                break;
+            case Op::ReadPixels:
+            {
+                GLint    x      = r.Get<int32_t>();
+                GLint    y      = r.Get<int32_t>();
+                GLsizei  width  = r.Get<int32_t>();
+                GLsizei  height = r.Get<int32_t>();
+                GLenum   format = r.Get<uint32_t>();
+                GLenum   type   = r.Get<uint32_t>();
+                uint64_t offset = r.Get<uint64_t>();
+                glReadPixels(x, y, width, height, format, type, const_cast<void*>(Offset(offset)));
+                break;
+            }
+
+            default:
+                std::cerr << "GLReplay: unknown op " << static_cast<int>(op)
+                          << " at " << r.GetPos() << std::endl;
+                return op;
+            }
+        }
+        return static_cast<Op>(0);      // 区切りの前に終わった
+    }
+
+    toy::GLCapture::Header mHeader;
+    std::vector<uint8_t>   mData;
+    std::vector<size_t>    mFrameBegin;     // 各フレームの先頭（mData 内の位置）
+
+    NameMap mBuffers;
+    NameMap mTextures;
+    NameMap mVertexArrays;
+    NameMap mFramebuffers;
+    NameMap mRenderbuffers;
+    NameMap mTransformFeedbacks;
+    NameMap mShaders;
+    NameMap mPrograms;
+
+    GLuint mCurrentProgram = 0;
+    std::unordered_map<GLuint, std::unordered_map<std::string, GLint>> mLocations;
+};
+
+// 時間の集計
+struct Stats
+{
+    double minMs = 1e30;
+    double maxMs = 0.0;
+    double sumMs = 0.0;
+    int    count = 0;
+
+    void Add(double ms)
+    {
+        minMs = std::min(minMs, ms);
+        maxMs = std::max(maxMs, ms);
+        sumMs += ms;
+        ++count;
+    }
+    double Avg() const { return count > 0 ? sumMs / count : 0.0; }
+};
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: GLReplay <capture.tglc> [iterations=100] [width=1280] [height=720]" << std::endl;
+        return 1;
+    }
+    const std::string path = argv[1];
+    const int iterations = (argc > 2) ? std::max(std::atoi(argv[2]), 1) : 100;
+    const int width      = (argc > 3) ? std::max(std::atoi(argv[3]), 1) : 1280;
+    const int height     = (argc > 4) ? std::max(std::atoi(argv[4]), 1) : 720;
+
+    Replayer replayer;
+    if (!replayer.Load(path))
+    {
+        return 1;
+    }
+
+    //---------------------------------------------------------
+    // 非表示ウィンドウ + GL 4.1 Core（Renderer と同じ設定）
+    //---------------------------------------------------------
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        std::cerr << "GLReplay: SDL_Init failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+    SDL_GL_SetAttribute(SDL_GL_RED_SIZE,   8);
+    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE,  8);
+    SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+
+    SDL_Window* window = SDL_CreateWindow("GLReplay", width, height, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!window)
+    {
+        std::cerr << "GLReplay: SDL_CreateWindow failed: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+    SDL_GLContext context = SDL_GL_CreateContext(window);
+    if (!context || !gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress))
+    {
+        std::cerr << "GLReplay: failed to create GL 4.1 context: " << SDL_GetError() << std::endl;
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    SDL_GL_SetSwapInterval(0);
+
+    int result = 0;
+    if (!replayer.RunSetup())
+    {
+        result = 1;
+    }
+    else
+    {
+        //-----------------------------------------------------
+        // 計測：フレームごとに GPU 時間（タイマークエリ）と
+        //       CPU 時間（発行から glFinish まで）
+        //-----------------------------------------------------
+        const size_t frames = replayer.GetReplayableFrames();
+        std::vector<Stats> gpu(frames), cpu(frames);
+        Stats gpuTotal, cpuTotal;
+
+        GLuint query = 0;
+        glGenQueries(1, &query);
+
+        for (int it = 0; it < iterations; ++it)
+        {
+            for (size_t f = 0; f < frames; ++f)
+            {
+                auto start = std::chrono::steady_clock::now();
+                glBeginQuery(GL_TIME_ELAPSED, query);
+                replayer.RunFrame(f);
+                glEndQuery(GL_TIME_ELAPSED);
+                glFinish();
+                auto end = std::chrono::steady_clock::now();
+
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+                double gpuMs = static_cast<double>(ns) / 1.0e6;
+                double cpuMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+                gpu[f].Add(gpuMs);
+                cpu[f].Add(cpuMs);
+                gpuTotal.Add(gpuMs);
+                cpuTotal.Add(cpuMs);
+            }
+        }
+        glDeleteQueries(1, &query);
+
+        std::printf("GLReplay: %s (%zu frame(s), %zu bytes), %d iteration(s), %dx%d\n",
+                    path.c_str(), frames, replayer.GetDataSize(), iterations, width, height);
+        std::printf("%8s  %28s  %28s\n", "frame", "cpu ms (min / avg / max)", "gpu ms (min / avg / max)");
+        for (size_t f = 0; f < frames; ++f)
+        {
+            std::printf("%8zu  %8.3f / %8.3f / %8.3f  %8.3f / %8.3f / %8.3f\n", f,
+                        cpu[f].minMs, cpu[f].Avg(), cpu[f].maxMs,
+                        gpu[f].minMs, gpu[f].Avg(), gpu[f].maxMs);
+        }
+        std::printf("%8s  %8.3f / %8.3f / %8.3f  %8.3f / %8.3f / %8.3f\n", "all",
+                    cpuTotal.minMs, cpuTotal.Avg(), cpuTotal.maxMs,
+                    gpuTotal.minMs, gpuTotal.Avg(), gpuTotal.maxMs);
+    }
+
+    SDL_GL_DestroyContext(context);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return result;
+}
@@ -0,0 +1,195 @@
+//=============================================================
+// LightBaker（コマンドライン版）
+// ・シーン記述の JSON に並べた静的メッシュについて、太陽の可視率と AO を
+//   頂点ごとに焼いてキャッシュファイルへ書き出す（toy::LightBaker と同じ処理・形式）
+// ・ゲーム側では MeshComponent::SetLightBaking(true) の後に
+//   GetLightBaker()->LoadCache(<out>) → Apply()。キーは LightBaker::MakeKey
+//   （Actor の ID + ワールド行列のハッシュ。同じキーが複数あれば、ここでも登録順に "#1" ... と付ける）
+//   ※ position / rotation / scale はゲーム側の Actor と同じ値にすること
+// ・メッシュの頂点は GPU から読み戻すので、非表示ウィンドウの GL コンテキストを作る
+//
+// 使い方
+//   LightBaker <scene.json> <out.bin>
+//
+// scene.json
+//   {
+//     "assets_path"  : "Assets/",
+//     "sun_direction": [x, y, z],        // ライト → シーン
+//     "sun_samples"  : 4,   "sun_angle"  : 0.5,
+//     "ao_samples"   : 32,  "ao_distance": 4.0,
+//     "threads"      : 0,                // 0 なら全コア
+//     "objects": [
+//       { "id": "Rock01", "mesh": "Rock.fbx", "right_handed": false,
+//         "position": [x, y, z], "rotation": [pitch, yaw, roll], "scale": 1.0 }
+//     ]
+//   }
+//   scale は数値か [x, y, z]
+//
+// ビルド
+//   ToyLib とリンクする（include / External / External/glad/include、SDL3、assimp）
+//=============================================================
+#include "Graphics/Mesh/LightBaker.h"
+#include "Asset/AssetManager.h"
+#include "Utils/JsonHelper.h"
+#include "glad/glad.h"
+
+#include <SDL3/SDL.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: LightBaker <scene.json> <out.bin>" << std::endl;
+        return 1;
+    }
+    const std::string scenePath = argv[1];
+    const std::string outPath   = argv[2];
+
+    nlohmann::json scene;
+    if (!JsonHelper::LoadFromFile(scenePath, scene))
+    {
+        std::cerr << "LightBaker: failed to load " << scenePath << std::endl;
+        return 1;
+    }
+    if (!scene.contains("objects") || !scene["objects"].is_array())
+    {
+        std::cerr << "LightBaker: \"objects\" is missing: " << scenePath << std::endl;
+        return 1;
+    }
+
+    toy::LightBakeSettings settings;
+    int threads = 0;
+    JsonHelper::GetVector3(scene, "sun_direction", settings.sunDirection);
+    JsonHelper::GetInt    (scene, "sun_samples",   settings.sunSamples);
+    JsonHelper::GetFloat  (scene, "sun_angle",     settings.sunAngle);
+    JsonHelper::GetInt    (scene, "ao_samples",    settings.aoSamples);
+    JsonHelper::GetFloat  (scene, "ao_distance",   settings.aoDistance);
+    JsonHelper::GetFloat  (scene, "ray_bias",      settings.rayBias);
+    if (JsonHelper::GetInt(scene, "threads", threads) && threads > 0)
+    {
+        settings.threads = static_cast<unsigned int>(threads);
+    }
+
+    //---------------------------------------------------------
+    // 非表示ウィンドウ + GL 4.1 Core（Renderer と同じ設定）
+    //---------------------------------------------------------
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        std::cerr << "LightBaker: SDL_Init failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+
+    SDL_Window* window = SDL_CreateWindow("LightBaker", 64, 64, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!window)
+    {
+        std::cerr << "LightBaker: SDL_CreateWindow failed: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+    SDL_GLContext context = SDL_GL_CreateContext(window);
+    if (!context || !gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress))
+    {
+        std::cerr << "LightBaker: failed to create GL 4.1 context: " << SDL_GetError() << std::endl;
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    int result = 0;
+    {
+        toy::AssetManager assets;
+        std::string assetsPath;
+        if (JsonHelper::GetString(scene, "assets_path", assetsPath))
+        {
+            assets.SetAssetsPath(assetsPath);
+        }
+
+        toy::LightBaker baker;
+        std::unordered_map<std::string, int> used;
+        size_t count = 0;
+
+        //-----------------------------------------------------
+        // 配置（ワールド行列は Actor と同じ Scale * Rotation * Translation）
+        //-----------------------------------------------------
+        for (const auto& obj : scene["objects"])
+        {
+            std::string id;
+            std::string meshFile;
+            if (!JsonHelper::GetString(obj, "id", id) || !JsonHelper::GetString(obj, "mesh", meshFile))
+            {
+                std::cerr << "LightBaker: object without \"id\" or \"mesh\" skipped" << std::endl;
+                continue;
+            }
+
+            bool isRightHanded = false;
+            JsonHelper::GetBool(obj, "right_handed", isRightHanded);
+            auto mesh = assets.GetMesh(meshFile, isRightHanded);
+            if (!mesh)
+            {
+                std::cerr << "LightBaker: failed to load mesh " << meshFile << std::endl;
+                continue;
+            }
+
+            Vector3    position = Vector3::Zero;
+            Quaternion rotation = Quaternion::Identity;
+            Vector3    scale(1.0f, 1.0f, 1.0f);
+            float      uniformScale = 1.0f;
+            JsonHelper::GetVector3(obj, "position", position);
+            JsonHelper::GetQuaternionFromEuler(obj, "rotation", rotation);
+            if (JsonHelper::GetFloat(obj, "scale", uniformScale))
+            {
+                scale = Vector3(uniformScale, uniformScale, uniformScale);
+            }
+            else
+            {
+                JsonHelper::GetVector3(obj, "scale", scale);
+            }
+
+            Matrix4 world = Matrix4::CreateScale(scale)
+                          * Matrix4::CreateFromQuaternion(rotation)
+                          * Matrix4::CreateTranslation(position);
+
+            std::string key = toy::LightBaker::MakeKey(id, world);
+            int n = used[key]++;
+            if (n > 0) key += "#" + std::to_string(n);
+            baker.AddInstance(key, mesh, world);
+            ++count;
+        }
+
+        if (count == 0)
+        {
+            std::cerr << "LightBaker: nothing to bake" << std::endl;
+            result = 1;
+        }
+        else
+        {
+            auto start = std::chrono::steady_clock::now();
+            size_t verts = baker.Bake(settings);
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+
+            if (!baker.SaveCache(outPath))
+            {
+                result = 1;
+            }
+            else
+            {
+                std::cout << "LightBaker: " << verts << " vertices in " << seconds
+                          << " s -> " << outPath << std::endl;
+            }
+        }
+    }
+
+    SDL_GL_DestroyContext(context);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return result;
+}